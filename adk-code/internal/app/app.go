@@ -10,7 +10,10 @@ import (
 
 	"google.golang.org/adk/agent"
 
+	"adk-code/internal/clone"
 	"adk-code/internal/config"
+	"adk-code/internal/llm"
+	"adk-code/internal/lsp"
 	"adk-code/internal/orchestration"
 	"adk-code/internal/repl"
 	"adk-code/internal/runtime"
@@ -63,6 +66,9 @@ func New(ctx context.Context, cfg *config.Config) (*Application, error) {
 	app.mcp = components.MCP
 	app.session = components.Session
 
+	// Warm the model discovery cache so /providers and /models answer instantly
+	llm.DefaultModelDiscovery().RefreshInBackground(app.ctx)
+
 	// Print welcome banner
 	displayName := app.model.Selected.DisplayName
 	banner := app.display.BannerRenderer.RenderStartBanner(AppVersion, displayName, cfg.WorkingDirectory)
@@ -138,6 +144,8 @@ func (a *Application) Close() {
 	if a.session != nil && a.session.Manager != nil {
 		a.session.Manager.Close()
 	}
+	lsp.DefaultManager().Close()
+	clone.CloseSharedPools()
 	if a.signalHandler != nil {
 		a.signalHandler.Cancel()
 	}
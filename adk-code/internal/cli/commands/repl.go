@@ -11,6 +11,7 @@ import (
 
 	"adk-code/internal/config"
 	"adk-code/internal/display"
+	"adk-code/internal/llm"
 	"adk-code/internal/mcp"
 	agentprompts "adk-code/internal/prompts"
 	"adk-code/internal/session"
@@ -55,6 +56,10 @@ func HandleBuiltinCommand(ctx context.Context, input string, renderer *display.R
 		handleTokensCommand(sessionTokens)
 		return true
 
+	case "/timeouts":
+		handleTimeoutsCommand(renderer)
+		return true
+
 	case "/compaction":
 		handleCompactionCommand(renderer, appConfig)
 		return true
@@ -119,6 +124,16 @@ func HandleBuiltinCommand(ctx context.Context, input string, renderer *display.R
 			HandleSetModel(renderer, modelRegistry, modelSpec)
 			return true
 		}
+		// Check if it's an /inspect command
+		if input == "/inspect" || strings.HasPrefix(input, "/inspect ") {
+			handleInspectCommand(input, renderer)
+			return true
+		}
+		// Check if it's a /cache command
+		if input == "/cache" || strings.HasPrefix(input, "/cache ") {
+			handleCacheCommand(input, renderer, appConfig)
+			return true
+		}
 		// Check if it's an /mcp command
 		if strings.HasPrefix(input, "/mcp") {
 			handleMCPCommand(input, renderer, mcpManager)
@@ -195,6 +210,23 @@ func handleProvidersCommand(ctx context.Context, renderer *display.Renderer, reg
 func handleTokensCommand(sessionTokens *tracking.SessionTokens) {
 	summary := sessionTokens.GetSummary()
 	fmt.Print(tracking.FormatSessionSummary(summary))
+
+	if stats := tools.GetSearchCacheStats(); stats.Hits+stats.Misses > 0 {
+		fmt.Print(formatSearchCacheStats(stats))
+	}
+}
+
+// formatSearchCacheStats renders web search cache effectiveness for /tokens
+func formatSearchCacheStats(stats tools.SearchCacheStats) string {
+	lines := []string{
+		"🔎 Web Search Cache",
+		fmt.Sprintf("  ├─ Lookups:          %d (%d hits, %d misses)", stats.Hits+stats.Misses, stats.Hits, stats.Misses),
+		fmt.Sprintf("  ├─ Hit Rate:         %.1f%%", stats.HitRate()),
+		fmt.Sprintf("  ├─ Search Calls:     %d", stats.SubagentCalls),
+		fmt.Sprintf("  └─ Cached Answers:   %d", stats.Entries),
+		"",
+	}
+	return strings.Join(lines, "\n")
 }
 
 // handleCompactionCommand displays the session history compaction configuration
@@ -224,6 +256,7 @@ func handleCompactionCommand(renderer *display.Renderer, appConfig interface{})
 	fmt.Printf("  %s Overlap Window:        %d invocations\n", renderer.Dim("•"), cfg.CompactionOverlap)
 	fmt.Printf("  %s Token Threshold:       %d tokens\n", renderer.Dim("•"), cfg.CompactionTokens)
 	fmt.Printf("  %s Safety Ratio:          %.1f%%\n", renderer.Dim("•"), cfg.CompactionSafety*100)
+	fmt.Printf("  %s Rolling Summary:       %t\n", renderer.Dim("•"), cfg.CompactionRolling)
 	fmt.Println()
 
 	// Display what this means
@@ -233,6 +266,7 @@ func handleCompactionCommand(renderer *display.Renderer, appConfig interface{})
 	fmt.Println(renderer.Dim("  • Overlap Window: How many recent invocations to retain in context"))
 	fmt.Println(renderer.Dim("  • Token Threshold: Summarization occurs when session exceeds this token limit"))
 	fmt.Println(renderer.Dim("  • Safety Ratio: Buffer below the token limit to prevent exceeding it"))
+	fmt.Println(renderer.Dim("  • Rolling Summary: One summary per session, updated from newly aged-out invocations only"))
 	fmt.Println()
 
 	// Display usage information
@@ -247,7 +281,8 @@ func handleCompactionCommand(renderer *display.Renderer, appConfig interface{})
 	fmt.Println("           " + renderer.Cyan("--compaction-threshold 5 \\"))
 	fmt.Println("           " + renderer.Cyan("--compaction-overlap 2 \\"))
 	fmt.Println("           " + renderer.Cyan("--compaction-tokens 700000 \\"))
-	fmt.Println("           " + renderer.Cyan("--compaction-safety 0.7"))
+	fmt.Println("           " + renderer.Cyan("--compaction-safety 0.7 \\"))
+	fmt.Println("           " + renderer.Cyan("--compaction-rolling"))
 	fmt.Println()
 }
 
@@ -623,6 +658,102 @@ func handleShowSessionREPL(ctx context.Context, renderer *display.Renderer, appC
 	handleSessionByID(ctx, renderer, cfg, sessionID)
 }
 
+// handleInspectCommand shows the breakdown of the last request sent to the model.
+// "/inspect last --json [file]" dumps it as JSON to stdout or a file.
+func handleInspectCommand(input string, renderer *display.Renderer) {
+	parts := strings.Fields(input)
+	if len(parts) > 1 && parts[1] != "last" {
+		fmt.Println(renderer.Yellow(fmt.Sprintf("⚠ Unknown /inspect subcommand: %s", parts[1])))
+		fmt.Println("Usage: /inspect last [--json [file]]")
+		return
+	}
+
+	inspection, ok := llm.DefaultRequestInspector().Last()
+	if !ok {
+		fmt.Println(renderer.Yellow("⚠ No request has been sent to the model yet"))
+		return
+	}
+
+	if len(parts) > 2 && parts[2] == "--json" {
+		data, err := inspection.JSON()
+		if err != nil {
+			fmt.Println(renderer.Red(fmt.Sprintf("Failed to encode request: %v", err)))
+			return
+		}
+		if len(parts) > 3 {
+			if err := os.WriteFile(parts[3], data, 0644); err != nil {
+				fmt.Println(renderer.Red(fmt.Sprintf("Failed to write %s: %v", parts[3], err)))
+				return
+			}
+			fmt.Println(renderer.Green("✓ Request written to " + parts[3]))
+			return
+		}
+		fmt.Println(string(data))
+		return
+	}
+
+	paginator := display.NewPaginator(renderer)
+	paginator.DisplayPaged(buildInspectionLines(renderer, inspection))
+}
+
+// handleCacheCommand shows the LLM response cache statistics. "/cache off"
+// sends the current session's requests to the model again, and "/cache on"
+// replays them from the cache.
+func handleCacheCommand(input string, renderer *display.Renderer, appConfig interface{}) {
+	cache := llm.ActiveResponseCache()
+	if cache == nil {
+		fmt.Println(renderer.Yellow("⚠ The response cache is off; start adk-code with --llm-cache to enable it"))
+		return
+	}
+	cfg, ok := appConfig.(*config.Config)
+	if !ok {
+		fmt.Println(renderer.Red("Error: Configuration not available"))
+		return
+	}
+
+	parts := strings.Fields(input)
+	if len(parts) > 1 {
+		switch parts[1] {
+		case "off":
+			cache.SetBypass(cfg.SessionName, true)
+			fmt.Println(renderer.Green("✓ Session " + cfg.SessionName + " bypasses the response cache"))
+		case "on":
+			cache.SetBypass(cfg.SessionName, false)
+			fmt.Println(renderer.Green("✓ Session " + cfg.SessionName + " uses the response cache"))
+		default:
+			fmt.Println(renderer.Yellow(fmt.Sprintf("⚠ Unknown /cache subcommand: %s", parts[1])))
+			fmt.Println("Usage: /cache [on|off]")
+		}
+		return
+	}
+
+	stats := cache.Stats()
+	status := "on"
+	if cache.Bypassed(cfg.SessionName) {
+		status = "bypassed"
+	}
+	fmt.Println(renderer.Bold("LLM Response Cache:"))
+	fmt.Printf("  %s Directory:        %s\n", renderer.Dim("•"), cache.Dir())
+	fmt.Printf("  %s This session:     %s\n", renderer.Dim("•"), status)
+	fmt.Printf("  %s Entries:          %d (%.1f MB)\n", renderer.Dim("•"), stats.Entries, float64(stats.Bytes)/(1024*1024))
+	fmt.Printf("  %s Hits / misses:    %d / %d\n", renderer.Dim("•"), stats.Hits, stats.Misses)
+	fmt.Printf("  %s Stored / evicted: %d / %d\n", renderer.Dim("•"), stats.Stores, stats.Evictions)
+}
+
+// handleTimeoutsCommand shows adaptive tool timeouts and the tools that
+// regularly exceed their SLO.
+func handleTimeoutsCommand(renderer *display.Renderer) {
+	policy := tracking.DefaultTimeoutPolicy()
+	stats := policy.Stats()
+	if len(stats) == 0 {
+		fmt.Println(renderer.Yellow("⚠ No tool runs with timeouts have been recorded yet"))
+		return
+	}
+
+	paginator := display.NewPaginator(renderer)
+	paginator.DisplayPaged(buildTimeoutLines(renderer, stats, policy.SLOViolators()))
+}
+
 // handleMCPCommand handles /mcp commands and subcommands
 func handleMCPCommand(input string, renderer *display.Renderer, mcpManager *mcp.Manager) {
 	// Handle case where MCP is disabled or not available
@@ -8,8 +8,9 @@ import (
 	"time"
 
 	"adk-code/internal/display"
-	"adk-code/internal/llm/backends"
+	"adk-code/internal/llm"
 	"adk-code/internal/session/compaction"
+	"adk-code/internal/tracking"
 	"adk-code/pkg/agents"
 	"adk-code/pkg/models"
 
@@ -41,6 +42,9 @@ func buildHelpMessageLines(renderer *display.Renderer) []string {
 	lines = append(lines, "   • "+renderer.Bold("/run-agent <name>")+" - Show agent details or execute agent (preview)")
 	lines = append(lines, "   • "+renderer.Bold("/prompt")+" - Display the system prompt")
 	lines = append(lines, "   • "+renderer.Bold("/tokens")+" - Show token usage statistics")
+	lines = append(lines, "   • "+renderer.Bold("/inspect last [--json [file]]")+" - Break down the last request sent to the model")
+	lines = append(lines, "   • "+renderer.Bold("/timeouts")+" - Show adaptive tool timeouts and tools missing their SLO")
+	lines = append(lines, "   • "+renderer.Bold("/cache [on|off]")+" - Show the LLM response cache, or bypass it for this session")
 	lines = append(lines, "")
 
 	lines = append(lines, renderer.Bold("📊 Session Management (REPL commands):"))
@@ -229,6 +233,23 @@ func buildModelsListLines(renderer *display.Renderer, registry *models.Registry)
 		lines = append(lines, "")
 	}
 
+	// Locally discovered models, from the discovery cache only
+	discovery := llm.DefaultModelDiscovery()
+	if discovered, status := discovery.Cached("ollama"); status != llm.DiscoveryMissing && len(discovered.Models) > 0 {
+		lines = append(lines, renderer.Bold(fmt.Sprintf("🦙 Ollama Models %s:", discoveryMarker(discovery, discovered, status))))
+		for _, modelInfo := range discovered.Models {
+			details := modelInfo.Family
+			if modelInfo.Size != "" {
+				details = strings.TrimSpace(details + " " + modelInfo.Size)
+			}
+			if details != "" {
+				details = " - " + details
+			}
+			lines = append(lines, fmt.Sprintf("   ○ %s%s", renderer.Bold("ollama/"+modelInfo.Name), details))
+		}
+		lines = append(lines, "")
+	}
+
 	lines = append(lines, renderer.Dim("Use --model flag to select a model (e.g., --model gemini-1.5-pro)"))
 	lines = append(lines, renderer.Dim("Use /current-model command to see details about the active model"))
 	lines = append(lines, "")
@@ -310,6 +331,11 @@ func buildProvidersListLines(ctx context.Context, renderer *display.Renderer, re
 	lines = append(lines, renderer.Cyan("════════════════════════════════════════════════════════════════"))
 	lines = append(lines, "")
 
+	// Never block on the network: use cached discovery results and refresh
+	// anything stale in the background for the next listing
+	discovery := llm.DefaultModelDiscovery()
+	discovery.RefreshInBackground(ctx)
+
 	// Display each provider
 	for _, providerName := range registry.ListProviders() {
 		provider := models.ParseProvider(providerName)
@@ -323,15 +349,14 @@ func buildProvidersListLines(ctx context.Context, renderer *display.Renderer, re
 		// List models for this provider
 		var modelsCfg []models.Config
 
-		// For Ollama, try to dynamically discover models from the server
+		// For Ollama, show the models discovered from the server (served from
+		// the discovery cache, refreshed in the background)
 		if providerName == "ollama" {
-			ollamaProvider := backends.NewOllamaProvider()
-			if dynamicModels, err := ollamaProvider.ListModels(ctx, false); err == nil && len(dynamicModels) > 0 {
-				// Display dynamic models from Ollama
-				lines = append(lines, renderer.Dim("   Dynamic models from Ollama server:"))
+			if discovered, status := discovery.Cached(providerName); status != llm.DiscoveryMissing && len(discovered.Models) > 0 {
+				lines = append(lines, renderer.Dim(fmt.Sprintf("   Dynamic models from Ollama server %s:", discoveryMarker(discovery, discovered, status))))
 				lines = append(lines, "")
 
-				for _, modelInfo := range dynamicModels {
+				for _, modelInfo := range discovered.Models {
 					icon := "○"
 					costIcon := "💰"
 					modelSyntax := fmt.Sprintf("ollama/%s", modelInfo.Name)
@@ -344,7 +369,10 @@ func buildProvidersListLines(ctx context.Context, renderer *display.Renderer, re
 				lines = append(lines, "")
 				continue
 			}
-			// Fall back to static models if dynamic discovery fails
+			if discovery.Refreshing() {
+				lines = append(lines, renderer.Dim("   Discovering models from Ollama server... (showing built-in list)"))
+			}
+			// Fall back to static models until discovery succeeds
 		}
 
 		// Use static models from registry (fallback)
@@ -377,6 +405,20 @@ func buildProvidersListLines(ctx context.Context, renderer *display.Renderer, re
 	return lines
 }
 
+// discoveryMarker describes how current a discovered model list is
+func discoveryMarker(discovery *llm.ModelDiscoveryService, result llm.DiscoveryResult, status llm.DiscoveryStatus) string {
+	marker := "(updated " + llm.FormatAge(result.FetchedAt)
+	if status == llm.DiscoveryStale {
+		marker = "(cached " + llm.FormatAge(result.FetchedAt)
+		if discovery.Refreshing() {
+			marker += ", refreshing"
+		} else if result.Error != "" {
+			marker += ", server unreachable"
+		}
+	}
+	return marker + ")"
+}
+
 // buildPromptLines builds the system prompt as an array of lines for pagination
 func buildPromptLines(renderer *display.Renderer, cleanedPrompt string) []string {
 	var lines []string
@@ -732,6 +774,101 @@ func countEventsByType(events session.Events) eventTypeCounts {
 	return counts
 }
 
+// buildInspectionLines renders a request breakdown: token estimates per
+// section, then every part with duplicate and oversized parts highlighted.
+func buildInspectionLines(renderer *display.Renderer, inspection *llm.RequestInspection) []string {
+	var lines []string
+
+	lines = append(lines, "")
+	lines = append(lines, renderer.Bold(fmt.Sprintf("🔍 Last Request to %s (%s)", inspection.Model, inspection.Time.Format("15:04:05"))))
+	lines = append(lines, "")
+
+	for _, section := range inspection.Sections {
+		share := 0.0
+		if inspection.TotalTokens > 0 {
+			share = float64(section.Tokens) / float64(inspection.TotalTokens) * 100
+		}
+		lines = append(lines, fmt.Sprintf("  %-8s %8d tokens  %5.1f%%  (%d parts)", section.Name, section.Tokens, share, section.Parts))
+	}
+	lines = append(lines, fmt.Sprintf("  %-8s %8d tokens (estimated)", "total", inspection.TotalTokens))
+
+	if inspection.Duplicates > 0 || inspection.Oversized > 0 {
+		lines = append(lines, "")
+		lines = append(lines, renderer.Yellow(fmt.Sprintf("  ⚠ %d duplicate and %d oversized parts", inspection.Duplicates, inspection.Oversized)))
+	}
+
+	lines = append(lines, "")
+	lines = append(lines, renderer.Bold("Parts:"))
+	for i, part := range inspection.Parts {
+		label := part.Kind
+		if part.Name != "" {
+			label += " " + part.Name
+		}
+		line := fmt.Sprintf("  %3d %-8s %-30s %7d  %s", i+1, part.Section, truncateText(label, 30), part.Tokens,
+			truncateText(strings.Join(strings.Fields(part.Preview), " "), 50))
+		if part.DuplicateOf > 0 {
+			line += renderer.Yellow(fmt.Sprintf("  [duplicate of #%d]", part.DuplicateOf))
+		}
+		for _, flag := range part.Flags {
+			if flag == "oversized" {
+				line += renderer.Yellow("  [oversized]")
+			}
+		}
+		lines = append(lines, line)
+	}
+	lines = append(lines, "")
+
+	return lines
+}
+
+// buildTimeoutLines builds the adaptive timeout report as an array of lines
+func buildTimeoutLines(renderer *display.Renderer, stats []tracking.TimeoutStats, violators []tracking.TimeoutStats) []string {
+	var lines []string
+
+	lines = append(lines, "")
+	lines = append(lines, renderer.Bold("⏱  Tool Timeouts (learned from recent runs)"))
+	lines = append(lines, "")
+	lines = append(lines, fmt.Sprintf("  %-36s %5s %9s %9s %9s %9s %8s", "tool / command", "runs", "p50", "p95", "timeout", "slo", "missed"))
+
+	violating := make(map[string]bool, len(violators))
+	for _, v := range violators {
+		violating[v.Key] = true
+	}
+	for _, st := range stats {
+		line := fmt.Sprintf("  %-36s %5d %9s %9s %9s %9s %7.1f%%", truncateText(st.Key, 36), st.Runs,
+			formatLatency(st.P50), formatLatency(st.P95), formatLatency(st.Timeout), formatLatency(st.SLO), st.ViolationRate()*100)
+		if violating[st.Key] {
+			line = renderer.Yellow(line)
+		}
+		lines = append(lines, line)
+	}
+
+	lines = append(lines, "")
+	if len(violators) == 0 {
+		lines = append(lines, renderer.Green("  ✓ All tools are meeting their SLO"))
+	} else {
+		lines = append(lines, renderer.Yellow(fmt.Sprintf("  ⚠ %d tools or commands regularly exceed their SLO:", len(violators))))
+		for _, v := range violators {
+			lines = append(lines, fmt.Sprintf("    • %s: %d of %d runs missed %s (%d timed out)", v.Key, v.Violations, v.Runs, formatLatency(v.SLO), v.TimedOut))
+		}
+	}
+	lines = append(lines, "")
+
+	return lines
+}
+
+// formatLatency rounds a latency for display, "-" when unset
+func formatLatency(d time.Duration) string {
+	switch {
+	case d <= 0:
+		return "-"
+	case d < time.Second:
+		return d.Round(time.Millisecond).String()
+	default:
+		return d.Round(100 * time.Millisecond).String()
+	}
+}
+
 // countTotalTokens sums up all tokens across events
 func countTotalTokens(events session.Events) int {
 	total := 0
@@ -0,0 +1,299 @@
+package clone
+
+import (
+	"bytes"
+	"errors"
+	"fmt"
+	"io/fs"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"sort"
+	"strings"
+)
+
+// Kind is how a file differs between a clone and the workspace.
+type Kind string
+
+// Change kinds
+const (
+	Added    Kind = "added"
+	Modified Kind = "modified"
+	Deleted  Kind = "deleted"
+)
+
+// Change is a file changed in a clone since it was synced.
+type Change struct {
+	// Path is relative to the clone root, with forward slashes
+	Path string
+	Kind Kind
+}
+
+// Changes lists the files changed in the clone since it was synced. Files
+// whose stat data is unchanged are skipped unread, and files rewritten with
+// the content they had are not reported. In a git repository, files that
+// .gitignore excludes (build output and caches, mostly) are not reported.
+func (c *Clone) Changes() ([]Change, error) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.changes()
+}
+
+func (c *Clone) changes() ([]Change, error) {
+	root := c.pool.root
+	var changes []Change
+	seen := make(map[string]bool)
+	err := filepath.WalkDir(c.Path, func(path string, d fs.DirEntry, err error) error {
+		if err != nil {
+			if path == c.Path {
+				return err
+			}
+			return nil
+		}
+		rel, _ := filepath.Rel(c.Path, path)
+		if rel == ".git" && d.IsDir() {
+			return filepath.SkipDir
+		}
+		if rel == ".git" || !d.Type().IsRegular() {
+			return nil
+		}
+		slash := filepath.ToSlash(rel)
+		seen[slash] = true
+		info, err := d.Info()
+		if err != nil {
+			return nil
+		}
+		e, known := c.manifest[slash]
+		switch {
+		case !known:
+			changes = append(changes, Change{Path: slash, Kind: Added})
+		case stampOf(info).equal(e.clone):
+		case !sameContent(path, filepath.Join(root, rel)):
+			changes = append(changes, Change{Path: slash, Kind: Modified})
+		}
+		return nil
+	})
+	if err != nil {
+		return nil, err
+	}
+	for rel := range c.manifest {
+		if !seen[rel] {
+			changes = append(changes, Change{Path: rel, Kind: Deleted})
+		}
+	}
+
+	if c.pool.ignores && len(changes) > 0 {
+		if changes, err = c.pool.dropIgnored(changes); err != nil {
+			return nil, err
+		}
+	}
+	sort.Slice(changes, func(i, j int) bool { return changes[i].Path < changes[j].Path })
+	return changes, nil
+}
+
+// dropIgnored removes the changes to files .gitignore excludes.
+func (p *Pool) dropIgnored(changes []Change) ([]Change, error) {
+	var in bytes.Buffer
+	for _, ch := range changes {
+		in.WriteString(ch.Path)
+		in.WriteByte(0)
+	}
+	cmd := exec.Command("git", "-C", p.root, "check-ignore", "--no-index", "--stdin", "-z")
+	cmd.Stdin = &in
+	out, err := cmd.Output()
+	if ee, ok := err.(*exec.ExitError); ok && ee.ExitCode() == 1 {
+		return changes, nil // nothing is ignored
+	} else if err != nil {
+		return nil, fmt.Errorf("git check-ignore: %w", err)
+	}
+	ignored := make(map[string]bool)
+	for _, path := range strings.Split(string(out), "\x00") {
+		ignored[path] = true
+	}
+	kept := changes[:0]
+	for _, ch := range changes {
+		if !ignored[ch.Path] {
+			kept = append(kept, ch)
+		}
+	}
+	return kept, nil
+}
+
+// sameContent reports whether two files hold the same bytes.
+func sameContent(a, b string) bool {
+	ia, errA := os.Stat(a)
+	ib, errB := os.Stat(b)
+	if errA != nil || errB != nil || ia.Size() != ib.Size() {
+		return false
+	}
+	da, errA := os.ReadFile(a)
+	db, errB := os.ReadFile(b)
+	return errA == nil && errB == nil && bytes.Equal(da, db)
+}
+
+// Apply copies the clone's changes to the given paths into the workspace,
+// or all of them when paths is empty. A change conflicts when the workspace
+// file changed since the clone was synced (or, for an added file, was
+// created meanwhile); unless force is set, nothing is applied when any
+// change conflicts. Files are replaced atomically.
+func (c *Clone) Apply(paths []string, force bool) (applied, conflicts []string, err error) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+
+	changes, err := c.changes()
+	if err != nil {
+		return nil, nil, err
+	}
+	if len(paths) > 0 {
+		byPath := make(map[string]Change, len(changes))
+		for _, ch := range changes {
+			byPath[ch.Path] = ch
+		}
+		selected := make([]Change, 0, len(paths))
+		for _, path := range paths {
+			ch, ok := byPath[filepath.ToSlash(filepath.Clean(path))]
+			if !ok {
+				return nil, nil, fmt.Errorf("%s is not changed in clone %s", path, c.ID)
+			}
+			selected = append(selected, ch)
+		}
+		changes = selected
+	}
+
+	root := c.pool.root
+	for _, ch := range changes {
+		now := missing
+		if info, err := os.Lstat(filepath.Join(root, filepath.FromSlash(ch.Path))); err == nil {
+			now = stampOf(info)
+		}
+		orig := missing
+		if e, ok := c.manifest[ch.Path]; ok {
+			orig = e.orig
+		}
+		if !now.equal(orig) {
+			conflicts = append(conflicts, ch.Path)
+		}
+	}
+	if len(conflicts) > 0 && !force {
+		return nil, conflicts, nil
+	}
+
+	for _, ch := range changes {
+		src := filepath.Join(c.Path, filepath.FromSlash(ch.Path))
+		dst := filepath.Join(root, filepath.FromSlash(ch.Path))
+		if ch.Kind == Deleted {
+			if err := os.Remove(dst); err != nil && !os.IsNotExist(err) {
+				return applied, conflicts, err
+			}
+			delete(c.manifest, ch.Path)
+		} else {
+			if err := replaceFile(src, dst); err != nil {
+				return applied, conflicts, err
+			}
+			ci, errC := os.Lstat(src)
+			oi, errO := os.Lstat(dst)
+			if errC == nil && errO == nil {
+				c.manifest[ch.Path] = entry{clone: stampOf(ci), orig: stampOf(oi)}
+			}
+		}
+		applied = append(applied, ch.Path)
+	}
+	return applied, conflicts, nil
+}
+
+// replaceFile atomically replaces dst with a copy of src, keeping src's mode.
+func replaceFile(src, dst string) error {
+	data, err := os.ReadFile(src)
+	if err != nil {
+		return err
+	}
+	info, err := os.Stat(src)
+	if err != nil {
+		return err
+	}
+	if err := os.MkdirAll(filepath.Dir(dst), 0755); err != nil {
+		return err
+	}
+	tmp, err := os.CreateTemp(filepath.Dir(dst), "."+filepath.Base(dst)+".*")
+	if err != nil {
+		return err
+	}
+	_, err = tmp.Write(data)
+	if closeErr := tmp.Close(); err == nil {
+		err = closeErr
+	}
+	if err == nil {
+		err = os.Chmod(tmp.Name(), info.Mode().Perm())
+	}
+	if err == nil {
+		err = os.Rename(tmp.Name(), dst)
+	}
+	if err != nil {
+		os.Remove(tmp.Name())
+	}
+	return err
+}
+
+// Diff returns a unified diff of one change, from the workspace file to the
+// clone's, with a/ and b/ path prefixes.
+func (c *Clone) Diff(ch Change) (string, error) {
+	rel := filepath.FromSlash(ch.Path)
+	from, to := filepath.Join(c.pool.root, rel), filepath.Join(c.Path, rel)
+	switch ch.Kind {
+	case Added:
+		from = os.DevNull
+	case Deleted:
+		to = os.DevNull
+	}
+	if _, err := exec.LookPath("git"); err != nil {
+		return wholeFileDiff(ch.Path, from, to)
+	}
+	out, err := exec.Command("git", "diff", "--no-index", "--no-color", "--", from, to).Output()
+	var ee *exec.ExitError
+	if err != nil && !(errors.As(err, &ee) && ee.ExitCode() == 1) {
+		return "", fmt.Errorf("git diff: %w", err)
+	}
+
+	// Drop git's header, which names the absolute paths, and relabel the
+	// file lines
+	lines := strings.SplitAfter(string(out), "\n")
+	for len(lines) > 0 && !strings.HasPrefix(lines[0], "--- ") && !strings.HasPrefix(lines[0], "Binary files") {
+		lines = lines[1:]
+	}
+	for i := 0; i < len(lines) && i < 2; i++ {
+		switch {
+		case strings.HasPrefix(lines[i], "--- ") && ch.Kind != Added:
+			lines[i] = "--- a/" + ch.Path + "\n"
+		case strings.HasPrefix(lines[i], "+++ ") && ch.Kind != Deleted:
+			lines[i] = "+++ b/" + ch.Path + "\n"
+		case strings.HasPrefix(lines[i], "Binary files"):
+			lines[i] = "Binary file " + ch.Path + " " + string(ch.Kind) + "\n"
+		}
+	}
+	return strings.Join(lines, ""), nil
+}
+
+// wholeFileDiff shows a change as the removal of every old line and the
+// addition of every new one, for when git is not available.
+func wholeFileDiff(path, from, to string) (string, error) {
+	var b strings.Builder
+	fmt.Fprintf(&b, "--- a/%s\n+++ b/%s\n", path, path)
+	for _, f := range []struct {
+		path   string
+		prefix string
+	}{{from, "-"}, {to, "+"}} {
+		if f.path == os.DevNull {
+			continue
+		}
+		data, err := os.ReadFile(f.path)
+		if err != nil {
+			return "", err
+		}
+		for _, line := range strings.SplitAfter(string(data), "\n") {
+			if line != "" {
+				b.WriteString(f.prefix + strings.TrimSuffix(line, "\n") + "\n")
+			}
+		}
+	}
+	return b.String(), nil
+}
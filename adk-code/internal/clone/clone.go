@@ -0,0 +1,362 @@
+// Package clone creates disposable copies of a workspace, so competing
+// changes and their test runs can proceed side by side without touching the
+// original tree. A Pool hands out clones, tracks what each one changed,
+// applies a chosen clone's changes back, and recycles or deletes the rest.
+//
+// Clones are made, in order of preference, by reflinking every file (a
+// copy-on-write clone that costs only metadata, on btrfs, XFS and similar),
+// by checking out a git worktree and copying the uncommitted changes into
+// it, or by copying the tree. Dependency directories such as node_modules
+// are linked rather than copied.
+package clone
+
+import (
+	"crypto/sha1"
+	"encoding/hex"
+	"errors"
+	"fmt"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"sort"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"syscall"
+	"time"
+
+	"adk-code/internal/gitindex"
+)
+
+// Strategy is how a clone's files are created.
+type Strategy string
+
+// Clone strategies
+const (
+	StrategyReflink  Strategy = "reflink"
+	StrategyWorktree Strategy = "worktree"
+	StrategyCopy     Strategy = "copy"
+)
+
+// Pool defaults
+const (
+	defaultMaxClones = 8
+	defaultMaxIdle   = 2
+	defaultIdleTTL   = 30 * time.Minute
+)
+
+// cloneSeq numbers clones, so IDs are unique across the pools of a process.
+var cloneSeq atomic.Int64
+
+// Options configures a Pool. Zero values pick the defaults.
+type Options struct {
+	// Dir holds the clones (default: the user cache directory)
+	Dir string
+	// MaxClones bounds the clones in use at once
+	MaxClones int
+	// MaxIdle bounds the released clones kept for reuse
+	MaxIdle int
+	// IdleTTL is how long a released clone is kept
+	IdleTTL time.Duration
+	// Strategy forces a strategy instead of the best available one
+	Strategy Strategy
+}
+
+// Pool hands out clones of one workspace root.
+type Pool struct {
+	root     string
+	dir      string
+	opts     Options
+	strategy Strategy
+	ignores  bool // root is in a git repository, so added files are filtered by .gitignore
+
+	mu      sync.Mutex
+	syncing map[string]*Clone // clones being created or recycled
+	active  map[string]*Clone
+	idle    []*Clone
+	closed  bool
+	syncs   sync.WaitGroup // Acquire calls syncing a clone
+}
+
+// Clone is one copy of the workspace.
+type Clone struct {
+	// ID names the clone within its pool
+	ID string
+	// Path is the clone's root directory
+	Path string
+	// Strategy is how the clone was made
+	Strategy Strategy
+
+	pool     *Pool
+	mu       sync.Mutex
+	manifest map[string]entry // files as of the last sync, by slash path
+	released time.Time
+}
+
+// stamp identifies a version of a file by its stat data.
+type stamp struct {
+	size  int64
+	mtime time.Time
+}
+
+func stampOf(info os.FileInfo) stamp {
+	return stamp{size: info.Size(), mtime: info.ModTime()}
+}
+
+// entry is a file as it was in the clone and in the original right after
+// the clone was synced.
+type entry struct {
+	clone, orig stamp
+}
+
+// NewPool returns a pool of clones of root.
+func NewPool(root string, opts Options) (*Pool, error) {
+	root, err := filepath.Abs(root)
+	if err != nil {
+		return nil, err
+	}
+	if info, err := os.Stat(root); err != nil || !info.IsDir() {
+		return nil, fmt.Errorf("not a directory: %s", root)
+	}
+	if opts.MaxClones <= 0 {
+		opts.MaxClones = defaultMaxClones
+	}
+	if opts.MaxIdle < 0 {
+		opts.MaxIdle = 0
+	} else if opts.MaxIdle == 0 {
+		opts.MaxIdle = defaultMaxIdle
+	}
+	if opts.IdleTTL <= 0 {
+		opts.IdleTTL = defaultIdleTTL
+	}
+
+	dir := opts.Dir
+	if dir == "" {
+		cache, err := os.UserCacheDir()
+		if err != nil {
+			cache = os.TempDir()
+		}
+		sum := sha1.Sum([]byte(root))
+		dir = filepath.Join(cache, "adk-code", "clones", filepath.Base(root)+"-"+hex.EncodeToString(sum[:6]))
+	}
+	if err := os.MkdirAll(dir, 0755); err != nil {
+		return nil, err
+	}
+	if strings.HasPrefix(dir+string(filepath.Separator), root+string(filepath.Separator)) {
+		return nil, fmt.Errorf("clone directory %s is inside the workspace", dir)
+	}
+
+	p := &Pool{root: root, dir: dir, opts: opts, syncing: make(map[string]*Clone), active: make(map[string]*Clone)}
+	repo, gitErr := gitindex.Open(root)
+	_, lookErr := exec.LookPath("git")
+	p.ignores = gitErr == nil && lookErr == nil
+	p.strategy = opts.Strategy
+	if p.strategy == "" {
+		switch {
+		case reflinkSupported(root, dir):
+			p.strategy = StrategyReflink
+		case p.ignores:
+			p.strategy = StrategyWorktree
+		default:
+			p.strategy = StrategyCopy
+		}
+	}
+	if p.strategy == StrategyWorktree {
+		if !p.ignores {
+			return nil, errors.New("the worktree strategy needs a git repository and the git command")
+		}
+		// A worktree holds the whole repository
+		p.root = repo.Root
+	}
+	return p, nil
+}
+
+// Root returns the workspace the pool clones.
+func (p *Pool) Root() string {
+	return p.root
+}
+
+// Strategy returns how the pool makes clones.
+func (p *Pool) Strategy() Strategy {
+	return p.strategy
+}
+
+// Acquire returns a clone in sync with the workspace, reusing an idle one
+// when there is one.
+func (p *Pool) Acquire() (*Clone, error) {
+	p.GC()
+
+	p.mu.Lock()
+	if p.closed {
+		p.mu.Unlock()
+		return nil, errors.New("the clone pool is closed")
+	}
+	if len(p.active)+len(p.syncing) >= p.opts.MaxClones {
+		p.mu.Unlock()
+		return nil, fmt.Errorf("%d clones are already in use; apply or discard one first", p.opts.MaxClones)
+	}
+	var c *Clone
+	if n := len(p.idle); n > 0 {
+		c, p.idle = p.idle[n-1], p.idle[:n-1]
+	} else {
+		id := fmt.Sprintf("%d-%d", os.Getpid(), cloneSeq.Add(1))
+		c = &Clone{ID: id, Path: filepath.Join(p.dir, id), Strategy: p.strategy, pool: p}
+	}
+	p.syncing[c.ID] = c
+	p.syncs.Add(1)
+	p.mu.Unlock()
+	defer p.syncs.Done()
+
+	err := p.sync(c)
+
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	delete(p.syncing, c.ID)
+	if err != nil || p.closed {
+		// A pool closed during the sync no longer tracks the clone
+		p.remove(c)
+		if err == nil {
+			err = errors.New("the clone pool was closed")
+		}
+		return nil, fmt.Errorf("cannot create %s clone: %w", p.strategy, err)
+	}
+	p.active[c.ID] = c
+	return c, nil
+}
+
+// Get returns the clone in use with the given ID.
+func (p *Pool) Get(id string) (*Clone, bool) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	c, ok := p.active[id]
+	return c, ok
+}
+
+// Active returns the clones in use, by ID.
+func (p *Pool) Active() []*Clone {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	clones := make([]*Clone, 0, len(p.active))
+	for _, c := range p.active {
+		clones = append(clones, c)
+	}
+	sort.Slice(clones, func(i, j int) bool { return clones[i].ID < clones[j].ID })
+	return clones
+}
+
+// Release returns a clone to the pool. It is kept for reuse, up to MaxIdle
+// clones for IdleTTL, and deleted otherwise.
+func (p *Pool) Release(c *Clone) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	if _, ok := p.active[c.ID]; !ok {
+		return
+	}
+	delete(p.active, c.ID)
+	if len(p.idle) >= p.opts.MaxIdle {
+		p.remove(c)
+		return
+	}
+	c.released = time.Now()
+	p.idle = append(p.idle, c)
+}
+
+// GC deletes idle clones past their TTL, and clone directories left by
+// processes that have exited once they are older than the TTL.
+func (p *Pool) GC() {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	cutoff := time.Now().Add(-p.opts.IdleTTL)
+	kept := p.idle[:0]
+	for _, c := range p.idle {
+		if c.released.Before(cutoff) {
+			p.remove(c)
+		} else {
+			kept = append(kept, c)
+		}
+	}
+	p.idle = kept
+
+	entries, _ := os.ReadDir(p.dir)
+	removed := false
+	for _, e := range entries {
+		var pid int
+		if _, err := fmt.Sscanf(e.Name(), "%d-", &pid); err != nil || processAlive(pid) {
+			continue // ours, another live process's, or not a clone
+		}
+		if info, err := e.Info(); err == nil && info.ModTime().Before(cutoff) {
+			os.RemoveAll(filepath.Join(p.dir, e.Name()))
+			removed = true
+		}
+	}
+	if removed && p.strategy == StrategyWorktree {
+		p.git("worktree", "prune")
+	}
+}
+
+// Close deletes every clone of the pool, in use or idle, and waits for the
+// clones still being synced, which their Acquire deletes. Acquire fails once
+// the pool is closed.
+func (p *Pool) Close() {
+	p.mu.Lock()
+	p.closed = true
+	for _, c := range p.active {
+		p.remove(c)
+	}
+	for _, c := range p.idle {
+		p.remove(c)
+	}
+	p.active, p.idle = make(map[string]*Clone), nil
+	p.mu.Unlock()
+
+	p.syncs.Wait()
+}
+
+// processAlive reports whether a process with the given ID is running.
+func processAlive(pid int) bool {
+	proc, err := os.FindProcess(pid)
+	return err == nil && proc.Signal(syscall.Signal(0)) == nil
+}
+
+// remove deletes a clone's directory. Callers hold p.mu.
+func (p *Pool) remove(c *Clone) {
+	if c.Strategy == StrategyWorktree {
+		if _, err := p.git("worktree", "remove", "--force", c.Path); err == nil {
+			return
+		}
+	}
+	os.RemoveAll(c.Path)
+	if c.Strategy == StrategyWorktree {
+		p.git("worktree", "prune")
+	}
+}
+
+// sync brings a new or recycled clone in line with the workspace.
+func (p *Pool) sync(c *Clone) error {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	var err error
+	if c.Strategy == StrategyWorktree {
+		c.manifest, err = p.syncWorktree(c.Path)
+	} else {
+		c.manifest, err = syncTree(p.root, c.Path, c.Strategy == StrategyReflink)
+	}
+	return err
+}
+
+// git runs a git command in the workspace.
+func (p *Pool) git(args ...string) (string, error) {
+	return runGit(p.root, args...)
+}
+
+func runGit(dir string, args ...string) (string, error) {
+	cmd := exec.Command("git", append([]string{"-C", dir}, args...)...)
+	out, err := cmd.Output()
+	if err != nil {
+		if ee, ok := err.(*exec.ExitError); ok && len(ee.Stderr) > 0 {
+			return string(out), fmt.Errorf("git %s: %s", args[0], strings.TrimSpace(string(ee.Stderr)))
+		}
+		return string(out), err
+	}
+	return string(out), nil
+}
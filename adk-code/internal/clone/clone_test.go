@@ -0,0 +1,268 @@
+package clone
+
+import (
+	"os"
+	"os/exec"
+	"path/filepath"
+	"reflect"
+	"strings"
+	"testing"
+	"time"
+)
+
+func write(t *testing.T, dir, rel, content string) {
+	t.Helper()
+	path := filepath.Join(dir, filepath.FromSlash(rel))
+	if err := os.MkdirAll(filepath.Dir(path), 0755); err != nil {
+		t.Fatal(err)
+	}
+	if err := os.WriteFile(path, []byte(content), 0644); err != nil {
+		t.Fatal(err)
+	}
+}
+
+func read(t *testing.T, dir, rel string) string {
+	t.Helper()
+	data, err := os.ReadFile(filepath.Join(dir, filepath.FromSlash(rel)))
+	if err != nil {
+		t.Fatal(err)
+	}
+	return string(data)
+}
+
+func git(t *testing.T, dir string, args ...string) {
+	t.Helper()
+	cmd := exec.Command("git", args...)
+	cmd.Dir = dir
+	cmd.Env = append(os.Environ(), "GIT_AUTHOR_NAME=t", "GIT_AUTHOR_EMAIL=t@t", "GIT_COMMITTER_NAME=t", "GIT_COMMITTER_EMAIL=t@t")
+	if out, err := cmd.CombinedOutput(); err != nil {
+		t.Fatalf("git %v failed: %v\n%s", args, err, out)
+	}
+}
+
+// newWorkspace creates a small project tree with a dependency directory.
+func newWorkspace(t *testing.T) string {
+	t.Helper()
+	dir := t.TempDir()
+	write(t, dir, "main.go", "package main\n")
+	write(t, dir, "lib/util.go", "package lib\n")
+	write(t, dir, "lib/old.go", "package lib // old\n")
+	write(t, dir, "node_modules/dep/index.js", "module.exports = 1\n")
+	return dir
+}
+
+func changeList(t *testing.T, c *Clone) string {
+	t.Helper()
+	changes, err := c.Changes()
+	if err != nil {
+		t.Fatalf("Changes failed: %v", err)
+	}
+	var parts []string
+	for _, ch := range changes {
+		parts = append(parts, string(ch.Kind)+" "+ch.Path)
+	}
+	return strings.Join(parts, ", ")
+}
+
+func TestCopyCloneChangesAndApply(t *testing.T) {
+	root := newWorkspace(t)
+	pool, err := NewPool(root, Options{Dir: t.TempDir(), Strategy: StrategyCopy})
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer pool.Close()
+	c, err := pool.Acquire()
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	if got := read(t, c.Path, "lib/util.go"); got != "package lib\n" {
+		t.Errorf("clone holds %q", got)
+	}
+	if link, err := os.Readlink(filepath.Join(c.Path, "node_modules")); err != nil || link != filepath.Join(root, "node_modules") {
+		t.Errorf("expected node_modules to be linked, got %q, %v", link, err)
+	}
+	if got := changeList(t, c); got != "" {
+		t.Errorf("fresh clone reports changes: %s", got)
+	}
+
+	write(t, c.Path, "main.go", "package main\n\nfunc main() {}\n")
+	write(t, c.Path, "lib/new.go", "package lib // new\n")
+	write(t, c.Path, "lib/util.go", "package lib\n") // rewritten unchanged
+	os.Remove(filepath.Join(c.Path, "lib/old.go"))
+	if got, want := changeList(t, c), "added lib/new.go, deleted lib/old.go, modified main.go"; got != want {
+		t.Errorf("changes = %s, want %s", got, want)
+	}
+
+	diff, err := c.Diff(Change{Path: "main.go", Kind: Modified})
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !strings.HasPrefix(diff, "--- a/main.go\n+++ b/main.go\n") || !strings.Contains(diff, "+func main() {}") {
+		t.Errorf("unexpected diff:\n%s", diff)
+	}
+
+	// The workspace moved on under one of the changed files
+	write(t, root, "main.go", "package main // edited meanwhile\n")
+	applied, conflicts, err := c.Apply(nil, false)
+	if err != nil || applied != nil || !reflect.DeepEqual(conflicts, []string{"main.go"}) {
+		t.Fatalf("Apply = %v, %v, %v; want only a main.go conflict", applied, conflicts, err)
+	}
+	if _, err := os.Stat(filepath.Join(root, "lib/new.go")); err == nil {
+		t.Error("a conflicting apply must change nothing")
+	}
+
+	applied, _, err = c.Apply([]string{"lib/new.go", "lib/old.go"}, false)
+	if err != nil || !reflect.DeepEqual(applied, []string{"lib/new.go", "lib/old.go"}) {
+		t.Fatalf("Apply = %v, %v", applied, err)
+	}
+	if read(t, root, "lib/new.go") != "package lib // new\n" {
+		t.Error("added file not applied")
+	}
+	if _, err := os.Stat(filepath.Join(root, "lib/old.go")); !os.IsNotExist(err) {
+		t.Error("deleted file not applied")
+	}
+	if got := changeList(t, c); got != "modified main.go" {
+		t.Errorf("applied changes still reported: %s", got)
+	}
+
+	applied, conflicts, err = c.Apply([]string{"main.go"}, true)
+	if err != nil || len(applied) != 1 || len(conflicts) != 1 || read(t, root, "main.go") != "package main\n\nfunc main() {}\n" {
+		t.Errorf("forced Apply = %v, %v, %v", applied, conflicts, err)
+	}
+	if _, _, err := c.Apply([]string{"missing.go"}, false); err == nil {
+		t.Error("expected an error for a path the clone did not change")
+	}
+}
+
+func TestPoolRecyclesAndCollects(t *testing.T) {
+	root := newWorkspace(t)
+	dir := t.TempDir()
+	pool, err := NewPool(root, Options{Dir: dir, Strategy: StrategyCopy, MaxClones: 2, MaxIdle: 1, IdleTTL: time.Hour})
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer pool.Close()
+
+	a, _ := pool.Acquire()
+	b, _ := pool.Acquire()
+	if _, err := pool.Acquire(); err == nil {
+		t.Error("expected MaxClones to be enforced")
+	}
+	write(t, a.Path, "scratch.txt", "experiment output\n")
+	pool.Release(a)
+	pool.Release(b) // over MaxIdle, so deleted
+	if _, err := os.Stat(b.Path); !os.IsNotExist(err) {
+		t.Error("expected the clone beyond MaxIdle to be deleted")
+	}
+
+	write(t, root, "lib/util.go", "package lib // updated\n")
+	c, err := pool.Acquire()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if c != a {
+		t.Error("expected the idle clone to be reused")
+	}
+	if read(t, c.Path, "lib/util.go") != "package lib // updated\n" {
+		t.Error("recycled clone missed a workspace change")
+	}
+	if _, err := os.Stat(filepath.Join(c.Path, "scratch.txt")); !os.IsNotExist(err) {
+		t.Error("recycled clone kept a file of the earlier experiment")
+	}
+	if got := changeList(t, c); got != "" {
+		t.Errorf("recycled clone reports changes: %s", got)
+	}
+
+	// A clone left by a process that is gone is collected once stale
+	orphan := filepath.Join(dir, "999999999-1")
+	write(t, orphan, "x", "x")
+	old := time.Now().Add(-2 * time.Hour)
+	os.Chtimes(orphan, old, old)
+	pool.GC()
+	if _, err := os.Stat(orphan); !os.IsNotExist(err) {
+		t.Error("expected the orphaned clone to be collected")
+	}
+	if _, err := os.Stat(c.Path); err != nil {
+		t.Error("GC removed a clone in use")
+	}
+}
+
+func TestPoolCloseDeletesClonesBeingSynced(t *testing.T) {
+	root := newWorkspace(t)
+	dir := t.TempDir()
+	pool, err := NewPool(root, Options{Dir: dir, Strategy: StrategyCopy})
+	if err != nil {
+		t.Fatal(err)
+	}
+	if _, err := pool.Acquire(); err != nil {
+		t.Fatal(err)
+	}
+
+	// Whether the Acquire finishes before or after Close, no clone survives
+	done := make(chan struct{})
+	go func() {
+		defer close(done)
+		pool.Acquire()
+	}()
+	pool.Close()
+	<-done
+
+	if entries, _ := os.ReadDir(dir); len(entries) != 0 {
+		t.Errorf("expected every clone to be deleted, found %d", len(entries))
+	}
+	if _, err := pool.Acquire(); err == nil {
+		t.Error("expected Acquire to fail after Close")
+	}
+}
+
+func TestWorktreeClone(t *testing.T) {
+	if _, err := exec.LookPath("git"); err != nil {
+		t.Skip("git not installed")
+	}
+	root := newWorkspace(t)
+	write(t, root, ".gitignore", "node_modules/\nbuild/\n")
+	git(t, root, "init", "-q")
+	git(t, root, "add", ".")
+	git(t, root, "commit", "-q", "-m", "initial")
+	write(t, root, "main.go", "package main // uncommitted\n")
+	write(t, root, "notes.md", "untracked\n")
+
+	pool, err := NewPool(root, Options{Dir: t.TempDir(), Strategy: StrategyWorktree})
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer pool.Close()
+	c, err := pool.Acquire()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if read(t, c.Path, "main.go") != "package main // uncommitted\n" || read(t, c.Path, "notes.md") != "untracked\n" {
+		t.Error("worktree clone is missing uncommitted changes")
+	}
+	if _, err := os.Stat(filepath.Join(c.Path, "node_modules/dep/index.js")); err != nil {
+		t.Error("expected node_modules to be linked into the worktree")
+	}
+	if got := changeList(t, c); got != "" {
+		t.Errorf("fresh worktree reports changes: %s", got)
+	}
+
+	write(t, c.Path, "lib/util.go", "package lib // fixed\n")
+	write(t, c.Path, "build/out.bin", "ignored build output")
+	if got := changeList(t, c); got != "modified lib/util.go" {
+		t.Errorf("changes = %s", got)
+	}
+	if _, _, err := c.Apply(nil, false); err != nil || read(t, root, "lib/util.go") != "package lib // fixed\n" {
+		t.Errorf("Apply failed: %v", err)
+	}
+
+	pool.Release(c)
+	write(t, root, "lib/old.go", "package lib // changed after release\n")
+	again, err := pool.Acquire()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if again != c || read(t, again.Path, "lib/old.go") != "package lib // changed after release\n" {
+		t.Error("recycled worktree is out of sync")
+	}
+}
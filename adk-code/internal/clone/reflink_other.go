@@ -0,0 +1,10 @@
+//go:build !linux
+
+package clone
+
+import "errors"
+
+// reflinkFile is not implemented here, so clones are copied.
+func reflinkFile(src, dst string) error {
+	return errors.ErrUnsupported
+}
@@ -0,0 +1,58 @@
+package clone
+
+import (
+	"path/filepath"
+	"sort"
+	"sync"
+)
+
+var (
+	sharedMu    sync.Mutex
+	sharedPools = make(map[string]*Pool) // by workspace path
+)
+
+// SharedPool returns the process-wide pool of the workspace at path,
+// creating it on first use. CloseSharedPools deletes their clones at exit.
+func SharedPool(path string) (*Pool, error) {
+	if path == "" {
+		path = "."
+	}
+	abs, err := filepath.Abs(path)
+	if err != nil {
+		return nil, err
+	}
+	sharedMu.Lock()
+	defer sharedMu.Unlock()
+	if p, ok := sharedPools[abs]; ok {
+		return p, nil
+	}
+	p, err := NewPool(abs, Options{})
+	if err != nil {
+		return nil, err
+	}
+	sharedPools[abs] = p
+	return p, nil
+}
+
+// SharedPools returns the process-wide pools, ordered by workspace path.
+func SharedPools() []*Pool {
+	sharedMu.Lock()
+	defer sharedMu.Unlock()
+	pools := make([]*Pool, 0, len(sharedPools))
+	for _, p := range sharedPools {
+		pools = append(pools, p)
+	}
+	sort.Slice(pools, func(i, j int) bool { return pools[i].Root() < pools[j].Root() })
+	return pools
+}
+
+// CloseSharedPools deletes every clone of the process-wide pools, so clones
+// and git worktrees do not outlive the process until another one's GC.
+func CloseSharedPools() {
+	sharedMu.Lock()
+	defer sharedMu.Unlock()
+	for path, p := range sharedPools {
+		p.Close()
+		delete(sharedPools, path)
+	}
+}
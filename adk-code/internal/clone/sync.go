@@ -0,0 +1,303 @@
+package clone
+
+import (
+	"io"
+	"io/fs"
+	"os"
+	"path/filepath"
+	"strings"
+	"time"
+
+	"adk-code/internal/gitindex"
+)
+
+// sharedDirs are dependency directories linked into clones rather than
+// copied: fixes rarely change them, and they are often most of a tree.
+var sharedDirs = map[string]bool{"node_modules": true, ".venv": true, "venv": true}
+
+// missing is the stamp of a file that does not exist.
+var missing = stamp{size: -1}
+
+func (s stamp) equal(o stamp) bool {
+	return s.size == o.size && s.mtime.Equal(o.mtime)
+}
+
+// syncTree makes dst a copy of src, except .git, reusing files whose size
+// and mtime already match so a recycled clone costs only what changed.
+// Copies keep their source mtime, which is how they are later recognized
+// as unchanged.
+func syncTree(src, dst string, reflink bool) (map[string]entry, error) {
+	if err := os.MkdirAll(dst, 0755); err != nil {
+		return nil, err
+	}
+	manifest := make(map[string]entry)
+	seen := make(map[string]bool)
+	err := filepath.WalkDir(src, func(path string, d fs.DirEntry, err error) error {
+		if err != nil {
+			if path == src {
+				return err
+			}
+			return nil // skip what cannot be read
+		}
+		rel, _ := filepath.Rel(src, path)
+		if rel == "." {
+			return nil
+		}
+		if rel == ".git" {
+			if d.IsDir() {
+				return filepath.SkipDir
+			}
+			return nil
+		}
+		seen[rel] = true
+		target := filepath.Join(dst, rel)
+
+		switch {
+		case d.IsDir() && sharedDirs[d.Name()]:
+			if link, err := os.Readlink(target); err != nil || link != path {
+				os.RemoveAll(target)
+				if err := os.Symlink(path, target); err != nil {
+					return err
+				}
+			}
+			return filepath.SkipDir
+		case d.IsDir():
+			if info, err := os.Lstat(target); err == nil && info.IsDir() {
+				return nil
+			}
+			os.RemoveAll(target)
+			return os.Mkdir(target, 0755)
+		case d.Type()&fs.ModeSymlink != 0:
+			link, err := os.Readlink(path)
+			if err != nil {
+				return nil
+			}
+			if current, err := os.Readlink(target); err != nil || current != link {
+				os.RemoveAll(target)
+				return os.Symlink(link, target)
+			}
+			return nil
+		case !d.Type().IsRegular():
+			return nil // sockets, devices and pipes are not copied
+		}
+
+		info, err := d.Info()
+		if err != nil {
+			return nil
+		}
+		if existing, err := os.Lstat(target); err == nil && existing.Mode().IsRegular() && stampOf(existing).equal(stampOf(info)) {
+			manifest[filepath.ToSlash(rel)] = entry{clone: stampOf(existing), orig: stampOf(info)}
+			return nil
+		}
+		os.RemoveAll(target)
+		copied, err := cloneFile(path, target, info, reflink)
+		if err != nil {
+			return err
+		}
+		manifest[filepath.ToSlash(rel)] = entry{clone: stampOf(copied), orig: stampOf(info)}
+		return nil
+	})
+	if err != nil {
+		return nil, err
+	}
+
+	// Drop what the clone has and the workspace no longer does
+	filepath.WalkDir(dst, func(path string, d fs.DirEntry, err error) error {
+		if err != nil {
+			return nil
+		}
+		rel, _ := filepath.Rel(dst, path)
+		if rel == "." || seen[rel] {
+			return nil
+		}
+		os.RemoveAll(path)
+		if d.IsDir() {
+			return filepath.SkipDir
+		}
+		return nil
+	})
+	return manifest, nil
+}
+
+// cloneFile copies src to the new file dst with src's mode and mtime,
+// reflinking when asked and falling back to a copy where that fails (dst on
+// another filesystem, say).
+func cloneFile(src, dst string, info os.FileInfo, reflink bool) (os.FileInfo, error) {
+	if !reflink || reflinkFile(src, dst) != nil {
+		if err := copyFile(src, dst); err != nil {
+			return nil, err
+		}
+	}
+	if err := os.Chmod(dst, info.Mode().Perm()); err != nil {
+		return nil, err
+	}
+	if err := os.Chtimes(dst, time.Now(), info.ModTime()); err != nil {
+		return nil, err
+	}
+	return os.Lstat(dst)
+}
+
+func copyFile(src, dst string) error {
+	in, err := os.Open(src)
+	if err != nil {
+		return err
+	}
+	defer in.Close()
+	out, err := os.OpenFile(dst, os.O_WRONLY|os.O_CREATE|os.O_EXCL, 0600)
+	if err != nil {
+		return err
+	}
+	if _, err := io.Copy(out, in); err != nil {
+		out.Close()
+		os.Remove(dst)
+		return err
+	}
+	return out.Close()
+}
+
+// copyTree copies the directory src to dst, which must not exist.
+func copyTree(src, dst string) error {
+	return filepath.WalkDir(src, func(path string, d fs.DirEntry, err error) error {
+		if err != nil {
+			return nil
+		}
+		rel, _ := filepath.Rel(src, path)
+		target := filepath.Join(dst, rel)
+		switch {
+		case d.IsDir():
+			return os.MkdirAll(target, 0755)
+		case d.Type()&fs.ModeSymlink != 0:
+			if link, err := os.Readlink(path); err == nil {
+				os.Symlink(link, target)
+			}
+			return nil
+		case d.Type().IsRegular():
+			info, err := d.Info()
+			if err != nil {
+				return nil
+			}
+			_, err = cloneFile(path, target, info, false)
+			return err
+		}
+		return nil
+	})
+}
+
+// reflinkSupported reports whether files of root can be reflinked into
+// dir, by trying it on the first file found.
+func reflinkSupported(root, dir string) bool {
+	var sample string
+	visited := 0
+	filepath.WalkDir(root, func(path string, d fs.DirEntry, err error) error {
+		visited++
+		switch {
+		case err != nil || sample != "" || visited > 1000:
+			return filepath.SkipAll
+		case d.IsDir() && d.Name() == ".git":
+			return filepath.SkipDir
+		case d.Type().IsRegular():
+			sample = path
+			return filepath.SkipAll
+		}
+		return nil
+	})
+	if sample == "" {
+		return false
+	}
+	probe := filepath.Join(dir, ".reflink-probe")
+	os.Remove(probe)
+	defer os.Remove(probe)
+	return reflinkFile(sample, probe) == nil
+}
+
+// syncWorktree makes dst a git worktree at the workspace's HEAD, recycling
+// an existing one, and copies the workspace's uncommitted changes into it.
+// Ignored files, build output included, are not copied, but those an
+// earlier experiment built in a recycled worktree are kept.
+func (p *Pool) syncWorktree(dst string) (map[string]entry, error) {
+	out, err := p.git("rev-parse", "--verify", "HEAD")
+	if err != nil {
+		return nil, err
+	}
+	head := strings.TrimSpace(out)
+
+	if _, err := os.Stat(filepath.Join(dst, ".git")); err == nil {
+		if _, err := runGit(dst, "checkout", "--quiet", "--detach", "--force", head); err != nil {
+			return nil, err
+		}
+		if _, err := runGit(dst, "clean", "-fdq"); err != nil {
+			return nil, err
+		}
+	} else {
+		os.RemoveAll(dst)
+		if _, err := p.git("worktree", "add", "--quiet", "--detach", dst, head); err != nil {
+			return nil, err
+		}
+	}
+
+	tracker, err := gitindex.TrackerFor(p.root)
+	if err != nil {
+		return nil, err
+	}
+	changes, err := tracker.Status(true)
+	if err != nil {
+		return nil, err
+	}
+	for _, c := range changes {
+		rel := filepath.FromSlash(strings.TrimSuffix(c.Path, "/"))
+		src, target := filepath.Join(p.root, rel), filepath.Join(dst, rel)
+		info, err := os.Lstat(src)
+		os.RemoveAll(target)
+		switch {
+		case err != nil:
+			// Deleted in the workspace
+		case info.IsDir():
+			err = copyTree(src, target)
+		case info.Mode().IsRegular():
+			if err = os.MkdirAll(filepath.Dir(target), 0755); err == nil {
+				_, err = cloneFile(src, target, info, false)
+			}
+		}
+		if err != nil && !os.IsNotExist(err) {
+			return nil, err
+		}
+	}
+	for name := range sharedDirs {
+		src := filepath.Join(p.root, name)
+		if info, err := os.Stat(src); err == nil && info.IsDir() {
+			if _, err := os.Lstat(filepath.Join(dst, name)); os.IsNotExist(err) {
+				os.Symlink(src, filepath.Join(dst, name))
+			}
+		}
+	}
+	return manifestOf(p.root, dst)
+}
+
+// manifestOf records the regular files of a clone and of the workspace at
+// the same paths.
+func manifestOf(root, clone string) (map[string]entry, error) {
+	manifest := make(map[string]entry)
+	err := filepath.WalkDir(clone, func(path string, d fs.DirEntry, err error) error {
+		if err != nil {
+			return nil
+		}
+		rel, _ := filepath.Rel(clone, path)
+		if rel == ".git" && d.IsDir() {
+			return filepath.SkipDir
+		}
+		if rel == ".git" || !d.Type().IsRegular() {
+			return nil
+		}
+		info, err := d.Info()
+		if err != nil {
+			return nil
+		}
+		orig := missing
+		if o, err := os.Lstat(filepath.Join(root, rel)); err == nil {
+			orig = stampOf(o)
+		}
+		manifest[filepath.ToSlash(rel)] = entry{clone: stampOf(info), orig: orig}
+		return nil
+	})
+	return manifest, err
+}
@@ -0,0 +1,346 @@
+// Package compressed streams gzip and zstd files line by line so tools can
+// read and search rotated logs without shelling out to zcat. Decompression
+// stops as soon as the caller stops reading, and gzip member boundaries seen
+// along the way are kept as seek points for later reads of the same file.
+package compressed
+
+import (
+	"bufio"
+	"bytes"
+	"compress/gzip"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"os/exec"
+)
+
+// Format is a compression format detected from a file's magic bytes.
+type Format int
+
+// Supported formats
+const (
+	None Format = iota
+	Gzip
+	Zstd
+)
+
+// String returns the format's name.
+func (f Format) String() string {
+	switch f {
+	case Gzip:
+		return "gzip"
+	case Zstd:
+		return "zstd"
+	default:
+		return "none"
+	}
+}
+
+var (
+	gzipMagic = []byte{0x1f, 0x8b}
+	zstdMagic = []byte{0x28, 0xb5, 0x2f, 0xfd}
+)
+
+// Detect reports the compression format of data from its first bytes.
+func Detect(header []byte) Format {
+	switch {
+	case bytes.HasPrefix(header, gzipMagic):
+		return Gzip
+	case bytes.HasPrefix(header, zstdMagic):
+		return Zstd
+	default:
+		return None
+	}
+}
+
+// Sniff reports the compression format of the file at path. Directories and
+// unreadable files are None with an error.
+func Sniff(path string) (Format, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return None, err
+	}
+	defer f.Close()
+	var header [4]byte
+	n, err := io.ReadFull(f, header[:])
+	if err != nil && err != io.ErrUnexpectedEOF && err != io.EOF {
+		return None, err
+	}
+	return Detect(header[:n]), nil
+}
+
+// ErrNotCompressed is returned by Open for files in neither format.
+var ErrNotCompressed = errors.New("file is not gzip or zstd compressed")
+
+// maxLineBytes caps a single returned line; longer lines are cut.
+const maxLineBytes = 1 << 20
+
+// Reader streams the decompressed lines of a compressed file. Lines are
+// counted as strings.Split(content, "\n") would count them, so a trailing
+// newline yields a final empty line.
+type Reader struct {
+	key    indexKey
+	format Format
+	file   *os.File
+	gz     *gzipStream
+	zstd   *exec.Cmd
+	br     *bufio.Reader
+	known  Index // index entry at open time
+
+	buf     []byte
+	line    int   // lines returned so far
+	pos     int64 // decompressed offset of the next line
+	members int   // gz.members already matched to lines
+	points  []SeekPoint
+	eof     bool
+	raw     bool // read through Read, so lines were not counted
+}
+
+// Open opens path for decompression, detecting its format from its magic
+// bytes. zstd files are decompressed by the zstd command, which must be
+// installed. The caller must Close the reader.
+func Open(path string) (*Reader, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	info, err := f.Stat()
+	if err != nil {
+		f.Close()
+		return nil, err
+	}
+	var header [4]byte
+	n, _ := io.ReadFull(f, header[:])
+
+	r := &Reader{key: keyFor(path, info), format: Detect(header[:n]), file: f}
+	r.known = lookupIndex(r.key)
+	switch r.format {
+	case Gzip:
+		err = r.startGzip(SeekPoint{Line: 1})
+	case Zstd:
+		err = r.startZstd(path)
+	default:
+		err = ErrNotCompressed
+	}
+	if err != nil {
+		r.Close()
+		return nil, err
+	}
+	return r, nil
+}
+
+func (r *Reader) startGzip(from SeekPoint) error {
+	gz, err := newGzipStream(r.file, from.Offset, from.Byte)
+	if err != nil {
+		return fmt.Errorf("invalid gzip data: %w", err)
+	}
+	r.gz, r.members = gz, 0
+	r.br = bufio.NewReaderSize(gz, 64*1024)
+	r.line, r.pos = from.Line-1, from.Byte
+	return nil
+}
+
+func (r *Reader) startZstd(path string) error {
+	zstd, err := exec.LookPath("zstd")
+	if err != nil {
+		return errors.New("zstd is not installed; cannot decompress zstd files")
+	}
+	r.zstd = exec.Command(zstd, "-dcq", "--", path)
+	stdout, err := r.zstd.StdoutPipe()
+	if err != nil {
+		return err
+	}
+	if err := r.zstd.Start(); err != nil {
+		r.zstd = nil
+		return err
+	}
+	r.br = bufio.NewReaderSize(stdout, 64*1024)
+	return nil
+}
+
+// Format returns the file's compression format.
+func (r *Reader) Format() Format {
+	return r.format
+}
+
+// TotalLines returns the file's line count if an earlier reader read it to
+// the end, or 0.
+func (r *Reader) TotalLines() int {
+	if r.eof && !r.raw {
+		return r.line
+	}
+	return r.known.TotalLines
+}
+
+// Line returns the number of the line ReadLine last returned.
+func (r *Reader) Line() int {
+	return r.line
+}
+
+// Read reads decompressed bytes. Mixing Read with ReadLine or SkipTo loses
+// line numbering.
+func (r *Reader) Read(p []byte) (int, error) {
+	r.raw = true
+	return r.br.Read(p)
+}
+
+// ReadLine returns the next line without its newline, valid until the next
+// call. Lines longer than 1MB are cut. It returns io.EOF after the last line.
+func (r *Reader) ReadLine() ([]byte, error) {
+	if r.eof {
+		return nil, io.EOF
+	}
+	r.buf = r.buf[:0]
+	size := int64(0)
+	for {
+		chunk, err := r.br.ReadSlice('\n')
+		size += int64(len(chunk))
+		if len(r.buf) < maxLineBytes {
+			r.buf = append(r.buf, chunk...)
+		}
+		switch err {
+		case bufio.ErrBufferFull:
+			continue
+		case nil:
+			r.advance(size)
+			return bytes.TrimSuffix(r.buf, []byte{'\n'}), nil
+		case io.EOF:
+			// The rest after the last newline is the last line
+			r.eof = true
+			r.advance(size)
+			return r.buf, nil
+		default:
+			return nil, err
+		}
+	}
+}
+
+// advance counts a line of size bytes and records a gzip member that starts
+// with it as a seek point.
+func (r *Reader) advance(size int64) {
+	start := r.pos
+	r.line++
+	r.pos += size
+	if r.gz == nil {
+		return
+	}
+	for ; r.members < len(r.gz.members); r.members++ {
+		m := r.gz.members[r.members]
+		if m.decompressed > start {
+			break
+		}
+		if m.decompressed == start {
+			r.points = append(r.points, SeekPoint{Offset: m.compressed, Line: r.line, Byte: start})
+		}
+	}
+}
+
+// SkipTo positions the reader so the next ReadLine returns line n
+// (1-indexed), resuming from the nearest known seek point when possible.
+// It must be called before any line is read.
+func (r *Reader) SkipTo(n int) error {
+	if r.gz != nil && r.line == 0 {
+		if point, ok := r.known.nearest(n); ok {
+			if err := r.startGzip(point); err != nil {
+				return err
+			}
+		}
+	}
+	for r.line < n-1 {
+		if _, err := r.ReadLine(); err != nil {
+			return err
+		}
+		if r.eof {
+			return io.EOF
+		}
+	}
+	return nil
+}
+
+// Close stops decompression and remembers what this reader learned about
+// the file for later readers.
+func (r *Reader) Close() error {
+	if !r.raw && (len(r.points) > 0 || r.eof) {
+		total := 0
+		if r.eof {
+			total = r.line
+		}
+		storeIndex(r.key, r.points, total)
+	}
+	if r.zstd != nil {
+		r.zstd.Process.Kill()
+		r.zstd.Wait()
+	}
+	return r.file.Close()
+}
+
+// memberStart is where a gzip member begins in the compressed file and in
+// the decompressed stream.
+type memberStart struct {
+	compressed   int64
+	decompressed int64
+}
+
+// gzipStream decompresses a gzip file one member at a time, noting where
+// each member after the first starts.
+type gzipStream struct {
+	counter *countingReader
+	br      *bufio.Reader
+	z       *gzip.Reader
+	base    int64 // compressed offset the stream started at
+	out     int64 // decompressed offset
+	ended   bool  // the current member ended
+	members []memberStart
+}
+
+func newGzipStream(f *os.File, offset, decompressed int64) (*gzipStream, error) {
+	if _, err := f.Seek(offset, io.SeekStart); err != nil {
+		return nil, err
+	}
+	counter := &countingReader{r: f}
+	// bufio.Reader is an io.ByteReader, so flate reads exactly up to the
+	// end of each member and member boundaries are exact
+	br := bufio.NewReader(counter)
+	z, err := gzip.NewReader(br)
+	if err != nil {
+		return nil, err
+	}
+	z.Multistream(false)
+	return &gzipStream{counter: counter, br: br, z: z, base: offset, out: decompressed}, nil
+}
+
+func (g *gzipStream) Read(p []byte) (int, error) {
+	for {
+		if g.ended {
+			start := g.base + g.counter.n - int64(g.br.Buffered())
+			if err := g.z.Reset(g.br); err != nil {
+				return 0, err // io.EOF after the last member
+			}
+			g.z.Multistream(false)
+			g.ended = false
+			g.members = append(g.members, memberStart{compressed: start, decompressed: g.out})
+		}
+		n, err := g.z.Read(p)
+		g.out += int64(n)
+		if err == io.EOF {
+			g.ended = true
+			if n == 0 {
+				continue
+			}
+			err = nil
+		}
+		return n, err
+	}
+}
+
+type countingReader struct {
+	r io.Reader
+	n int64
+}
+
+func (c *countingReader) Read(p []byte) (int, error) {
+	n, err := c.r.Read(p)
+	c.n += int64(n)
+	return n, err
+}
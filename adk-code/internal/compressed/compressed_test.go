@@ -0,0 +1,140 @@
+package compressed
+
+import (
+	"bytes"
+	"compress/gzip"
+	"fmt"
+	"io"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"testing"
+)
+
+// writeGzipMembers writes each chunk as its own gzip member, as bgzip or
+// concatenated rotations produce.
+func writeGzipMembers(t *testing.T, path string, chunks ...string) {
+	t.Helper()
+	var buf bytes.Buffer
+	for _, chunk := range chunks {
+		zw := gzip.NewWriter(&buf)
+		zw.Write([]byte(chunk))
+		zw.Close()
+	}
+	if err := os.WriteFile(path, buf.Bytes(), 0644); err != nil {
+		t.Fatal(err)
+	}
+}
+
+func lines(from, to int) string {
+	var b bytes.Buffer
+	for i := from; i <= to; i++ {
+		fmt.Fprintf(&b, "line %d\n", i)
+	}
+	return b.String()
+}
+
+func TestDetect(t *testing.T) {
+	if Detect([]byte{0x1f, 0x8b, 8}) != Gzip || Detect([]byte{0x28, 0xb5, 0x2f, 0xfd}) != Zstd || Detect([]byte("plain")) != None {
+		t.Error("unexpected formats")
+	}
+	path := filepath.Join(t.TempDir(), "a.log")
+	os.WriteFile(path, []byte("x"), 0644)
+	if f, err := Sniff(path); f != None || err != nil {
+		t.Errorf("Sniff of a short plain file = %v, %v", f, err)
+	}
+}
+
+func TestReaderCountsLinesLikeSplit(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "app.log.gz")
+	writeGzipMembers(t, path, "a\nb\n")
+	r, err := Open(path)
+	if err != nil {
+		t.Fatalf("Open failed: %v", err)
+	}
+	var got []string
+	for {
+		line, err := r.ReadLine()
+		if err == io.EOF {
+			break
+		}
+		if err != nil {
+			t.Fatal(err)
+		}
+		got = append(got, string(line))
+	}
+	r.Close()
+	if len(got) != 3 || got[0] != "a" || got[1] != "b" || got[2] != "" {
+		t.Fatalf("expected a, b and a final empty line, got %q", got)
+	}
+	if idx, _ := Lookup(path); idx.TotalLines != 3 {
+		t.Errorf("expected the line count to be remembered, got %+v", idx)
+	}
+}
+
+func TestReaderStopsEarlyAndResumesFromSeekPoints(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "app.log.gz")
+	writeGzipMembers(t, path, lines(1, 100), lines(101, 200), lines(201, 300))
+
+	// The first read decompresses only as far as needed
+	r, err := Open(path)
+	if err != nil {
+		t.Fatalf("Open failed: %v", err)
+	}
+	if err := r.SkipTo(150); err != nil {
+		t.Fatalf("SkipTo failed: %v", err)
+	}
+	line, _ := r.ReadLine()
+	if string(line) != "line 150" || r.TotalLines() != 0 {
+		t.Fatalf("got %q with total %d", line, r.TotalLines())
+	}
+	r.Close()
+
+	idx, _ := Lookup(path)
+	if len(idx.Points) != 1 || idx.Points[0].Line != 101 {
+		t.Fatalf("expected a seek point at line 101, got %+v", idx)
+	}
+
+	// A later read restarts at the second member
+	r, err = Open(path)
+	if err != nil {
+		t.Fatalf("Open failed: %v", err)
+	}
+	defer r.Close()
+	if err := r.SkipTo(120); err != nil {
+		t.Fatalf("SkipTo failed: %v", err)
+	}
+	if r.gz.base != idx.Points[0].Offset {
+		t.Errorf("expected decompression to resume at offset %d, got %d", idx.Points[0].Offset, r.gz.base)
+	}
+	line, _ = r.ReadLine()
+	if string(line) != "line 120" || r.Line() != 120 {
+		t.Errorf("got %q as line %d", line, r.Line())
+	}
+	if err := r.SkipTo(1000); err != io.EOF {
+		t.Errorf("expected EOF past the end, got %v", err)
+	}
+}
+
+func TestReaderZstd(t *testing.T) {
+	if _, err := exec.LookPath("zstd"); err != nil {
+		t.Skip("zstd not installed")
+	}
+	dir := t.TempDir()
+	plain := filepath.Join(dir, "app.log")
+	os.WriteFile(plain, []byte(lines(1, 10)), 0644)
+	if out, err := exec.Command("zstd", "-q", plain).CombinedOutput(); err != nil {
+		t.Fatalf("zstd failed: %v %s", err, out)
+	}
+	r, err := Open(plain + ".zst")
+	if err != nil {
+		t.Fatalf("Open failed: %v", err)
+	}
+	defer r.Close()
+	if err := r.SkipTo(5); err != nil {
+		t.Fatal(err)
+	}
+	if line, _ := r.ReadLine(); string(line) != "line 5" || r.Format() != Zstd {
+		t.Errorf("got %q from %v", line, r.Format())
+	}
+}
@@ -0,0 +1,104 @@
+package compressed
+
+import (
+	"os"
+	"path/filepath"
+	"sort"
+	"sync"
+	"time"
+)
+
+// maxIndexedFiles bounds the number of files with a kept seek-point index.
+const maxIndexedFiles = 64
+
+// SeekPoint is a place decompression can restart from: the start of a gzip
+// member that begins on a line boundary.
+type SeekPoint struct {
+	// Offset is the member's offset in the compressed file.
+	Offset int64
+	// Line is the number of the member's first line (1-indexed).
+	Line int
+	// Byte is the member's offset in the decompressed stream.
+	Byte int64
+}
+
+// Index is what earlier reads learned about a compressed file.
+type Index struct {
+	// Points are seek points after the start of the file, by line.
+	Points []SeekPoint
+	// TotalLines is the line count, or 0 if no read reached the end.
+	TotalLines int
+}
+
+// nearest returns the last seek point at or before line.
+func (idx Index) nearest(line int) (SeekPoint, bool) {
+	i := sort.Search(len(idx.Points), func(i int) bool { return idx.Points[i].Line > line })
+	if i == 0 {
+		return SeekPoint{}, false
+	}
+	return idx.Points[i-1], true
+}
+
+// indexKey identifies one version of a file.
+type indexKey struct {
+	path    string
+	size    int64
+	modTime time.Time
+}
+
+func keyFor(path string, info os.FileInfo) indexKey {
+	if abs, err := filepath.Abs(path); err == nil {
+		path = abs
+	}
+	return indexKey{path: path, size: info.Size(), modTime: info.ModTime()}
+}
+
+var (
+	indexMu sync.Mutex
+	indexes = make(map[indexKey]Index)
+)
+
+func lookupIndex(key indexKey) Index {
+	indexMu.Lock()
+	defer indexMu.Unlock()
+	return indexes[key]
+}
+
+// storeIndex merges points and a known line count into key's index.
+func storeIndex(key indexKey, points []SeekPoint, total int) {
+	indexMu.Lock()
+	defer indexMu.Unlock()
+	idx, ok := indexes[key]
+	if !ok && len(indexes) >= maxIndexedFiles {
+		// Drop an arbitrary entry, usually an older version of a rotated file
+		for k := range indexes {
+			delete(indexes, k)
+			break
+		}
+	}
+
+	merged := append(append([]SeekPoint(nil), idx.Points...), points...)
+	sort.Slice(merged, func(i, j int) bool { return merged[i].Line < merged[j].Line })
+	idx.Points = merged[:0]
+	for _, p := range merged {
+		if n := len(idx.Points); n == 0 || idx.Points[n-1].Line != p.Line {
+			idx.Points = append(idx.Points, p)
+		}
+	}
+	if total > 0 {
+		idx.TotalLines = total
+	}
+	indexes[key] = idx
+}
+
+// Lookup returns what earlier reads learned about the file at path.
+func Lookup(path string) (Index, bool) {
+	info, err := os.Stat(path)
+	if err != nil {
+		return Index{}, false
+	}
+	indexMu.Lock()
+	defer indexMu.Unlock()
+	idx, ok := indexes[keyFor(path, info)]
+	return idx, ok
+}
@@ -45,6 +45,19 @@ type Config struct {
 	CompactionOverlap   int     // Number of invocations to retain in overlap
 	CompactionTokens    int     // Token threshold for triggering compaction
 	CompactionSafety    float64 // Safety ratio for token limits (0.0-1.0)
+	CompactionRolling   bool    // Keep one rolling summary instead of one per window
+
+	// Tool timeout configuration
+	ToolTimeoutPercentile float64 // Latency percentile adaptive tool timeouts cover (0.0-1.0]
+
+	// LLM response cache configuration
+	LLMCache        bool    // Replay identical model requests from a local cache
+	LLMCacheDir     string  // Cache directory
+	LLMCacheSizeMB  int     // Size bound of the cache directory
+	LLMCacheLatency float64 // Factor applied to the recorded latency of replayed responses
+
+	// OpenAI configuration
+	OpenAIResponses bool // Use the Responses API and chain turns server-side
 }
 
 // LoadFromEnv loads configuration from environment and CLI flags
@@ -90,6 +103,19 @@ func LoadFromEnv() (Config, []string) {
 	compactionOverlap := flag.Int("compaction-overlap", 2, "Number of invocations to retain in overlap window (default: 2)")
 	compactionTokens := flag.Int("compaction-tokens", 700000, "Token threshold for triggering compaction (default: 700000)")
 	compactionSafety := flag.Float64("compaction-safety", 0.7, "Safety ratio for token limits 0.0-1.0 (default: 0.7)")
+	compactionRolling := flag.Bool("compaction-rolling", false, "Keep a single rolling summary updated from newly aged-out events instead of summarizing each window (default: false)")
+
+	// Tool timeout configuration flags
+	toolTimeoutPercentile := flag.Float64("tool-timeout-percentile", 0.95, "Latency percentile of past runs that adaptive tool timeouts cover, 0.0-1.0 (default: 0.95)")
+
+	// LLM response cache flags
+	llmCache := flag.Bool("llm-cache", false, "Replay identical model requests from a local response cache, e.g. in CI (optional, default: false)")
+	llmCacheDir := flag.String("llm-cache-dir", "", "Response cache directory (optional, defaults to ~/.code_agent/llm_cache)")
+	llmCacheSize := flag.Int("llm-cache-size", 512, "Response cache size bound in MB (default: 512)")
+	llmCacheLatency := flag.Float64("llm-cache-latency", 0, "Replay cached responses with their recorded latency times this factor (default: 0, instant)")
+
+	// OpenAI flags
+	openAIResponses := flag.Bool("openai-responses", false, "Use the OpenAI Responses API, sending only each turn's new items and letting the server keep the conversation (default: false)")
 
 	flag.Parse()
 
@@ -138,25 +164,32 @@ func LoadFromEnv() (Config, []string) {
 	}
 
 	return Config{
-		OutputFormat:        *outputFormat,
-		TypewriterEnabled:   *typewriterEnabled,
-		SessionName:         *sessionName,
-		DBPath:              *dbPath,
-		WorkingDirectory:    *workingDirectory,
-		Backend:             selectedBackend,
-		APIKey:              apiKeyValue,
-		VertexAIProject:     projectValue,
-		VertexAILocation:    locationValue,
-		Model:               *model,
-		EnableThinking:      *enableThinking,
-		ThinkingBudget:      int32(*thinkingBudget),
-		MCPConfigPath:       *mcpConfigPath,
-		MCPConfig:           mcpConfig,
-		CompactionEnabled:   *compactionEnabled,
-		CompactionThreshold: *compactionThreshold,
-		CompactionOverlap:   *compactionOverlap,
-		CompactionTokens:    *compactionTokens,
-		CompactionSafety:    *compactionSafety,
+		OutputFormat:          *outputFormat,
+		TypewriterEnabled:     *typewriterEnabled,
+		SessionName:           *sessionName,
+		DBPath:                *dbPath,
+		WorkingDirectory:      *workingDirectory,
+		Backend:               selectedBackend,
+		APIKey:                apiKeyValue,
+		VertexAIProject:       projectValue,
+		VertexAILocation:      locationValue,
+		Model:                 *model,
+		EnableThinking:        *enableThinking,
+		ThinkingBudget:        int32(*thinkingBudget),
+		MCPConfigPath:         *mcpConfigPath,
+		MCPConfig:             mcpConfig,
+		CompactionEnabled:     *compactionEnabled,
+		CompactionThreshold:   *compactionThreshold,
+		CompactionOverlap:     *compactionOverlap,
+		CompactionTokens:      *compactionTokens,
+		CompactionSafety:      *compactionSafety,
+		CompactionRolling:     *compactionRolling,
+		ToolTimeoutPercentile: *toolTimeoutPercentile,
+		LLMCache:              *llmCache,
+		LLMCacheDir:           *llmCacheDir,
+		LLMCacheSizeMB:        *llmCacheSize,
+		LLMCacheLatency:       *llmCacheLatency,
+		OpenAIResponses:       *openAIResponses,
 	}, flag.Args()
 }
 
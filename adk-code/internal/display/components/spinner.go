@@ -2,6 +2,8 @@ package components
 
 import (
 	"fmt"
+	"io"
+	"os"
 	"sync"
 	"time"
 
@@ -62,10 +64,12 @@ type Spinner struct {
 	metrics  *tracking.TokenMetrics
 	active   bool
 	stopped  bool
+	animated bool // whether Start launched the animation goroutine
 	stopCh   chan struct{}
 	doneCh   chan struct{}
 	renderer core.StyleRenderer
 	mode     SpinnerMode
+	out      io.Writer
 }
 
 // NewSpinner creates a new spinner
@@ -77,6 +81,7 @@ func NewSpinner(renderer core.StyleRenderer, message string) *Spinner {
 		stopCh:   make(chan struct{}),
 		doneCh:   make(chan struct{}),
 		mode:     SpinnerModeTool,
+		out:      os.Stdout,
 	}
 }
 
@@ -89,6 +94,7 @@ func NewSpinnerWithStyle(renderer core.StyleRenderer, message string, style Spin
 		stopCh:   make(chan struct{}),
 		doneCh:   make(chan struct{}),
 		mode:     SpinnerModeTool,
+		out:      os.Stdout,
 	}
 }
 
@@ -123,9 +129,11 @@ func (s *Spinner) Start() {
 	s.active = true
 	s.stopped = false
 
-	// Only show spinner in TTY mode
-	if !IsTTY() {
-		fmt.Printf("%s...\n", s.message)
+	// Only show spinner in TTY mode; otherwise print the message once and
+	// don't animate at all
+	s.animated = IsTTY()
+	if !s.animated {
+		fmt.Fprintf(s.out, "%s...\n", s.message)
 		return
 	}
 
@@ -148,6 +156,9 @@ func (s *Spinner) Stop() {
 
 	s.stopped = true
 	s.active = false
+	if !s.animated {
+		return
+	}
 	close(s.stopCh)
 
 	// Release lock before waiting for doneCh to avoid deadlock
@@ -172,94 +183,221 @@ func (s *Spinner) UpdateWithMetrics(message string, metrics *tracking.TokenMetri
 	s.metrics = metrics
 }
 
-// animate runs the spinner animation loop
+// Spinner refresh rate bounds. The tick interval starts at the style's speed
+// and backs off when writes to the terminal are slow.
+const (
+	maxSpinnerInterval = time.Second
+	// slowWriteFraction is how much of an interval a write may take before
+	// the interval doubles
+	slowWriteFraction = 4
+	// fastWriteFraction is how little of an interval a write must take before
+	// a backed-off interval halves again
+	fastWriteFraction = 16
+)
+
+// clearToEOL erases whatever a longer previous line left behind
+const clearToEOL = "\033[K"
+
+// adaptInterval returns the next tick interval given how long the last write
+// took, so slow terminals (remote sessions, busy ptys) get fewer redraws.
+func adaptInterval(interval, base, write time.Duration) time.Duration {
+	switch {
+	case write > interval/slowWriteFraction && interval < maxSpinnerInterval:
+		interval *= 2
+		if interval > maxSpinnerInterval {
+			interval = maxSpinnerInterval
+		}
+	case write < interval/fastWriteFraction && interval > base:
+		interval /= 2
+		if interval < base {
+			interval = base
+		}
+	}
+	return interval
+}
+
+// tokenCounts is the part of a TokenMetrics shown by the spinner, used to
+// reuse the formatted string while the counts are unchanged.
+type tokenCounts struct {
+	prompt, cached, response, thought, toolUse, total int32
+}
+
+func countsOf(m *tracking.TokenMetrics) tokenCounts {
+	return tokenCounts{m.PromptTokens, m.CachedTokens, m.ResponseTokens, m.ThoughtTokens, m.ToolUseTokens, m.TotalTokens}
+}
+
+// spinnerLine renders the spinner line and remembers what is on screen, so a
+// tick writes only what changed: nothing, just the frame, or the whole line.
+// Styled strings are cached and rebuilt only when their input changes.
+// It is owned by the animation goroutine.
+type spinnerLine struct {
+	renderer core.StyleRenderer
+	buf      []byte
+
+	// Colored frames for the current style and mode
+	rawFrames []string
+	mode      SpinnerMode
+	frames    []string
+
+	rawMessage string
+	message    string
+
+	hasMetrics bool
+	counts     tokenCounts
+	metrics    string
+
+	drawn bool
+	frame string // frame currently on screen
+}
+
+func newSpinnerLine(renderer core.StyleRenderer) *spinnerLine {
+	return &spinnerLine{renderer: renderer}
+}
+
+// set updates the cached styled parts and reports whether the text after
+// the frame changed.
+func (l *spinnerLine) set(rawFrames []string, mode SpinnerMode, message string, metrics *tracking.TokenMetrics) bool {
+	if !sameFrames(rawFrames, l.rawFrames) || mode != l.mode || l.frames == nil {
+		l.rawFrames, l.mode = rawFrames, mode
+		l.frames = make([]string, len(rawFrames))
+		for i, f := range rawFrames {
+			l.frames[i] = l.colorFrame(f)
+		}
+	}
+
+	changed := !l.drawn
+	if message != l.rawMessage {
+		l.rawMessage = message
+		l.message = l.dim(message)
+		changed = true
+	}
+
+	hasMetrics := metrics != nil && metrics.TotalTokens > 0
+	switch {
+	case hasMetrics && (!l.hasMetrics || countsOf(metrics) != l.counts):
+		l.counts = countsOf(metrics)
+		l.metrics = l.dim(tracking.FormatTokenMetrics(*metrics))
+		changed = true
+	case !hasMetrics && l.hasMetrics:
+		l.metrics = ""
+		changed = true
+	}
+	l.hasMetrics = hasMetrics
+	return changed
+}
+
+// update returns the bytes that bring the screen to the given state, or nil
+// when it already shows it. All frames are assumed to be one cell wide, so a
+// frame change rewrites only the frame.
+func (l *spinnerLine) update(rawFrames []string, mode SpinnerMode, frame int, message string, metrics *tracking.TokenMetrics) []byte {
+	changed := l.set(rawFrames, mode, message, metrics)
+	f := l.frames[frame%len(l.frames)]
+	l.buf = l.buf[:0]
+	switch {
+	case changed:
+		l.buf = l.appendLine(l.buf, f)
+		l.buf = append(l.buf, clearToEOL...)
+	case f != l.frame:
+		l.buf = append(l.buf, '\r')
+		l.buf = append(l.buf, f...)
+	default:
+		return nil
+	}
+	l.drawn, l.frame = true, f
+	return l.buf
+}
+
+// final returns the line left on screen when the spinner stops: the last
+// state with its metrics, or a cleared line when there are none.
+func (l *spinnerLine) final(rawFrames []string, mode SpinnerMode, frame int, message string, metrics *tracking.TokenMetrics) []byte {
+	l.set(rawFrames, mode, message, metrics)
+	l.buf = l.buf[:0]
+	if !l.hasMetrics {
+		return append(l.buf, "\r"+clearToEOL...)
+	}
+	l.buf = l.appendLine(l.buf, l.frames[frame%len(l.frames)])
+	l.buf = append(l.buf, clearToEOL...)
+	return append(l.buf, '\n')
+}
+
+func (l *spinnerLine) appendLine(dst []byte, frame string) []byte {
+	dst = append(dst, '\r')
+	dst = append(dst, frame...)
+	dst = append(dst, ' ')
+	dst = append(dst, l.message...)
+	if l.hasMetrics {
+		dst = append(dst, "  "...)
+		dst = append(dst, l.metrics...)
+	}
+	return dst
+}
+
+// colorFrame colors a frame based on mode
+func (l *spinnerLine) colorFrame(frame string) string {
+	if l.renderer == nil {
+		return frame
+	}
+	if l.mode == SpinnerModeThinking {
+		return l.renderer.Yellow(frame)
+	}
+	return l.renderer.Cyan(frame)
+}
+
+func (l *spinnerLine) dim(text string) string {
+	if l.renderer == nil {
+		return text
+	}
+	return l.renderer.Dim(text)
+}
+
+func sameFrames(a, b []string) bool {
+	return len(a) == len(b) && (len(a) == 0 || &a[0] == &b[0])
+}
+
+// animate runs the spinner animation loop. A tick redraws only when the
+// frame, message or metrics changed, and the tick interval adapts to how
+// fast the terminal accepts writes.
 func (s *Spinner) animate() {
 	defer close(s.doneCh)
 
-	ticker := time.NewTicker(s.style.Speed)
+	s.mu.Lock()
+	base := s.style.Speed
+	s.mu.Unlock()
+	interval := base
+	ticker := time.NewTicker(interval)
 	defer ticker.Stop()
 
+	line := newSpinnerLine(s.renderer)
 	frame := 0
 
 	for {
 		select {
 		case <-s.stopCh:
-			// Print final state with metrics if available before clearing
 			s.mu.Lock()
-			message := s.message
-			metrics := s.metrics
-			mode := s.mode
+			frames, mode, message, metrics := s.style.Frames, s.mode, s.message, s.metrics
 			s.mu.Unlock()
-
-			if metrics != nil && metrics.TotalTokens > 0 {
-				metricsStr := tracking.FormatTokenMetrics(*metrics)
-				if s.renderer != nil {
-					var coloredSpinChar string
-					if mode == SpinnerModeThinking {
-						coloredSpinChar = s.renderer.Yellow(s.style.Frames[frame%len(s.style.Frames)])
-					} else {
-						coloredSpinChar = s.renderer.Cyan(s.style.Frames[frame%len(s.style.Frames)])
-					}
-					fmt.Print("\r" + coloredSpinChar + " " +
-						s.renderer.Dim(message) + "  " + s.renderer.Dim(metricsStr) + "\n")
-				} else {
-					fmt.Printf("\r%s %s  %s\n", s.style.Frames[frame%len(s.style.Frames)], message, metricsStr)
-				}
-			} else {
-				// No metrics, just clear
-				fmt.Print("\r\033[K")
-			}
+			s.out.Write(line.final(frames, mode, frame, message, metrics))
 			return
 
 		case <-ticker.C:
 			s.mu.Lock()
-			message := s.message
-			metrics := s.metrics
-			mode := s.mode
+			frames, speed, mode, message, metrics := s.style.Frames, s.style.Speed, s.mode, s.message, s.metrics
 			s.mu.Unlock()
 
-			// Render current frame
-			spinChar := s.style.Frames[frame%len(s.style.Frames)]
-
-			// Build output with metrics if available
-			var output string
-			if metrics != nil && metrics.TotalTokens > 0 {
-				metricsStr := tracking.FormatTokenMetrics(*metrics)
-				if s.renderer != nil {
-					// Color based on mode
-					var coloredSpinChar string
-					if mode == SpinnerModeThinking {
-						coloredSpinChar = s.renderer.Yellow(spinChar)
-					} else {
-						coloredSpinChar = s.renderer.Cyan(spinChar)
-					}
-					output = fmt.Sprintf("\r%s %s  %s",
-						coloredSpinChar,
-						s.renderer.Dim(message),
-						s.renderer.Dim(metricsStr))
-				} else {
-					output = fmt.Sprintf("\r%s %s  %s", spinChar, message, metricsStr)
-				}
-			} else {
-				// No metrics, just show message
-				if s.renderer != nil {
-					// Color based on mode
-					var coloredSpinChar string
-					if mode == SpinnerModeThinking {
-						coloredSpinChar = s.renderer.Yellow(spinChar)
-					} else {
-						coloredSpinChar = s.renderer.Cyan(spinChar)
-					}
-					output = fmt.Sprintf("\r%s %s",
-						coloredSpinChar,
-						s.renderer.Dim(message))
-				} else {
-					output = fmt.Sprintf("\r%s %s", spinChar, message)
-				}
+			if speed != base {
+				// Mode changed the style
+				base, interval = speed, speed
+				ticker.Reset(interval)
 			}
 
-			fmt.Print(output)
-
+			if b := line.update(frames, mode, frame, message, metrics); b != nil {
+				start := time.Now()
+				s.out.Write(b)
+				if next := adaptInterval(interval, base, time.Since(start)); next != interval {
+					interval = next
+					ticker.Reset(interval)
+				}
+			}
 			frame++
 		}
 	}
@@ -269,7 +407,7 @@ func (s *Spinner) animate() {
 func (s *Spinner) StopWithMessage(message string) {
 	s.Stop()
 	if message != "" {
-		fmt.Println(message)
+		fmt.Fprintln(s.out, message)
 	}
 }
 
@@ -277,9 +415,9 @@ func (s *Spinner) StopWithMessage(message string) {
 func (s *Spinner) StopWithSuccess(message string) {
 	s.Stop()
 	if s.renderer != nil {
-		fmt.Println(s.renderer.SuccessCheckmark(message))
+		fmt.Fprintln(s.out, s.renderer.SuccessCheckmark(message))
 	} else {
-		fmt.Printf("✓ %s\n", message)
+		fmt.Fprintf(s.out, "✓ %s\n", message)
 	}
 }
 
@@ -287,8 +425,8 @@ func (s *Spinner) StopWithSuccess(message string) {
 func (s *Spinner) StopWithError(message string) {
 	s.Stop()
 	if s.renderer != nil {
-		fmt.Println(s.renderer.ErrorX(message))
+		fmt.Fprintln(s.out, s.renderer.ErrorX(message))
 	} else {
-		fmt.Printf("✗ %s\n", message)
+		fmt.Fprintf(s.out, "✗ %s\n", message)
 	}
 }
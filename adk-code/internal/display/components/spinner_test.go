@@ -1,9 +1,12 @@
 package components
 
 import (
+	"bytes"
 	"testing"
+	"time"
 
 	"adk-code/internal/display/styles"
+	"adk-code/internal/tracking"
 )
 
 // Re-export for tests (only OutputFormatPlain, NewRenderer is in paginator_test.go)
@@ -86,3 +89,89 @@ func TestSpinner_UpdateMessage(t *testing.T) {
 		t.Fatalf("expected message 'initial', got '%s'", s.message)
 	}
 }
+
+func TestSpinnerLine_RedrawsOnlyChanges(t *testing.T) {
+	line := newSpinnerLine(nil)
+	frames := SpinnerLine.Frames
+	metrics := &tracking.TokenMetrics{PromptTokens: 10, TotalTokens: 12}
+
+	if got := string(line.update(frames, SpinnerModeTool, 0, "working", nil)); got != "\r- working"+clearToEOL {
+		t.Fatalf("expected a full first draw, got %q", got)
+	}
+	if got := line.update(frames, SpinnerModeTool, 4, "working", nil); got != nil {
+		t.Fatalf("expected no redraw for an unchanged frame, got %q", got)
+	}
+	if got := string(line.update(frames, SpinnerModeTool, 1, "working", nil)); got != "\r\\" {
+		t.Fatalf("expected only the frame to be redrawn, got %q", got)
+	}
+	want := "\r\\ working  " + tracking.FormatTokenMetrics(*metrics) + clearToEOL
+	if got := string(line.update(frames, SpinnerModeTool, 1, "working", metrics)); got != want {
+		t.Fatalf("expected a full redraw with metrics, got %q", got)
+	}
+
+	// Equal counts in a new value don't redraw
+	same := *metrics
+	same.RequestID = "next"
+	if got := line.update(frames, SpinnerModeTool, 1, "working", &same); got != nil {
+		t.Fatalf("expected no redraw for equal metrics, got %q", got)
+	}
+	if got := string(line.update(frames, SpinnerModeTool, 1, "done", &same)); got != "\r\\ done  "+tracking.FormatTokenMetrics(same)+clearToEOL {
+		t.Fatalf("expected a full redraw for a new message, got %q", got)
+	}
+	if got := string(line.final(frames, SpinnerModeTool, 1, "done", nil)); got != "\r"+clearToEOL {
+		t.Fatalf("expected the line to be cleared without metrics, got %q", got)
+	}
+}
+
+func TestAdaptInterval(t *testing.T) {
+	base := 80 * time.Millisecond
+	if got := adaptInterval(base, base, time.Millisecond); got != base {
+		t.Errorf("fast writes should keep the base interval, got %v", got)
+	}
+	if got := adaptInterval(base, base, 30*time.Millisecond); got != 2*base {
+		t.Errorf("slow writes should double the interval, got %v", got)
+	}
+	if got := adaptInterval(800*time.Millisecond, base, time.Second); got != maxSpinnerInterval {
+		t.Errorf("interval should be capped at %v, got %v", maxSpinnerInterval, got)
+	}
+	if got := adaptInterval(4*base, base, time.Millisecond); got != 2*base {
+		t.Errorf("fast writes should halve a backed-off interval, got %v", got)
+	}
+}
+
+func TestSpinner_NonTTYDoesNotAnimate(t *testing.T) {
+	defer func(orig func() bool) { IsTTY = orig }(IsTTY)
+	IsTTY = func() bool { return false }
+
+	var out bytes.Buffer
+	s := NewSpinner(nil, "processing")
+	s.out = &out
+	s.Start()
+	s.UpdateWithMetrics("still processing", &tracking.TokenMetrics{TotalTokens: 5})
+	s.Stop() // must not wait for an animation that never started
+	if out.String() != "processing...\n" {
+		t.Fatalf("expected the message once, got %q", out.String())
+	}
+}
+
+func TestSpinner_AnimatesOnTTY(t *testing.T) {
+	defer func(orig func() bool) { IsTTY = orig }(IsTTY)
+	IsTTY = func() bool { return true }
+
+	var out bytes.Buffer
+	s := NewSpinnerWithStyle(nil, "processing", SpinnerStyle{Frames: []string{"*"}, Speed: time.Millisecond})
+	s.out = &out
+	s.Start()
+	time.Sleep(20 * time.Millisecond)
+	metrics := &tracking.TokenMetrics{TotalTokens: 5}
+	s.UpdateWithMetrics("processing", metrics)
+	time.Sleep(20 * time.Millisecond)
+	s.Stop()
+
+	// A single-frame spinner draws once per change, then the final line
+	withMetrics := "\r* processing  " + tracking.FormatTokenMetrics(*metrics) + clearToEOL
+	want := "\r* processing" + clearToEOL + withMetrics + withMetrics + "\n"
+	if out.String() != want {
+		t.Fatalf("unexpected output %q", out.String())
+	}
+}
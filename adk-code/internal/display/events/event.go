@@ -3,6 +3,7 @@ package events
 
 import (
 	"fmt"
+	"os"
 	"path/filepath"
 	"strings"
 
@@ -49,7 +50,7 @@ var (
 
 // PrintEventEnhanced processes and displays agent events
 func PrintEventEnhanced(renderer *Renderer, streamDisplay *StreamingDisplay,
-	event *session.Event, spinner *Spinner, activeToolName *string, toolRunning *bool,
+	event *session.Event, spinner *Spinner, activeToolName *string, toolRunning *bool, printedDeltas *bool,
 	sessionTokens *tracking.SessionTokens, requestID string, timeline *EventTimeline) {
 
 	if event.Content == nil || len(event.Content.Parts) == 0 {
@@ -84,6 +85,21 @@ func PrintEventEnhanced(renderer *Renderer, streamDisplay *StreamingDisplay,
 		return
 	}
 
+	// Partial events carry incremental deltas of a streamed response; the
+	// aggregated response (with usage and function calls) follows them
+	if event.Partial {
+		printPartialEvent(streamDisplay, event, spinner, printedDeltas)
+		return
+	}
+
+	// Text already shown as streamed deltas is not printed again
+	streamed := streamDisplay != nil && streamDisplay.CompleteStream()
+	if *printedDeltas {
+		// Deltas printed without a streaming display leave the line open
+		fmt.Println()
+		streamed, *printedDeltas = true, false
+	}
+
 	// Record token metrics if available and update spinner with metrics
 	if event.UsageMetadata != nil {
 		sessionTokens.RecordMetrics(event.UsageMetadata, requestID)
@@ -107,7 +123,7 @@ func PrintEventEnhanced(renderer *Renderer, streamDisplay *StreamingDisplay,
 
 	for _, part := range event.Content.Parts {
 		// Handle text content
-		if part.Text != "" {
+		if part.Text != "" && !streamed {
 			// Only stop spinner for actual agent responses (not tool-related text)
 			text := part.Text
 			isToolRelated := strings.Contains(text, "read_file") ||
@@ -200,6 +216,12 @@ func PrintEventEnhanced(renderer *Renderer, streamDisplay *StreamingDisplay,
 			resultOutput := renderer.RenderToolResult(part.FunctionResponse.Name, result)
 			fmt.Print(resultOutput)
 
+			// Write diff previews hunk by hunk as each is rendered instead of
+			// building the whole highlighted diff first
+			if diff, ok := result["diff"].(string); ok && diff != "" {
+				_ = toolRenderer.StreamDiff(os.Stdout, strings.NewReader(diff))
+			}
+
 			// Display grounding information if available (for google_search and other grounded tools)
 			if event.GroundingMetadata != nil && (part.FunctionResponse.Name == "google_search" || strings.Contains(part.FunctionResponse.Name, "search")) {
 				groundingInfo := grounding.ExtractGroundingInfo(event.GroundingMetadata)
@@ -217,6 +239,24 @@ func PrintEventEnhanced(renderer *Renderer, streamDisplay *StreamingDisplay,
 	}
 }
 
+// printPartialEvent routes the text deltas of a partial event to the
+// streaming display as they arrive. Without a streaming display the deltas go
+// straight to stdout and printedDeltas records it for the aggregated event.
+func printPartialEvent(streamDisplay *StreamingDisplay, event *session.Event, spinner *Spinner, printedDeltas *bool) {
+	for _, part := range event.Content.Parts {
+		if part == nil || part.Text == "" {
+			continue
+		}
+		spinner.Stop()
+		if streamDisplay != nil {
+			streamDisplay.HandleTextDelta(part.Text, part.Thought)
+		} else {
+			fmt.Print(part.Text)
+			*printedDeltas = true
+		}
+	}
+}
+
 // GetToolSpinnerMessage returns a context-aware spinner message for tool execution
 func GetToolSpinnerMessage(toolName string, args map[string]any) string {
 	icon := EventTypeIcon(EventTypeExecuting)
@@ -100,7 +100,7 @@ func NewStreamingDisplay(renderer *Renderer, typewriter *TypewriterPrinter) *Str
 
 // PrintEventEnhanced processes and displays agent events
 func PrintEventEnhanced(renderer *Renderer, streamDisplay *StreamingDisplay,
-	event *session.Event, spinner *Spinner, activeToolName *string, toolRunning *bool,
+	event *session.Event, spinner *Spinner, activeToolName *string, toolRunning *bool, printedDeltas *bool,
 	sessionTokens *tracking.SessionTokens, requestID string, timeline *EventTimeline) {
-	events.PrintEventEnhanced(renderer, streamDisplay, event, spinner, activeToolName, toolRunning, sessionTokens, requestID, timeline)
+	events.PrintEventEnhanced(renderer, streamDisplay, event, spinner, activeToolName, toolRunning, printedDeltas, sessionTokens, requestID, timeline)
 }
@@ -6,8 +6,6 @@ import (
 	"strings"
 
 	"adk-code/internal/display/styles"
-
-	"github.com/charmbracelet/lipgloss"
 )
 
 // ToolFormatter formats tool calls and results
@@ -73,60 +71,70 @@ func (tf *ToolFormatter) getToolHeader(toolName string, args map[string]any) str
 		toolIcon = "→"
 	}
 
-	iconStyle := lipgloss.NewStyle().
-		Foreground(lipgloss.AdaptiveColor{Light: "240", Dark: "245"})
-
-	toolStyle := lipgloss.NewStyle().
-		Foreground(lipgloss.Color("39")). // Blue
-		Bold(false)
-
 	switch toolName {
 	case "read_file":
 		if path, ok := args["path"].(string); ok {
 			displayPath := tf.truncatePath(path, 60)
-			return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Reading") + " " + tf.formatter.Dim(displayPath)
+			return tf.header(toolIcon, "Reading", displayPath)
 		}
-		return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Reading file")
+		return tf.header(toolIcon, "Reading file", "")
 
 	case "write_file":
 		if path, ok := args["path"].(string); ok {
 			displayPath := tf.truncatePath(path, 60)
-			return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Writing") + " " + tf.formatter.Dim(displayPath)
+			return tf.header(toolIcon, "Writing", displayPath)
 		}
-		return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Writing file")
+		return tf.header(toolIcon, "Writing file", "")
 
 	case "replace_in_file", "search_replace":
 		if path, ok := args["path"].(string); ok {
 			displayPath := tf.truncatePath(path, 60)
-			return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Editing") + " " + tf.formatter.Dim(displayPath)
+			return tf.header(toolIcon, "Editing", displayPath)
 		}
-		return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Editing file")
+		return tf.header(toolIcon, "Editing file", "")
 
 	case "list_directory":
 		if path, ok := args["path"].(string); ok {
 			displayPath := tf.truncatePath(path, 60)
-			return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Listing") + " " + tf.formatter.Dim(displayPath)
+			return tf.header(toolIcon, "Listing", displayPath)
 		}
-		return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Listing files")
+		return tf.header(toolIcon, "Listing files", "")
 
 	case "execute_command", "execute_program":
 		if command, ok := args["command"].(string); ok {
-			return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Running") + " " + tf.formatter.Dim("`"+command+"`")
+			return tf.header(toolIcon, "Running", "`"+command+"`")
 		}
 		if program, ok := args["program"].(string); ok {
-			return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Running") + " " + tf.formatter.Dim("`"+program+"`")
+			return tf.header(toolIcon, "Running", "`"+program+"`")
 		}
-		return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Running command")
+		return tf.header(toolIcon, "Running command", "")
 
 	case "grep_search":
 		if pattern, ok := args["pattern"].(string); ok {
-			return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Searching for") + " " + tf.formatter.Dim("`"+pattern+"`")
+			return tf.header(toolIcon, "Searching for", "`"+pattern+"`")
 		}
-		return iconStyle.Render(toolIcon) + " " + toolStyle.Render("Searching files")
+		return tf.header(toolIcon, "Searching files", "")
 
 	default:
-		return iconStyle.Render(toolIcon) + " " + toolStyle.Render(toolName)
+		return tf.header(toolIcon, toolName, "")
+	}
+}
+
+// header renders "icon action detail" with the detail dimmed, building the
+// line in one buffer from the precompiled styles
+func (tf *ToolFormatter) header(icon, action, detail string) string {
+	// The icon and action are styled whenever the color profile allows, the
+	// detail only when the output format does too
+	table := styles.Table()
+	buf := make([]byte, 0, 64+len(action)+len(detail))
+	buf = table.Append(buf, styles.StyleToolIcon, icon)
+	buf = append(buf, ' ')
+	buf = table.Append(buf, styles.StyleToolName, action)
+	if detail != "" {
+		buf = append(buf, ' ')
+		buf = tf.formatter.Append(buf, styles.StyleDim, detail)
 	}
+	return string(buf)
 }
 
 // extractError extracts error messages from various error formats in tool results
@@ -179,10 +187,7 @@ func (tf *ToolFormatter) extractError(result map[string]any) string {
 func (tf *ToolFormatter) RenderToolResult(toolName string, result map[string]any) string {
 	// Check for errors - handle multiple error formats
 	if err := tf.extractError(result); err != "" {
-		errorStyle := lipgloss.NewStyle().
-			Foreground(lipgloss.Color("1")). // Red
-			Bold(false)
-		return "  " + errorStyle.Render("✗ "+err) + "\n"
+		return "  " + styles.Table().Render(styles.StyleRed, "✗ "+err) + "\n"
 	}
 
 	// Subtle success indicator
@@ -192,54 +197,61 @@ func (tf *ToolFormatter) RenderToolResult(toolName string, result map[string]any
 		checkmark = "OK"
 	}
 
-	dimStyle := lipgloss.NewStyle().
-		Foreground(lipgloss.AdaptiveColor{Light: "250", Dark: "238"})
-
-	successStyle := lipgloss.NewStyle().
-		Foreground(lipgloss.Color("2")) // Green
-
 	// Add contextual success message based on tool type
 	var message string
 	switch toolName {
 	case "read_file":
 		if content, ok := result["content"].(string); ok {
-			lines := len(strings.Split(content, "\n"))
-			message = dimStyle.Render(fmt.Sprintf("  %s Read %d lines", successStyle.Render(checkmark), lines))
+			lines := strings.Count(content, "\n") + 1
+			message = tf.resultLine(checkmark, fmt.Sprintf("Read %d lines", lines))
 		} else {
-			message = dimStyle.Render("  " + successStyle.Render(checkmark) + " Read complete")
+			message = tf.resultLine(checkmark, "Read complete")
 		}
 	case "write_file":
 		if path, ok := result["path"].(string); ok {
 			displayPath := tf.truncatePath(path, 50)
-			message = dimStyle.Render("  " + successStyle.Render(checkmark) + " Wrote " + displayPath)
+			message = tf.resultLine(checkmark, "Wrote "+displayPath)
 		} else {
-			message = dimStyle.Render("  " + successStyle.Render(checkmark) + " Write complete")
+			message = tf.resultLine(checkmark, "Write complete")
 		}
 	case "replace_in_file", "search_replace":
-		message = dimStyle.Render("  " + successStyle.Render(checkmark) + " Edit applied")
+		message = tf.resultLine(checkmark, "Edit applied")
 	case "list_directory":
 		if items, ok := result["items"].([]any); ok {
-			message = dimStyle.Render(fmt.Sprintf("  %s Found %d items", successStyle.Render(checkmark), len(items)))
+			message = tf.resultLine(checkmark, fmt.Sprintf("Found %d items", len(items)))
 		} else {
-			message = dimStyle.Render("  " + successStyle.Render(checkmark) + " List complete")
+			message = tf.resultLine(checkmark, "List complete")
 		}
 	case "execute_command", "execute_program":
 		if exitCode, ok := result["exit_code"].(int); ok && exitCode == 0 {
-			message = dimStyle.Render("  " + successStyle.Render(checkmark) + " Command successful")
+			message = tf.resultLine(checkmark, "Command successful")
 		} else if exitCode, ok := result["exit_code"].(float64); ok && exitCode == 0 {
-			message = dimStyle.Render("  " + successStyle.Render(checkmark) + " Command successful")
+			message = tf.resultLine(checkmark, "Command successful")
 		} else {
-			message = dimStyle.Render("  " + successStyle.Render(checkmark) + " Command complete")
+			message = tf.resultLine(checkmark, "Command complete")
 		}
 	case "grep_search":
 		if matches, ok := result["matches"].([]any); ok {
-			message = dimStyle.Render(fmt.Sprintf("  %s Found %d matches", successStyle.Render(checkmark), len(matches)))
+			message = tf.resultLine(checkmark, fmt.Sprintf("Found %d matches", len(matches)))
 		} else {
-			message = dimStyle.Render("  " + successStyle.Render(checkmark) + " Search complete")
+			message = tf.resultLine(checkmark, "Search complete")
 		}
 	default:
-		message = dimStyle.Render("  " + successStyle.Render(checkmark) + " Complete")
+		message = tf.resultLine(checkmark, "Complete")
 	}
 
 	return message + "\n"
 }
+
+// resultLine renders a muted "  ✓ message" line with a green checkmark
+func (tf *ToolFormatter) resultLine(checkmark, message string) string {
+	table := styles.Table()
+	buf := make([]byte, 0, 48+len(message))
+	buf = table.AppendOpen(buf, styles.StyleMuted)
+	buf = append(buf, "  "...)
+	buf = table.Append(buf, styles.StyleGreen, checkmark)
+	buf = append(buf, ' ')
+	buf = append(buf, message...)
+	buf = table.AppendClose(buf, styles.StyleMuted)
+	return string(buf)
+}
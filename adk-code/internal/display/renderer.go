@@ -12,6 +12,7 @@ type (
 	TimelineEvent = components.TimelineEvent
 	EventTimeline = components.EventTimeline
 	APIUsageInfo  = formatters.APIUsageInfo
+	StyleID       = styles.StyleID
 )
 
 // Re-export functions
@@ -27,6 +28,22 @@ const (
 	OutputFormatJSON  = styles.OutputFormatJSON
 )
 
+// Precompiled styles for Renderer.Styled and Renderer.AppendStyled
+const (
+	StyleDim      = styles.StyleDim
+	StyleGreen    = styles.StyleGreen
+	StyleRed      = styles.StyleRed
+	StyleYellow   = styles.StyleYellow
+	StyleBlue     = styles.StyleBlue
+	StyleCyan     = styles.StyleCyan
+	StyleWhite    = styles.StyleWhite
+	StyleBold     = styles.StyleBold
+	StyleSuccess  = styles.StyleSuccess
+	StyleToolIcon = styles.StyleToolIcon
+	StyleToolName = styles.StyleToolName
+	StyleMuted    = styles.StyleMuted
+)
+
 // Event types - re-export for backward compatibility
 const (
 	EventTypeThinking  = components.EventTypeThinking
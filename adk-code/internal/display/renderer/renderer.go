@@ -117,6 +117,17 @@ func (r *Renderer) Success(text string) string {
 	return r.styleFormatter.Success(text)
 }
 
+// Styled renders text in a precompiled style
+func (r *Renderer) Styled(id styles.StyleID, text string) string {
+	return r.styleFormatter.Render(id, text)
+}
+
+// AppendStyled appends text rendered in a precompiled style to dst, so hot
+// paths can build lines in a reusable buffer without allocating
+func (r *Renderer) AppendStyled(dst []byte, id styles.StyleID, text string) []byte {
+	return r.styleFormatter.Append(dst, id, text)
+}
+
 func (r *Renderer) SuccessCheckmark(text string) string {
 	return r.styleFormatter.SuccessCheckmark(text)
 }
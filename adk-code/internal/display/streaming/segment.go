@@ -49,6 +49,7 @@ type StreamingSegment struct {
 	typewriter     *TypewriterPrinter
 	outputFormat   string
 	headerRendered bool
+	streamed       bool // content was printed incrementally as it arrived
 }
 
 // NewStreamingSegment creates a new streaming segment
@@ -80,6 +81,29 @@ func (ss *StreamingSegment) AppendText(text string) {
 	ss.buffer.WriteString(text)
 }
 
+// AppendDelta adds an incremental chunk of a streamed message and prints it
+// immediately. Streamed segments are shown as raw text; they are not
+// re-rendered as markdown when frozen.
+func (ss *StreamingSegment) AppendDelta(delta string) {
+	ss.mu.Lock()
+	defer ss.mu.Unlock()
+
+	if ss.frozen || delta == "" {
+		return
+	}
+
+	ss.buffer.WriteString(delta)
+	ss.streamed = true
+	fmt.Print(delta)
+}
+
+// IsStreamed returns whether the segment is receiving incremental deltas
+func (ss *StreamingSegment) IsStreamed() bool {
+	ss.mu.Lock()
+	defer ss.mu.Unlock()
+	return ss.streamed
+}
+
 // Freeze finalizes the segment and renders the accumulated content
 func (ss *StreamingSegment) Freeze() {
 	ss.mu.Lock()
@@ -92,6 +116,14 @@ func (ss *StreamingSegment) Freeze() {
 	ss.frozen = true
 	content := ss.buffer.String()
 
+	if ss.streamed {
+		// Content is already on screen; just terminate the line
+		if content != "" && !strings.HasSuffix(content, "\n") {
+			fmt.Println()
+		}
+		return
+	}
+
 	if content != "" {
 		ss.renderContent(content)
 	}
@@ -18,6 +18,7 @@ type StreamingDisplay struct {
 	dedupe        *MessageDeduplicator
 	activeSegment *StreamingSegment
 	typewriter    *TypewriterPrinter
+	streamedText  bool // deltas were shown since the last CompleteStream
 }
 
 // NewStreamingDisplay creates a new streaming display manager
@@ -67,6 +68,58 @@ func (sd *StreamingDisplay) HandleTextMessage(text string, isThinking bool) {
 	sd.activeSegment = nil
 }
 
+// HandleTextDelta appends an incremental chunk of a streamed model response
+// to the active segment, which prints it as soon as it arrives. Deltas are
+// not deduplicated since short chunks legitimately repeat.
+func (sd *StreamingDisplay) HandleTextDelta(delta string, isThinking bool) {
+	if delta == "" {
+		return
+	}
+
+	sd.mu.Lock()
+	defer sd.mu.Unlock()
+
+	msgType := MessageTypeResponse
+	if isThinking {
+		msgType = MessageTypeThinking
+	}
+
+	// Continue the active segment only if it is a streamed one of the same type
+	if sd.activeSegment != nil && (sd.activeSegment.messageType != msgType || !sd.activeSegment.IsStreamed()) {
+		sd.activeSegment.Freeze()
+		sd.activeSegment = nil
+	}
+
+	if sd.activeSegment == nil {
+		sd.activeSegment = NewStreamingSegment(
+			msgType,
+			sd.renderer.MarkdownRenderer(),
+			sd.typewriter,
+			sd.renderer.OutputFormat(),
+		)
+	}
+
+	sd.activeSegment.AppendDelta(delta)
+	sd.streamedText = true
+}
+
+// CompleteStream finalizes streamed output when the aggregated (non-partial)
+// response arrives. It reports whether text was streamed since the previous
+// call, in which case the final response's text is already on screen.
+func (sd *StreamingDisplay) CompleteStream() bool {
+	sd.mu.Lock()
+	defer sd.mu.Unlock()
+
+	if sd.activeSegment != nil && !sd.activeSegment.IsFrozen() {
+		sd.activeSegment.Freeze()
+		sd.activeSegment = nil
+	}
+
+	streamed := sd.streamedText
+	sd.streamedText = false
+	return streamed
+}
+
 // HandleToolCall processes a tool call
 func (sd *StreamingDisplay) HandleToolCall(toolName string, args map[string]any) {
 	sd.mu.Lock()
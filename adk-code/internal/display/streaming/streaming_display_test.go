@@ -162,3 +162,38 @@ func TestStreamingDisplay_MultipleMessages(t *testing.T) {
 		t.Errorf("activeSegment should be nil after HandleTextMessage (segment is frozen and cleared)")
 	}
 }
+
+// TestStreamingDisplay_HandleTextDelta tests that deltas extend one segment
+func TestStreamingDisplay_HandleTextDelta(t *testing.T) {
+	renderer, err := NewRenderer("plain")
+	if err != nil {
+		t.Fatalf("NewRenderer failed: %v", err)
+	}
+	sd := NewStreamingDisplay(renderer, nil)
+
+	sd.HandleTextDelta("Hel", false)
+	segment := sd.activeSegment
+	sd.HandleTextDelta("lo", false)
+
+	if sd.activeSegment != segment {
+		t.Fatal("deltas of the same type should append to the active segment")
+	}
+	if got := segment.buffer.String(); got != "Hello" {
+		t.Errorf("expected accumulated delta text %q, got %q", "Hello", got)
+	}
+
+	sd.HandleTextDelta("Reasoning", true)
+	if sd.activeSegment == segment || !segment.IsFrozen() {
+		t.Error("a delta of a different type should freeze the previous segment")
+	}
+
+	if !sd.CompleteStream() {
+		t.Error("CompleteStream should report that text was streamed")
+	}
+	if sd.activeSegment != nil {
+		t.Error("CompleteStream should freeze and clear the active segment")
+	}
+	if sd.CompleteStream() {
+		t.Error("CompleteStream should reset after reporting")
+	}
+}
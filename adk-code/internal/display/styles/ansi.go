@@ -0,0 +1,165 @@
+package styles
+
+import (
+	"strings"
+	"sync"
+
+	"github.com/charmbracelet/lipgloss"
+)
+
+// StyleID names a precompiled style in a StyleTable.
+type StyleID int
+
+// Precompiled styles
+const (
+	StyleDim StyleID = iota
+	StyleGreen
+	StyleRed
+	StyleYellow
+	StyleBlue
+	StyleCyan
+	StyleWhite
+	StyleBold
+	StyleSuccess
+	StyleToolIcon
+	StyleToolName
+	StyleMuted
+	numStyles
+)
+
+// tabSpaces is what lipgloss expands a tab to by default
+const tabSpaces = "    "
+
+// ansiStyle is a style's raw escape sequences for one color profile.
+type ansiStyle struct {
+	prefix string
+	suffix string
+	style  lipgloss.Style // renders multi-line text
+}
+
+// StyleTable holds the ANSI prefix and suffix of every StyleID for one color
+// profile, so single-line text can be styled without going through lipgloss.
+// Output matches lipgloss, which expands tabs to four spaces. Multi-line
+// text, which lipgloss also pads to a common width, is passed to lipgloss.
+type StyleTable struct {
+	styles [numStyles]ansiStyle
+}
+
+// compileStyle extracts the escape sequences lipgloss puts around text.
+// Escape sequences never contain 'x', so it marks where the text goes.
+func compileStyle(style lipgloss.Style) ansiStyle {
+	rendered := style.Render("x")
+	i := strings.IndexByte(rendered, 'x')
+	if i < 0 {
+		return ansiStyle{style: style}
+	}
+	return ansiStyle{prefix: rendered[:i], suffix: rendered[i+1:], style: style}
+}
+
+// newStyleTable compiles s for the current lipgloss color profile.
+func newStyleTable(s *Styles) *StyleTable {
+	t := &StyleTable{}
+	for id, style := range map[StyleID]lipgloss.Style{
+		StyleDim:      s.DimStyle,
+		StyleGreen:    s.GreenStyle,
+		StyleRed:      s.RedStyle,
+		StyleYellow:   s.YellowStyle,
+		StyleBlue:     s.BlueStyle,
+		StyleCyan:     s.CyanStyle,
+		StyleWhite:    s.WhiteStyle,
+		StyleBold:     s.BoldStyle,
+		StyleSuccess:  s.SuccessStyle,
+		StyleToolIcon: s.ToolIconStyle,
+		StyleToolName: s.ToolNameStyle,
+		StyleMuted:    s.MutedStyle,
+	} {
+		t.styles[id] = compileStyle(style)
+	}
+	return t
+}
+
+var (
+	styleTablesMu sync.Mutex
+	// styleTables caches one table per lipgloss color profile
+	styleTables = make(map[int]*StyleTable)
+)
+
+// Table returns the precompiled style table for the active color profile.
+func Table() *StyleTable {
+	profile := int(lipgloss.ColorProfile())
+	styleTablesMu.Lock()
+	defer styleTablesMu.Unlock()
+	t, ok := styleTables[profile]
+	if !ok {
+		t = newStyleTable(NewStyles())
+		styleTables[profile] = t
+	}
+	return t
+}
+
+// Append appends text rendered in style id to dst.
+func (t *StyleTable) Append(dst []byte, id StyleID, text string) []byte {
+	style := t.styles[id]
+	if strings.IndexByte(text, '\n') >= 0 {
+		return append(dst, style.style.Render(text)...)
+	}
+	dst = append(dst, style.prefix...)
+	dst = appendExpandingTabs(dst, text)
+	return append(dst, style.suffix...)
+}
+
+// AppendOpen appends the escape sequence that starts style id, for
+// composing nested single-line styles; close it with AppendClose.
+func (t *StyleTable) AppendOpen(dst []byte, id StyleID) []byte {
+	return append(dst, t.styles[id].prefix...)
+}
+
+// AppendClose appends the escape sequence that ends style id.
+func (t *StyleTable) AppendClose(dst []byte, id StyleID) []byte {
+	return append(dst, t.styles[id].suffix...)
+}
+
+// Render returns text rendered in style id. For single-line text the result
+// is the only allocation, and text needing no escape sequences or tab
+// expansion is returned as is.
+func (t *StyleTable) Render(id StyleID, text string) string {
+	style := t.styles[id]
+	if strings.IndexByte(text, '\n') >= 0 {
+		return style.style.Render(text)
+	}
+	tabs := strings.Count(text, "\t")
+	if style.prefix == "" && style.suffix == "" && tabs == 0 {
+		return text
+	}
+	var b strings.Builder
+	b.Grow(len(style.prefix) + len(text) + tabs*(len(tabSpaces)-1) + len(style.suffix))
+	b.WriteString(style.prefix)
+	writeExpandingTabs(&b, text)
+	b.WriteString(style.suffix)
+	return b.String()
+}
+
+func appendExpandingTabs(dst []byte, s string) []byte {
+	for {
+		i := strings.IndexByte(s, '\t')
+		if i < 0 {
+			return append(dst, s...)
+		}
+		dst = append(dst, s[:i]...)
+		dst = append(dst, tabSpaces...)
+		s = s[i+1:]
+	}
+}
+
+func writeExpandingTabs(b *strings.Builder, s string) {
+	for {
+		i := strings.IndexByte(s, '\t')
+		if i < 0 {
+			b.WriteString(s)
+			return
+		}
+		b.WriteString(s[:i])
+		b.WriteString(tabSpaces)
+		s = s[i+1:]
+	}
+}
@@ -0,0 +1,91 @@
+package styles
+
+import (
+	"testing"
+
+	"github.com/charmbracelet/lipgloss"
+	"github.com/muesli/termenv"
+)
+
+// withProfile renders with profile for the duration of the test.
+func withProfile(tb testing.TB, profile termenv.Profile) {
+	tb.Helper()
+	previous := lipgloss.ColorProfile()
+	lipgloss.SetColorProfile(profile)
+	tb.Cleanup(func() { lipgloss.SetColorProfile(previous) })
+}
+
+func TestStyleTableMatchesLipgloss(t *testing.T) {
+	s := NewStyles()
+	styleByID := map[StyleID]lipgloss.Style{
+		StyleDim:      s.DimStyle,
+		StyleBlue:     s.BlueStyle,
+		StyleBold:     s.BoldStyle,
+		StyleSuccess:  s.SuccessStyle,
+		StyleToolIcon: s.ToolIconStyle,
+	}
+	inputs := []string{"plain", "", "two\nlines", "tab\tseparated", "ünïcødé ✓"}
+
+	for _, profile := range []termenv.Profile{termenv.TrueColor, termenv.ANSI256, termenv.ANSI, termenv.Ascii} {
+		withProfile(t, profile)
+		table := Table()
+		for id, style := range styleByID {
+			for _, input := range inputs {
+				want := style.Render(input)
+				if got := table.Render(id, input); got != want {
+					t.Errorf("profile %v style %d Render(%q) = %q, want %q", profile, id, input, got, want)
+				}
+				if got := string(table.Append([]byte("> "), id, input)); got != "> "+want {
+					t.Errorf("profile %v style %d Append(%q) = %q, want %q", profile, id, input, got, "> "+want)
+				}
+			}
+		}
+	}
+}
+
+func TestStyleTableAppendDoesNotAllocate(t *testing.T) {
+	withProfile(t, termenv.ANSI256)
+	table := Table()
+	buf := make([]byte, 0, 256)
+	allocs := testing.AllocsPerRun(100, func() {
+		buf = table.Append(buf[:0], StyleCyan, "Agent is thinking")
+		buf = append(buf, ' ')
+		buf = table.Append(buf, StyleDim, "(12s)")
+	})
+	if allocs != 0 {
+		t.Errorf("expected no allocations, got %v", allocs)
+	}
+}
+
+// The benchmarks render one spinner-style status line made of two styled
+// segments. Run with -benchmem to compare allocations per line.
+
+func BenchmarkLineLipgloss(b *testing.B) {
+	withProfile(b, termenv.ANSI256)
+	s := NewStyles()
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		_ = s.CyanStyle.Render("Agent is thinking") + " " + s.DimStyle.Render("(12s)")
+	}
+}
+
+func BenchmarkLineTableRender(b *testing.B) {
+	withProfile(b, termenv.ANSI256)
+	table := Table()
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		_ = table.Render(StyleCyan, "Agent is thinking") + " " + table.Render(StyleDim, "(12s)")
+	}
+}
+
+func BenchmarkLineTableAppend(b *testing.B) {
+	withProfile(b, termenv.ANSI256)
+	table := Table()
+	buf := make([]byte, 0, 256)
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		buf = table.Append(buf[:0], StyleCyan, "Agent is thinking")
+		buf = append(buf, ' ')
+		buf = table.Append(buf, StyleDim, "(12s)")
+	}
+}
@@ -13,6 +13,10 @@ type Styles struct {
 	WhiteStyle   lipgloss.Style
 	BoldStyle    lipgloss.Style
 	SuccessStyle lipgloss.Style
+
+	ToolIconStyle lipgloss.Style
+	ToolNameStyle lipgloss.Style
+	MutedStyle    lipgloss.Style
 }
 
 // NewStyles initializes all lipgloss styles
@@ -27,5 +31,9 @@ func NewStyles() *Styles {
 		WhiteStyle:   lipgloss.NewStyle().Foreground(lipgloss.Color("7")),            // White
 		BoldStyle:    lipgloss.NewStyle().Bold(true),                                 // Bold
 		SuccessStyle: lipgloss.NewStyle().Foreground(lipgloss.Color("2")).Bold(true), // Green + Bold
+
+		ToolIconStyle: lipgloss.NewStyle().Foreground(lipgloss.AdaptiveColor{Light: "240", Dark: "245"}), // Tool call icon
+		ToolNameStyle: lipgloss.NewStyle().Foreground(lipgloss.Color("39")),                              // Tool call action
+		MutedStyle:    lipgloss.NewStyle().Foreground(lipgloss.AdaptiveColor{Light: "250", Dark: "238"}), // Tool result summary
 	}
 }
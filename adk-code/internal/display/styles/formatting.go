@@ -34,12 +34,29 @@ func (f *Formatter) shouldFormat() bool {
 	return f.outputFormat != OutputFormatPlain && IsTTY != nil && IsTTY()
 }
 
+// Render renders text in a precompiled style
+func (f *Formatter) Render(id StyleID, text string) string {
+	if !f.shouldFormat() {
+		return text
+	}
+	return Table().Render(id, text)
+}
+
+// Append appends text rendered in a precompiled style to dst, for callers
+// that build output in a reusable buffer
+func (f *Formatter) Append(dst []byte, id StyleID, text string) []byte {
+	if !f.shouldFormat() {
+		return append(dst, text...)
+	}
+	return Table().Append(dst, id, text)
+}
+
 // Dim renders text in dim gray
 func (f *Formatter) Dim(text string) string {
 	if !f.shouldFormat() {
 		return text
 	}
-	return f.styles.DimStyle.Render(text)
+	return Table().Render(StyleDim, text)
 }
 
 // Green renders text in green
@@ -47,7 +64,7 @@ func (f *Formatter) Green(text string) string {
 	if !f.shouldFormat() {
 		return text
 	}
-	return f.styles.GreenStyle.Render(text)
+	return Table().Render(StyleGreen, text)
 }
 
 // Red renders text in red
@@ -55,7 +72,7 @@ func (f *Formatter) Red(text string) string {
 	if !f.shouldFormat() {
 		return text
 	}
-	return f.styles.RedStyle.Render(text)
+	return Table().Render(StyleRed, text)
 }
 
 // Yellow renders text in yellow
@@ -63,7 +80,7 @@ func (f *Formatter) Yellow(text string) string {
 	if !f.shouldFormat() {
 		return text
 	}
-	return f.styles.YellowStyle.Render(text)
+	return Table().Render(StyleYellow, text)
 }
 
 // Blue renders text in blue
@@ -71,7 +88,7 @@ func (f *Formatter) Blue(text string) string {
 	if !f.shouldFormat() {
 		return text
 	}
-	return f.styles.BlueStyle.Render(text)
+	return Table().Render(StyleBlue, text)
 }
 
 // Cyan renders text in cyan
@@ -79,7 +96,7 @@ func (f *Formatter) Cyan(text string) string {
 	if !f.shouldFormat() {
 		return text
 	}
-	return f.styles.CyanStyle.Render(text)
+	return Table().Render(StyleCyan, text)
 }
 
 // Bold renders text in bold
@@ -87,7 +104,7 @@ func (f *Formatter) Bold(text string) string {
 	if !f.shouldFormat() {
 		return text
 	}
-	return f.styles.BoldStyle.Render(text)
+	return Table().Render(StyleBold, text)
 }
 
 // Success renders text in green with bold
@@ -95,7 +112,7 @@ func (f *Formatter) Success(text string) string {
 	if !f.shouldFormat() {
 		return text
 	}
-	return f.styles.SuccessStyle.Render(text)
+	return Table().Render(StyleSuccess, text)
 }
 
 // SuccessCheckmark renders a checkmark with text in green
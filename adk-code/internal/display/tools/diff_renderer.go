@@ -0,0 +1,458 @@
+package tools
+
+import (
+	"bufio"
+	"bytes"
+	"fmt"
+	"io"
+	"path/filepath"
+	"strconv"
+	"strings"
+	"sync"
+
+	"github.com/alecthomas/chroma/v2"
+	chromaformatters "github.com/alecthomas/chroma/v2/formatters"
+	"github.com/alecthomas/chroma/v2/lexers"
+	chromastyles "github.com/alecthomas/chroma/v2/styles"
+	"github.com/charmbracelet/lipgloss"
+	"github.com/muesli/termenv"
+)
+
+const (
+	// DefaultMaxDiffHunks is how many hunks are rendered before the rest are folded
+	DefaultMaxDiffHunks = 20
+	// DefaultMaxDiffLines caps rendered lines, for huge hunks and diffs without hunks
+	DefaultMaxDiffLines = 1000
+	// diffFlushBytes is the buffered output size at which a hunk is written early
+	diffFlushBytes = 32 * 1024
+	// maxHighlightLineLength skips syntax highlighting for very long lines
+	maxHighlightLineLength = 400
+	// maxHighlightCacheBytes bounds the per-process highlighted hunk cache
+	maxHighlightCacheBytes = 4 * 1024 * 1024
+	// styleSentinel marks where text goes when extracting a style's ANSI codes
+	styleSentinel = "\ue000"
+)
+
+// diffLineKind classifies a line of a unified diff.
+type diffLineKind int
+
+const (
+	diffContext diffLineKind = iota
+	diffAdd
+	diffRemove
+	diffHunk
+	diffHeader
+	diffNote // "\ No newline at end of file"
+)
+
+// diffLine is one line of a hunk waiting to be written.
+type diffLine struct {
+	kind diffLineKind
+	text string
+}
+
+// styledAffix is the ANSI prefix and suffix a style wraps around text.
+type styledAffix struct {
+	prefix, suffix string
+}
+
+// DiffRenderer renders unified diffs hunk by hunk. Each hunk is written as
+// soon as it is complete, output past the limits is only counted, and line
+// styles are applied from precomputed ANSI prefixes instead of styling every
+// line through lipgloss.
+type DiffRenderer struct {
+	renderer *Renderer
+	MaxHunks int
+	MaxLines int
+
+	affixOnce sync.Once
+	affixes   [diffNote + 1]styledAffix
+	highlight bool
+	profile   termenv.Profile
+}
+
+// NewDiffRenderer creates a diff renderer with the default hunk limit.
+func NewDiffRenderer(renderer *Renderer) *DiffRenderer {
+	return &DiffRenderer{renderer: renderer, MaxHunks: DefaultMaxDiffHunks, MaxLines: DefaultMaxDiffLines}
+}
+
+// styleAffixes extracts the ANSI codes of each line style once. Plain output
+// yields empty affixes.
+func (dr *DiffRenderer) styleAffixes() {
+	dr.affixOnce.Do(func() {
+		styles := [...]func(string) string{
+			diffContext: dr.renderer.Dim,
+			diffAdd:     dr.renderer.Green,
+			diffRemove:  dr.renderer.Red,
+			diffHunk:    dr.renderer.Cyan,
+			diffHeader:  dr.renderer.Bold,
+			diffNote:    dr.renderer.Dim,
+		}
+		for kind, style := range styles {
+			styled := style(styleSentinel)
+			if i := strings.Index(styled, styleSentinel); i >= 0 {
+				dr.affixes[kind] = styledAffix{prefix: styled[:i], suffix: styled[i+len(styleSentinel):]}
+			}
+		}
+		// Highlight code only when the renderer emits colors at all, in the
+		// colors its profile supports
+		dr.profile = lipgloss.ColorProfile()
+		dr.highlight = dr.affixes[diffAdd].prefix != "" && highlightFormatter(dr.profile) != nil
+	})
+}
+
+// Stream reads a unified diff from r and writes the rendered hunks to w as
+// they complete, so a diff arriving from a pipe or command is shown while it
+// is produced. Once MaxHunks hunks or MaxLines lines have been rendered the
+// rest of the diff is only counted and folded into one summary line.
+func (dr *DiffRenderer) Stream(w io.Writer, r io.Reader) error {
+	dr.styleAffixes()
+
+	scanner := bufio.NewScanner(r)
+	scanner.Buffer(make([]byte, 64*1024), 4*1024*1024)
+
+	var (
+		pending          []diffLine // lines of the current hunk
+		pendingBytes     int
+		ext              string
+		oldLeft, newLeft int // remaining lines of the current hunk
+		rendered         int
+		folding          bool
+		foldedHunks      int
+		foldedLines      int
+		hunks            int
+		kind             = diffContext
+		out              bytes.Buffer
+	)
+	flush := func() error {
+		if len(pending) == 0 {
+			return nil
+		}
+		out.Reset()
+		dr.writeLines(&out, pending, ext)
+		pending, pendingBytes = pending[:0], 0
+		_, err := w.Write(out.Bytes())
+		return err
+	}
+
+	for scanner.Scan() {
+		line := scanner.Text()
+
+		lastKind := kind
+		if oldLeft > 0 || newLeft > 0 {
+			// Inside a hunk only the first column matters ("--- x" may be a removed line)
+			kind = classifyHunkLine(line)
+			switch kind {
+			case diffAdd:
+				newLeft--
+			case diffRemove:
+				oldLeft--
+			case diffContext:
+				oldLeft--
+				newLeft--
+			}
+		} else {
+			kind = classifyDiffLine(line)
+		}
+
+		switch kind {
+		case diffHeader:
+			// A file section starts: write the previous hunk, keep headers together
+			if lastKind != diffHeader {
+				if err := flush(); err != nil {
+					return err
+				}
+			}
+			if strings.HasPrefix(line, "+++ ") {
+				ext = diffPathExt(line[4:])
+			}
+		case diffHunk:
+			if err := flush(); err != nil {
+				return err
+			}
+			oldLeft, newLeft = parseHunkCounts(line)
+			hunks++
+			if dr.MaxHunks > 0 && hunks > dr.MaxHunks {
+				folding = true
+			}
+		}
+
+		if !folding && dr.MaxLines > 0 && rendered >= dr.MaxLines {
+			folding = true
+		}
+		if folding {
+			switch kind {
+			case diffHunk:
+				foldedHunks++
+			case diffHeader:
+			default:
+				foldedLines++
+			}
+			continue
+		}
+
+		pending = append(pending, diffLine{kind: kind, text: line})
+		pendingBytes += len(line)
+		rendered++
+		// Very large hunks are written in chunks rather than all at once
+		if pendingBytes >= diffFlushBytes {
+			if err := flush(); err != nil {
+				return err
+			}
+		}
+	}
+	if err := flush(); err != nil {
+		return err
+	}
+	if err := scanner.Err(); err != nil {
+		return err
+	}
+
+	if !folding {
+		return nil
+	}
+	fold := fmt.Sprintf("… %d more lines not shown", foldedLines)
+	if foldedHunks > 0 {
+		fold = fmt.Sprintf("… %d more hunks (%d lines) not shown", foldedHunks, foldedLines)
+	}
+	a := dr.affixes[diffContext]
+	_, err := io.WriteString(w, a.prefix+fold+a.suffix+"\n")
+	return err
+}
+
+// Render renders a whole diff to a string.
+func (dr *DiffRenderer) Render(diff string) string {
+	var output strings.Builder
+	_ = dr.Stream(&output, strings.NewReader(diff))
+	return output.String()
+}
+
+// writeLines appends the styled lines of (part of) a hunk. Code in added,
+// removed and context lines is syntax highlighted when the file type is
+// known; the +/- marker keeps the diff color. The old side (context and
+// removed lines) and the new side (context and added lines) are each
+// highlighted as one text, so tokens spanning lines such as block comments
+// keep their colors.
+func (dr *DiffRenderer) writeLines(buf *bytes.Buffer, lines []diffLine, ext string) {
+	var highlighted []string
+	if dr.highlight && ext != "" {
+		highlighted = make([]string, len(lines))
+		dr.highlightSide(highlighted, lines, ext, diffRemove)
+		dr.highlightSide(highlighted, lines, ext, diffAdd)
+	}
+
+	for i, line := range lines {
+		a := dr.affixes[line.kind]
+		if highlighted != nil && highlighted[i] != "" {
+			buf.WriteString(a.prefix)
+			buf.WriteByte(line.text[0])
+			buf.WriteString(a.suffix)
+			buf.WriteString(highlighted[i])
+			buf.WriteByte('\n')
+			continue
+		}
+		buf.WriteString(a.prefix)
+		buf.WriteString(line.text)
+		buf.WriteString(a.suffix)
+		buf.WriteByte('\n')
+	}
+}
+
+// highlightSide highlights the context lines together with the lines of
+// kind side, storing each line's highlighted code in out. Context lines end
+// up with the colors of the new side, which runs last.
+func (dr *DiffRenderer) highlightSide(out []string, lines []diffLine, ext string, side diffLineKind) {
+	var (
+		indexes []int
+		code    []string
+	)
+	for i, line := range lines {
+		if line.kind != side && line.kind != diffContext {
+			continue
+		}
+		text := ""
+		if line.text != "" {
+			text = line.text[1:]
+		}
+		if len(text) > maxHighlightLineLength {
+			// Kept out of the lexer; the line is written plain
+			text = ""
+		}
+		indexes = append(indexes, i)
+		code = append(code, text)
+	}
+	if len(indexes) == 0 {
+		return
+	}
+
+	result, ok := highlightLines(dr.profile, ext, code)
+	if !ok {
+		return
+	}
+	for j, i := range indexes {
+		if code[j] != "" && strings.TrimSpace(code[j]) != "" {
+			out[i] = result[j]
+		}
+	}
+}
+
+// classifyHunkLine classifies a line known to be inside a hunk.
+func classifyHunkLine(line string) diffLineKind {
+	switch {
+	case strings.HasPrefix(line, "\\"):
+		return diffNote
+	case strings.HasPrefix(line, "+"):
+		return diffAdd
+	case strings.HasPrefix(line, "-"):
+		return diffRemove
+	default:
+		return diffContext
+	}
+}
+
+// parseHunkCounts returns the old and new line counts of a "@@ -a,b +c,d @@"
+// header. Omitted counts default to 1; malformed headers yield zero.
+func parseHunkCounts(line string) (int, int) {
+	fields := strings.Fields(line)
+	if len(fields) < 3 {
+		return 0, 0
+	}
+	return rangeCount(fields[1], '-'), rangeCount(fields[2], '+')
+}
+
+func rangeCount(field string, sign byte) int {
+	if len(field) < 2 || field[0] != sign {
+		return 0
+	}
+	_, count, found := strings.Cut(field[1:], ",")
+	if !found {
+		return 1
+	}
+	n, err := strconv.Atoi(count)
+	if err != nil {
+		return 0
+	}
+	return n
+}
+
+func classifyDiffLine(line string) diffLineKind {
+	switch {
+	case strings.HasPrefix(line, "\\"):
+		return diffNote
+	case strings.HasPrefix(line, "@@"):
+		return diffHunk
+	case strings.HasPrefix(line, "+++ "), strings.HasPrefix(line, "--- "), strings.HasPrefix(line, "diff "):
+		return diffHeader
+	case strings.HasPrefix(line, "+"):
+		return diffAdd
+	case strings.HasPrefix(line, "-"):
+		return diffRemove
+	default:
+		return diffContext
+	}
+}
+
+// diffPathExt returns the extension of the path in a "+++ b/path" header.
+func diffPathExt(path string) string {
+	path = strings.TrimSpace(path)
+	if i := strings.IndexByte(path, '\t'); i >= 0 {
+		path = path[:i]
+	}
+	return strings.ToLower(filepath.Ext(path))
+}
+
+// Syntax highlighting state shared by all diff renderers: the lexer for each
+// file extension is resolved once, and highlighted hunks are memoized since
+// the same previews are often rendered more than once.
+var (
+	highlightMu         sync.Mutex
+	lexerByExt          = make(map[string]chroma.Lexer)
+	highlightedHunks    = make(map[string][]string)
+	highlightCacheBytes int
+)
+
+// highlightFormatter returns the chroma formatter matching a color profile,
+// or nil when the profile has no colors.
+func highlightFormatter(profile termenv.Profile) chroma.Formatter {
+	switch profile {
+	case termenv.TrueColor:
+		return chromaformatters.TTY16m
+	case termenv.ANSI256:
+		return chromaformatters.TTY256
+	case termenv.ANSI:
+		return chromaformatters.TTY16
+	default:
+		return nil
+	}
+}
+
+// highlightLines highlights consecutive lines of code as one text for the
+// file extension and returns the highlighted code of each line, or false if
+// the extension has no lexer or the profile no colors.
+func highlightLines(profile termenv.Profile, ext string, lines []string) ([]string, bool) {
+	formatter := highlightFormatter(profile)
+	if formatter == nil {
+		return nil, false
+	}
+	text := strings.Join(lines, "\n")
+	key := strconv.Itoa(int(profile)) + "\x00" + ext + "\x00" + text
+
+	highlightMu.Lock()
+	if cached, ok := highlightedHunks[key]; ok {
+		highlightMu.Unlock()
+		return cached, true
+	}
+	lexer, resolved := lexerByExt[ext]
+	if !resolved {
+		lexer = lexers.Match("file" + ext)
+		if lexer != nil {
+			lexer = chroma.Coalesce(lexer)
+		}
+		lexerByExt[ext] = lexer
+	}
+	highlightMu.Unlock()
+
+	if lexer == nil {
+		return nil, false
+	}
+	iterator, err := lexer.Tokenise(nil, text+"\n")
+	if err != nil {
+		return nil, false
+	}
+
+	// Tokens spanning lines are split so each line is formatted on its own,
+	// with the colors the lexer state gave it
+	style := chromastyles.Get("monokai")
+	tokenLines := chroma.SplitTokensIntoLines(iterator.Tokens())
+	highlighted := make([]string, len(lines))
+	var out bytes.Buffer
+	for i := range highlighted {
+		if i >= len(tokenLines) {
+			return nil, false
+		}
+		// Drop the newline ending the line so it is not wrapped in color codes
+		tokens := tokenLines[i]
+		if n := len(tokens); n > 0 {
+			tokens[n-1].Value = strings.TrimSuffix(tokens[n-1].Value, "\n")
+		}
+		out.Reset()
+		if err := formatter.Format(&out, style, chroma.Literator(tokens...)); err != nil {
+			return nil, false
+		}
+		highlighted[i] = out.String()
+	}
+
+	size := len(key)
+	for _, line := range highlighted {
+		size += len(line)
+	}
+	highlightMu.Lock()
+	if highlightCacheBytes+size > maxHighlightCacheBytes {
+		highlightedHunks = make(map[string][]string)
+		highlightCacheBytes = 0
+	}
+	highlightedHunks[key] = highlighted
+	highlightCacheBytes += size
+	highlightMu.Unlock()
+	return highlighted, true
+}
@@ -0,0 +1,147 @@
+package tools
+
+import (
+	"fmt"
+	"strings"
+	"testing"
+
+	"github.com/muesli/termenv"
+)
+
+// countingWriter records each write so tests can observe streaming.
+type countingWriter struct {
+	writes []string
+}
+
+func (w *countingWriter) Write(p []byte) (int, error) {
+	w.writes = append(w.writes, string(p))
+	return len(p), nil
+}
+
+func buildDiff(hunks int) string {
+	var b strings.Builder
+	b.WriteString("--- a/main.go\n+++ b/main.go\n")
+	for i := 0; i < hunks; i++ {
+		fmt.Fprintf(&b, "@@ -%d,2 +%d,2 @@\n", i*10+1, i*10+1)
+		b.WriteString(" context\n")
+		// A removed SQL comment looks like a file header
+		b.WriteString("--- removed comment\n")
+		b.WriteString("+added line\n")
+	}
+	return b.String()
+}
+
+func TestDiffRendererStreamsHunks(t *testing.T) {
+	renderer, _ := NewRenderer(OutputFormatPlain)
+	dr := NewDiffRenderer(renderer)
+
+	w := &countingWriter{}
+	if err := dr.Stream(w, strings.NewReader(buildDiff(3))); err != nil {
+		t.Fatalf("Stream failed: %v", err)
+	}
+
+	// Headers, then one write per hunk
+	if len(w.writes) != 4 {
+		t.Fatalf("expected 4 writes, got %d: %q", len(w.writes), w.writes)
+	}
+	if got := strings.Join(w.writes, ""); got != buildDiff(3) {
+		t.Errorf("expected plain output to match the input diff, got %q", got)
+	}
+}
+
+func TestDiffRendererFoldsExtraHunks(t *testing.T) {
+	renderer, _ := NewRenderer(OutputFormatPlain)
+	dr := NewDiffRenderer(renderer)
+	dr.MaxHunks = 2
+
+	output := dr.Render(buildDiff(5))
+
+	if strings.Count(output, "@@") != 4 {
+		t.Errorf("expected 2 rendered hunks, got output %q", output)
+	}
+	if !strings.HasSuffix(output, "… 3 more hunks (9 lines) not shown\n") {
+		t.Errorf("expected fold summary, got %q", output)
+	}
+}
+
+func TestDiffRendererCapsLines(t *testing.T) {
+	renderer, _ := NewRenderer(OutputFormatPlain)
+	dr := NewDiffRenderer(renderer)
+	dr.MaxLines = 4
+
+	output := dr.Render(strings.Repeat("+line\n", 10))
+
+	if strings.Count(output, "+line") != 4 || !strings.Contains(output, "… 6 more lines not shown") {
+		t.Errorf("expected 4 lines and a fold line, got %q", output)
+	}
+}
+
+func TestParseHunkCounts(t *testing.T) {
+	tests := []struct {
+		header   string
+		old, new int
+	}{
+		{"@@ -1,3 +1,4 @@ func main()", 3, 4},
+		{"@@ -5 +5,0 @@", 1, 0},
+		{"@@ malformed", 0, 0},
+	}
+	for _, tt := range tests {
+		if old, new := parseHunkCounts(tt.header); old != tt.old || new != tt.new {
+			t.Errorf("parseHunkCounts(%q) = %d, %d; want %d, %d", tt.header, old, new, tt.old, tt.new)
+		}
+	}
+}
+
+func TestDiffRendererIgnoresNoNewlineMarkers(t *testing.T) {
+	renderer, _ := NewRenderer(OutputFormatPlain)
+	dr := NewDiffRenderer(renderer)
+
+	// The marker counts toward neither side, so "--- b" is still a removed
+	// line of the hunk rather than a new file header
+	diff := "@@ -1,2 +1 @@\n-a\n\\ No newline at end of file\n--- b\n+c\n"
+	w := &countingWriter{}
+	if err := dr.Stream(w, strings.NewReader(diff)); err != nil {
+		t.Fatalf("Stream failed: %v", err)
+	}
+	if len(w.writes) != 1 || w.writes[0] != diff {
+		t.Errorf("expected the hunk in one write, got %q", w.writes)
+	}
+}
+
+func TestHighlightLinesKeepsStateAcrossLines(t *testing.T) {
+	lines := []string{"/* a comment", "   spanning lines */"}
+	first, ok := highlightLines(termenv.ANSI256, ".go", lines)
+	if !ok || len(first) != 2 {
+		t.Fatalf("expected Go code to be highlighted per line, got %q", first)
+	}
+	// The second line continues the comment rather than starting as code
+	escape := func(s string) string { return s[:strings.IndexByte(s, 'm')+1] }
+	if !strings.HasPrefix(first[1], "\x1b[") || escape(first[1]) != escape(first[0]) {
+		t.Errorf("expected both lines in the comment color, got %q", first)
+	}
+	if _, cached := lexerByExt[".go"]; !cached {
+		t.Error("expected the Go lexer to be cached")
+	}
+	if second, _ := highlightLines(termenv.ANSI256, ".go", lines); &second[0] != &first[0] {
+		t.Error("expected the memoized highlight to be reused")
+	}
+	if _, ok := highlightLines(termenv.ANSI256, ".unknownext", []string{"text"}); ok {
+		t.Error("expected no highlighting for an unknown extension")
+	}
+}
+
+func TestHighlightFollowsColorProfile(t *testing.T) {
+	if _, ok := highlightLines(termenv.Ascii, ".go", []string{"func main() {}"}); ok {
+		t.Error("expected no highlighting without colors")
+	}
+	for _, profile := range []termenv.Profile{termenv.ANSI, termenv.ANSI256, termenv.TrueColor} {
+		if highlightFormatter(profile) == nil {
+			t.Errorf("expected a formatter for profile %d", profile)
+		}
+	}
+	ansi, _ := highlightLines(termenv.ANSI256, ".go", []string{"x := 1"})
+	trueColor, _ := highlightLines(termenv.TrueColor, ".go", []string{"x := 1"})
+	if ansi[0] == trueColor[0] {
+		t.Errorf("expected profile-specific escapes, got %q for both", ansi[0])
+	}
+}
@@ -3,6 +3,7 @@ package tools
 import (
 	"encoding/json"
 	"fmt"
+	"io"
 	"strings"
 
 	rdr "adk-code/internal/display/renderer"
@@ -19,16 +20,18 @@ var NewMarkdownRenderer = rdr.NewMarkdownRenderer
 
 // ToolRenderer provides specialized rendering for tool calls and results.
 type ToolRenderer struct {
-	renderer   *Renderer
-	mdRenderer *MarkdownRenderer
+	renderer     *Renderer
+	mdRenderer   *MarkdownRenderer
+	diffRenderer *DiffRenderer
 }
 
 // NewToolRenderer creates a new tool renderer.
 func NewToolRenderer(renderer *Renderer) *ToolRenderer {
 	mdRenderer, _ := NewMarkdownRenderer()
 	return &ToolRenderer{
-		renderer:   renderer,
-		mdRenderer: mdRenderer,
+		renderer:     renderer,
+		mdRenderer:   mdRenderer,
+		diffRenderer: NewDiffRenderer(renderer),
 	}
 }
 
@@ -166,25 +169,16 @@ func (tr *ToolRenderer) RenderToolResultJSON(toolName string, result map[string]
 	return string(jsonBytes) + "\n"
 }
 
-// RenderDiff renders a file diff with syntax highlighting.
+// RenderDiff renders a file diff with syntax highlighting, folding hunks
+// beyond the display limit, for callers that need it as one string.
 func (tr *ToolRenderer) RenderDiff(diff string) string {
-	var output strings.Builder
-
-	lines := strings.Split(diff, "\n")
-	for _, line := range lines {
-		if strings.HasPrefix(line, "+") && !strings.HasPrefix(line, "+++") {
-			output.WriteString(tr.renderer.Green(line))
-		} else if strings.HasPrefix(line, "-") && !strings.HasPrefix(line, "---") {
-			output.WriteString(tr.renderer.Red(line))
-		} else if strings.HasPrefix(line, "@@") {
-			output.WriteString(tr.renderer.Cyan(line))
-		} else {
-			output.WriteString(tr.renderer.Dim(line))
-		}
-		output.WriteString("\n")
-	}
+	return tr.diffRenderer.Render(diff)
+}
 
-	return output.String()
+// StreamDiff renders a diff read from r to w, writing each hunk as soon as
+// it is rendered.
+func (tr *ToolRenderer) StreamDiff(w io.Writer, r io.Reader) error {
+	return tr.diffRenderer.Stream(w, r)
 }
 
 // RenderFileTree renders a file tree structure.
@@ -383,6 +383,17 @@ func (trp *ToolResultParser) parseWriteFile(result map[string]any) string {
 
 // parseGeneric formats generic tool results
 func (trp *ToolResultParser) parseGeneric(result map[string]any) string {
+	// Diffs are rendered separately, hunk by hunk, by the diff renderer
+	if _, ok := result["diff"].(string); ok {
+		withoutDiff := make(map[string]any, len(result))
+		for k, v := range result {
+			if k != "diff" {
+				withoutDiff[k] = v
+			}
+		}
+		result = withoutDiff
+	}
+
 	// Try to pretty print as JSON
 	jsonBytes, err := json.MarshalIndent(result, "", "  ")
 	if err != nil {
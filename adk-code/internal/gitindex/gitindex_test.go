@@ -0,0 +1,226 @@
+package gitindex
+
+import (
+	"os"
+	"os/exec"
+	"path/filepath"
+	"strings"
+	"testing"
+)
+
+// newRepo creates a repository with two committed files. The git CLI only
+// builds the fixture; the package under test never runs it.
+func newRepo(t *testing.T) string {
+	t.Helper()
+	if _, err := exec.LookPath("git"); err != nil {
+		t.Skip("git not installed")
+	}
+	dir := t.TempDir()
+	write(t, dir, "main.go", "package main\n")
+	write(t, dir, "docs/readme.md", "# docs\n")
+	write(t, dir, ".gitignore", "*.log\nbuild/\n")
+	git(t, dir, "init", "-q")
+	git(t, dir, "add", ".")
+	git(t, dir, "commit", "-q", "-m", "initial")
+	return dir
+}
+
+func git(t *testing.T, dir string, args ...string) string {
+	t.Helper()
+	cmd := exec.Command("git", args...)
+	cmd.Dir = dir
+	cmd.Env = append(os.Environ(), "GIT_AUTHOR_NAME=t", "GIT_AUTHOR_EMAIL=t@t", "GIT_COMMITTER_NAME=t", "GIT_COMMITTER_EMAIL=t@t")
+	out, err := cmd.CombinedOutput()
+	if err != nil {
+		t.Fatalf("git %v failed: %v\n%s", args, err, out)
+	}
+	return strings.TrimSpace(string(out))
+}
+
+func write(t *testing.T, dir, rel, content string) {
+	t.Helper()
+	path := filepath.Join(dir, filepath.FromSlash(rel))
+	if err := os.MkdirAll(filepath.Dir(path), 0755); err != nil {
+		t.Fatal(err)
+	}
+	if err := os.WriteFile(path, []byte(content), 0644); err != nil {
+		t.Fatal(err)
+	}
+}
+
+func statusMap(t *testing.T, tracker *Tracker, refresh bool) map[string]string {
+	t.Helper()
+	changes, err := tracker.Status(refresh)
+	if err != nil {
+		t.Fatalf("Status failed: %v", err)
+	}
+	got := make(map[string]string)
+	for _, c := range changes {
+		got[c.Path] = c.Staged + "/" + c.Unstaged
+	}
+	return got
+}
+
+func TestReadIndexMatchesGit(t *testing.T) {
+	dir := newRepo(t)
+	idx, err := ReadIndex(filepath.Join(dir, ".git", "index"))
+	if err != nil {
+		t.Fatalf("ReadIndex failed: %v", err)
+	}
+	if len(idx.Entries) != 3 {
+		t.Fatalf("expected 3 entries, got %d", len(idx.Entries))
+	}
+	for _, e := range idx.Entries {
+		want := git(t, dir, "rev-parse", ":"+e.Path)
+		if e.Hash.String() != want {
+			t.Errorf("%s: expected %s, got %s", e.Path, want, e.Hash)
+		}
+	}
+	if BlobHash([]byte("package main\n")).String() != git(t, dir, "hash-object", "main.go") {
+		t.Error("expected BlobHash to match git hash-object")
+	}
+}
+
+func TestStatusReportsChanges(t *testing.T) {
+	dir := newRepo(t)
+	write(t, dir, "main.go", "package main\n\nfunc main() {}\n")
+	write(t, dir, "new.go", "package main\n")
+	write(t, dir, "debug.log", "ignored\n")
+	write(t, dir, "build/out.bin", "ignored\n")
+	write(t, dir, "scratch/a.txt", "untracked dir\n")
+	write(t, dir, "staged.go", "package main\n")
+	git(t, dir, "add", "staged.go")
+	if err := os.Remove(filepath.Join(dir, "docs", "readme.md")); err != nil {
+		t.Fatal(err)
+	}
+
+	repo, err := Open(filepath.Join(dir, "docs"))
+	if err != nil {
+		t.Fatalf("Open failed: %v", err)
+	}
+	got := statusMap(t, NewTracker(repo), false)
+	want := map[string]string{
+		"main.go":        "/modified",
+		"docs/readme.md": "/deleted",
+		"new.go":         "/untracked",
+		"scratch/":       "/untracked",
+		"staged.go":      "added/",
+	}
+	if len(got) != len(want) {
+		t.Errorf("expected %v, got %v", want, got)
+	}
+	for path, status := range want {
+		if got[path] != status {
+			t.Errorf("%s: expected %q, got %q", path, status, got[path])
+		}
+	}
+}
+
+func TestStatusDetectsSameSizeEditWithRestoredMTime(t *testing.T) {
+	dir := newRepo(t)
+	path := filepath.Join(dir, "main.go")
+	info, err := os.Stat(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	// Same size and mtime as the index entry: only ctime or content give it away
+	write(t, dir, "main.go", "package mian\n")
+	if err := os.Chtimes(path, info.ModTime(), info.ModTime()); err != nil {
+		t.Fatal(err)
+	}
+
+	repo, _ := Open(dir)
+	if got := statusMap(t, NewTracker(repo), false); got["main.go"] != "/modified" {
+		t.Errorf("expected main.go to be modified, got %v", got)
+	}
+}
+
+func TestStatusUpdatesIncrementallyFromWrites(t *testing.T) {
+	dir := newRepo(t)
+	repo, _ := Open(dir)
+	tracker := NewTracker(repo)
+	if got := statusMap(t, tracker, false); len(got) != 0 {
+		t.Fatalf("expected a clean tree, got %v", got)
+	}
+
+	// Not reported until the write is announced
+	write(t, dir, "main.go", "package main // edited\n")
+	write(t, dir, "docs/notes.md", "notes\n")
+	if got := statusMap(t, tracker, false); len(got) != 0 {
+		t.Fatalf("expected cached clean status, got %v", got)
+	}
+	tracker.MarkWritten(filepath.Join(dir, "main.go"))
+	tracker.MarkWritten(filepath.Join(dir, "docs", "notes.md"))
+	got := statusMap(t, tracker, false)
+	if got["main.go"] != "/modified" || got["docs/notes.md"] != "/untracked" {
+		t.Errorf("expected incremental updates, got %v", got)
+	}
+
+	// Reverting the content makes the file clean again
+	write(t, dir, "main.go", "package main\n")
+	tracker.MarkWritten(filepath.Join(dir, "main.go"))
+	if got := statusMap(t, tracker, false); got["main.go"] != "" {
+		t.Errorf("expected main.go to be clean, got %v", got)
+	}
+}
+
+func TestReadObjectFromPacks(t *testing.T) {
+	dir := newRepo(t)
+	// Commit a second version so gc stores one blob as a delta
+	write(t, dir, "main.go", "package main\n\n"+strings.Repeat("// filler line\n", 50))
+	git(t, dir, "commit", "-q", "-am", "second")
+	write(t, dir, "main.go", "package main\n\n"+strings.Repeat("// filler line\n", 50)+"func main() {}\n")
+	git(t, dir, "commit", "-q", "-am", "third")
+	git(t, dir, "gc", "-q", "--aggressive")
+
+	repo, _ := Open(dir)
+	defer repo.Close()
+	head, ok, err := repo.Head()
+	if err != nil || !ok || head.String() != git(t, dir, "rev-parse", "HEAD") {
+		t.Fatalf("expected HEAD from packed refs, got %s %v %v", head, ok, err)
+	}
+	for _, rev := range []string{"HEAD~2:main.go", "HEAD~1:main.go", "HEAD:main.go"} {
+		id, _ := ParseHash(git(t, dir, "rev-parse", rev))
+		blob, err := repo.ReadBlob(id)
+		if err != nil {
+			t.Fatalf("%s: ReadBlob failed: %v", rev, err)
+		}
+		if string(blob) != git(t, dir, "show", rev)+"\n" {
+			t.Errorf("%s: content mismatch", rev)
+		}
+	}
+	files, err := repo.TreeFiles(head)
+	if err != nil || len(files) != 3 {
+		t.Errorf("expected 3 files in HEAD, got %v %v", files, err)
+	}
+}
+
+func TestIgnoreRules(t *testing.T) {
+	var rules ignoreRules
+	for _, line := range []string{"*.log", "!keep.log", "/root-only", "docs/**/*.tmp", "out/"} {
+		p, ok := parseIgnoreLine(line, "")
+		if !ok {
+			t.Fatalf("failed to parse %q", line)
+		}
+		rules = append(rules, p)
+	}
+	cases := []struct {
+		path  string
+		isDir bool
+		want  bool
+	}{
+		{"a/b/debug.log", false, true},
+		{"keep.log", false, false},
+		{"root-only", false, true},
+		{"sub/root-only", false, false},
+		{"docs/x/y/z.tmp", false, true},
+		{"docs/z.tmp", false, true},
+		{"out", true, true},
+		{"out", false, false},
+	}
+	for _, c := range cases {
+		if got, _ := rules.match(c.path, c.isDir); got != c.want {
+			t.Errorf("%s (dir=%v): expected ignored=%v", c.path, c.isDir, c.want)
+		}
+	}
+}
@@ -0,0 +1,147 @@
+package gitindex
+
+import (
+	"bufio"
+	"os"
+	"path"
+	"regexp"
+	"strings"
+)
+
+// ignorePattern is one line of a .gitignore or info/exclude file.
+type ignorePattern struct {
+	re       *regexp.Regexp
+	negate   bool
+	dirOnly  bool
+	anchored bool   // matches the path relative to base rather than the name
+	base     string // directory of the ignore file, slash separated ("" for root)
+}
+
+// ignoreRules is the ordered set of patterns that apply in one directory;
+// later patterns take precedence.
+type ignoreRules []ignorePattern
+
+// parseIgnoreFile reads patterns from file, scoped to the base directory.
+func parseIgnoreFile(file, base string) ignoreRules {
+	f, err := os.Open(file)
+	if err != nil {
+		return nil
+	}
+	defer f.Close()
+
+	var rules ignoreRules
+	scanner := bufio.NewScanner(f)
+	for scanner.Scan() {
+		if p, ok := parseIgnoreLine(scanner.Text(), base); ok {
+			rules = append(rules, p)
+		}
+	}
+	return rules
+}
+
+func parseIgnoreLine(line, base string) (ignorePattern, bool) {
+	line = strings.TrimRight(line, "\r")
+	if !strings.HasSuffix(line, "\\ ") {
+		line = strings.TrimRight(line, " ")
+	}
+	if line == "" || strings.HasPrefix(line, "#") {
+		return ignorePattern{}, false
+	}
+
+	p := ignorePattern{base: base}
+	if strings.HasPrefix(line, "!") {
+		p.negate = true
+		line = line[1:]
+	} else if strings.HasPrefix(line, "\\!") || strings.HasPrefix(line, "\\#") {
+		line = line[1:]
+	}
+	if strings.HasSuffix(line, "/") {
+		p.dirOnly = true
+		line = strings.TrimSuffix(line, "/")
+	}
+	// A slash anywhere but the end anchors the pattern to its directory
+	if strings.Contains(line, "/") {
+		p.anchored = true
+		line = strings.TrimPrefix(line, "/")
+	}
+	if line == "" {
+		return ignorePattern{}, false
+	}
+
+	re, err := regexp.Compile("^" + globToRegexp(line) + "$")
+	if err != nil {
+		return ignorePattern{}, false
+	}
+	p.re = re
+	return p, true
+}
+
+// globToRegexp translates gitignore glob syntax, including "**", to a regexp.
+func globToRegexp(glob string) string {
+	var b strings.Builder
+	for i := 0; i < len(glob); i++ {
+		c := glob[i]
+		switch c {
+		case '*':
+			if i+1 < len(glob) && glob[i+1] == '*' {
+				switch {
+				case i+2 < len(glob) && glob[i+2] == '/':
+					b.WriteString("(?:.*/)?") // "**/" matches zero or more directories
+					i += 2
+				default:
+					b.WriteString(".*")
+					i++
+				}
+				continue
+			}
+			b.WriteString("[^/]*")
+		case '?':
+			b.WriteString("[^/]")
+		case '[':
+			end := strings.IndexByte(glob[i+1:], ']')
+			if end < 0 {
+				b.WriteString(`\[`)
+				continue
+			}
+			class := glob[i+1 : i+1+end]
+			if strings.HasPrefix(class, "!") {
+				class = "^" + class[1:]
+			}
+			b.WriteString("[" + strings.ReplaceAll(class, `\`, `\\`) + "]")
+			i += end + 1
+		case '\\':
+			if i+1 < len(glob) {
+				i++
+				b.WriteString(regexp.QuoteMeta(string(glob[i])))
+			}
+		default:
+			b.WriteString(regexp.QuoteMeta(string(c)))
+		}
+	}
+	return b.String()
+}
+
+// match reports whether rel (slash separated, relative to the repository
+// root) is ignored. decided is false when no pattern matched.
+func (rules ignoreRules) match(rel string, isDir bool) (ignored, decided bool) {
+	for i := len(rules) - 1; i >= 0; i-- {
+		p := rules[i]
+		if p.dirOnly && !isDir {
+			continue
+		}
+		subject := path.Base(rel)
+		if p.anchored {
+			subject = rel
+			if p.base != "" {
+				var ok bool
+				if subject, ok = strings.CutPrefix(rel, p.base+"/"); !ok {
+					continue
+				}
+			}
+		}
+		if p.re.MatchString(subject) {
+			return !p.negate, true
+		}
+	}
+	return false, false
+}
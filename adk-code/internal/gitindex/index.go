@@ -0,0 +1,210 @@
+// Package gitindex reads git repositories natively: the .git/index file, loose
+// and packed objects, and HEAD, so working tree status can be computed
+// without spawning git.
+package gitindex
+
+import (
+	"bytes"
+	"crypto/sha1"
+	"encoding/binary"
+	"encoding/hex"
+	"fmt"
+	"os"
+	"strconv"
+	"time"
+)
+
+// Hash is a SHA-1 object id.
+type Hash [sha1.Size]byte
+
+// String returns the hash in hex.
+func (h Hash) String() string {
+	return hex.EncodeToString(h[:])
+}
+
+// ParseHash parses a 40 character hex object id.
+func ParseHash(s string) (Hash, error) {
+	var h Hash
+	if len(s) != 2*sha1.Size {
+		return h, fmt.Errorf("invalid object id %q", s)
+	}
+	if _, err := hex.Decode(h[:], []byte(s)); err != nil {
+		return h, fmt.Errorf("invalid object id %q: %w", s, err)
+	}
+	return h, nil
+}
+
+// BlobHash returns the object id git assigns to content stored as a blob.
+func BlobHash(content []byte) Hash {
+	hasher := sha1.New()
+	hasher.Write([]byte("blob " + strconv.Itoa(len(content)) + "\x00"))
+	hasher.Write(content)
+	var h Hash
+	copy(h[:], hasher.Sum(nil))
+	return h
+}
+
+// File modes recorded in the index
+const (
+	ModeRegular    = 0o100644
+	ModeExecutable = 0o100755
+	ModeSymlink    = 0o120000
+	ModeGitlink    = 0o160000
+)
+
+const (
+	flagStageMask      = 0x3000
+	flagStageShift     = 12
+	flagExtended       = 0x4000
+	extFlagSkipTree    = 0x4000
+	extFlagIntentToAdd = 0x2000
+	flagAssumeValid    = 0x8000
+)
+
+// Entry is one path in the index with the stat data cached for it.
+type Entry struct {
+	Path  string
+	Hash  Hash
+	Mode  uint32
+	Stage int
+
+	CTime time.Time
+	MTime time.Time
+	Dev   uint32
+	Ino   uint32
+	UID   uint32
+	GID   uint32
+	Size  uint32
+
+	AssumeValid bool
+	SkipTree    bool
+	IntentToAdd bool
+}
+
+// Index is a parsed .git/index file.
+type Index struct {
+	Version uint32
+	Entries []Entry
+	// ModTime is the index file's modification time, used for racy-clean checks
+	ModTime time.Time
+}
+
+// ReadIndex parses the index file at path. A missing index is an empty index.
+func ReadIndex(path string) (*Index, error) {
+	data, err := os.ReadFile(path)
+	if os.IsNotExist(err) {
+		return &Index{Version: 2}, nil
+	}
+	if err != nil {
+		return nil, err
+	}
+	info, err := os.Stat(path)
+	if err != nil {
+		return nil, err
+	}
+	idx, err := parseIndex(data)
+	if err != nil {
+		return nil, fmt.Errorf("failed to parse %s: %w", path, err)
+	}
+	idx.ModTime = info.ModTime()
+	return idx, nil
+}
+
+func parseIndex(data []byte) (*Index, error) {
+	if len(data) < 12+sha1.Size || !bytes.Equal(data[:4], []byte("DIRC")) {
+		return nil, fmt.Errorf("not a git index")
+	}
+	idx := &Index{Version: binary.BigEndian.Uint32(data[4:8])}
+	if idx.Version < 2 || idx.Version > 4 {
+		return nil, fmt.Errorf("unsupported index version %d", idx.Version)
+	}
+	count := binary.BigEndian.Uint32(data[8:12])
+	// The trailing checksum is not part of the entries or extensions
+	body := data[:len(data)-sha1.Size]
+
+	idx.Entries = make([]Entry, 0, count)
+	offset := 12
+	var prevPath []byte
+	for i := uint32(0); i < count; i++ {
+		const fixed = 62 // stat fields, object id and flags
+		if offset+fixed > len(body) {
+			return nil, fmt.Errorf("entry %d truncated", i)
+		}
+		b := body[offset:]
+		e := Entry{
+			CTime: time.Unix(int64(binary.BigEndian.Uint32(b[0:])), int64(binary.BigEndian.Uint32(b[4:]))),
+			MTime: time.Unix(int64(binary.BigEndian.Uint32(b[8:])), int64(binary.BigEndian.Uint32(b[12:]))),
+			Dev:   binary.BigEndian.Uint32(b[16:]),
+			Ino:   binary.BigEndian.Uint32(b[20:]),
+			Mode:  binary.BigEndian.Uint32(b[24:]),
+			UID:   binary.BigEndian.Uint32(b[28:]),
+			GID:   binary.BigEndian.Uint32(b[32:]),
+			Size:  binary.BigEndian.Uint32(b[36:]),
+		}
+		copy(e.Hash[:], b[40:60])
+		flags := binary.BigEndian.Uint16(b[60:])
+		e.Stage = int(flags&flagStageMask) >> flagStageShift
+		e.AssumeValid = flags&flagAssumeValid != 0
+
+		headerLen := fixed
+		if flags&flagExtended != 0 {
+			if idx.Version < 3 || offset+fixed+2 > len(body) {
+				return nil, fmt.Errorf("entry %d has invalid extended flags", i)
+			}
+			ext := binary.BigEndian.Uint16(b[62:])
+			e.SkipTree = ext&extFlagSkipTree != 0
+			e.IntentToAdd = ext&extFlagIntentToAdd != 0
+			headerLen += 2
+		}
+
+		rest := b[headerLen:]
+		if idx.Version == 4 {
+			// Paths are prefix-compressed against the previous entry
+			strip, n := readOffsetVarint(rest)
+			if n == 0 || strip > len(prevPath) {
+				return nil, fmt.Errorf("entry %d has an invalid path prefix", i)
+			}
+			rest = rest[n:]
+			end := bytes.IndexByte(rest, 0)
+			if end < 0 {
+				return nil, fmt.Errorf("entry %d path is unterminated", i)
+			}
+			path := make([]byte, 0, len(prevPath)-strip+end)
+			path = append(path, prevPath[:len(prevPath)-strip]...)
+			path = append(path, rest[:end]...)
+			e.Path = string(path)
+			prevPath = path
+			offset += headerLen + n + end + 1
+		} else {
+			end := bytes.IndexByte(rest, 0)
+			if end < 0 {
+				return nil, fmt.Errorf("entry %d path is unterminated", i)
+			}
+			e.Path = string(rest[:end])
+			// Entries are NUL padded to a multiple of 8 bytes
+			offset += (headerLen + end + 8) &^ 7
+		}
+		idx.Entries = append(idx.Entries, e)
+	}
+	return idx, nil
+}
+
+// readOffsetVarint decodes git's offset varint (used by index v4 and
+// OFS_DELTA pack entries). It returns the value and the bytes consumed.
+func readOffsetVarint(b []byte) (int, int) {
+	if len(b) == 0 {
+		return 0, 0
+	}
+	c := b[0]
+	val := int(c & 0x7f)
+	n := 1
+	for c&0x80 != 0 {
+		if n >= len(b) {
+			return 0, 0
+		}
+		c = b[n]
+		n++
+		val = ((val + 1) << 7) | int(c&0x7f)
+	}
+	return val, n
+}
@@ -0,0 +1,545 @@
+package gitindex
+
+import (
+	"bufio"
+	"bytes"
+	"compress/zlib"
+	"encoding/binary"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"sort"
+	"strconv"
+	"strings"
+	"sync"
+)
+
+// Object types
+const (
+	ObjectCommit = "commit"
+	ObjectTree   = "tree"
+	ObjectBlob   = "blob"
+	ObjectTag    = "tag"
+)
+
+// Repository locates a repository's git directory and reads its objects.
+type Repository struct {
+	// Root is the working tree root
+	Root string
+	// GitDir holds HEAD and the index (differs from CommonDir for worktrees)
+	GitDir string
+	// CommonDir holds objects and refs
+	CommonDir string
+
+	packsMu sync.Mutex
+	packs   []*packFile
+	loaded  bool
+}
+
+// Open finds the repository whose working tree contains path.
+func Open(path string) (*Repository, error) {
+	dir, err := filepath.Abs(path)
+	if err != nil {
+		return nil, err
+	}
+	for {
+		dotGit := filepath.Join(dir, ".git")
+		if info, err := os.Stat(dotGit); err == nil {
+			gitDir := dotGit
+			if !info.IsDir() {
+				// Worktrees and submodules use a "gitdir: <path>" file
+				if gitDir, err = readGitFile(dotGit); err != nil {
+					return nil, err
+				}
+			}
+			return &Repository{Root: dir, GitDir: gitDir, CommonDir: commonDir(gitDir)}, nil
+		}
+		parent := filepath.Dir(dir)
+		if parent == dir {
+			return nil, fmt.Errorf("not a git repository: %s", path)
+		}
+		dir = parent
+	}
+}
+
+func readGitFile(path string) (string, error) {
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return "", err
+	}
+	target, ok := strings.CutPrefix(strings.TrimSpace(string(data)), "gitdir: ")
+	if !ok {
+		return "", fmt.Errorf("invalid .git file %s", path)
+	}
+	if !filepath.IsAbs(target) {
+		target = filepath.Join(filepath.Dir(path), target)
+	}
+	return target, nil
+}
+
+func commonDir(gitDir string) string {
+	data, err := os.ReadFile(filepath.Join(gitDir, "commondir"))
+	if err != nil {
+		return gitDir
+	}
+	dir := strings.TrimSpace(string(data))
+	if !filepath.IsAbs(dir) {
+		dir = filepath.Join(gitDir, dir)
+	}
+	return filepath.Clean(dir)
+}
+
+// IndexPath returns the path of the index file.
+func (r *Repository) IndexPath() string {
+	return filepath.Join(r.GitDir, "index")
+}
+
+// Head resolves HEAD to a commit id. ok is false on an unborn branch.
+func (r *Repository) Head() (hash Hash, ok bool, err error) {
+	data, err := os.ReadFile(filepath.Join(r.GitDir, "HEAD"))
+	if err != nil {
+		return hash, false, err
+	}
+	head := strings.TrimSpace(string(data))
+	for depth := 0; depth < 10; depth++ {
+		ref, symbolic := strings.CutPrefix(head, "ref: ")
+		if !symbolic {
+			hash, err = ParseHash(head)
+			return hash, err == nil, err
+		}
+		target, found, err := r.readRef(ref)
+		if err != nil || !found {
+			return hash, false, err
+		}
+		head = target
+	}
+	return hash, false, fmt.Errorf("too many symbolic refs in HEAD")
+}
+
+// readRef reads a loose ref, falling back to packed-refs.
+func (r *Repository) readRef(ref string) (string, bool, error) {
+	for _, dir := range []string{r.GitDir, r.CommonDir} {
+		data, err := os.ReadFile(filepath.Join(dir, filepath.FromSlash(ref)))
+		if err == nil {
+			return strings.TrimSpace(string(data)), true, nil
+		}
+	}
+	f, err := os.Open(filepath.Join(r.CommonDir, "packed-refs"))
+	if os.IsNotExist(err) {
+		return "", false, nil
+	}
+	if err != nil {
+		return "", false, err
+	}
+	defer f.Close()
+	scanner := bufio.NewScanner(f)
+	for scanner.Scan() {
+		line := scanner.Text()
+		if hash, name, ok := strings.Cut(line, " "); ok && name == ref {
+			return hash, true, nil
+		}
+	}
+	return "", false, scanner.Err()
+}
+
+// ReadObject returns an object's type and content from loose objects or packs.
+func (r *Repository) ReadObject(hash Hash) (string, []byte, error) {
+	hex := hash.String()
+	path := filepath.Join(r.CommonDir, "objects", hex[:2], hex[2:])
+	if f, err := os.Open(path); err == nil {
+		defer f.Close()
+		return readLooseObject(f)
+	}
+
+	// Packs written since they were listed (e.g. by gc) are picked up on a miss
+	for _, reload := range []bool{false, true} {
+		packs, err := r.packList(reload)
+		if err != nil {
+			return "", nil, err
+		}
+		for _, p := range packs {
+			if offset, ok := p.find(hash); ok {
+				return p.read(r, offset, 0)
+			}
+		}
+	}
+	return "", nil, fmt.Errorf("object %s not found", hex)
+}
+
+func (r *Repository) packList(reload bool) ([]*packFile, error) {
+	r.packsMu.Lock()
+	defer r.packsMu.Unlock()
+	if r.loaded && !reload {
+		return r.packs, nil
+	}
+	packs, err := r.openPacks()
+	if err != nil {
+		return nil, err
+	}
+	r.closePacks()
+	r.packs, r.loaded = packs, true
+	return packs, nil
+}
+
+// ReadBlob returns a blob's content.
+func (r *Repository) ReadBlob(hash Hash) ([]byte, error) {
+	kind, data, err := r.ReadObject(hash)
+	if err != nil {
+		return nil, err
+	}
+	if kind != ObjectBlob {
+		return nil, fmt.Errorf("object %s is a %s, not a blob", hash, kind)
+	}
+	return data, nil
+}
+
+func readLooseObject(r io.Reader) (string, []byte, error) {
+	zr, err := zlib.NewReader(r)
+	if err != nil {
+		return "", nil, err
+	}
+	defer zr.Close()
+	data, err := io.ReadAll(zr)
+	if err != nil {
+		return "", nil, err
+	}
+	header, content, ok := bytes.Cut(data, []byte{0})
+	if !ok {
+		return "", nil, fmt.Errorf("corrupt loose object header")
+	}
+	kind, size, ok := strings.Cut(string(header), " ")
+	if !ok {
+		return "", nil, fmt.Errorf("corrupt loose object header")
+	}
+	if n, err := strconv.Atoi(size); err != nil || n != len(content) {
+		return "", nil, fmt.Errorf("loose object size mismatch")
+	}
+	return kind, content, nil
+}
+
+// TreeFiles flattens the tree of a commit into blob ids keyed by slash
+// separated path. Submodules are included with their commit id.
+func (r *Repository) TreeFiles(commit Hash) (map[string]Hash, error) {
+	kind, data, err := r.ReadObject(commit)
+	if err != nil {
+		return nil, err
+	}
+	if kind != ObjectCommit {
+		return nil, fmt.Errorf("object %s is a %s, not a commit", commit, kind)
+	}
+	line, _, _ := bytes.Cut(data, []byte{'\n'})
+	treeHex, ok := strings.CutPrefix(string(line), "tree ")
+	if !ok {
+		return nil, fmt.Errorf("commit %s has no tree", commit)
+	}
+	tree, err := ParseHash(treeHex)
+	if err != nil {
+		return nil, err
+	}
+	files := make(map[string]Hash)
+	return files, r.walkTree(tree, "", files)
+}
+
+func (r *Repository) walkTree(tree Hash, prefix string, files map[string]Hash) error {
+	kind, data, err := r.ReadObject(tree)
+	if err != nil {
+		return err
+	}
+	if kind != ObjectTree {
+		return fmt.Errorf("object %s is a %s, not a tree", tree, kind)
+	}
+	for len(data) > 0 {
+		modeAndName, rest, ok := bytes.Cut(data, []byte{0})
+		if !ok || len(rest) < len(Hash{}) {
+			return fmt.Errorf("corrupt tree %s", tree)
+		}
+		mode, name, _ := strings.Cut(string(modeAndName), " ")
+		var id Hash
+		copy(id[:], rest)
+		data = rest[len(id):]
+
+		if mode == "40000" {
+			if err := r.walkTree(id, prefix+name+"/", files); err != nil {
+				return err
+			}
+			continue
+		}
+		files[prefix+name] = id
+	}
+	return nil
+}
+
+// packFile is a pack and its version 2 index.
+type packFile struct {
+	path    string
+	fanout  [256]uint32
+	ids     []byte // sorted object ids, 20 bytes each
+	offsets []byte // 4 byte offsets, MSB set for large offsets
+	large   []byte // 8 byte offsets
+
+	mu sync.Mutex
+	f  *os.File
+}
+
+func (r *Repository) openPacks() ([]*packFile, error) {
+	idxFiles, err := filepath.Glob(filepath.Join(r.CommonDir, "objects", "pack", "*.idx"))
+	if err != nil {
+		return nil, err
+	}
+	sort.Strings(idxFiles)
+	packs := make([]*packFile, 0, len(idxFiles))
+	for _, idxPath := range idxFiles {
+		p, err := openPackIndex(idxPath)
+		if err != nil {
+			return nil, err
+		}
+		packs = append(packs, p)
+	}
+	return packs, nil
+}
+
+func openPackIndex(idxPath string) (*packFile, error) {
+	data, err := os.ReadFile(idxPath)
+	if err != nil {
+		return nil, err
+	}
+	const header = 8
+	if len(data) < header+256*4 || !bytes.Equal(data[:4], []byte{0xff, 't', 'O', 'c'}) || binary.BigEndian.Uint32(data[4:]) != 2 {
+		return nil, fmt.Errorf("unsupported pack index %s", idxPath)
+	}
+	p := &packFile{path: strings.TrimSuffix(idxPath, ".idx") + ".pack"}
+	for i := range p.fanout {
+		p.fanout[i] = binary.BigEndian.Uint32(data[header+i*4:])
+	}
+	n := int(p.fanout[255])
+	pos := header + 256*4
+	idSize := len(Hash{})
+	if len(data) < pos+n*(idSize+4+4) {
+		return nil, fmt.Errorf("truncated pack index %s", idxPath)
+	}
+	p.ids = data[pos : pos+n*idSize]
+	pos += n*idSize + n*4 // skip CRCs
+	p.offsets = data[pos : pos+n*4]
+	pos += n * 4
+	p.large = data[pos:]
+	return p, nil
+}
+
+// find returns the pack offset of an object.
+func (p *packFile) find(hash Hash) (int64, bool) {
+	lo := 0
+	if hash[0] > 0 {
+		lo = int(p.fanout[hash[0]-1])
+	}
+	hi := int(p.fanout[hash[0]])
+	idSize := len(hash)
+	i := lo + sort.Search(hi-lo, func(i int) bool {
+		return bytes.Compare(p.ids[(lo+i)*idSize:(lo+i+1)*idSize], hash[:]) >= 0
+	})
+	if i >= hi || !bytes.Equal(p.ids[i*idSize:(i+1)*idSize], hash[:]) {
+		return 0, false
+	}
+	off := binary.BigEndian.Uint32(p.offsets[i*4:])
+	if off&0x80000000 == 0 {
+		return int64(off), true
+	}
+	j := int(off & 0x7fffffff)
+	if (j+1)*8 > len(p.large) {
+		return 0, false
+	}
+	return int64(binary.BigEndian.Uint64(p.large[j*8:])), true
+}
+
+// Pack entry types
+const (
+	packCommit   = 1
+	packTree     = 2
+	packBlob     = 3
+	packTag      = 4
+	packOfsDelta = 6
+	packRefDelta = 7
+)
+
+// maxDeltaDepth guards against corrupt delta chains
+const maxDeltaDepth = 64
+
+// read decodes the object at offset, resolving delta chains.
+func (p *packFile) read(repo *Repository, offset int64, depth int) (string, []byte, error) {
+	if depth > maxDeltaDepth {
+		return "", nil, fmt.Errorf("delta chain too deep in %s", p.path)
+	}
+	p.mu.Lock()
+	if p.f == nil {
+		f, err := os.Open(p.path)
+		if err != nil {
+			p.mu.Unlock()
+			return "", nil, err
+		}
+		p.f = f
+	}
+	f := p.f
+	p.mu.Unlock()
+
+	// Entry header: type and inflated size, then the base reference for deltas
+	br := bufio.NewReader(io.NewSectionReader(f, offset, 1<<62))
+	c, err := br.ReadByte()
+	if err != nil {
+		return "", nil, err
+	}
+	kind := int(c>>4) & 7
+	for c&0x80 != 0 {
+		if c, err = br.ReadByte(); err != nil {
+			return "", nil, err
+		}
+	}
+
+	var baseKind string
+	var base []byte
+	switch kind {
+	case packOfsDelta:
+		var buf [10]byte
+		n := 0
+		for {
+			if n == len(buf) {
+				return "", nil, fmt.Errorf("corrupt delta offset in %s", p.path)
+			}
+			if buf[n], err = br.ReadByte(); err != nil {
+				return "", nil, err
+			}
+			n++
+			if buf[n-1]&0x80 == 0 {
+				break
+			}
+		}
+		back, _ := readOffsetVarint(buf[:n])
+		baseKind, base, err = p.read(repo, offset-int64(back), depth+1)
+	case packRefDelta:
+		var id Hash
+		if _, err := io.ReadFull(br, id[:]); err != nil {
+			return "", nil, err
+		}
+		baseKind, base, err = repo.ReadObject(id)
+	}
+	if err != nil {
+		return "", nil, err
+	}
+
+	zr, err := zlib.NewReader(br)
+	if err != nil {
+		return "", nil, err
+	}
+	defer zr.Close()
+	data, err := io.ReadAll(zr)
+	if err != nil {
+		return "", nil, err
+	}
+
+	switch kind {
+	case packCommit:
+		return ObjectCommit, data, nil
+	case packTree:
+		return ObjectTree, data, nil
+	case packBlob:
+		return ObjectBlob, data, nil
+	case packTag:
+		return ObjectTag, data, nil
+	case packOfsDelta, packRefDelta:
+		out, err := applyDelta(base, data)
+		return baseKind, out, err
+	default:
+		return "", nil, fmt.Errorf("unknown pack object type %d", kind)
+	}
+}
+
+// applyDelta applies a git delta to base.
+func applyDelta(base, delta []byte) ([]byte, error) {
+	srcSize, n := readSizeVarint(delta)
+	delta = delta[n:]
+	dstSize, n := readSizeVarint(delta)
+	delta = delta[n:]
+	if srcSize != len(base) {
+		return nil, fmt.Errorf("delta base size mismatch")
+	}
+
+	out := make([]byte, 0, dstSize)
+	for len(delta) > 0 {
+		op := delta[0]
+		delta = delta[1:]
+		switch {
+		case op&0x80 != 0:
+			// Copy from base: offset and size bytes are present per bit
+			var offset, size int
+			for i := 0; i < 4; i++ {
+				if op&(1<<i) != 0 {
+					if len(delta) == 0 {
+						return nil, fmt.Errorf("truncated delta")
+					}
+					offset |= int(delta[0]) << (8 * i)
+					delta = delta[1:]
+				}
+			}
+			for i := 0; i < 3; i++ {
+				if op&(0x10<<i) != 0 {
+					if len(delta) == 0 {
+						return nil, fmt.Errorf("truncated delta")
+					}
+					size |= int(delta[0]) << (8 * i)
+					delta = delta[1:]
+				}
+			}
+			if size == 0 {
+				size = 0x10000
+			}
+			if offset+size > len(base) {
+				return nil, fmt.Errorf("delta copy out of range")
+			}
+			out = append(out, base[offset:offset+size]...)
+		case op != 0:
+			// Insert the next op bytes literally
+			if int(op) > len(delta) {
+				return nil, fmt.Errorf("truncated delta")
+			}
+			out = append(out, delta[:op]...)
+			delta = delta[op:]
+		default:
+			return nil, fmt.Errorf("invalid delta opcode")
+		}
+	}
+	if len(out) != dstSize {
+		return nil, fmt.Errorf("delta result size mismatch")
+	}
+	return out, nil
+}
+
+// readSizeVarint decodes the little-endian size varint of delta headers.
+func readSizeVarint(b []byte) (int, int) {
+	size, shift := 0, 0
+	for i, c := range b {
+		size |= int(c&0x7f) << shift
+		shift += 7
+		if c&0x80 == 0 {
+			return size, i + 1
+		}
+	}
+	return size, len(b)
+}
+
+// Close releases open pack files.
+func (r *Repository) Close() error {
+	r.packsMu.Lock()
+	defer r.packsMu.Unlock()
+	r.closePacks()
+	return nil
+}
+
+func (r *Repository) closePacks() {
+	for _, p := range r.packs {
+		p.mu.Lock()
+		if p.f != nil {
+			p.f.Close()
+			p.f = nil
+		}
+		p.mu.Unlock()
+	}
+}
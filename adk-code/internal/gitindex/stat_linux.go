@@ -0,0 +1,17 @@
+package gitindex
+
+import (
+	"os"
+	"syscall"
+	"time"
+)
+
+// statExtra returns the stat fields git records beyond size and mtime.
+func statExtra(info os.FileInfo) (ctime time.Time, ino uint32, ok bool) {
+	st, ok := info.Sys().(*syscall.Stat_t)
+	if !ok {
+		return time.Time{}, 0, false
+	}
+	sec, nsec := st.Ctim.Unix()
+	return time.Unix(sec, nsec), uint32(st.Ino), true
+}
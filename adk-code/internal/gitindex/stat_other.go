@@ -0,0 +1,14 @@
+//go:build !linux
+
+package gitindex
+
+import (
+	"os"
+	"time"
+)
+
+// statExtra returns the stat fields git records beyond size and mtime. They
+// are not available here, so only size and mtime are compared.
+func statExtra(info os.FileInfo) (ctime time.Time, ino uint32, ok bool) {
+	return time.Time{}, 0, false
+}
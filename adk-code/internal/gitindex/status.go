@@ -0,0 +1,540 @@
+package gitindex
+
+import (
+	"os"
+	"path"
+	"path/filepath"
+	"sort"
+	"strings"
+	"sync"
+	"time"
+)
+
+// Change kinds
+const (
+	StatusAdded     = "added"
+	StatusModified  = "modified"
+	StatusDeleted   = "deleted"
+	StatusUntracked = "untracked"
+	StatusConflict  = "conflict"
+)
+
+// Change is a path whose index entry differs from HEAD (Staged) or whose
+// working tree file differs from the index (Unstaged). Untracked directories
+// are reported once, with a trailing slash, as git status does.
+type Change struct {
+	Path     string `json:"path"`
+	Staged   string `json:"staged,omitempty"`
+	Unstaged string `json:"unstaged,omitempty"`
+
+	HeadHash  Hash `json:"-"`
+	IndexHash Hash `json:"-"`
+	InHead    bool `json:"-"`
+	InIndex   bool `json:"-"`
+}
+
+// fileStamp identifies a version of a file by its stat data.
+type fileStamp struct {
+	size  int64
+	mtime time.Time
+}
+
+func stampOf(info os.FileInfo) fileStamp {
+	return fileStamp{size: info.Size(), mtime: info.ModTime()}
+}
+
+type hashedFile struct {
+	stamp fileStamp
+	hash  Hash
+}
+
+type dirListing struct {
+	mtime   time.Time
+	entries []os.DirEntry
+}
+
+type ignoreFile struct {
+	stamp fileStamp
+	rules ignoreRules
+}
+
+// Tracker computes the status of one repository's working tree and keeps it
+// up to date. The first Status call stats every tracked file and walks the
+// tree for untracked files; later calls only re-check paths reported through
+// MarkWritten, until the index or HEAD changes or MarkStale is called.
+type Tracker struct {
+	repo *Repository
+
+	mu          sync.Mutex
+	index       *Index
+	indexStamp  fileStamp
+	byPath      map[string]*Entry
+	trackedDirs map[string]bool
+	head        Hash
+	headOK      bool
+	headFiles   map[string]Hash
+
+	worktree  map[string]string // unstaged status of tracked paths that are not clean
+	untracked map[string]bool
+	scanned   bool
+	stale     bool
+	dirty     map[string]bool
+
+	hashes  map[string]hashedFile // content hashes of files whose stat data was inconclusive
+	dirs    map[string]dirListing
+	ignores map[string]ignoreFile
+}
+
+// NewTracker creates a tracker for repo.
+func NewTracker(repo *Repository) *Tracker {
+	return &Tracker{
+		repo:    repo,
+		dirty:   make(map[string]bool),
+		hashes:  make(map[string]hashedFile),
+		dirs:    make(map[string]dirListing),
+		ignores: make(map[string]ignoreFile),
+	}
+}
+
+// Repository returns the tracked repository.
+func (t *Tracker) Repository() *Repository {
+	return t.repo
+}
+
+// MarkWritten records that the file at absPath was written, so the next
+// Status call re-checks it.
+func (t *Tracker) MarkWritten(absPath string) {
+	rel, err := filepath.Rel(t.repo.Root, absPath)
+	if err != nil || rel == ".." || strings.HasPrefix(rel, ".."+string(filepath.Separator)) {
+		return
+	}
+	t.mu.Lock()
+	defer t.mu.Unlock()
+	t.dirty[filepath.ToSlash(rel)] = true
+}
+
+// MarkStale forces the next Status call to rescan the whole working tree,
+// for changes made outside the edit tools (e.g. by shell commands).
+func (t *Tracker) MarkStale() {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+	t.stale = true
+}
+
+// Status returns the changed, staged and untracked paths sorted by path.
+// refresh forces a full rescan.
+func (t *Tracker) Status(refresh bool) ([]Change, error) {
+	t.mu.Lock()
+	defer t.mu.Unlock()
+
+	indexChanged, err := t.loadIndex()
+	if err != nil {
+		return nil, err
+	}
+	headChanged, err := t.loadHead()
+	if err != nil {
+		return nil, err
+	}
+
+	if refresh || t.stale || !t.scanned || indexChanged || headChanged {
+		t.fullScan()
+	} else {
+		for rel := range t.dirty {
+			t.recheck(rel)
+		}
+	}
+	t.dirty = make(map[string]bool)
+	return t.changes(), nil
+}
+
+// loadIndex re-reads the index when its file changed.
+func (t *Tracker) loadIndex() (bool, error) {
+	var stamp fileStamp
+	if info, err := os.Stat(t.repo.IndexPath()); err == nil {
+		stamp = stampOf(info)
+	}
+	if t.index != nil && stamp == t.indexStamp {
+		return false, nil
+	}
+	index, err := ReadIndex(t.repo.IndexPath())
+	if err != nil {
+		return false, err
+	}
+	t.index, t.indexStamp = index, stamp
+	t.byPath = make(map[string]*Entry, len(index.Entries))
+	t.trackedDirs = make(map[string]bool)
+	for i := range index.Entries {
+		e := &index.Entries[i]
+		// Keep the first stage of a conflicted path
+		if _, seen := t.byPath[e.Path]; !seen {
+			t.byPath[e.Path] = e
+		}
+		for dir := path.Dir(e.Path); dir != "."; dir = path.Dir(dir) {
+			if t.trackedDirs[dir] {
+				break
+			}
+			t.trackedDirs[dir] = true
+		}
+	}
+	return true, nil
+}
+
+// loadHead resolves HEAD and flattens its tree when the commit changed.
+func (t *Tracker) loadHead() (bool, error) {
+	head, ok, err := t.repo.Head()
+	if err != nil {
+		return false, err
+	}
+	if t.headFiles != nil && ok == t.headOK && head == t.head {
+		return false, nil
+	}
+	files := make(map[string]Hash)
+	if ok {
+		if files, err = t.repo.TreeFiles(head); err != nil {
+			return false, err
+		}
+	}
+	t.head, t.headOK, t.headFiles = head, ok, files
+	return true, nil
+}
+
+func (t *Tracker) fullScan() {
+	t.worktree = make(map[string]string)
+	for i := range t.index.Entries {
+		e := &t.index.Entries[i]
+		if t.byPath[e.Path] != e {
+			continue
+		}
+		if status := t.entryStatus(e); status != "" {
+			t.worktree[e.Path] = status
+		}
+	}
+
+	t.untracked = make(map[string]bool)
+	t.walkUntracked("", t.rootRules())
+	t.scanned, t.stale = true, false
+}
+
+// recheck updates the status of one path after it was written.
+func (t *Tracker) recheck(rel string) {
+	delete(t.hashes, rel)
+	delete(t.dirs, path.Dir(rel))
+
+	if e, tracked := t.byPath[rel]; tracked {
+		if status := t.entryStatus(e); status != "" {
+			t.worktree[rel] = status
+		} else {
+			delete(t.worktree, rel)
+		}
+		return
+	}
+
+	// An untracked file is reported under its first untracked ancestor
+	key := rel
+	for dir := path.Dir(rel); dir != "."; dir = path.Dir(dir) {
+		if !t.trackedDirs[dir] {
+			key = dir + "/"
+		}
+	}
+	info, err := os.Lstat(t.abs(rel))
+	if err != nil {
+		delete(t.untracked, rel)
+		return
+	}
+	if ignored, _ := t.rulesFor(path.Dir(rel)).match(rel, info.IsDir()); ignored {
+		return
+	}
+	t.untracked[key] = true
+}
+
+// entryStatus compares a tracked file with its index entry. Stat data that
+// matches is trusted unless the entry is racily clean (modified in the same
+// instant the index was written), in which case the content is hashed.
+func (t *Tracker) entryStatus(e *Entry) string {
+	if e.Stage > 0 {
+		return StatusConflict
+	}
+	if e.AssumeValid || e.SkipTree || e.Mode == ModeGitlink {
+		return ""
+	}
+	info, err := os.Lstat(t.abs(e.Path))
+	if err != nil {
+		if os.IsNotExist(err) {
+			return StatusDeleted
+		}
+		return ""
+	}
+	if e.IntentToAdd {
+		return StatusAdded
+	}
+
+	isLink := info.Mode()&os.ModeSymlink != 0
+	if isLink != (e.Mode == ModeSymlink) || info.IsDir() {
+		return StatusModified
+	}
+	if !isLink && (e.Mode == ModeExecutable) != (info.Mode()&0o111 != 0) {
+		return StatusModified
+	}
+	// A zero size may be a racily-clean entry git smudged; only content decides
+	if e.Size != 0 && int64(e.Size) != info.Size()&0xffffffff {
+		return StatusModified
+	}
+	if t.statMatches(e, info) && e.MTime.Before(t.index.ModTime) {
+		return ""
+	}
+
+	hash, ok := t.contentHash(e.Path, info, isLink)
+	if !ok || hash == e.Hash {
+		return ""
+	}
+	return StatusModified
+}
+
+func (t *Tracker) statMatches(e *Entry, info os.FileInfo) bool {
+	mtime := info.ModTime()
+	if mtime.Unix() != e.MTime.Unix() {
+		return false
+	}
+	// Index entries written without nanoseconds compare by second
+	if e.MTime.Nanosecond() != 0 && mtime.Nanosecond() != e.MTime.Nanosecond() {
+		return false
+	}
+	if int64(e.Size) != info.Size()&0xffffffff {
+		return false
+	}
+	if ctime, ino, ok := statExtra(info); ok {
+		if ctime.Unix() != e.CTime.Unix() || (e.Ino != 0 && ino != e.Ino) {
+			return false
+		}
+		if e.CTime.Nanosecond() != 0 && ctime.Nanosecond() != e.CTime.Nanosecond() {
+			return false
+		}
+	}
+	return true
+}
+
+// contentHash hashes a file (or symlink target) as a blob, reusing the hash
+// while the file's stat data is unchanged.
+func (t *Tracker) contentHash(rel string, info os.FileInfo, isLink bool) (Hash, bool) {
+	stamp := stampOf(info)
+	if cached, ok := t.hashes[rel]; ok && cached.stamp == stamp {
+		return cached.hash, true
+	}
+	var content []byte
+	var err error
+	if isLink {
+		var target string
+		target, err = os.Readlink(t.abs(rel))
+		content = []byte(filepath.ToSlash(target))
+	} else {
+		content, err = os.ReadFile(t.abs(rel))
+	}
+	if err != nil {
+		return Hash{}, false
+	}
+	hash := BlobHash(content)
+	t.hashes[rel] = hashedFile{stamp: stamp, hash: hash}
+	return hash, true
+}
+
+// walkUntracked records untracked, non-ignored paths below dir.
+func (t *Tracker) walkUntracked(dir string, rules ignoreRules) {
+	rules = t.withIgnoreFile(dir, rules)
+	for _, entry := range t.list(dir) {
+		name := entry.Name()
+		if name == ".git" {
+			continue
+		}
+		rel := name
+		if dir != "" {
+			rel = dir + "/" + name
+		}
+		if _, tracked := t.byPath[rel]; tracked {
+			continue
+		}
+		isDir := entry.IsDir()
+		if ignored, _ := rules.match(rel, isDir); ignored {
+			continue
+		}
+		switch {
+		case isDir && t.trackedDirs[rel]:
+			t.walkUntracked(rel, rules)
+		case isDir:
+			if t.hasUntracked(rel, rules) {
+				t.untracked[rel+"/"] = true
+			}
+		default:
+			t.untracked[rel] = true
+		}
+	}
+}
+
+// hasUntracked reports whether an untracked directory holds any file that is
+// not ignored.
+func (t *Tracker) hasUntracked(dir string, rules ignoreRules) bool {
+	rules = t.withIgnoreFile(dir, rules)
+	for _, entry := range t.list(dir) {
+		rel := dir + "/" + entry.Name()
+		if entry.Name() == ".git" {
+			return true // a nested repository
+		}
+		if ignored, _ := rules.match(rel, entry.IsDir()); ignored {
+			continue
+		}
+		if !entry.IsDir() || t.hasUntracked(rel, rules) {
+			return true
+		}
+	}
+	return false
+}
+
+// list reads a directory, reusing the previous listing while the directory's
+// mtime (which changes when entries are added or removed) is unchanged.
+func (t *Tracker) list(dir string) []os.DirEntry {
+	abs := t.abs(dir)
+	info, err := os.Stat(abs)
+	if err != nil {
+		return nil
+	}
+	if cached, ok := t.dirs[dir]; ok && cached.mtime.Equal(info.ModTime()) {
+		return cached.entries
+	}
+	entries, err := os.ReadDir(abs)
+	if err != nil {
+		return nil
+	}
+	t.dirs[dir] = dirListing{mtime: info.ModTime(), entries: entries}
+	return entries
+}
+
+// rootRules returns the repository-wide exclude rules.
+func (t *Tracker) rootRules() ignoreRules {
+	return t.loadIgnoreFile(filepath.Join(t.repo.CommonDir, "info", "exclude"), "")
+}
+
+// rulesFor returns the rules that apply inside dir.
+func (t *Tracker) rulesFor(dir string) ignoreRules {
+	rules := t.withIgnoreFile("", t.rootRules())
+	if dir == "." || dir == "" {
+		return rules
+	}
+	parts := strings.Split(dir, "/")
+	for i := range parts {
+		rules = t.withIgnoreFile(strings.Join(parts[:i+1], "/"), rules)
+	}
+	return rules
+}
+
+// withIgnoreFile appends the rules of dir's .gitignore to rules.
+func (t *Tracker) withIgnoreFile(dir string, rules ignoreRules) ignoreRules {
+	own := t.loadIgnoreFile(filepath.Join(t.abs(dir), ".gitignore"), dir)
+	if len(own) == 0 {
+		return rules
+	}
+	combined := make(ignoreRules, 0, len(rules)+len(own))
+	return append(append(combined, rules...), own...)
+}
+
+func (t *Tracker) loadIgnoreFile(file, base string) ignoreRules {
+	info, err := os.Stat(file)
+	if err != nil {
+		return nil
+	}
+	stamp := stampOf(info)
+	if cached, ok := t.ignores[file]; ok && cached.stamp == stamp {
+		return cached.rules
+	}
+	rules := parseIgnoreFile(file, base)
+	t.ignores[file] = ignoreFile{stamp: stamp, rules: rules}
+	return rules
+}
+
+func (t *Tracker) abs(rel string) string {
+	return filepath.Join(t.repo.Root, filepath.FromSlash(rel))
+}
+
+// changes combines index-vs-HEAD, worktree-vs-index and untracked results.
+func (t *Tracker) changes() []Change {
+	byPath := make(map[string]*Change)
+	get := func(p string) *Change {
+		c, ok := byPath[p]
+		if !ok {
+			c = &Change{Path: p}
+			byPath[p] = c
+		}
+		return c
+	}
+
+	for p, e := range t.byPath {
+		headHash, inHead := t.headFiles[p]
+		staged := ""
+		switch {
+		case e.IntentToAdd || e.Stage > 0:
+		case !inHead:
+			staged = StatusAdded
+		case headHash != e.Hash:
+			staged = StatusModified
+		}
+		unstaged := t.worktree[p]
+		if staged == "" && unstaged == "" {
+			continue
+		}
+		c := get(p)
+		c.Staged, c.Unstaged = staged, unstaged
+		c.IndexHash, c.InIndex = e.Hash, true
+		c.HeadHash, c.InHead = headHash, inHead
+	}
+	for p, hash := range t.headFiles {
+		if _, inIndex := t.byPath[p]; !inIndex {
+			c := get(p)
+			c.Staged = StatusDeleted
+			c.HeadHash, c.InHead = hash, true
+		}
+	}
+	for p := range t.untracked {
+		get(p).Unstaged = StatusUntracked
+	}
+
+	changes := make([]Change, 0, len(byPath))
+	for _, c := range byPath {
+		changes = append(changes, *c)
+	}
+	sort.Slice(changes, func(i, j int) bool { return changes[i].Path < changes[j].Path })
+	return changes
+}
+
+var (
+	trackersMu sync.Mutex
+	trackers   = make(map[string]*Tracker)
+)
+
+// TrackerFor returns the shared tracker of the repository containing path.
+func TrackerFor(path string) (*Tracker, error) {
+	repo, err := Open(path)
+	if err != nil {
+		return nil, err
+	}
+	trackersMu.Lock()
+	defer trackersMu.Unlock()
+	if t, ok := trackers[repo.Root]; ok {
+		return t, nil
+	}
+	t := NewTracker(repo)
+	trackers[repo.Root] = t
+	return t, nil
+}
+
+// NotifyWrite tells the trackers of every open repository containing
+// absPath that it was written. An empty path means any file may have changed.
+func NotifyWrite(absPath string) {
+	trackersMu.Lock()
+	defer trackersMu.Unlock()
+	for root, t := range trackers {
+		switch {
+		case absPath == "":
+			t.MarkStale()
+		case absPath == root || strings.HasPrefix(absPath, root+string(filepath.Separator)):
+			t.MarkWritten(absPath)
+		}
+	}
+}
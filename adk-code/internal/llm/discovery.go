@@ -0,0 +1,285 @@
+// Package llm - Concurrent model discovery with an on-disk cache
+package llm
+
+import (
+	"context"
+	"encoding/json"
+	"fmt"
+	"os"
+	"path/filepath"
+	"sort"
+	"sync"
+	"time"
+
+	"adk-code/pkg/models"
+)
+
+const (
+	// DefaultDiscoveryTTL is how long discovered model lists are considered fresh
+	DefaultDiscoveryTTL = 10 * time.Minute
+	// DefaultDiscoveryTimeout bounds each provider query so one slow or
+	// unreachable backend cannot stall the others
+	DefaultDiscoveryTimeout = 3 * time.Second
+)
+
+// DiscoveryStatus describes how current a cached model list is
+type DiscoveryStatus int
+
+const (
+	// DiscoveryMissing means the provider has never been discovered successfully
+	DiscoveryMissing DiscoveryStatus = iota
+	// DiscoveryStale means cached data exists but is older than the TTL
+	DiscoveryStale
+	// DiscoveryFresh means cached data is within the TTL
+	DiscoveryFresh
+)
+
+// DiscoveryResult holds the last known models for a provider
+type DiscoveryResult struct {
+	Provider    string             `json:"provider"`
+	Models      []models.ModelInfo `json:"models"`
+	FetchedAt   time.Time          `json:"fetched_at"`
+	LastAttempt time.Time          `json:"last_attempt"`
+	Error       string             `json:"error,omitempty"`
+}
+
+// ModelDiscoveryService queries every discoverable provider concurrently and
+// keeps the results in memory and on disk, so listing commands can answer
+// instantly from cache while a background refresh brings the data up to date.
+type ModelDiscoveryService struct {
+	registry  *Registry
+	cachePath string
+	ttl       time.Duration
+	timeout   time.Duration
+
+	mu         sync.RWMutex
+	results    map[string]DiscoveryResult
+	refreshing bool
+	loadOnce   sync.Once
+
+	refreshMu sync.Mutex // serializes provider queries
+}
+
+// NewModelDiscoveryService creates a discovery service. An empty cachePath
+// disables the on-disk cache; zero durations select the defaults.
+func NewModelDiscoveryService(registry *Registry, cachePath string, ttl, timeout time.Duration) *ModelDiscoveryService {
+	if ttl == 0 {
+		ttl = DefaultDiscoveryTTL
+	}
+	if timeout == 0 {
+		timeout = DefaultDiscoveryTimeout
+	}
+	return &ModelDiscoveryService{
+		registry:  registry,
+		cachePath: cachePath,
+		ttl:       ttl,
+		timeout:   timeout,
+		results:   make(map[string]DiscoveryResult),
+	}
+}
+
+var (
+	defaultDiscovery     *ModelDiscoveryService
+	defaultDiscoveryOnce sync.Once
+)
+
+// DefaultModelDiscovery returns the process-wide discovery service, caching
+// results in ~/.code_agent/model_cache.json.
+func DefaultModelDiscovery() *ModelDiscoveryService {
+	defaultDiscoveryOnce.Do(func() {
+		cachePath := ""
+		if home, err := os.UserHomeDir(); err == nil {
+			cachePath = filepath.Join(home, ".code_agent", "model_cache.json")
+		}
+		defaultDiscovery = NewModelDiscoveryService(NewRegistry(), cachePath, 0, 0)
+	})
+	return defaultDiscovery
+}
+
+// Cached returns the last known result for a provider without any network access.
+func (s *ModelDiscoveryService) Cached(provider string) (DiscoveryResult, DiscoveryStatus) {
+	s.load()
+	s.mu.RLock()
+	defer s.mu.RUnlock()
+
+	result, ok := s.results[provider]
+	if !ok || result.FetchedAt.IsZero() {
+		return result, DiscoveryMissing
+	}
+	if time.Since(result.FetchedAt) >= s.ttl {
+		return result, DiscoveryStale
+	}
+	return result, DiscoveryFresh
+}
+
+// Refreshing reports whether a refresh is currently in flight.
+func (s *ModelDiscoveryService) Refreshing() bool {
+	s.mu.RLock()
+	defer s.mu.RUnlock()
+	return s.refreshing
+}
+
+// RefreshInBackground starts a refresh of stale providers unless one is
+// already running. It returns immediately.
+func (s *ModelDiscoveryService) RefreshInBackground(ctx context.Context) {
+	s.mu.Lock()
+	if s.refreshing {
+		s.mu.Unlock()
+		return
+	}
+	s.refreshing = true
+	s.mu.Unlock()
+
+	go func() {
+		_ = s.refresh(ctx, false)
+	}()
+}
+
+// Refresh queries providers concurrently (all of them when force is set,
+// otherwise only those whose cache is stale) and persists the results.
+func (s *ModelDiscoveryService) Refresh(ctx context.Context, force bool) error {
+	s.mu.Lock()
+	s.refreshing = true
+	s.mu.Unlock()
+	return s.refresh(ctx, force)
+}
+
+func (s *ModelDiscoveryService) refresh(ctx context.Context, force bool) error {
+	defer func() {
+		s.mu.Lock()
+		s.refreshing = false
+		s.mu.Unlock()
+	}()
+
+	s.load()
+	s.refreshMu.Lock()
+	defer s.refreshMu.Unlock()
+
+	var (
+		wg      sync.WaitGroup
+		mu      sync.Mutex
+		updates = make(map[string]DiscoveryResult)
+	)
+	for name, backend := range s.registry.providers {
+		discoverable, ok := backend.(ModelDiscovery)
+		if !ok {
+			continue
+		}
+		if _, status := s.Cached(name); !force && status == DiscoveryFresh {
+			continue
+		}
+
+		wg.Add(1)
+		go func(name string, discoverable ModelDiscovery) {
+			defer wg.Done()
+			queryCtx, cancel := context.WithTimeout(ctx, s.timeout)
+			defer cancel()
+
+			list, err := discoverable.ListModels(queryCtx, force)
+			mu.Lock()
+			updates[name] = DiscoveryResult{Provider: name, Models: list, LastAttempt: time.Now(), Error: errorString(err)}
+			mu.Unlock()
+		}(name, discoverable)
+	}
+	wg.Wait()
+
+	if len(updates) == 0 {
+		return nil
+	}
+
+	s.mu.Lock()
+	for name, update := range updates {
+		previous := s.results[name]
+		if update.Error != "" {
+			// Keep the last good model list; just record the failed attempt
+			previous.Provider = name
+			previous.LastAttempt = update.LastAttempt
+			previous.Error = update.Error
+			s.results[name] = previous
+			continue
+		}
+		update.FetchedAt = update.LastAttempt
+		s.results[name] = update
+	}
+	s.mu.Unlock()
+
+	return s.save()
+}
+
+// load reads the on-disk cache once.
+func (s *ModelDiscoveryService) load() {
+	s.loadOnce.Do(func() {
+		if s.cachePath == "" {
+			return
+		}
+		data, err := os.ReadFile(s.cachePath)
+		if err != nil {
+			return
+		}
+		var cached []DiscoveryResult
+		if err := json.Unmarshal(data, &cached); err != nil {
+			return
+		}
+		s.mu.Lock()
+		defer s.mu.Unlock()
+		for _, result := range cached {
+			if _, exists := s.results[result.Provider]; !exists {
+				s.results[result.Provider] = result
+			}
+		}
+	})
+}
+
+// save writes the cache atomically so concurrent processes never read a
+// partially written file.
+func (s *ModelDiscoveryService) save() error {
+	if s.cachePath == "" {
+		return nil
+	}
+
+	s.mu.RLock()
+	cached := make([]DiscoveryResult, 0, len(s.results))
+	for _, result := range s.results {
+		cached = append(cached, result)
+	}
+	s.mu.RUnlock()
+	sort.Slice(cached, func(i, j int) bool { return cached[i].Provider < cached[j].Provider })
+
+	data, err := json.MarshalIndent(cached, "", "  ")
+	if err != nil {
+		return fmt.Errorf("failed to encode model cache: %w", err)
+	}
+	if err := os.MkdirAll(filepath.Dir(s.cachePath), 0755); err != nil {
+		return fmt.Errorf("failed to create model cache directory: %w", err)
+	}
+	tmp := s.cachePath + ".tmp"
+	if err := os.WriteFile(tmp, data, 0644); err != nil {
+		return fmt.Errorf("failed to write model cache: %w", err)
+	}
+	if err := os.Rename(tmp, s.cachePath); err != nil {
+		return fmt.Errorf("failed to replace model cache: %w", err)
+	}
+	return nil
+}
+
+// FormatAge renders how long ago a result was fetched (e.g. "just now", "5m ago").
+func FormatAge(t time.Time) string {
+	age := time.Since(t)
+	switch {
+	case age < time.Minute:
+		return "just now"
+	case age < time.Hour:
+		return fmt.Sprintf("%dm ago", int(age.Minutes()))
+	case age < 24*time.Hour:
+		return fmt.Sprintf("%dh ago", int(age.Hours()))
+	default:
+		return fmt.Sprintf("%dd ago", int(age.Hours()/24))
+	}
+}
+
+func errorString(err error) string {
+	if err == nil {
+		return ""
+	}
+	return err.Error()
+}
@@ -0,0 +1,126 @@
+package llm
+
+import (
+	"context"
+	"errors"
+	"path/filepath"
+	"sync/atomic"
+	"testing"
+	"time"
+
+	adkmodel "google.golang.org/adk/model"
+
+	"adk-code/pkg/models"
+)
+
+// fakeDiscoveryProvider is a discoverable backend with configurable latency.
+type fakeDiscoveryProvider struct {
+	name  string
+	delay time.Duration
+	err   error
+	calls atomic.Int32
+}
+
+func (p *fakeDiscoveryProvider) Create(ctx context.Context, config any) (adkmodel.LLM, error) {
+	return nil, errors.New("not implemented")
+}
+func (p *fakeDiscoveryProvider) Validate(config any) error { return nil }
+func (p *fakeDiscoveryProvider) GetMetadata() models.ProviderMetadata {
+	return models.ProviderMetadata{Name: p.name}
+}
+func (p *fakeDiscoveryProvider) Name() string { return p.name }
+
+func (p *fakeDiscoveryProvider) ListModels(ctx context.Context, forceRefresh bool) ([]models.ModelInfo, error) {
+	p.calls.Add(1)
+	select {
+	case <-time.After(p.delay):
+	case <-ctx.Done():
+		return nil, ctx.Err()
+	}
+	if p.err != nil {
+		return nil, p.err
+	}
+	return []models.ModelInfo{{Name: p.name + "-model", Provider: p.name}}, nil
+}
+
+func (p *fakeDiscoveryProvider) GetModelInfo(ctx context.Context, modelName string) (*models.ModelInfo, error) {
+	return nil, errors.New("not implemented")
+}
+
+func newTestDiscovery(t *testing.T, providers ...ProviderBackend) (*ModelDiscoveryService, string) {
+	t.Helper()
+	registry := &Registry{providers: make(map[string]ProviderBackend)}
+	for _, p := range providers {
+		registry.Register(p)
+	}
+	cachePath := filepath.Join(t.TempDir(), "model_cache.json")
+	return NewModelDiscoveryService(registry, cachePath, time.Minute, 100*time.Millisecond), cachePath
+}
+
+func TestDiscoveryQueriesProvidersConcurrentlyWithTimeout(t *testing.T) {
+	fast := &fakeDiscoveryProvider{name: "fast", delay: 10 * time.Millisecond}
+	slow := &fakeDiscoveryProvider{name: "slow", delay: 5 * time.Second}
+	service, _ := newTestDiscovery(t, fast, slow)
+
+	start := time.Now()
+	if err := service.Refresh(context.Background(), false); err != nil {
+		t.Fatalf("Refresh failed: %v", err)
+	}
+	if elapsed := time.Since(start); elapsed > 2*time.Second {
+		t.Fatalf("slow provider stalled discovery for %v", elapsed)
+	}
+
+	if result, status := service.Cached("fast"); status != DiscoveryFresh || len(result.Models) != 1 {
+		t.Errorf("expected fresh result for fast provider, got %v %+v", status, result)
+	}
+	if result, status := service.Cached("slow"); status != DiscoveryMissing || result.Error == "" {
+		t.Errorf("expected timed out provider to be missing with an error, got %v %+v", status, result)
+	}
+}
+
+func TestDiscoveryPersistsAndSkipsFreshProviders(t *testing.T) {
+	provider := &fakeDiscoveryProvider{name: "ollama"}
+	service, cachePath := newTestDiscovery(t, provider)
+
+	if err := service.Refresh(context.Background(), false); err != nil {
+		t.Fatalf("Refresh failed: %v", err)
+	}
+	if err := service.Refresh(context.Background(), false); err != nil {
+		t.Fatalf("Refresh failed: %v", err)
+	}
+	if got := provider.calls.Load(); got != 1 {
+		t.Errorf("expected fresh cache to skip the second query, got %d calls", got)
+	}
+
+	// A new service reads the cache from disk without querying
+	registry := &Registry{providers: map[string]ProviderBackend{"ollama": provider}}
+	reloaded := NewModelDiscoveryService(registry, cachePath, time.Minute, time.Second)
+	result, status := reloaded.Cached("ollama")
+	if status != DiscoveryFresh || len(result.Models) != 1 || result.Models[0].Name != "ollama-model" {
+		t.Errorf("expected cached models from disk, got %v %+v", status, result)
+	}
+	if got := provider.calls.Load(); got != 1 {
+		t.Errorf("expected no query when reading the disk cache, got %d calls", got)
+	}
+}
+
+func TestDiscoveryKeepsLastGoodModelsOnFailure(t *testing.T) {
+	provider := &fakeDiscoveryProvider{name: "ollama"}
+	service, _ := newTestDiscovery(t, provider)
+
+	if err := service.Refresh(context.Background(), true); err != nil {
+		t.Fatalf("Refresh failed: %v", err)
+	}
+	provider.err = errors.New("connection refused")
+	if err := service.Refresh(context.Background(), true); err != nil {
+		t.Fatalf("Refresh failed: %v", err)
+	}
+
+	result, status := service.Cached("ollama")
+	if status == DiscoveryMissing || len(result.Models) != 1 {
+		t.Errorf("expected previous models to be kept, got %v %+v", status, result)
+	}
+	if result.Error != "connection refused" {
+		t.Errorf("expected failure to be recorded, got %q", result.Error)
+	}
+}
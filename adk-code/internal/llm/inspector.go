@@ -0,0 +1,328 @@
+// Package llm - Outgoing request inspection with per-part token attribution
+package llm
+
+import (
+	"context"
+	"crypto/sha256"
+	"encoding/json"
+	"fmt"
+	"iter"
+	"sync"
+	"time"
+
+	"google.golang.org/adk/model"
+	"google.golang.org/genai"
+)
+
+// Request sections, in the order they are sent
+const (
+	SectionSystem  = "system"
+	SectionTools   = "tools"
+	SectionHistory = "history"
+	SectionInput   = "input"
+)
+
+const (
+	// DefaultOversizedPartTokens flags single parts estimated above this size
+	DefaultOversizedPartTokens = 4000
+	// minDuplicateBytes ignores short parts (e.g. "ok") when looking for duplicates
+	minDuplicateBytes = 64
+	// maxInspections is how many recent requests the inspector keeps
+	maxInspections = 8
+	// previewLength bounds the text preview stored for each part
+	previewLength = 80
+)
+
+// InspectedPart is one part of an outgoing request with its estimated cost.
+type InspectedPart struct {
+	Section     string   `json:"section"`
+	Content     int      `json:"content"` // index into LLMRequest.Contents, -1 for system and tools
+	Role        string   `json:"role,omitempty"`
+	Kind        string   `json:"kind"`
+	Name        string   `json:"name,omitempty"` // tool or function name
+	Bytes       int      `json:"bytes"`
+	Tokens      int      `json:"tokens"`
+	Preview     string   `json:"preview,omitempty"`
+	Flags       []string `json:"flags,omitempty"`
+	DuplicateOf int      `json:"duplicate_of,omitempty"` // 1-based index of the first identical part
+}
+
+// SectionSummary totals the parts of one section.
+type SectionSummary struct {
+	Name   string `json:"name"`
+	Parts  int    `json:"parts"`
+	Tokens int    `json:"tokens"`
+}
+
+// RequestInspection is the breakdown of one outgoing LLMRequest.
+type RequestInspection struct {
+	Model       string           `json:"model"`
+	Time        time.Time        `json:"time"`
+	Stream      bool             `json:"stream"`
+	TotalTokens int              `json:"total_tokens"`
+	Sections    []SectionSummary `json:"sections"`
+	Parts       []InspectedPart  `json:"parts"`
+	Duplicates  int              `json:"duplicates"`
+	Oversized   int              `json:"oversized"`
+}
+
+// JSON returns the inspection as indented JSON.
+func (r *RequestInspection) JSON() ([]byte, error) {
+	return json.MarshalIndent(r, "", "  ")
+}
+
+// EstimateTokens approximates the token count of text (about 4 bytes per token).
+func EstimateTokens(bytes int) int {
+	return (bytes + 3) / 4
+}
+
+// RequestInspector keeps the breakdowns of the most recent outgoing requests.
+type RequestInspector struct {
+	mu              sync.RWMutex
+	recent          []*RequestInspection
+	OversizedTokens int
+}
+
+// NewRequestInspector creates an inspector with the default thresholds.
+func NewRequestInspector() *RequestInspector {
+	return &RequestInspector{OversizedTokens: DefaultOversizedPartTokens}
+}
+
+var (
+	defaultInspector     *RequestInspector
+	defaultInspectorOnce sync.Once
+)
+
+// DefaultRequestInspector returns the process-wide request inspector.
+func DefaultRequestInspector() *RequestInspector {
+	defaultInspectorOnce.Do(func() {
+		defaultInspector = NewRequestInspector()
+	})
+	return defaultInspector
+}
+
+// Record inspects a request and stores the result.
+func (ri *RequestInspector) Record(modelName string, req *model.LLMRequest, stream bool) *RequestInspection {
+	inspection := InspectRequest(req, ri.OversizedTokens)
+	inspection.Model = modelName
+	inspection.Stream = stream
+
+	ri.mu.Lock()
+	defer ri.mu.Unlock()
+	ri.recent = append(ri.recent, inspection)
+	if len(ri.recent) > maxInspections {
+		ri.recent = ri.recent[len(ri.recent)-maxInspections:]
+	}
+	return inspection
+}
+
+// Last returns the most recent inspection, if any.
+func (ri *RequestInspector) Last() (*RequestInspection, bool) {
+	ri.mu.RLock()
+	defer ri.mu.RUnlock()
+	if len(ri.recent) == 0 {
+		return nil, false
+	}
+	return ri.recent[len(ri.recent)-1], true
+}
+
+// InspectingLLM is a model.LLM middleware that records every outgoing request
+// before passing it on unchanged.
+type InspectingLLM struct {
+	llm       model.LLM
+	inspector *RequestInspector
+}
+
+// NewInspectingLLM wraps llm so its requests are recorded by inspector.
+func NewInspectingLLM(llm model.LLM, inspector *RequestInspector) *InspectingLLM {
+	return &InspectingLLM{llm: llm, inspector: inspector}
+}
+
+// Name returns the wrapped model's name.
+func (m *InspectingLLM) Name() string {
+	return m.llm.Name()
+}
+
+// GenerateContent records the request and delegates to the wrapped model.
+func (m *InspectingLLM) GenerateContent(ctx context.Context, req *model.LLMRequest, stream bool) iter.Seq2[*model.LLMResponse, error] {
+	if req != nil {
+		m.inspector.Record(m.llm.Name(), req, stream)
+	}
+	return m.llm.GenerateContent(ctx, req, stream)
+}
+
+// InspectRequest breaks a request into system prompt, tool schemas, history
+// and new input, estimating tokens per part and flagging parts that repeat
+// earlier ones or exceed oversizedTokens.
+func InspectRequest(req *model.LLMRequest, oversizedTokens int) *RequestInspection {
+	inspection := &RequestInspection{Time: time.Now()}
+	if oversizedTokens <= 0 {
+		oversizedTokens = DefaultOversizedPartTokens
+	}
+
+	var payloads []string // part payloads used for duplicate detection
+	add := func(part InspectedPart, payload string) {
+		part.Bytes = len(payload)
+		part.Tokens = EstimateTokens(len(payload))
+		part.Preview = preview(part.Kind, payload)
+		inspection.Parts = append(inspection.Parts, part)
+		payloads = append(payloads, payload)
+	}
+
+	if cfg := req.Config; cfg != nil {
+		if cfg.SystemInstruction != nil {
+			for _, p := range cfg.SystemInstruction.Parts {
+				if p != nil {
+					add(InspectedPart{Section: SectionSystem, Content: -1, Kind: partKind(p)}, partPayload(p))
+				}
+			}
+		}
+		for _, t := range cfg.Tools {
+			if t == nil {
+				continue
+			}
+			for _, decl := range t.FunctionDeclarations {
+				if decl == nil {
+					continue
+				}
+				add(InspectedPart{Section: SectionTools, Content: -1, Kind: "function_declaration", Name: decl.Name}, marshalPayload(decl))
+			}
+			// Built-in tools (search, code execution) have no declaration to size
+			if len(t.FunctionDeclarations) == 0 {
+				add(InspectedPart{Section: SectionTools, Content: -1, Kind: "builtin_tool"}, marshalPayload(t))
+			}
+		}
+	}
+
+	// New input is the trailing run of user contents after the last model turn
+	inputStart := len(req.Contents)
+	for inputStart > 0 {
+		c := req.Contents[inputStart-1]
+		if c == nil || c.Role != string(genai.RoleUser) {
+			break
+		}
+		inputStart--
+	}
+
+	for i, c := range req.Contents {
+		if c == nil {
+			continue
+		}
+		section := SectionHistory
+		if i >= inputStart {
+			section = SectionInput
+		}
+		for _, p := range c.Parts {
+			if p == nil {
+				continue
+			}
+			add(InspectedPart{Section: section, Content: i, Role: c.Role, Kind: partKind(p), Name: partName(p)}, partPayload(p))
+		}
+	}
+
+	// Flag duplicates and oversized parts
+	first := make(map[[sha256.Size]byte]int)
+	for i := range inspection.Parts {
+		part := &inspection.Parts[i]
+		if len(payloads[i]) >= minDuplicateBytes {
+			sum := sha256.Sum256([]byte(payloads[i]))
+			if j, seen := first[sum]; seen {
+				part.Flags = append(part.Flags, "duplicate")
+				part.DuplicateOf = j + 1
+				inspection.Duplicates++
+			} else {
+				first[sum] = i
+			}
+		}
+		if part.Tokens > oversizedTokens {
+			part.Flags = append(part.Flags, "oversized")
+			inspection.Oversized++
+		}
+	}
+
+	// Section totals in request order, omitting empty sections
+	for _, name := range []string{SectionSystem, SectionTools, SectionHistory, SectionInput} {
+		summary := SectionSummary{Name: name}
+		for _, part := range inspection.Parts {
+			if part.Section == name {
+				summary.Parts++
+				summary.Tokens += part.Tokens
+			}
+		}
+		if summary.Parts > 0 {
+			inspection.Sections = append(inspection.Sections, summary)
+			inspection.TotalTokens += summary.Tokens
+		}
+	}
+
+	return inspection
+}
+
+func partKind(p *genai.Part) string {
+	switch {
+	case p.FunctionCall != nil:
+		return "function_call"
+	case p.FunctionResponse != nil:
+		return "function_response"
+	case p.InlineData != nil:
+		return "inline_data"
+	case p.FileData != nil:
+		return "file_data"
+	case p.ExecutableCode != nil:
+		return "executable_code"
+	case p.CodeExecutionResult != nil:
+		return "code_execution_result"
+	case p.Thought:
+		return "thought"
+	default:
+		return "text"
+	}
+}
+
+func partName(p *genai.Part) string {
+	switch {
+	case p.FunctionCall != nil:
+		return p.FunctionCall.Name
+	case p.FunctionResponse != nil:
+		return p.FunctionResponse.Name
+	default:
+		return ""
+	}
+}
+
+// partPayload returns the representation of a part whose size approximates
+// what the provider is sent.
+func partPayload(p *genai.Part) string {
+	switch {
+	case p.FunctionCall != nil:
+		return p.FunctionCall.Name + marshalPayload(p.FunctionCall.Args)
+	case p.FunctionResponse != nil:
+		return p.FunctionResponse.Name + marshalPayload(p.FunctionResponse.Response)
+	case p.InlineData != nil:
+		// Binary data is billed by the provider in its own units; count its bytes
+		return string(p.InlineData.Data)
+	case p.Text != "":
+		return p.Text
+	default:
+		return marshalPayload(p)
+	}
+}
+
+func marshalPayload(v any) string {
+	data, err := json.Marshal(v)
+	if err != nil {
+		return fmt.Sprintf("%v", v)
+	}
+	return string(data)
+}
+
+func preview(kind, payload string) string {
+	if kind == "inline_data" {
+		return ""
+	}
+	runes := []rune(payload)
+	if len(runes) > previewLength {
+		return string(runes[:previewLength-3]) + "..."
+	}
+	return string(runes)
+}
@@ -0,0 +1,108 @@
+package llm
+
+import (
+	"context"
+	"encoding/json"
+	"iter"
+	"strings"
+	"testing"
+
+	"google.golang.org/adk/model"
+	"google.golang.org/genai"
+)
+
+func testRequest(input string) *model.LLMRequest {
+	return &model.LLMRequest{
+		Config: &genai.GenerateContentConfig{
+			SystemInstruction: genai.NewContentFromText("You are a coding agent.", genai.RoleUser),
+			Tools: []*genai.Tool{{FunctionDeclarations: []*genai.FunctionDeclaration{
+				{Name: "read_file", Description: "Reads a file"},
+				{Name: "grep_search", Description: "Searches files"},
+			}}},
+		},
+		Contents: []*genai.Content{
+			genai.NewContentFromText("first question", genai.RoleUser),
+			genai.NewContentFromText("first answer", "model"),
+			{Role: string(genai.RoleUser), Parts: []*genai.Part{{Text: input}, {Text: input}}},
+		},
+	}
+}
+
+func TestInspectRequestAttributesSections(t *testing.T) {
+	inspection := InspectRequest(testRequest("explain this"), 0)
+
+	want := map[string]int{SectionSystem: 1, SectionTools: 2, SectionHistory: 2, SectionInput: 2}
+	if len(inspection.Sections) != len(want) {
+		t.Fatalf("expected %d sections, got %+v", len(want), inspection.Sections)
+	}
+	total := 0
+	for _, section := range inspection.Sections {
+		if section.Parts != want[section.Name] {
+			t.Errorf("section %s: expected %d parts, got %d", section.Name, want[section.Name], section.Parts)
+		}
+		total += section.Tokens
+	}
+	if total != inspection.TotalTokens || total == 0 {
+		t.Errorf("expected section tokens to add up to %d, got %d", inspection.TotalTokens, total)
+	}
+	if inspection.Parts[1].Name != "read_file" || inspection.Parts[1].Kind != "function_declaration" {
+		t.Errorf("expected tool schema part for read_file, got %+v", inspection.Parts[1])
+	}
+}
+
+func TestInspectRequestFlagsDuplicateAndOversizedParts(t *testing.T) {
+	input := strings.Repeat("please refactor the session service ", 10)
+	inspection := InspectRequest(testRequest(input), 50)
+
+	if inspection.Duplicates != 1 {
+		t.Fatalf("expected the repeated input part to be flagged once, got %d", inspection.Duplicates)
+	}
+	last := inspection.Parts[len(inspection.Parts)-1]
+	if last.DuplicateOf != len(inspection.Parts)-1 || last.Flags[0] != "duplicate" {
+		t.Errorf("expected last part to duplicate the previous one, got %+v", last)
+	}
+	if inspection.Oversized != 2 {
+		t.Errorf("expected both input parts to exceed 50 tokens, got %d", inspection.Oversized)
+	}
+
+	data, err := inspection.JSON()
+	if err != nil {
+		t.Fatalf("JSON failed: %v", err)
+	}
+	var decoded RequestInspection
+	if err := json.Unmarshal(data, &decoded); err != nil || decoded.Duplicates != 1 {
+		t.Errorf("expected JSON dump to round-trip, got %v %+v", err, decoded)
+	}
+}
+
+type recordingLLM struct{ calls int }
+
+func (m *recordingLLM) Name() string { return "test-model" }
+func (m *recordingLLM) GenerateContent(ctx context.Context, req *model.LLMRequest, stream bool) iter.Seq2[*model.LLMResponse, error] {
+	m.calls++
+	return func(yield func(*model.LLMResponse, error) bool) {}
+}
+
+func TestInspectingLLMRecordsRequests(t *testing.T) {
+	inner := &recordingLLM{}
+	inspector := NewRequestInspector()
+	wrapped := NewInspectingLLM(inner, inspector)
+
+	if _, ok := inspector.Last(); ok {
+		t.Fatal("expected no inspection before the first request")
+	}
+	for i := 0; i < maxInspections+2; i++ {
+		wrapped.GenerateContent(context.Background(), testRequest("hi"), true)
+	}
+
+	last, ok := inspector.Last()
+	if !ok || last.Model != "test-model" || !last.Stream {
+		t.Errorf("expected last inspection for test-model, got %+v", last)
+	}
+	if inner.calls != maxInspections+2 {
+		t.Errorf("expected every request to reach the wrapped model, got %d", inner.calls)
+	}
+	if len(inspector.recent) != maxInspections {
+		t.Errorf("expected inspector to keep %d requests, got %d", maxInspections, len(inspector.recent))
+	}
+}
@@ -0,0 +1,385 @@
+// Package llm - Deterministic response cache for replays and CI
+package llm
+
+import (
+	"context"
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"fmt"
+	"io/fs"
+	"iter"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+	"sync"
+	"time"
+
+	"google.golang.org/adk/model"
+	"google.golang.org/adk/session"
+)
+
+const (
+	// DefaultResponseCacheBytes bounds the cache directory
+	DefaultResponseCacheBytes = 512 * 1024 * 1024
+	// responseCacheVersion changes when the key or entry format does,
+	// orphaning older entries until eviction removes them
+	responseCacheVersion = 1
+	// evictionTarget is the fraction of the bound eviction shrinks the cache to
+	evictionTarget = 0.9
+)
+
+// cachedResponse is a stored response: every chunk the model yielded, in
+// order, and when each arrived.
+type cachedResponse struct {
+	Version int               `json:"version"`
+	Model   string            `json:"model"`
+	Stream  bool              `json:"stream"`
+	Created time.Time         `json:"created"`
+	Offsets []time.Duration   `json:"offsets"` // arrival of each chunk after the request
+	Chunks  []json.RawMessage `json:"chunks"`  // model.LLMResponse values
+}
+
+// ResponseCacheStats counts cache activity since the cache was opened.
+type ResponseCacheStats struct {
+	Hits      int   `json:"hits"`
+	Misses    int   `json:"misses"`
+	Stores    int   `json:"stores"`
+	Evictions int   `json:"evictions"`
+	Bytes     int64 `json:"bytes"`
+	Entries   int   `json:"entries"`
+}
+
+// ResponseCache stores complete model responses on disk, one file per
+// request hash, bounded in size by evicting the least recently used.
+type ResponseCache struct {
+	dir      string
+	maxBytes int64
+
+	// LatencyScale replays hits with the recorded delays between chunks
+	// multiplied by this factor; 0 replays instantly.
+	LatencyScale float64
+
+	mu       sync.Mutex
+	stats    ResponseCacheStats
+	bypassed map[string]bool // session IDs that skip the cache
+}
+
+// OpenResponseCache opens (creating) a response cache in dir, bounded to
+// maxBytes (DefaultResponseCacheBytes if not positive).
+func OpenResponseCache(dir string, maxBytes int64) (*ResponseCache, error) {
+	if maxBytes <= 0 {
+		maxBytes = DefaultResponseCacheBytes
+	}
+	if err := os.MkdirAll(dir, 0755); err != nil {
+		return nil, fmt.Errorf("failed to create response cache: %w", err)
+	}
+	rc := &ResponseCache{dir: dir, maxBytes: maxBytes, bypassed: make(map[string]bool)}
+	for _, f := range rc.files() {
+		rc.stats.Bytes += f.size
+		rc.stats.Entries++
+	}
+	return rc, nil
+}
+
+var (
+	activeCacheMu sync.Mutex
+	activeCache   *ResponseCache
+)
+
+// SetActiveResponseCache makes rc the cache REPL commands report on.
+func SetActiveResponseCache(rc *ResponseCache) {
+	activeCacheMu.Lock()
+	defer activeCacheMu.Unlock()
+	activeCache = rc
+}
+
+// ActiveResponseCache returns the process-wide response cache, or nil when
+// caching is off.
+func ActiveResponseCache() *ResponseCache {
+	activeCacheMu.Lock()
+	defer activeCacheMu.Unlock()
+	return activeCache
+}
+
+// Dir returns the cache directory.
+func (rc *ResponseCache) Dir() string {
+	return rc.dir
+}
+
+// Stats returns the cache's counters.
+func (rc *ResponseCache) Stats() ResponseCacheStats {
+	rc.mu.Lock()
+	defer rc.mu.Unlock()
+	return rc.stats
+}
+
+// SetBypass turns the cache off (or back on) for one session: its requests
+// go to the model and their responses are not stored.
+func (rc *ResponseCache) SetBypass(sessionID string, bypass bool) {
+	rc.mu.Lock()
+	defer rc.mu.Unlock()
+	if bypass {
+		rc.bypassed[sessionID] = true
+	} else {
+		delete(rc.bypassed, sessionID)
+	}
+}
+
+// Bypassed reports whether a session skips the cache.
+func (rc *ResponseCache) Bypassed(sessionID string) bool {
+	rc.mu.Lock()
+	defer rc.mu.Unlock()
+	return rc.bypassed[sessionID]
+}
+
+// path returns the file holding the entry for key.
+func (rc *ResponseCache) path(key string) string {
+	return filepath.Join(rc.dir, key[:2], key+".json")
+}
+
+// get returns the entry for key and marks it recently used.
+func (rc *ResponseCache) get(key string) (*cachedResponse, bool) {
+	path := rc.path(key)
+	data, err := os.ReadFile(path)
+	if err != nil {
+		rc.count(func(s *ResponseCacheStats) { s.Misses++ })
+		return nil, false
+	}
+	var entry cachedResponse
+	if err := json.Unmarshal(data, &entry); err != nil || entry.Version != responseCacheVersion || len(entry.Chunks) == 0 {
+		os.Remove(path)
+		rc.count(func(s *ResponseCacheStats) { s.Misses++; s.Bytes -= int64(len(data)); s.Entries-- })
+		return nil, false
+	}
+	now := time.Now()
+	os.Chtimes(path, now, now)
+	rc.count(func(s *ResponseCacheStats) { s.Hits++ })
+	return &entry, true
+}
+
+// put stores the entry for key, then evicts if the cache is over its bound.
+func (rc *ResponseCache) put(key string, entry *cachedResponse) error {
+	data, err := json.Marshal(entry)
+	if err != nil {
+		return err
+	}
+	path := rc.path(key)
+	if err := os.MkdirAll(filepath.Dir(path), 0755); err != nil {
+		return err
+	}
+	var replaced int64 = -1
+	if info, err := os.Stat(path); err == nil {
+		replaced = info.Size()
+	}
+	tmp, err := os.CreateTemp(filepath.Dir(path), ".entry-*")
+	if err != nil {
+		return err
+	}
+	_, err = tmp.Write(data)
+	if closeErr := tmp.Close(); err == nil {
+		err = closeErr
+	}
+	if err == nil {
+		err = os.Rename(tmp.Name(), path)
+	}
+	if err != nil {
+		os.Remove(tmp.Name())
+		return err
+	}
+
+	rc.mu.Lock()
+	rc.stats.Stores++
+	rc.stats.Bytes += int64(len(data))
+	if replaced >= 0 {
+		rc.stats.Bytes -= replaced
+	} else {
+		rc.stats.Entries++
+	}
+	over := rc.stats.Bytes > rc.maxBytes
+	rc.mu.Unlock()
+	if over {
+		rc.evict()
+	}
+	return nil
+}
+
+type cacheFile struct {
+	path  string
+	size  int64
+	mtime time.Time
+}
+
+// files lists the cache entries.
+func (rc *ResponseCache) files() []cacheFile {
+	var files []cacheFile
+	filepath.WalkDir(rc.dir, func(path string, d fs.DirEntry, err error) error {
+		if err != nil || d.IsDir() || !strings.HasSuffix(path, ".json") {
+			return nil
+		}
+		if info, err := d.Info(); err == nil {
+			files = append(files, cacheFile{path: path, size: info.Size(), mtime: info.ModTime()})
+		}
+		return nil
+	})
+	return files
+}
+
+// evict deletes the least recently used entries until the cache is back
+// under evictionTarget of its bound.
+func (rc *ResponseCache) evict() {
+	files := rc.files()
+	sort.Slice(files, func(i, j int) bool { return files[i].mtime.Before(files[j].mtime) })
+	var total int64
+	for _, f := range files {
+		total += f.size
+	}
+	target := int64(float64(rc.maxBytes) * evictionTarget)
+	evicted := 0
+	for _, f := range files {
+		if total <= target {
+			break
+		}
+		if os.Remove(f.path) == nil {
+			total -= f.size
+			evicted++
+		}
+	}
+	rc.count(func(s *ResponseCacheStats) {
+		s.Evictions += evicted
+		s.Bytes = total
+		s.Entries = len(files) - evicted
+	})
+}
+
+func (rc *ResponseCache) count(update func(*ResponseCacheStats)) {
+	rc.mu.Lock()
+	defer rc.mu.Unlock()
+	update(&rc.stats)
+}
+
+// RequestKey returns the canonical hash of a request: the model, whether
+// it streams, the contents and the generation config (system instruction,
+// tool declarations, temperature and the other sampling settings). The
+// tool implementations in LLMRequest.Tools are not part of the key.
+func RequestKey(modelName string, req *model.LLMRequest, stream bool) (string, error) {
+	payload, err := json.Marshal(struct {
+		Version  int    `json:"v"`
+		Model    string `json:"model"`
+		Stream   bool   `json:"stream"`
+		Contents any    `json:"contents"`
+		Config   any    `json:"config"`
+	}{responseCacheVersion, modelName, stream, req.Contents, req.Config})
+	if err != nil {
+		return "", err
+	}
+	sum := sha256.Sum256(payload)
+	return hex.EncodeToString(sum[:]), nil
+}
+
+type cacheBypassKey struct{}
+
+// WithCacheBypass returns a context whose model requests skip the response
+// cache.
+func WithCacheBypass(ctx context.Context) context.Context {
+	return context.WithValue(ctx, cacheBypassKey{}, true)
+}
+
+// CachingLLM is a model.LLM middleware that answers repeated requests from
+// a ResponseCache, replaying every stored chunk, function calls included,
+// with the original chunk boundaries.
+type CachingLLM struct {
+	llm   model.LLM
+	cache *ResponseCache
+}
+
+// NewCachingLLM wraps llm so its responses are stored in and replayed from
+// cache.
+func NewCachingLLM(llm model.LLM, cache *ResponseCache) *CachingLLM {
+	return &CachingLLM{llm: llm, cache: cache}
+}
+
+// Name returns the wrapped model's name.
+func (m *CachingLLM) Name() string {
+	return m.llm.Name()
+}
+
+// bypass reports whether a request made with ctx skips the cache: when the
+// context asks for it, or when it is an invocation of a bypassed session.
+func (m *CachingLLM) bypass(ctx context.Context) bool {
+	if on, _ := ctx.Value(cacheBypassKey{}).(bool); on {
+		return true
+	}
+	if inv, ok := ctx.(interface{ Session() session.Session }); ok && inv.Session() != nil {
+		return m.cache.Bypassed(inv.Session().ID())
+	}
+	return false
+}
+
+// GenerateContent replays a stored response for the request if there is
+// one, and otherwise delegates to the wrapped model and stores its
+// response once it completes without error.
+func (m *CachingLLM) GenerateContent(ctx context.Context, req *model.LLMRequest, stream bool) iter.Seq2[*model.LLMResponse, error] {
+	if req == nil || m.bypass(ctx) {
+		return m.llm.GenerateContent(ctx, req, stream)
+	}
+	key, err := RequestKey(m.llm.Name(), req, stream)
+	if err != nil {
+		return m.llm.GenerateContent(ctx, req, stream)
+	}
+	if entry, ok := m.cache.get(key); ok {
+		return m.replay(ctx, entry)
+	}
+
+	return func(yield func(*model.LLMResponse, error) bool) {
+		entry := &cachedResponse{Version: responseCacheVersion, Model: m.llm.Name(), Stream: stream, Created: time.Now()}
+		complete := true
+		for resp, err := range m.llm.GenerateContent(ctx, req, stream) {
+			if err != nil || resp == nil || resp.ErrorCode != "" {
+				complete = false
+			} else if data, err := json.Marshal(resp); err == nil {
+				// Encoded before yielding, as callers may modify responses
+				entry.Offsets = append(entry.Offsets, time.Since(entry.Created))
+				entry.Chunks = append(entry.Chunks, data)
+			} else {
+				complete = false
+			}
+			if !yield(resp, err) {
+				return // a partial response is not stored
+			}
+		}
+		if complete && len(entry.Chunks) > 0 && ctx.Err() == nil {
+			m.cache.put(key, entry)
+		}
+	}
+}
+
+// replay yields a stored response's chunks, spaced by the recorded delays
+// scaled by LatencyScale.
+func (m *CachingLLM) replay(ctx context.Context, entry *cachedResponse) iter.Seq2[*model.LLMResponse, error] {
+	return func(yield func(*model.LLMResponse, error) bool) {
+		start := time.Now()
+		for i, data := range entry.Chunks {
+			if m.cache.LatencyScale > 0 && i < len(entry.Offsets) {
+				due := time.Duration(float64(entry.Offsets[i]) * m.cache.LatencyScale)
+				if wait := due - time.Since(start); wait > 0 {
+					select {
+					case <-ctx.Done():
+						yield(nil, ctx.Err())
+						return
+					case <-time.After(wait):
+					}
+				}
+			}
+			var resp model.LLMResponse
+			if err := json.Unmarshal(data, &resp); err != nil {
+				yield(nil, fmt.Errorf("corrupt cached response: %w", err))
+				return
+			}
+			if !yield(&resp, nil) {
+				return
+			}
+		}
+	}
+}
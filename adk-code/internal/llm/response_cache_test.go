@@ -0,0 +1,136 @@
+package llm
+
+import (
+	"context"
+	"iter"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"google.golang.org/adk/model"
+	"google.golang.org/genai"
+)
+
+// scriptedLLM streams a text chunk and then a function call
+type scriptedLLM struct{ calls int }
+
+func (m *scriptedLLM) Name() string { return "test-model" }
+func (m *scriptedLLM) GenerateContent(ctx context.Context, req *model.LLMRequest, stream bool) iter.Seq2[*model.LLMResponse, error] {
+	m.calls++
+	return func(yield func(*model.LLMResponse, error) bool) {
+		if !yield(&model.LLMResponse{Content: genai.NewContentFromText("Let me look.", "model"), Partial: true}, nil) {
+			return
+		}
+		time.Sleep(20 * time.Millisecond)
+		call := &genai.Content{Role: "model", Parts: []*genai.Part{genai.NewPartFromFunctionCall("read_file", map[string]any{"path": "main.go"})}}
+		yield(&model.LLMResponse{Content: call, TurnComplete: true}, nil)
+	}
+}
+
+func collect(t *testing.T, seq iter.Seq2[*model.LLMResponse, error]) []*model.LLMResponse {
+	t.Helper()
+	var responses []*model.LLMResponse
+	for resp, err := range seq {
+		if err != nil {
+			t.Fatalf("unexpected error: %v", err)
+		}
+		responses = append(responses, resp)
+	}
+	return responses
+}
+
+func TestCachingLLMReplaysResponses(t *testing.T) {
+	cache, err := OpenResponseCache(t.TempDir(), 0)
+	if err != nil {
+		t.Fatal(err)
+	}
+	inner := &scriptedLLM{}
+	cached := NewCachingLLM(inner, cache)
+	ctx := context.Background()
+
+	first := collect(t, cached.GenerateContent(ctx, testRequest("fix the bug"), true))
+	// Callers may modify what they receive; the stored copy must not change
+	first[0].Content.Parts[0].Text = "modified"
+
+	replayed := collect(t, cached.GenerateContent(ctx, testRequest("fix the bug"), true))
+	if inner.calls != 1 {
+		t.Fatalf("expected the repeated request to be served from cache, got %d model calls", inner.calls)
+	}
+	if len(replayed) != 2 || !replayed[0].Partial || replayed[0].Content.Parts[0].Text != "Let me look." {
+		t.Fatalf("expected the streamed chunks to be replayed as recorded, got %+v", replayed)
+	}
+	fc := replayed[1].Content.Parts[0].FunctionCall
+	if fc == nil || fc.Name != "read_file" || fc.Args["path"] != "main.go" || !replayed[1].TurnComplete {
+		t.Errorf("expected the function call chunk to be replayed, got %+v", replayed[1])
+	}
+
+	// A different request, the non-streaming variant, and a bypassed context miss
+	collect(t, cached.GenerateContent(ctx, testRequest("other bug"), true))
+	collect(t, cached.GenerateContent(ctx, testRequest("fix the bug"), false))
+	collect(t, cached.GenerateContent(WithCacheBypass(ctx), testRequest("fix the bug"), true))
+	if inner.calls != 4 {
+		t.Errorf("expected 4 model calls, got %d", inner.calls)
+	}
+	if stats := cache.Stats(); stats.Hits != 1 || stats.Stores != 3 || stats.Entries != 3 {
+		t.Errorf("unexpected stats %+v", stats)
+	}
+
+	// Recorded latency is replayed when asked
+	cache.LatencyScale = 1
+	start := time.Now()
+	collect(t, cached.GenerateContent(ctx, testRequest("fix the bug"), true))
+	if elapsed := time.Since(start); elapsed < 15*time.Millisecond {
+		t.Errorf("expected the replay to take the recorded time, took %v", elapsed)
+	}
+}
+
+func TestCachingLLMSkipsIncompleteResponses(t *testing.T) {
+	cache, _ := OpenResponseCache(t.TempDir(), 0)
+	inner := &scriptedLLM{}
+	cached := NewCachingLLM(inner, cache)
+
+	for range cached.GenerateContent(context.Background(), testRequest("fix the bug"), true) {
+		break // the caller stops after the first chunk
+	}
+	collect(t, cached.GenerateContent(context.Background(), testRequest("fix the bug"), true))
+	if inner.calls != 2 {
+		t.Errorf("expected a partially consumed response not to be cached, got %d model calls", inner.calls)
+	}
+}
+
+func TestResponseCacheEvictsLeastRecentlyUsed(t *testing.T) {
+	dir := t.TempDir()
+	cache, _ := OpenResponseCache(dir, 1)
+	cached := NewCachingLLM(&scriptedLLM{}, cache)
+	ctx := context.Background()
+
+	collect(t, cached.GenerateContent(ctx, testRequest("first"), true))
+	entries, _ := filepath.Glob(filepath.Join(dir, "*", "*.json"))
+	if len(entries) != 0 {
+		t.Errorf("expected entries over the size bound to be evicted, found %d", len(entries))
+	}
+
+	cache.maxBytes = 1 << 20
+	collect(t, cached.GenerateContent(ctx, testRequest("old"), true))
+	collect(t, cached.GenerateContent(ctx, testRequest("new"), true))
+	oldKey, _ := RequestKey("test-model", testRequest("old"), true)
+	newKey, _ := RequestKey("test-model", testRequest("new"), true)
+	past := time.Now().Add(-time.Hour)
+	os.Chtimes(cache.path(oldKey), past, past)
+	info, _ := os.Stat(cache.path(newKey))
+	cache.maxBytes = info.Size() + info.Size()/2
+	cache.evict()
+
+	if _, err := os.Stat(cache.path(oldKey)); !os.IsNotExist(err) {
+		t.Error("expected the least recently used entry to be evicted")
+	}
+	if _, err := os.Stat(cache.path(newKey)); err != nil {
+		t.Error("expected the recent entry to be kept")
+	}
+
+	reopened, _ := OpenResponseCache(dir, 0)
+	if stats := reopened.Stats(); stats.Entries != 1 || stats.Bytes != info.Size() {
+		t.Errorf("expected the reopened cache to count 1 entry of %d bytes, got %+v", info.Size(), stats)
+	}
+}
@@ -0,0 +1,457 @@
+package lsp
+
+import (
+	"context"
+	"crypto/sha256"
+	"encoding/json"
+	"fmt"
+	"io"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"strings"
+	"sync"
+	"time"
+)
+
+// document tracks the version of a file synchronized with the server.
+type document struct {
+	path    string
+	version int
+	hash    [sha256.Size]byte
+	modTime time.Time // on-disk state at the last sync, to notice later edits
+	size    int64
+}
+
+// diagnosticsEntry holds the latest diagnostics published for a document.
+type diagnosticsEntry struct {
+	version     *int
+	diagnostics []Diagnostic
+	seq         uint64
+}
+
+// Client is a connection to one running language server for one workspace root.
+type Client struct {
+	spec    ServerSpec
+	root    string
+	command []string
+	cmd     *exec.Cmd
+	conn    *Conn
+
+	mu      sync.Mutex
+	docs    map[string]*document
+	epoch   uint64 // incremented whenever any document changes
+	diags   map[string]diagnosticsEntry
+	diagSeq uint64
+	diagCh  chan struct{} // closed and replaced on every publish
+
+	cache *responseCache
+}
+
+// startClient launches the language server process and performs the
+// initialize handshake.
+func startClient(ctx context.Context, spec ServerSpec, root string) (*Client, error) {
+	command, ok := spec.resolveCommand()
+	if !ok {
+		return nil, fmt.Errorf("no %s language server installed (tried %v)", spec.Language, spec.Commands)
+	}
+
+	// The server outlives the request that started it, so it must not be bound to ctx
+	cmd := exec.Command(command[0], command[1:]...)
+	cmd.Dir = root
+	cmd.Stderr = io.Discard
+
+	stdin, err := cmd.StdinPipe()
+	if err != nil {
+		return nil, fmt.Errorf("failed to open stdin: %w", err)
+	}
+	stdout, err := cmd.StdoutPipe()
+	if err != nil {
+		return nil, fmt.Errorf("failed to open stdout: %w", err)
+	}
+	if err := cmd.Start(); err != nil {
+		return nil, fmt.Errorf("failed to start %s: %w", command[0], err)
+	}
+
+	c := newClient(spec, root, stdout, stdin, stdin)
+	c.cmd = cmd
+	c.command = command
+
+	if err := c.initialize(ctx); err != nil {
+		c.Close()
+		return nil, err
+	}
+	return c, nil
+}
+
+// newClient wires a client to an already-established transport.
+func newClient(spec ServerSpec, root string, r io.Reader, w io.Writer, closer io.Closer) *Client {
+	c := &Client{
+		spec:   spec,
+		root:   root,
+		docs:   make(map[string]*document),
+		diags:  make(map[string]diagnosticsEntry),
+		diagCh: make(chan struct{}),
+		cache:  newResponseCache(defaultCacheEntries),
+	}
+	c.conn = NewConn(r, w, closer, c.handleNotification)
+	return c
+}
+
+// initialize performs the LSP initialize/initialized handshake.
+func (c *Client) initialize(ctx context.Context) error {
+	params := map[string]any{
+		"processId": os.Getpid(),
+		"rootUri":   PathToURI(c.root),
+		"workspaceFolders": []map[string]string{
+			{"uri": PathToURI(c.root), "name": c.root},
+		},
+		"capabilities": map[string]any{
+			"textDocument": map[string]any{
+				"synchronization":    map[string]any{"didSave": false},
+				"definition":         map[string]any{"linkSupport": true},
+				"references":         map[string]any{},
+				"hover":              map[string]any{"contentFormat": []string{"plaintext", "markdown"}},
+				"publishDiagnostics": map[string]any{"versionSupport": true},
+			},
+			"workspace": map[string]any{
+				"symbol":           map[string]any{},
+				"workspaceFolders": true,
+				"configuration":    true,
+			},
+		},
+	}
+
+	initCtx, cancel := context.WithTimeout(ctx, 30*time.Second)
+	defer cancel()
+	if err := c.conn.Call(initCtx, "initialize", params, nil); err != nil {
+		return fmt.Errorf("%s initialize failed: %w", c.spec.Language, err)
+	}
+	return c.conn.Notify("initialized", map[string]any{})
+}
+
+// Root returns the workspace root this server was started for.
+func (c *Client) Root() string { return c.root }
+
+// Language returns the language handled by this server.
+func (c *Client) Language() string { return c.spec.Language }
+
+// Alive reports whether the server connection is still open.
+func (c *Client) Alive() bool {
+	select {
+	case <-c.conn.Done():
+		return false
+	default:
+		return true
+	}
+}
+
+// Close shuts the server down, politely first and forcefully if needed.
+func (c *Client) Close() error {
+	if c.Alive() {
+		ctx, cancel := context.WithTimeout(context.Background(), 2*time.Second)
+		_ = c.conn.Call(ctx, "shutdown", nil, nil)
+		_ = c.conn.Notify("exit", nil)
+		cancel()
+	}
+	err := c.conn.Close()
+	if c.cmd != nil && c.cmd.Process != nil {
+		done := make(chan struct{})
+		go func() {
+			_ = c.cmd.Wait()
+			close(done)
+		}()
+		select {
+		case <-done:
+		case <-time.After(2 * time.Second):
+			_ = c.cmd.Process.Kill()
+		}
+	}
+	return err
+}
+
+// handleNotification records diagnostics pushed by the server.
+func (c *Client) handleNotification(method string, params json.RawMessage) {
+	if method != "textDocument/publishDiagnostics" {
+		return
+	}
+	var p publishDiagnosticsParams
+	if err := json.Unmarshal(params, &p); err != nil {
+		return
+	}
+
+	c.mu.Lock()
+	c.diagSeq++
+	c.diags[p.URI] = diagnosticsEntry{version: p.Version, diagnostics: p.Diagnostics, seq: c.diagSeq}
+	close(c.diagCh)
+	c.diagCh = make(chan struct{})
+	c.mu.Unlock()
+}
+
+// syncDocument makes sure the server sees the current on-disk content of path
+// and returns the document version.
+func (c *Client) syncDocument(path string) (int, error) {
+	info, err := os.Stat(path)
+	if err != nil {
+		return 0, err
+	}
+	content, err := os.ReadFile(path)
+	if err != nil {
+		return 0, err
+	}
+	hash := sha256.Sum256(content)
+	uri := PathToURI(path)
+
+	c.mu.Lock()
+	doc, open := c.docs[uri]
+	if open && doc.hash == hash {
+		doc.modTime, doc.size = info.ModTime(), info.Size()
+		version := doc.version
+		c.mu.Unlock()
+		return version, nil
+	}
+	if !open {
+		doc = &document{path: path}
+		c.docs[uri] = doc
+	}
+	doc.modTime, doc.size = info.ModTime(), info.Size()
+	doc.version++
+	doc.hash = hash
+	version := doc.version
+	c.epoch++
+	c.mu.Unlock()
+
+	if !open {
+		return version, c.conn.Notify("textDocument/didOpen", map[string]any{
+			"textDocument": textDocumentItem{URI: uri, LanguageID: c.spec.Language, Version: version, Text: string(content)},
+		})
+	}
+	return version, c.conn.Notify("textDocument/didChange", map[string]any{
+		"textDocument":   versionedTextDocumentIdentifier{URI: uri, Version: version},
+		"contentChanges": []map[string]string{{"text": string(content)}},
+	})
+}
+
+// refreshOpenDocuments re-syncs every open document whose file changed on
+// disk since its last sync, and closes those that were deleted. Answers about
+// one file often depend on others, so this runs before any cached lookup.
+func (c *Client) refreshOpenDocuments() {
+	c.mu.Lock()
+	docs := make([]document, 0, len(c.docs))
+	for _, doc := range c.docs {
+		docs = append(docs, *doc)
+	}
+	c.mu.Unlock()
+
+	for _, doc := range docs {
+		info, err := os.Stat(doc.path)
+		switch {
+		case err != nil:
+			c.closeDocument(doc.path)
+		case !info.ModTime().Equal(doc.modTime) || info.Size() != doc.size:
+			_, _ = c.syncDocument(doc.path)
+		}
+	}
+}
+
+// closeDocument tells the server an open document is gone.
+func (c *Client) closeDocument(path string) {
+	uri := PathToURI(path)
+	c.mu.Lock()
+	_, open := c.docs[uri]
+	delete(c.docs, uri)
+	c.epoch++
+	c.mu.Unlock()
+	if open {
+		_ = c.conn.Notify("textDocument/didClose", map[string]any{
+			"textDocument": textDocumentIdentifier{URI: uri},
+		})
+	}
+}
+
+// FileChanged reports a file written behind the server's back. An open
+// document is re-synced; any other file under the root is announced as a
+// watched-file change. Both invalidate cached cross-file answers.
+func (c *Client) FileChanged(path string) {
+	uri := PathToURI(path)
+	c.mu.Lock()
+	_, open := c.docs[uri]
+	c.mu.Unlock()
+
+	if open {
+		if _, err := c.syncDocument(path); err != nil {
+			c.closeDocument(path)
+		}
+		return
+	}
+	if rel, err := filepath.Rel(c.root, path); err != nil || strings.HasPrefix(rel, "..") {
+		return
+	}
+
+	changeType := 2 // Changed
+	if _, err := os.Stat(path); err != nil {
+		changeType = 3 // Deleted
+	}
+	c.mu.Lock()
+	c.epoch++
+	c.mu.Unlock()
+	_ = c.conn.Notify("workspace/didChangeWatchedFiles", map[string]any{
+		"changes": []map[string]any{{"uri": uri, "type": changeType}},
+	})
+}
+
+// WorkspaceChanged reports that arbitrary files may have changed (e.g. after
+// a shell command): open documents are re-synced and cached answers dropped.
+func (c *Client) WorkspaceChanged() {
+	c.refreshOpenDocuments()
+	c.mu.Lock()
+	c.epoch++
+	c.mu.Unlock()
+}
+
+// prepareDocument re-syncs stale open documents and then path, returning the
+// version of path.
+func (c *Client) prepareDocument(path string) (int, error) {
+	c.refreshOpenDocuments()
+	return c.syncDocument(path)
+}
+
+// currentEpoch returns the workspace-wide change counter.
+func (c *Client) currentEpoch() uint64 {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.epoch
+}
+
+// cachedCall performs a request, serving repeated identical requests against
+// unchanged documents from the response cache.
+func (c *Client) cachedCall(ctx context.Context, key, method string, params any) (json.RawMessage, error) {
+	if raw, ok := c.cache.get(key); ok {
+		return raw, nil
+	}
+	var raw json.RawMessage
+	if err := c.conn.Call(ctx, method, params, &raw); err != nil {
+		return nil, err
+	}
+	c.cache.put(key, raw)
+	return raw, nil
+}
+
+// Definition returns the definition location(s) of the symbol at pos.
+func (c *Client) Definition(ctx context.Context, path string, pos Position) ([]Location, error) {
+	version, err := c.prepareDocument(path)
+	if err != nil {
+		return nil, err
+	}
+	// Definitions may live in other files, so key on the workspace epoch too
+	key := fmt.Sprintf("definition|%s|%d|%d|%d:%d", path, version, c.currentEpoch(), pos.Line, pos.Character)
+	raw, err := c.cachedCall(ctx, key, "textDocument/definition", textDocumentPositionParams{
+		TextDocument: textDocumentIdentifier{URI: PathToURI(path)},
+		Position:     pos,
+	})
+	if err != nil {
+		return nil, err
+	}
+	return decodeLocations(raw)
+}
+
+// References returns all references to the symbol at pos.
+func (c *Client) References(ctx context.Context, path string, pos Position, includeDeclaration bool) ([]Location, error) {
+	version, err := c.prepareDocument(path)
+	if err != nil {
+		return nil, err
+	}
+	key := fmt.Sprintf("references|%s|%d|%d|%d:%d|%t", path, version, c.currentEpoch(), pos.Line, pos.Character, includeDeclaration)
+	params := referenceParams{
+		TextDocument: textDocumentIdentifier{URI: PathToURI(path)},
+		Position:     pos,
+	}
+	params.Context.IncludeDeclaration = includeDeclaration
+	raw, err := c.cachedCall(ctx, key, "textDocument/references", params)
+	if err != nil {
+		return nil, err
+	}
+	return decodeLocations(raw)
+}
+
+// Hover returns the hover documentation/signature for the symbol at pos.
+func (c *Client) Hover(ctx context.Context, path string, pos Position) (string, error) {
+	version, err := c.prepareDocument(path)
+	if err != nil {
+		return "", err
+	}
+	key := fmt.Sprintf("hover|%s|%d|%d|%d:%d", path, version, c.currentEpoch(), pos.Line, pos.Character)
+	raw, err := c.cachedCall(ctx, key, "textDocument/hover", textDocumentPositionParams{
+		TextDocument: textDocumentIdentifier{URI: PathToURI(path)},
+		Position:     pos,
+	})
+	if err != nil {
+		return "", err
+	}
+	return decodeHover(raw)
+}
+
+// WorkspaceSymbols searches symbols across the workspace.
+func (c *Client) WorkspaceSymbols(ctx context.Context, query string) ([]SymbolInformation, error) {
+	c.refreshOpenDocuments()
+	key := fmt.Sprintf("symbols|%d|%s", c.currentEpoch(), query)
+	raw, err := c.cachedCall(ctx, key, "workspace/symbol", map[string]string{"query": query})
+	if err != nil {
+		return nil, err
+	}
+	if len(raw) == 0 || string(raw) == "null" {
+		return nil, nil
+	}
+	var symbols []SymbolInformation
+	if err := json.Unmarshal(raw, &symbols); err != nil {
+		return nil, fmt.Errorf("failed to decode workspace symbols: %w", err)
+	}
+	return symbols, nil
+}
+
+// Diagnostics synchronizes path and waits (up to wait) for the server to
+// publish diagnostics for the current version of the document.
+func (c *Client) Diagnostics(ctx context.Context, path string, wait time.Duration) ([]Diagnostic, error) {
+	c.mu.Lock()
+	startSeq := c.diagSeq
+	c.mu.Unlock()
+
+	version, err := c.syncDocument(path)
+	if err != nil {
+		return nil, err
+	}
+	uri := PathToURI(path)
+
+	timer := time.NewTimer(wait)
+	defer timer.Stop()
+	for {
+		c.mu.Lock()
+		entry, ok := c.diags[uri]
+		ch := c.diagCh
+		c.mu.Unlock()
+
+		if ok {
+			// Prefer an exact version match; servers without version support
+			// are accepted once they have published after our sync.
+			if entry.version != nil && *entry.version == version {
+				return entry.diagnostics, nil
+			}
+			if entry.version == nil && entry.seq > startSeq {
+				return entry.diagnostics, nil
+			}
+		}
+
+		select {
+		case <-ch:
+		case <-timer.C:
+			if ok {
+				return entry.diagnostics, nil
+			}
+			return nil, nil
+		case <-ctx.Done():
+			return nil, ctx.Err()
+		case <-c.conn.Done():
+			return nil, fmt.Errorf("%s language server exited", c.spec.Language)
+		}
+	}
+}
@@ -0,0 +1,352 @@
+package lsp
+
+import (
+	"bufio"
+	"context"
+	"encoding/json"
+	"fmt"
+	"io"
+	"net/textproto"
+	"os"
+	"path/filepath"
+	"strconv"
+	"sync"
+	"testing"
+	"time"
+)
+
+// fakeServer is an in-process language server speaking the LSP base protocol.
+type fakeServer struct {
+	t      *testing.T
+	reader *bufio.Reader
+	writer io.Writer
+
+	mu    sync.Mutex
+	calls map[string]int
+	opens []string
+}
+
+func newFakeClient(t *testing.T) (*Client, *fakeServer) {
+	t.Helper()
+	clientToServerR, clientToServerW := io.Pipe()
+	serverToClientR, serverToClientW := io.Pipe()
+
+	srv := &fakeServer{
+		t:      t,
+		reader: bufio.NewReader(clientToServerR),
+		writer: serverToClientW,
+		calls:  make(map[string]int),
+	}
+	go srv.serve()
+
+	spec, _ := SpecForLanguage("go")
+	c := newClient(spec, t.TempDir(), serverToClientR, clientToServerW, clientToServerW)
+	t.Cleanup(func() {
+		_ = c.conn.Close()
+		_ = serverToClientW.Close()
+	})
+	return c, srv
+}
+
+func (s *fakeServer) count(method string) int {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	return s.calls[method]
+}
+
+func (s *fakeServer) send(msg map[string]any) {
+	body, _ := json.Marshal(msg)
+	fmt.Fprintf(s.writer, "Content-Length: %d\r\n\r\n%s", len(body), body)
+}
+
+func (s *fakeServer) serve() {
+	tp := textproto.NewReader(s.reader)
+	for {
+		header, err := tp.ReadMIMEHeader()
+		if err != nil {
+			return
+		}
+		length, _ := strconv.Atoi(header.Get("Content-Length"))
+		body := make([]byte, length)
+		if _, err := io.ReadFull(s.reader, body); err != nil {
+			return
+		}
+		var msg struct {
+			ID     json.RawMessage `json:"id"`
+			Method string          `json:"method"`
+			Params json.RawMessage `json:"params"`
+		}
+		if err := json.Unmarshal(body, &msg); err != nil {
+			continue
+		}
+
+		s.mu.Lock()
+		s.calls[msg.Method]++
+		s.mu.Unlock()
+
+		switch msg.Method {
+		case "textDocument/didOpen", "textDocument/didChange":
+			var p struct {
+				TextDocument struct {
+					URI     string `json:"uri"`
+					Version int    `json:"version"`
+				} `json:"textDocument"`
+			}
+			_ = json.Unmarshal(msg.Params, &p)
+			s.mu.Lock()
+			s.opens = append(s.opens, p.TextDocument.URI)
+			s.mu.Unlock()
+			s.send(map[string]any{
+				"jsonrpc": "2.0",
+				"method":  "textDocument/publishDiagnostics",
+				"params": map[string]any{
+					"uri":     p.TextDocument.URI,
+					"version": p.TextDocument.Version,
+					"diagnostics": []map[string]any{{
+						"range":    map[string]any{"start": map[string]int{"line": 2, "character": 1}, "end": map[string]int{"line": 2, "character": 4}},
+						"severity": 1,
+						"message":  fmt.Sprintf("version %d", p.TextDocument.Version),
+					}},
+				},
+			})
+		case "textDocument/definition":
+			var p textDocumentPositionParams
+			_ = json.Unmarshal(msg.Params, &p)
+			s.send(map[string]any{"jsonrpc": "2.0", "id": msg.ID, "result": []map[string]any{{
+				"targetUri":            p.TextDocument.URI,
+				"targetRange":          map[string]any{"start": map[string]int{"line": 0, "character": 0}, "end": map[string]int{"line": 0, "character": 9}},
+				"targetSelectionRange": map[string]any{"start": map[string]int{"line": 0, "character": 5}, "end": map[string]int{"line": 0, "character": 9}},
+			}}})
+		case "textDocument/hover":
+			s.send(map[string]any{"jsonrpc": "2.0", "id": msg.ID, "result": map[string]any{
+				"contents": map[string]string{"kind": "markdown", "value": "func main()"},
+			}})
+		default:
+			if len(msg.ID) > 0 {
+				s.send(map[string]any{"jsonrpc": "2.0", "id": msg.ID, "result": nil})
+			}
+		}
+	}
+}
+
+func writeTempFile(t *testing.T, dir, name, content string) string {
+	t.Helper()
+	path := filepath.Join(dir, name)
+	if err := os.WriteFile(path, []byte(content), 0644); err != nil {
+		t.Fatalf("failed to write %s: %v", name, err)
+	}
+	return path
+}
+
+func TestClientDefinitionIsCachedPerVersion(t *testing.T) {
+	c, srv := newFakeClient(t)
+	ctx := context.Background()
+	path := writeTempFile(t, c.Root(), "main.go", "package main\n\nfunc main() {}\n")
+
+	for i := 0; i < 3; i++ {
+		locs, err := c.Definition(ctx, path, Position{Line: 2, Character: 6})
+		if err != nil {
+			t.Fatalf("Definition failed: %v", err)
+		}
+		if len(locs) != 1 || locs[0].Range.Start.Character != 5 {
+			t.Fatalf("unexpected locations: %+v", locs)
+		}
+	}
+	if got := srv.count("textDocument/definition"); got != 1 {
+		t.Errorf("expected 1 definition request for unchanged document, got %d", got)
+	}
+	if got := srv.count("textDocument/didOpen"); got != 1 {
+		t.Errorf("expected a single didOpen, got %d", got)
+	}
+
+	// Editing the file bumps the version and bypasses the cache
+	writeTempFile(t, c.Root(), "main.go", "package main\n\nfunc main() { println() }\n")
+	if _, err := c.Definition(ctx, path, Position{Line: 2, Character: 6}); err != nil {
+		t.Fatalf("Definition failed: %v", err)
+	}
+	if got := srv.count("textDocument/definition"); got != 2 {
+		t.Errorf("expected cache miss after edit, got %d requests", got)
+	}
+	if got := srv.count("textDocument/didChange"); got != 1 {
+		t.Errorf("expected a didChange after edit, got %d", got)
+	}
+}
+
+func TestClientHover(t *testing.T) {
+	c, _ := newFakeClient(t)
+	path := writeTempFile(t, c.Root(), "main.go", "package main\n")
+
+	text, err := c.Hover(context.Background(), path, Position{})
+	if err != nil {
+		t.Fatalf("Hover failed: %v", err)
+	}
+	if text != "func main()" {
+		t.Errorf("expected hover text 'func main()', got %q", text)
+	}
+}
+
+func TestClientDiagnosticsMatchesVersion(t *testing.T) {
+	c, _ := newFakeClient(t)
+	path := writeTempFile(t, c.Root(), "main.go", "package main\n")
+
+	diags, err := c.Diagnostics(context.Background(), path, 2*time.Second)
+	if err != nil {
+		t.Fatalf("Diagnostics failed: %v", err)
+	}
+	if len(diags) != 1 || diags[0].Message != "version 1" {
+		t.Fatalf("unexpected diagnostics: %+v", diags)
+	}
+
+	writeTempFile(t, c.Root(), "main.go", "package main\n\nvar x\n")
+	diags, err = c.Diagnostics(context.Background(), path, 2*time.Second)
+	if err != nil {
+		t.Fatalf("Diagnostics failed: %v", err)
+	}
+	if len(diags) != 1 || diags[0].Message != "version 2" {
+		t.Fatalf("expected diagnostics for version 2, got %+v", diags)
+	}
+}
+
+func TestConnCallAfterCloseFails(t *testing.T) {
+	c, _ := newFakeClient(t)
+	_ = c.conn.Close()
+
+	err := c.conn.Call(context.Background(), "workspace/symbol", map[string]string{"query": "x"}, nil)
+	if err == nil {
+		t.Fatal("expected error calling on a closed connection")
+	}
+}
+
+func TestDecodeLocationsShapes(t *testing.T) {
+	tests := []struct {
+		name string
+		raw  string
+		want int
+	}{
+		{"null", `null`, 0},
+		{"single", `{"uri":"file:///a.go","range":{"start":{"line":1,"character":2},"end":{"line":1,"character":3}}}`, 1},
+		{"list", `[{"uri":"file:///a.go","range":{}},{"uri":"file:///b.go","range":{}}]`, 2},
+		{"links", `[{"targetUri":"file:///a.go","targetRange":{},"targetSelectionRange":{}}]`, 1},
+	}
+	for _, tt := range tests {
+		t.Run(tt.name, func(t *testing.T) {
+			locs, err := decodeLocations(json.RawMessage(tt.raw))
+			if err != nil {
+				t.Fatalf("decode failed: %v", err)
+			}
+			if len(locs) != tt.want {
+				t.Errorf("expected %d locations, got %d", tt.want, len(locs))
+			}
+		})
+	}
+}
+
+func TestResponseCacheEvictsOldest(t *testing.T) {
+	cache := newResponseCache(2)
+	cache.put("a", json.RawMessage(`1`))
+	cache.put("b", json.RawMessage(`2`))
+	cache.get("a")
+	cache.put("c", json.RawMessage(`3`))
+
+	if _, ok := cache.get("b"); ok {
+		t.Error("expected least recently used entry to be evicted")
+	}
+	if _, ok := cache.get("a"); !ok {
+		t.Error("expected recently used entry to be kept")
+	}
+	if cache.len() != 2 {
+		t.Errorf("expected 2 entries, got %d", cache.len())
+	}
+}
+
+func TestURIRoundTrip(t *testing.T) {
+	path := filepath.Join(string(filepath.Separator), "tmp", "dir with space", "main.go")
+	if got := URIToPath(PathToURI(path)); got != path {
+		t.Errorf("expected %s, got %s", path, got)
+	}
+}
+
+func TestClientCacheSeesOtherFileChanges(t *testing.T) {
+	c, srv := newFakeClient(t)
+	ctx := context.Background()
+	mainPath := writeTempFile(t, c.Root(), "main.go", "package main\n\nfunc main() { helper() }\n")
+	helperPath := writeTempFile(t, c.Root(), "helper.go", "package main\n\nfunc helper() {}\n")
+	otherPath := writeTempFile(t, c.Root(), "other.go", "package main\n")
+
+	definition := func() {
+		t.Helper()
+		if _, err := c.Definition(ctx, mainPath, Position{Line: 2, Character: 15}); err != nil {
+			t.Fatalf("Definition failed: %v", err)
+		}
+	}
+	if _, err := c.Hover(ctx, helperPath, Position{}); err != nil {
+		t.Fatalf("Hover failed: %v", err)
+	}
+	definition()
+	definition()
+	if got := srv.count("textDocument/definition"); got != 1 {
+		t.Fatalf("expected the repeated definition to be cached, got %d requests", got)
+	}
+
+	// Another open document changed on disk: it is re-synced and the answer recomputed
+	writeTempFile(t, c.Root(), "helper.go", "package main\n\n// helper does nothing\nfunc helper() {}\n")
+	definition()
+	if got := srv.count("textDocument/didChange"); got != 1 {
+		t.Errorf("expected the edited open document to be re-synced, got %d didChange", got)
+	}
+	if got := srv.count("textDocument/definition"); got != 2 {
+		t.Errorf("expected a cache miss after another file changed, got %d requests", got)
+	}
+
+	// A write to a file the server has not opened is announced and also invalidates
+	c.FileChanged(otherPath)
+	definition()
+	if got := srv.count("workspace/didChangeWatchedFiles"); got != 1 {
+		t.Errorf("expected a watched-file notification, got %d", got)
+	}
+	if got := srv.count("textDocument/definition"); got != 3 {
+		t.Errorf("expected a cache miss after a reported write, got %d requests", got)
+	}
+}
+
+func TestManagerCloseStopsPendingStart(t *testing.T) {
+	release := make(chan struct{})
+	started := make(chan *Client, 1)
+	m := NewManager()
+	m.start = func(ctx context.Context, spec ServerSpec, root string) (*Client, error) {
+		c, _ := newFakeClient(t)
+		started <- c
+		<-release
+		return c, nil
+	}
+
+	result := make(chan error, 1)
+	go func() {
+		_, err := m.ClientForLanguage(context.Background(), "go")
+		result <- err
+	}()
+	c := <-started
+
+	closed := make(chan struct{})
+	go func() {
+		m.Close()
+		close(closed)
+	}()
+	select {
+	case <-closed:
+		t.Fatal("Close returned while a server was still starting")
+	case <-time.After(50 * time.Millisecond):
+	}
+	close(release)
+
+	if err := <-result; err == nil {
+		t.Error("expected the start to fail once the manager is closed")
+	}
+	<-closed
+	if c.Alive() {
+		t.Error("expected the server started during Close to be shut down")
+	}
+	if len(m.Status()) != 0 {
+		t.Error("expected no servers after Close")
+	}
+}
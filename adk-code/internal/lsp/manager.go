@@ -0,0 +1,266 @@
+package lsp
+
+import (
+	"context"
+	"fmt"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+	"sync"
+
+	"adk-code/pkg/workspace"
+)
+
+// Manager owns the language servers for a session. Servers are started lazily
+// the first time a file of their language is queried within a workspace root
+// and are kept warm until Close is called.
+type Manager struct {
+	mu        sync.Mutex
+	clients   map[string]*Client
+	starting  map[string]*startResult
+	closed    bool
+	workspace *workspace.Manager
+	start     func(ctx context.Context, spec ServerSpec, root string) (*Client, error)
+}
+
+// startResult lets concurrent callers share a single server launch.
+type startResult struct {
+	done   chan struct{}
+	client *Client
+	err    error
+}
+
+// ServerStatus describes a running language server.
+type ServerStatus struct {
+	Language string
+	Root     string
+	Command  []string
+	Alive    bool
+}
+
+// NewManager creates an empty language server manager.
+func NewManager() *Manager {
+	return &Manager{
+		clients:  make(map[string]*Client),
+		starting: make(map[string]*startResult),
+		start:    startClient,
+	}
+}
+
+// Global manager instance shared by the navigation tools
+var defaultManager = NewManager()
+
+// DefaultManager returns the session-wide language server manager.
+func DefaultManager() *Manager {
+	return defaultManager
+}
+
+// SetWorkspace makes the manager resolve server roots through the workspace
+// manager, so each WorkspaceRoot gets its own server instance.
+func (m *Manager) SetWorkspace(ws *workspace.Manager) {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	m.workspace = ws
+}
+
+// ClientForFile returns a running server for the file's language and root,
+// starting one if needed.
+func (m *Manager) ClientForFile(ctx context.Context, path string) (*Client, error) {
+	spec, ok := SpecForPath(path)
+	if !ok {
+		return nil, fmt.Errorf("no language server configured for %s files", filepath.Ext(path))
+	}
+	return m.client(ctx, spec, m.rootFor(spec, path))
+}
+
+// ClientForLanguage returns a running server for language rooted at the
+// primary workspace (or the current directory).
+func (m *Manager) ClientForLanguage(ctx context.Context, language string) (*Client, error) {
+	spec, ok := SpecForLanguage(language)
+	if !ok {
+		return nil, fmt.Errorf("unsupported language: %s", language)
+	}
+	return m.client(ctx, spec, m.defaultRoot())
+}
+
+// Status lists the servers currently managed, sorted by root and language.
+func (m *Manager) Status() []ServerStatus {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	status := make([]ServerStatus, 0, len(m.clients))
+	for _, c := range m.clients {
+		status = append(status, ServerStatus{Language: c.spec.Language, Root: c.root, Command: c.command, Alive: c.Alive()})
+	}
+	sort.Slice(status, func(i, j int) bool {
+		if status[i].Root != status[j].Root {
+			return status[i].Root < status[j].Root
+		}
+		return status[i].Language < status[j].Language
+	})
+	return status
+}
+
+// ResolvePath turns a tool path argument into an absolute path the way the
+// file tools do: @workspace:path hints and relative paths resolve through the
+// workspace roots, falling back to the current directory without a workspace.
+func (m *Manager) ResolvePath(path string) (string, error) {
+	m.mu.Lock()
+	ws := m.workspace
+	m.mu.Unlock()
+
+	if ws == nil || filepath.IsAbs(path) {
+		return filepath.Abs(path)
+	}
+	resolver := workspace.NewResolver(ws)
+	var resolved *workspace.ResolvedPath
+	var err error
+	if strings.HasPrefix(path, "@") {
+		resolved, err = resolver.ResolvePathString(path)
+	} else {
+		resolved, err = resolver.ResolvePathWithDisambiguation(path)
+	}
+	if err != nil {
+		return "", err
+	}
+	return resolved.AbsolutePath, nil
+}
+
+// NotifyWrite tells the running servers that a tool wrote path, or possibly
+// any file when path is empty, so they re-sync and drop cached answers.
+func (m *Manager) NotifyWrite(path string) {
+	m.mu.Lock()
+	clients := make([]*Client, 0, len(m.clients))
+	for _, c := range m.clients {
+		clients = append(clients, c)
+	}
+	m.mu.Unlock()
+
+	for _, c := range clients {
+		if !c.Alive() {
+			continue
+		}
+		if path == "" {
+			c.WorkspaceChanged()
+		} else {
+			c.FileChanged(path)
+		}
+	}
+}
+
+// Close shuts down every running server, including those still starting,
+// and makes later requests fail.
+func (m *Manager) Close() {
+	m.mu.Lock()
+	m.closed = true
+	clients := m.clients
+	m.clients = make(map[string]*Client)
+	pending := make([]*startResult, 0, len(m.starting))
+	for _, p := range m.starting {
+		pending = append(pending, p)
+	}
+	m.mu.Unlock()
+
+	var wg sync.WaitGroup
+	for _, c := range clients {
+		wg.Add(1)
+		go func(c *Client) {
+			defer wg.Done()
+			_ = c.Close()
+		}(c)
+	}
+	wg.Wait()
+
+	// A launch in progress closes its own client once it sees m.closed
+	for _, p := range pending {
+		<-p.done
+	}
+}
+
+// client returns the cached server for (spec, root) or launches it. Dead
+// servers are restarted transparently.
+func (m *Manager) client(ctx context.Context, spec ServerSpec, root string) (*Client, error) {
+	key := spec.Language + "|" + root
+
+	m.mu.Lock()
+	if m.closed {
+		m.mu.Unlock()
+		return nil, fmt.Errorf("language servers are shut down")
+	}
+	if c, ok := m.clients[key]; ok {
+		if c.Alive() {
+			m.mu.Unlock()
+			return c, nil
+		}
+		delete(m.clients, key)
+	}
+	if pending, ok := m.starting[key]; ok {
+		m.mu.Unlock()
+		select {
+		case <-pending.done:
+			return pending.client, pending.err
+		case <-ctx.Done():
+			return nil, ctx.Err()
+		}
+	}
+	pending := &startResult{done: make(chan struct{})}
+	m.starting[key] = pending
+	m.mu.Unlock()
+
+	pending.client, pending.err = m.start(ctx, spec, root)
+
+	var orphan *Client
+	m.mu.Lock()
+	delete(m.starting, key)
+	if pending.err == nil {
+		if m.closed {
+			orphan = pending.client
+			pending.client, pending.err = nil, fmt.Errorf("language servers are shut down")
+		} else {
+			m.clients[key] = pending.client
+		}
+	}
+	m.mu.Unlock()
+	if orphan != nil {
+		_ = orphan.Close()
+	}
+	close(pending.done)
+
+	return pending.client, pending.err
+}
+
+// rootFor picks the server root for a file: its workspace root if one
+// contains it, otherwise the nearest directory with a language root marker.
+func (m *Manager) rootFor(spec ServerSpec, path string) string {
+	m.mu.Lock()
+	ws := m.workspace
+	m.mu.Unlock()
+
+	if ws != nil {
+		if root := ws.ResolvePathToRoot(path); root != nil {
+			return root.Path
+		}
+	}
+	if root := spec.findRootByMarkers(filepath.Dir(path)); root != "" {
+		return root
+	}
+	return m.defaultRoot()
+}
+
+// defaultRoot is the primary workspace root or the current directory.
+func (m *Manager) defaultRoot() string {
+	m.mu.Lock()
+	ws := m.workspace
+	m.mu.Unlock()
+
+	if ws != nil {
+		if primary := ws.GetPrimaryRoot(); primary != nil {
+			return primary.Path
+		}
+	}
+	cwd, err := os.Getwd()
+	if err != nil {
+		return "."
+	}
+	return cwd
+}
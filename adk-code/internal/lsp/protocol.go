@@ -0,0 +1,238 @@
+// Package lsp provides a minimal Language Server Protocol client used by the
+// code navigation tools. It launches locally installed language servers
+// (gopls, pyright, rust-analyzer) per workspace root on demand, keeps them warm
+// for the rest of the session and caches responses by document version.
+package lsp
+
+import (
+	"encoding/json"
+	"net/url"
+	"path/filepath"
+	"strings"
+)
+
+// Position is a zero-based line/character offset inside a text document.
+// Character is measured in UTF-16 code units, as required by the protocol.
+type Position struct {
+	Line      int `json:"line"`
+	Character int `json:"character"`
+}
+
+// Range is a span between two positions in a text document.
+type Range struct {
+	Start Position `json:"start"`
+	End   Position `json:"end"`
+}
+
+// Location is a range inside a specific document.
+type Location struct {
+	URI   string `json:"uri"`
+	Range Range  `json:"range"`
+}
+
+// locationLink is the alternate definition result shape some servers return.
+type locationLink struct {
+	TargetURI            string `json:"targetUri"`
+	TargetRange          Range  `json:"targetRange"`
+	TargetSelectionRange Range  `json:"targetSelectionRange"`
+}
+
+// SymbolInformation describes a symbol returned by workspace/symbol.
+type SymbolInformation struct {
+	Name          string   `json:"name"`
+	Kind          int      `json:"kind"`
+	Location      Location `json:"location"`
+	ContainerName string   `json:"containerName,omitempty"`
+}
+
+// Diagnostic is a compiler or linter message published by the server.
+type Diagnostic struct {
+	Range    Range  `json:"range"`
+	Severity int    `json:"severity,omitempty"`
+	Code     any    `json:"code,omitempty"`
+	Source   string `json:"source,omitempty"`
+	Message  string `json:"message"`
+}
+
+// publishDiagnosticsParams is the payload of textDocument/publishDiagnostics.
+type publishDiagnosticsParams struct {
+	URI         string       `json:"uri"`
+	Version     *int         `json:"version,omitempty"`
+	Diagnostics []Diagnostic `json:"diagnostics"`
+}
+
+// textDocumentItem is sent with textDocument/didOpen.
+type textDocumentItem struct {
+	URI        string `json:"uri"`
+	LanguageID string `json:"languageId"`
+	Version    int    `json:"version"`
+	Text       string `json:"text"`
+}
+
+// textDocumentIdentifier identifies a document by URI.
+type textDocumentIdentifier struct {
+	URI string `json:"uri"`
+}
+
+// versionedTextDocumentIdentifier identifies a specific document version.
+type versionedTextDocumentIdentifier struct {
+	URI     string `json:"uri"`
+	Version int    `json:"version"`
+}
+
+// textDocumentPositionParams is the common shape of position-based requests.
+type textDocumentPositionParams struct {
+	TextDocument textDocumentIdentifier `json:"textDocument"`
+	Position     Position               `json:"position"`
+}
+
+// referenceParams extends textDocumentPositionParams with reference options.
+type referenceParams struct {
+	TextDocument textDocumentIdentifier `json:"textDocument"`
+	Position     Position               `json:"position"`
+	Context      struct {
+		IncludeDeclaration bool `json:"includeDeclaration"`
+	} `json:"context"`
+}
+
+// SymbolKindName returns a short human-readable name for an LSP SymbolKind.
+func SymbolKindName(kind int) string {
+	names := map[int]string{
+		1: "file", 2: "module", 3: "namespace", 4: "package", 5: "class",
+		6: "method", 7: "property", 8: "field", 9: "constructor", 10: "enum",
+		11: "interface", 12: "function", 13: "variable", 14: "constant",
+		15: "string", 16: "number", 17: "boolean", 18: "array", 19: "object",
+		20: "key", 21: "null", 22: "enum_member", 23: "struct", 24: "event",
+		25: "operator", 26: "type_parameter",
+	}
+	if name, ok := names[kind]; ok {
+		return name
+	}
+	return "symbol"
+}
+
+// SeverityName returns a short name for a diagnostic severity.
+func SeverityName(severity int) string {
+	switch severity {
+	case 1:
+		return "error"
+	case 2:
+		return "warning"
+	case 3:
+		return "info"
+	case 4:
+		return "hint"
+	default:
+		return "error"
+	}
+}
+
+// PathToURI converts an absolute filesystem path to a file:// URI.
+func PathToURI(path string) string {
+	u := url.URL{Scheme: "file", Path: filepath.ToSlash(path)}
+	if !strings.HasPrefix(u.Path, "/") {
+		// Windows drive paths need a leading slash (file:///C:/...)
+		u.Path = "/" + u.Path
+	}
+	return u.String()
+}
+
+// URIToPath converts a file:// URI back to a filesystem path.
+func URIToPath(uri string) string {
+	u, err := url.Parse(uri)
+	if err != nil || u.Scheme != "file" {
+		return uri
+	}
+	path := u.Path
+	// Strip the leading slash from Windows drive paths (/C:/...)
+	if len(path) >= 3 && path[0] == '/' && path[2] == ':' {
+		path = path[1:]
+	}
+	return filepath.FromSlash(path)
+}
+
+// decodeLocations normalizes the many shapes a definition/references result can
+// take (null, Location, []Location, []LocationLink) into a flat slice.
+func decodeLocations(raw json.RawMessage) ([]Location, error) {
+	if len(raw) == 0 || string(raw) == "null" {
+		return nil, nil
+	}
+
+	trimmed := strings.TrimSpace(string(raw))
+	if strings.HasPrefix(trimmed, "{") {
+		var single Location
+		if err := json.Unmarshal(raw, &single); err != nil {
+			return nil, err
+		}
+		return []Location{single}, nil
+	}
+
+	var items []json.RawMessage
+	if err := json.Unmarshal(raw, &items); err != nil {
+		return nil, err
+	}
+
+	locations := make([]Location, 0, len(items))
+	for _, item := range items {
+		var link locationLink
+		if err := json.Unmarshal(item, &link); err == nil && link.TargetURI != "" {
+			locations = append(locations, Location{URI: link.TargetURI, Range: link.TargetSelectionRange})
+			continue
+		}
+		var loc Location
+		if err := json.Unmarshal(item, &loc); err != nil {
+			return nil, err
+		}
+		locations = append(locations, loc)
+	}
+	return locations, nil
+}
+
+// decodeHover flattens a hover result (MarkupContent, MarkedString or a list of
+// MarkedStrings) into plain text.
+func decodeHover(raw json.RawMessage) (string, error) {
+	if len(raw) == 0 || string(raw) == "null" {
+		return "", nil
+	}
+
+	var hover struct {
+		Contents json.RawMessage `json:"contents"`
+	}
+	if err := json.Unmarshal(raw, &hover); err != nil {
+		return "", err
+	}
+	return decodeMarked(hover.Contents), nil
+}
+
+// decodeMarked handles the union types used for hover contents.
+func decodeMarked(raw json.RawMessage) string {
+	if len(raw) == 0 {
+		return ""
+	}
+
+	var text string
+	if err := json.Unmarshal(raw, &text); err == nil {
+		return text
+	}
+
+	var markup struct {
+		Kind     string `json:"kind"`
+		Language string `json:"language"`
+		Value    string `json:"value"`
+	}
+	if err := json.Unmarshal(raw, &markup); err == nil && markup.Value != "" {
+		return markup.Value
+	}
+
+	var list []json.RawMessage
+	if err := json.Unmarshal(raw, &list); err == nil {
+		parts := make([]string, 0, len(list))
+		for _, item := range list {
+			if s := decodeMarked(item); s != "" {
+				parts = append(parts, s)
+			}
+		}
+		return strings.Join(parts, "\n\n")
+	}
+	return ""
+}
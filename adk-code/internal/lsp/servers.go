@@ -0,0 +1,93 @@
+package lsp
+
+import (
+	"os"
+	"os/exec"
+	"path/filepath"
+	"strings"
+)
+
+// ServerSpec describes how to launch a language server for one language.
+type ServerSpec struct {
+	// Language is the LSP languageId sent with didOpen (e.g., "go")
+	Language string
+	// Extensions are the file extensions handled by this server
+	Extensions []string
+	// Commands are candidate command lines, tried in order until one is installed
+	Commands [][]string
+	// RootMarkers identify the project root when no workspace root applies
+	RootMarkers []string
+}
+
+// DefaultServers lists the language servers launched on demand.
+var DefaultServers = []ServerSpec{
+	{
+		Language:    "go",
+		Extensions:  []string{".go"},
+		Commands:    [][]string{{"gopls"}},
+		RootMarkers: []string{"go.work", "go.mod"},
+	},
+	{
+		Language:    "python",
+		Extensions:  []string{".py", ".pyi"},
+		Commands:    [][]string{{"pyright-langserver", "--stdio"}, {"basedpyright-langserver", "--stdio"}, {"pylsp"}},
+		RootMarkers: []string{"pyproject.toml", "setup.py", "setup.cfg", "pyrightconfig.json"},
+	},
+	{
+		Language:    "rust",
+		Extensions:  []string{".rs"},
+		Commands:    [][]string{{"rust-analyzer"}},
+		RootMarkers: []string{"Cargo.toml"},
+	},
+}
+
+// SpecForPath returns the server spec handling the file's extension.
+func SpecForPath(path string) (ServerSpec, bool) {
+	ext := strings.ToLower(filepath.Ext(path))
+	for _, spec := range DefaultServers {
+		for _, e := range spec.Extensions {
+			if e == ext {
+				return spec, true
+			}
+		}
+	}
+	return ServerSpec{}, false
+}
+
+// SpecForLanguage returns the server spec for a languageId.
+func SpecForLanguage(language string) (ServerSpec, bool) {
+	for _, spec := range DefaultServers {
+		if spec.Language == language {
+			return spec, true
+		}
+	}
+	return ServerSpec{}, false
+}
+
+// resolveCommand returns the first installed command line for the spec.
+func (s ServerSpec) resolveCommand() ([]string, bool) {
+	for _, cmd := range s.Commands {
+		if len(cmd) == 0 {
+			continue
+		}
+		if path, err := exec.LookPath(cmd[0]); err == nil {
+			return append([]string{path}, cmd[1:]...), true
+		}
+	}
+	return nil, false
+}
+
+// findRootByMarkers walks up from dir looking for one of the spec's root markers.
+func (s ServerSpec) findRootByMarkers(dir string) string {
+	for current := dir; ; current = filepath.Dir(current) {
+		for _, marker := range s.RootMarkers {
+			if _, err := os.Stat(filepath.Join(current, marker)); err == nil {
+				return current
+			}
+		}
+		parent := filepath.Dir(current)
+		if parent == current {
+			return ""
+		}
+	}
+}
@@ -4,6 +4,7 @@ import (
 	"context"
 	"fmt"
 	"os"
+	"path/filepath"
 	"strings"
 
 	"google.golang.org/adk/model"
@@ -110,8 +111,9 @@ func InitializeModelComponents(ctx context.Context, cfg *config.Config) (*ModelC
 			return nil, fmt.Errorf("openAI backend requires OPENAI_API_KEY environment variable")
 		}
 		initializer.llm, err = models.CreateOpenAIModel(ctx, models.OpenAIConfig{
-			APIKey:    openaiKey,
-			ModelName: actualModelID,
+			APIKey:       openaiKey,
+			ModelName:    actualModelID,
+			ResponsesAPI: cfg.OpenAIResponses,
 		})
 
 	case "ollama":
@@ -132,6 +134,28 @@ func InitializeModelComponents(ctx context.Context, cfg *config.Config) (*ModelC
 		return nil, fmt.Errorf("failed to create LLM model: %w", err)
 	}
 
+	// Replay identical requests from the response cache when enabled
+	if cfg.LLMCache {
+		cacheDir := cfg.LLMCacheDir
+		if cacheDir == "" {
+			home, err := os.UserHomeDir()
+			if err != nil {
+				return nil, fmt.Errorf("failed to locate response cache: %w", err)
+			}
+			cacheDir = filepath.Join(home, ".code_agent", "llm_cache")
+		}
+		cache, err := llm.OpenResponseCache(cacheDir, int64(cfg.LLMCacheSizeMB)*1024*1024)
+		if err != nil {
+			return nil, err
+		}
+		cache.LatencyScale = cfg.LLMCacheLatency
+		llm.SetActiveResponseCache(cache)
+		initializer.llm = llm.NewCachingLLM(initializer.llm, cache)
+	}
+
+	// Record outgoing requests for /inspect
+	initializer.llm = llm.NewInspectingLLM(initializer.llm, llm.DefaultRequestInspector())
+
 	return &ModelComponents{
 		Registry: initializer.registry,
 		Selected: initializer.selected,
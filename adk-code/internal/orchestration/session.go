@@ -3,6 +3,7 @@ package orchestration
 import (
 	"context"
 	"fmt"
+	"os"
 
 	"google.golang.org/adk/agent"
 	"google.golang.org/adk/model"
@@ -32,6 +33,15 @@ func InitializeSessionComponents(ctx context.Context, cfg *config.Config, ag age
 		return nil, fmt.Errorf("failed to create session manager: %w", err)
 	}
 
+	// Adaptive tool timeouts learn from runs recorded in the session database
+	timeoutPolicy := tracking.DefaultTimeoutPolicy()
+	timeoutPolicy.SetPercentile(cfg.ToolTimeoutPercentile)
+	if store := initializer.manager.ToolLatencyStore(); store != nil {
+		if err := timeoutPolicy.Load(ctx, store); err != nil {
+			fmt.Fprintf(os.Stderr, "Warning: Failed to load tool latency history: %v\n", err)
+		}
+	}
+
 	// Generate unique session name if not specified
 	if cfg.SessionName == "" {
 		cfg.SessionName = GenerateUniqueSessionName()
@@ -58,6 +68,9 @@ func InitializeSessionComponents(ctx context.Context, cfg *config.Config, ag age
 			TokenThreshold:      cfg.CompactionTokens,
 			SafetyRatio:         cfg.CompactionSafety,
 			PromptTemplate:      compaction.DefaultConfig().PromptTemplate,
+
+			RollingSummary:        cfg.CompactionRolling,
+			RollingPromptTemplate: compaction.DefaultConfig().RollingPromptTemplate,
 		}
 		sessionService = compaction.NewCompactionService(sessionService, compactionConfig)
 
@@ -10,9 +10,9 @@ import (
 	"google.golang.org/adk/agent/llmagent"
 	"google.golang.org/adk/model"
 	"google.golang.org/adk/tool"
-	"google.golang.org/adk/tool/agenttool"
 	"google.golang.org/genai"
 
+	"adk-code/internal/lsp"
 	pkgerrors "adk-code/pkg/errors"
 	"adk-code/pkg/workspace"
 	"adk-code/tools"
@@ -72,8 +72,12 @@ func createGoogleSearchSubAgent(ctx context.Context, model model.LLM) (tool.Tool
 		return nil, fmt.Errorf("failed to create google_search sub-agent: %w", err)
 	}
 
-	// Wrap the sub-agent as a tool using ADK's agent-as-tool pattern
-	wrappedTool := agenttool.New(searchAgent, &agenttool.Config{})
+	// Wrap the sub-agent in a cached search tool: repeated queries are answered
+	// from a session cache and several queries can share one sub-agent call
+	wrappedTool, err := tools.NewCachedSearchTool(searchAgent)
+	if err != nil {
+		return nil, fmt.Errorf("failed to wrap google_search sub-agent: %w", err)
+	}
 
 	return wrappedTool, nil
 }
@@ -163,6 +167,12 @@ func NewCodingAgent(ctx context.Context, cfg Config) (agentiface.Agent, error) {
 		}
 	}
 
+	// Language servers are started per workspace root on first use
+	lsp.DefaultManager().SetWorkspace(wsManager)
+
+	// Workspace-wide searches (all_roots) fan out over these roots
+	workspace.SetActive(wsManager)
+
 	// Build environment context for LLM
 	envContext, err := wsManager.BuildEnvironmentContext()
 	if err != nil {
@@ -204,6 +214,8 @@ func NewCodingAgent(ctx context.Context, cfg Config) (agentiface.Agent, error) {
 		Tools:                 registeredTools, // Use tools from registry
 		Toolsets:              cfg.MCPToolsets, // Add MCP toolsets
 		GenerateContentConfig: generateConfig,
+		// Prefetched files reach the model without being stored in history
+		BeforeModelCallbacks: []llmagent.BeforeModelCallback{injectTurnContext},
 	})
 	if err != nil {
 		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to create coding agent", err)
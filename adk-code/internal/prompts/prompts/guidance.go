@@ -13,6 +13,27 @@ const GuidanceSection = `## Tool Parameter Reference
 ❌ WRONG: offset=0, limit is not offset/limit
 ✅ CORRECT: offset=10, limit=50 reads lines 10-59
 
+**builtin_read_files** Parameters:
+- files: List of {path, offset, limit} specs (required, max 50)
+- max_lines / max_bytes: Budget shared by the whole batch (optional)
+
+✅ CORRECT: Read the 5-15 files a change touches in one builtin_read_files call instead of one builtin_read_file call each
+
+**builtin_query_data** Parameters:
+- path: JSON, JSONL or CSV/TSV file (required)
+- rows / where / select: jq-style record path, filter and projection (optional)
+- aggregate / group_by: count, sum(p), avg(p), min(p), max(p), distinct(p) (optional)
+
+❌ WRONG: Paging a 500MB JSONL file through builtin_read_file to count errors
+✅ CORRECT: builtin_query_data(path="events.jsonl", where=".level == \"error\"", group_by=".service")
+
+**builtin_experiment_start** / **builtin_experiment_apply** Parameters:
+- count: Clones to create, one per approach (1-4)
+- id / paths / force / discard_others: Clone to apply, optional subset of files, overwrite conflicts, release the rest
+
+❌ WRONG: Trying two fixes one after another in the real tree and reverting by hand
+✅ CORRECT: builtin_experiment_start(count=2), edit and test each clone with working_dir=<clone path>, then builtin_experiment_apply(id=<winner>, discard_others=true)
+
 **search_replace** Parameters:
 - path: File to modify (required)
 - diff: Text containing SEARCH/REPLACE blocks (required)
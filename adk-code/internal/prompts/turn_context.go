@@ -0,0 +1,67 @@
+package agent_prompts
+
+import (
+	"context"
+
+	agentiface "google.golang.org/adk/agent"
+	"google.golang.org/adk/model"
+	"google.golang.org/genai"
+)
+
+type turnContextKey struct{}
+
+// WithTurnContext returns a context whose model requests carry parts after the
+// user message of the current turn. The parts never reach the session history,
+// so later turns and compaction do not see them.
+func WithTurnContext(ctx context.Context, parts ...*genai.Part) context.Context {
+	if len(parts) == 0 {
+		return ctx
+	}
+	return context.WithValue(ctx, turnContextKey{}, parts)
+}
+
+// TurnContext returns the parts attached to ctx by WithTurnContext.
+func TurnContext(ctx context.Context) []*genai.Part {
+	parts, _ := ctx.Value(turnContextKey{}).([]*genai.Part)
+	return parts
+}
+
+// injectTurnContext is a before-model callback that appends the turn context
+// to the outgoing request.
+func injectTurnContext(ctx agentiface.CallbackContext, req *model.LLMRequest) (*model.LLMResponse, error) {
+	appendTurnContext(req, TurnContext(ctx))
+	return nil, nil
+}
+
+// appendTurnContext adds parts to the last user message of req, skipping the
+// function responses that also use the user role. The message is copied
+// because request contents share their parts with the session events.
+func appendTurnContext(req *model.LLMRequest, parts []*genai.Part) {
+	if len(parts) == 0 {
+		return
+	}
+	for i := len(req.Contents) - 1; i >= 0; i-- {
+		c := req.Contents[i]
+		if c == nil || c.Role != string(genai.RoleUser) || !hasUserText(c) {
+			continue
+		}
+		msg := *c
+		msg.Parts = append(append(make([]*genai.Part, 0, len(c.Parts)+len(parts)), c.Parts...), parts...)
+		req.Contents[i] = &msg
+		return
+	}
+}
+
+func hasUserText(c *genai.Content) bool {
+	for _, p := range c.Parts {
+		if p == nil || p.FunctionResponse != nil {
+			return false
+		}
+	}
+	for _, p := range c.Parts {
+		if p.Text != "" {
+			return true
+		}
+	}
+	return false
+}
@@ -0,0 +1,29 @@
+package agent_prompts
+
+import (
+	"testing"
+
+	"google.golang.org/adk/model"
+	"google.golang.org/genai"
+)
+
+func TestAppendTurnContextTargetsUserMessage(t *testing.T) {
+	user := &genai.Content{Role: string(genai.RoleUser), Parts: []*genai.Part{{Text: "explain main.go"}}}
+	call := &genai.Content{Role: string(genai.RoleModel), Parts: []*genai.Part{{FunctionCall: &genai.FunctionCall{Name: "read_file"}}}}
+	result := &genai.Content{Role: string(genai.RoleUser), Parts: []*genai.Part{{FunctionResponse: &genai.FunctionResponse{Name: "read_file"}}}}
+	req := &model.LLMRequest{Contents: []*genai.Content{user, call, result}}
+
+	appendTurnContext(req, []*genai.Part{{Text: "<prefetched_files>"}})
+
+	got := req.Contents[0]
+	if len(got.Parts) != 2 || got.Parts[1].Text != "<prefetched_files>" {
+		t.Fatalf("expected the prefetch after the user text, got %+v", got.Parts)
+	}
+	if req.Contents[2] != result {
+		t.Error("expected the function response to stay untouched")
+	}
+	// The session's own content must not change
+	if len(user.Parts) != 1 {
+		t.Errorf("expected the stored message to keep one part, got %d", len(user.Parts))
+	}
+}
@@ -0,0 +1,206 @@
+package repl
+
+import (
+	"bytes"
+	"context"
+	"fmt"
+	"os"
+	"path/filepath"
+	"regexp"
+	"strings"
+	"sync"
+
+	"google.golang.org/genai"
+
+	agentprompts "adk-code/internal/prompts"
+	"adk-code/pkg/workspace"
+)
+
+const (
+	// prefetchTokenBudget bounds the file content attached to a prompt
+	prefetchTokenBudget = 8000
+	// prefetchMaxFiles bounds how many mentioned files are read
+	prefetchMaxFiles = 8
+	// prefetchMaxFileBytes skips files too large to be worth attaching whole
+	prefetchMaxFileBytes = 256 * 1024
+)
+
+// lineSuffix matches a trailing ":line" or ":line:col" location
+var lineSuffix = regexp.MustCompile(`(:\d+)+$`)
+
+// prefetchedFile is one mentioned file read before the turn starts.
+type prefetchedFile struct {
+	Path      string // as shown to the model
+	Content   string
+	Truncated bool
+}
+
+// extractPathTokens returns the words of input that look like file paths:
+// words containing a slash or ending in a file extension, with surrounding
+// quotes, punctuation and ":line" suffixes removed. URLs are skipped, and so
+// are version numbers like "v1.2", whose "extension" has no letter.
+func extractPathTokens(input string) []string {
+	fields := strings.FieldsFunc(input, func(r rune) bool {
+		switch r {
+		case ' ', '\t', '\n', '\r', '`', '"', '\'', '(', ')', '[', ']', '<', '>', ',', ';':
+			return true
+		}
+		return false
+	})
+
+	seen := make(map[string]bool)
+	var tokens []string
+	for _, field := range fields {
+		token := strings.TrimRight(field, ".:!?")
+		token = lineSuffix.ReplaceAllString(token, "")
+		if token == "" || strings.Contains(token, "://") || seen[token] {
+			continue
+		}
+		_, path := workspace.ParseWorkspaceHint(token)
+		ext := filepath.Ext(path)
+		if !strings.Contains(path, "/") && !isFileExtension(ext) {
+			continue
+		}
+		seen[token] = true
+		tokens = append(tokens, token)
+	}
+	return tokens
+}
+
+// isFileExtension reports whether ext (with its dot) is alphanumeric and has
+// at least one letter, as in ".go" or ".mp4" but not ".2".
+func isFileExtension(ext string) bool {
+	letters := false
+	for _, r := range strings.TrimPrefix(ext, ".") {
+		switch {
+		case r >= 'a' && r <= 'z' || r >= 'A' && r <= 'Z':
+			letters = true
+		case r < '0' || r > '9':
+			return false
+		}
+	}
+	return letters
+}
+
+// prefetchFiles resolves the paths mentioned in input against the workspace,
+// reads the existing files concurrently, and returns their contents in
+// mention order within a budget of maxTokens.
+func prefetchFiles(ctx context.Context, manager *workspace.Manager, input string, maxTokens int) []prefetchedFile {
+	if manager == nil || maxTokens <= 0 {
+		return nil
+	}
+	resolver := workspace.NewResolver(manager)
+
+	type candidate struct {
+		display string
+		abs     string
+	}
+	var candidates []candidate
+	seen := make(map[string]bool)
+	for _, token := range extractPathTokens(input) {
+		if len(candidates) == prefetchMaxFiles {
+			break
+		}
+		var resolved *workspace.ResolvedPath
+		var err error
+		if hint, path := workspace.ParseWorkspaceHint(token); hint != nil {
+			resolved, err = resolver.ResolvePath(path, hint)
+		} else {
+			resolved, err = resolver.ResolvePathWithDisambiguation(token)
+		}
+		if err != nil || seen[resolved.AbsolutePath] {
+			continue
+		}
+		info, err := os.Stat(resolved.AbsolutePath)
+		if err != nil || !info.Mode().IsRegular() || info.Size() > prefetchMaxFileBytes {
+			continue
+		}
+		seen[resolved.AbsolutePath] = true
+		display := resolved.RelativePath
+		if !manager.IsSingleRoot() {
+			display = workspace.HintedPath(*resolved.Root, resolved.AbsolutePath)
+		}
+		candidates = append(candidates, candidate{display: display, abs: resolved.AbsolutePath})
+	}
+	if len(candidates) == 0 {
+		return nil
+	}
+
+	contents := make([][]byte, len(candidates))
+	var wg sync.WaitGroup
+	for i, c := range candidates {
+		wg.Add(1)
+		go func(i int, path string) {
+			defer wg.Done()
+			if ctx.Err() != nil {
+				return
+			}
+			data, err := os.ReadFile(path)
+			// Binary files are of no use as prompt context
+			if err != nil || bytes.IndexByte(data[:min(len(data), 8000)], 0) >= 0 {
+				return
+			}
+			contents[i] = data
+		}(i, c.abs)
+	}
+	wg.Wait()
+
+	remaining := maxTokens * 4
+	var files []prefetchedFile
+	for i, c := range candidates {
+		data := contents[i]
+		if data == nil {
+			continue
+		}
+		if remaining <= 0 {
+			break
+		}
+		file := prefetchedFile{Path: c.display, Content: string(data)}
+		if len(data) > remaining {
+			// Keep whole lines only
+			cut := bytes.LastIndexByte(data[:remaining], '\n')
+			if cut <= 0 {
+				break
+			}
+			file.Content = string(data[:cut+1])
+			file.Truncated = true
+		}
+		remaining -= len(file.Content)
+		files = append(files, file)
+	}
+	return files
+}
+
+// newTurn builds the user message stored in session history. Prefetched files
+// ride on the returned context instead, so only this turn's model requests see
+// them and later turns and compaction never carry them.
+func newTurn(ctx context.Context, input string, files []prefetchedFile) (context.Context, *genai.Content) {
+	msg := &genai.Content{
+		Role:  string(genai.RoleUser),
+		Parts: []*genai.Part{{Text: input}},
+	}
+	if len(files) > 0 {
+		ctx = agentprompts.WithTurnContext(ctx, prefetchPart(files))
+	}
+	return ctx, msg
+}
+
+// prefetchPart renders prefetched files as one text part for the user message.
+func prefetchPart(files []prefetchedFile) *genai.Part {
+	var b strings.Builder
+	b.WriteString("<prefetched_files>\nThe user's message mentions these files. Their current contents are included below, so there is no need to read them again unless they change.\n")
+	for _, f := range files {
+		if f.Truncated {
+			fmt.Fprintf(&b, "<file path=%q truncated=\"true\">\n", f.Path)
+		} else {
+			fmt.Fprintf(&b, "<file path=%q>\n", f.Path)
+		}
+		b.WriteString(f.Content)
+		if !strings.HasSuffix(f.Content, "\n") {
+			b.WriteByte('\n')
+		}
+		b.WriteString("</file>\n")
+	}
+	b.WriteString("</prefetched_files>")
+	return &genai.Part{Text: b.String()}
+}
@@ -0,0 +1,80 @@
+package repl
+
+import (
+	"context"
+	"os"
+	"path/filepath"
+	"reflect"
+	"strings"
+	"testing"
+
+	agentprompts "adk-code/internal/prompts"
+	"adk-code/pkg/workspace"
+)
+
+func TestExtractPathTokens(t *testing.T) {
+	input := "fix the bug in tools/web/fetch.go:42, then check `main.go` and (README.md). See https://example.com/a.go, since v1.2 or 3.14."
+	got := extractPathTokens(input)
+	want := []string{"tools/web/fetch.go", "main.go", "README.md"}
+	if !reflect.DeepEqual(got, want) {
+		t.Errorf("expected %v, got %v", want, got)
+	}
+}
+
+func TestPrefetchFiles(t *testing.T) {
+	dir := t.TempDir()
+	writeFile := func(rel, content string) {
+		path := filepath.Join(dir, rel)
+		if err := os.MkdirAll(filepath.Dir(path), 0755); err != nil {
+			t.Fatal(err)
+		}
+		if err := os.WriteFile(path, []byte(content), 0644); err != nil {
+			t.Fatal(err)
+		}
+	}
+	writeFile("tools/web/fetch.go", "package web\n")
+	writeFile("data.bin", "\x00\x01\x02")
+	writeFile("big.txt", strings.Repeat("line of text\n", 100))
+
+	manager, err := workspace.FromSingleDirectory(dir)
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	files := prefetchFiles(context.Background(), manager, "look at tools/web/fetch.go, data.bin, missing.go and tools/web/fetch.go", 1000)
+	if len(files) != 1 || files[0].Path != "tools/web/fetch.go" || files[0].Content != "package web\n" {
+		t.Fatalf("expected only fetch.go, got %+v", files)
+	}
+
+	// The budget truncates at a line boundary
+	files = prefetchFiles(context.Background(), manager, "summarize big.txt", 10)
+	if len(files) != 1 || !files[0].Truncated {
+		t.Fatalf("expected a truncated big.txt, got %+v", files)
+	}
+	if len(files[0].Content) > 40 || !strings.HasSuffix(files[0].Content, "\n") {
+		t.Errorf("expected whole lines within 40 bytes, got %q", files[0].Content)
+	}
+
+	part := prefetchPart(files)
+	if !strings.Contains(part.Text, `<file path="big.txt" truncated="true">`) {
+		t.Errorf("unexpected part text: %s", part.Text)
+	}
+}
+
+func TestNewTurnKeepsPrefetchOutOfHistory(t *testing.T) {
+	files := []prefetchedFile{{Path: "main.go", Content: "package main\n"}}
+	ctx, msg := newTurn(context.Background(), "explain main.go", files)
+
+	// The message the runner stores holds only what the user typed
+	if len(msg.Parts) != 1 || msg.Parts[0].Text != "explain main.go" {
+		t.Fatalf("expected only the user text in the stored message, got %+v", msg.Parts)
+	}
+	parts := agentprompts.TurnContext(ctx)
+	if len(parts) != 1 || !strings.Contains(parts[0].Text, `<file path="main.go">`) {
+		t.Fatalf("expected the prefetched files on the turn context, got %+v", parts)
+	}
+
+	if _, msg := newTurn(context.Background(), "hello", nil); len(msg.Parts) != 1 {
+		t.Errorf("expected a plain message without files, got %+v", msg.Parts)
+	}
+}
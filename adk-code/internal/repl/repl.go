@@ -6,12 +6,12 @@ import (
 	"os"
 	"path/filepath"
 	"strings"
+	"time"
 
 	"github.com/chzyer/readline"
 	"google.golang.org/adk/agent"
 	"google.golang.org/adk/runner"
 	sessionpkg "google.golang.org/adk/session"
-	"google.golang.org/genai"
 
 	"adk-code/internal/cli"
 	"adk-code/internal/display"
@@ -20,6 +20,7 @@ import (
 	"adk-code/internal/session/compaction"
 	"adk-code/internal/tracking"
 	"adk-code/pkg/models"
+	"adk-code/pkg/workspace"
 )
 
 // Config holds configuration for the REPL
@@ -133,12 +134,15 @@ func (r *REPL) Run(ctx context.Context) {
 
 // processUserMessage handles a user input message
 func (r *REPL) processUserMessage(ctx context.Context, input string) {
-	// Create user message
-	userMsg := &genai.Content{
-		Role: genai.RoleUser,
-		Parts: []*genai.Part{
-			{Text: input},
-		},
+	// Attach the files the prompt names so the model can skip reading them
+	files := prefetchFiles(ctx, workspace.Active(), input, prefetchTokenBudget)
+	ctx, userMsg := newTurn(ctx, input, files)
+	if len(files) > 0 {
+		paths := make([]string, len(files))
+		for i, f := range files {
+			paths[i] = f.Path
+		}
+		fmt.Printf("%s\n", r.config.Renderer.Dim("📎 Attached "+strings.Join(paths, ", ")))
 	}
 
 	// Run agent with enhanced spinner
@@ -151,8 +155,13 @@ func (r *REPL) processUserMessage(ctx context.Context, input string) {
 	hasError := false
 	var activeToolName string
 	toolRunning := false
+	printedDeltas := false
 	requestID := fmt.Sprintf("req_%d", r.config.SessionTokens.GetSummary().RequestCount+1)
 
+	// Time to first visible token for this turn
+	turnStart := time.Now()
+	var firstToken time.Duration
+
 	// Run the agent in a goroutine and receive results through a channel
 	// This allows us to respond to context cancellation while the agent is thinking
 	type eventResult struct {
@@ -162,8 +171,10 @@ func (r *REPL) processUserMessage(ctx context.Context, input string) {
 
 	eventChan := make(chan eventResult, 1)
 	go func() {
+		// SSE streaming yields partial events with text deltas as the model
+		// generates them; partial events are never persisted by the session service
 		for evt, err := range r.config.Runner.Run(ctx, r.config.UserID, r.config.SessionName, userMsg, agent.RunConfig{
-			StreamingMode: agent.StreamingModeNone,
+			StreamingMode: agent.StreamingModeSSE,
 		}) {
 			// Send result through channel (non-blocking due to buffer)
 			eventChan <- eventResult{evt, err}
@@ -204,11 +215,17 @@ agentLoop:
 			}
 
 			if result.event != nil {
-				display.PrintEventEnhanced(r.config.Renderer, r.config.StreamingDisplay, result.event, spinner, &activeToolName, &toolRunning, r.config.SessionTokens, requestID, timeline)
+				if firstToken == 0 && hasVisibleText(result.event) {
+					firstToken = time.Since(turnStart)
+				}
+				display.PrintEventEnhanced(r.config.Renderer, r.config.StreamingDisplay, result.event, spinner, &activeToolName, &toolRunning, &printedDeltas, r.config.SessionTokens, requestID, timeline)
 			}
 		}
 	}
 
+	turnDuration := time.Since(turnStart)
+	r.config.SessionTokens.RecordTurnLatency(firstToken, turnDuration)
+
 	// Trigger compaction if enabled and conditions are met
 	if !hasError && r.config.SessionManager != nil && r.config.SessionManager.Coordinator != nil {
 		ctx := context.Background()
@@ -329,6 +346,12 @@ agentLoop:
 		}
 	}
 
+	// Display responsiveness for this turn
+	if firstToken > 0 {
+		fmt.Printf("%s\n", r.config.Renderer.Dim(fmt.Sprintf("⚡ First token %s · turn %s",
+			firstToken.Round(time.Millisecond), turnDuration.Round(time.Millisecond))))
+	}
+
 	// Update prompt based on last operation status
 	if r.lastOpStatus {
 		r.readline.SetPrompt(r.config.Renderer.Green("✓ ") + r.config.Renderer.Cyan(r.config.Renderer.Bold("❯")+" "))
@@ -336,3 +359,16 @@ agentLoop:
 		r.readline.SetPrompt(r.config.Renderer.Cyan(r.config.Renderer.Bold("❯") + " "))
 	}
 }
+
+// hasVisibleText reports whether an event carries model text shown to the user.
+func hasVisibleText(event *sessionpkg.Event) bool {
+	if event.Content == nil || event.Author == "user" {
+		return false
+	}
+	for _, part := range event.Content.Parts {
+		if part != nil && part.Text != "" {
+			return true
+		}
+	}
+	return false
+}
@@ -1,12 +1,18 @@
 package compaction
 
 import (
+	"context"
 	"encoding/json"
+	"fmt"
+	"iter"
+	"strings"
 	"testing"
 	"time"
 
 	"github.com/google/uuid"
+	"google.golang.org/adk/model"
 	"google.golang.org/adk/session"
+	"google.golang.org/genai"
 )
 
 // TestCompactionMetadataStorage tests storing and retrieving compaction metadata
@@ -145,3 +151,151 @@ func TestConfigDefaults(t *testing.T) {
 		t.Error("PromptTemplate should not be empty")
 	}
 }
+
+// summaryLLM answers every request with a fixed summary and records prompts
+type summaryLLM struct {
+	summary string
+	prompts []string
+}
+
+func (m *summaryLLM) Name() string { return "test-model" }
+func (m *summaryLLM) GenerateContent(ctx context.Context, req *model.LLMRequest, stream bool) iter.Seq2[*model.LLMResponse, error] {
+	m.prompts = append(m.prompts, req.Contents[0].Parts[0].Text)
+	return func(yield func(*model.LLMResponse, error) bool) {
+		yield(&model.LLMResponse{Content: genai.NewContentFromText(m.summary, "model")}, nil)
+	}
+}
+
+// mapState is an in-memory session.State
+type mapState map[string]any
+
+func (s mapState) Get(key string) (any, error) {
+	if v, ok := s[key]; ok {
+		return v, nil
+	}
+	return nil, session.ErrStateKeyNotExist
+}
+func (s mapState) Set(key string, value any) error { s[key] = value; return nil }
+func (s mapState) All() iter.Seq2[string, any] {
+	return func(yield func(string, any) bool) {
+		for k, v := range s {
+			if !yield(k, v) {
+				return
+			}
+		}
+	}
+}
+
+// sliceEvents is an in-memory session.Events
+type sliceEvents []*session.Event
+
+func (e sliceEvents) All() iter.Seq[*session.Event] {
+	return func(yield func(*session.Event) bool) {
+		for _, event := range e {
+			if !yield(event) {
+				return
+			}
+		}
+	}
+}
+func (e sliceEvents) Len() int                { return len(e) }
+func (e sliceEvents) At(i int) *session.Event { return e[i] }
+
+// invocationEvents returns two events, a user and an agent turn, for each
+// invocation, a minute apart
+func invocationEvents(start time.Time, invocations int) []*session.Event {
+	var events []*session.Event
+	for i := 0; i < invocations; i++ {
+		id := fmt.Sprintf("inv-%d", i+1)
+		for j, author := range []string{"user", "agent"} {
+			events = append(events, &session.Event{
+				ID:           fmt.Sprintf("%s-%d", id, j),
+				InvocationID: id,
+				Author:       author,
+				Timestamp:    start.Add(time.Duration(2*i+j) * time.Minute),
+				LLMResponse:  model.LLMResponse{Content: genai.NewContentFromText(author+" turn of "+id, "user")},
+			})
+		}
+	}
+	return events
+}
+
+// TestSelectAgedOut tests that only uncovered invocations beyond the overlap are selected
+func TestSelectAgedOut(t *testing.T) {
+	start := time.Date(2025, 1, 1, 0, 0, 0, 0, time.UTC)
+	events := invocationEvents(start, 6)
+	selector := NewSelector(&Config{InvocationThreshold: 3, OverlapSize: 2})
+
+	selected := selector.SelectAgedOut(events, time.Time{})
+	if len(selected) != 8 || selected[0].InvocationID != "inv-1" || selected[7].InvocationID != "inv-4" {
+		t.Fatalf("expected inv-1..inv-4 to age out, got %d events", len(selected))
+	}
+
+	// inv-3 and inv-4 are uncovered, but fewer than the threshold
+	if selected := selector.SelectAgedOut(events, events[3].Timestamp); selected != nil {
+		t.Errorf("expected nothing below the threshold, got %d events", len(selected))
+	}
+}
+
+// TestRollingSummaryUpdates tests that each update sends only the new events
+// and produces a single superseding summary
+func TestRollingSummaryUpdates(t *testing.T) {
+	start := time.Date(2025, 1, 1, 0, 0, 0, 0, time.UTC)
+	events := invocationEvents(start, 8)
+	config := DefaultConfig()
+	config.InvocationThreshold, config.OverlapSize = 2, 1
+	llm := &summaryLLM{summary: "first summary"}
+	summarizer := NewLLMSummarizer(llm, config)
+	selector := NewSelector(config)
+	state := mapState{}
+
+	apply := func(event *session.Event) {
+		for k, v := range event.Actions.StateDelta {
+			state.Set(k, v)
+		}
+	}
+
+	first, summary, err := summarizer.SummarizeRolling(context.Background(), nil, selector.SelectAgedOut(events[:6], time.Time{}))
+	if err != nil {
+		t.Fatalf("SummarizeRolling failed: %v", err)
+	}
+	apply(first)
+	if summary.Version != 1 || summary.Text != "first summary" || summary.EventCount != 4 {
+		t.Errorf("unexpected first summary %+v", summary)
+	}
+
+	previous, err := GetRollingSummary(state)
+	if err != nil || previous == nil || !previous.EndTimestamp.Equal(events[3].Timestamp) {
+		t.Fatalf("expected the summary in state, got %+v, %v", previous, err)
+	}
+	llm.summary = "second summary"
+	delta := selector.SelectAgedOut(events, previous.EndTimestamp)
+	second, summary, err := summarizer.SummarizeRolling(context.Background(), previous, delta)
+	if err != nil {
+		t.Fatalf("SummarizeRolling failed: %v", err)
+	}
+	apply(second)
+
+	prompt := llm.prompts[1]
+	if !strings.Contains(prompt, "first summary") || strings.Contains(prompt, "turn of inv-2") || !strings.Contains(prompt, "turn of inv-7") || strings.Contains(prompt, "turn of inv-8") {
+		t.Errorf("expected the previous summary plus inv-3..inv-7 only, got:\n%s", prompt)
+	}
+	if summary.Version != 2 || !summary.StartTimestamp.Equal(start) || summary.EventCount != 14 {
+		t.Errorf("unexpected second summary %+v", summary)
+	}
+
+	// Only the latest summary and the overlap remain in context
+	all := append(append(append([]*session.Event{}, events...), first), second)
+	filtered := filterCompactedEvents(sliceEvents(all))
+	var got []string
+	for _, event := range filtered {
+		if IsCompactionEvent(event) {
+			got = append(got, event.LLMResponse.Content.Parts[0].Text)
+		} else {
+			got = append(got, event.InvocationID)
+		}
+	}
+	if want := "inv-8 inv-8 second summary"; strings.Join(got, " ") != want {
+		t.Errorf("filtered context = %q, want %q", strings.Join(got, " "), want)
+	}
+}
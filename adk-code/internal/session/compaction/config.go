@@ -14,6 +14,22 @@ Conversation History:
 %s
 `
 
+const defaultRollingPromptTemplate = `The following is a running summary of a conversation between a user and an AI agent, followed by the newest part of that conversation.
+Update the summary so it also covers the newest part, focusing on:
+1. Key decisions and outcomes
+2. Important context and state changes
+3. Unresolved questions or pending tasks
+4. Tool calls and their results
+
+Drop details that the newest part makes obsolete, such as tasks now completed. Keep the updated summary under 500 tokens while preserving critical information.
+
+Running Summary:
+%s
+
+Newest Conversation:
+%s
+`
+
 // Config holds configuration for session history compaction
 type Config struct {
 	// Invocation-based triggering
@@ -26,6 +42,11 @@ type Config struct {
 
 	// Prompt configuration
 	PromptTemplate string `json:"prompt_template"`
+
+	// Rolling summary mode: keep one summary per session and update it from
+	// the events aged out since, instead of summarizing each window apart
+	RollingSummary        bool   `json:"rolling_summary"`
+	RollingPromptTemplate string `json:"rolling_prompt_template"`
 }
 
 // DefaultConfig returns the default compaction configuration
@@ -36,5 +57,7 @@ func DefaultConfig() *Config {
 		TokenThreshold:      700000,
 		SafetyRatio:         0.7,
 		PromptTemplate:      defaultPromptTemplate,
+
+		RollingPromptTemplate: defaultRollingPromptTemplate,
 	}
 }
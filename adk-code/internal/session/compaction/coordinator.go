@@ -3,6 +3,7 @@ package compaction
 import (
 	"context"
 	"fmt"
+	"time"
 
 	"google.golang.org/adk/model"
 	"google.golang.org/adk/session"
@@ -47,6 +48,10 @@ func (c *Coordinator) RunCompaction(
 		eventList = append(eventList, event)
 	}
 
+	if c.config.RollingSummary {
+		return c.runRollingCompaction(ctx, sess, eventList)
+	}
+
 	// Select events to compact
 	toCompact, err := c.selector.SelectEventsToCompact(eventList)
 	if err != nil {
@@ -71,3 +76,36 @@ func (c *Coordinator) RunCompaction(
 	// Original events remain in storage
 	return c.sessionService.AppendEvent(ctx, sess, compactionEvent)
 }
+
+// runRollingCompaction updates the session's rolling summary with the events
+// aged out since it was last updated, so each call costs input proportional
+// to the new events rather than the window.
+func (c *Coordinator) runRollingCompaction(
+	ctx context.Context,
+	sess session.Session,
+	eventList []*session.Event,
+) error {
+	previous, err := GetRollingSummary(sess.State())
+	if err != nil {
+		return fmt.Errorf("error reading rolling summary: %w", err)
+	}
+	var since time.Time
+	if previous != nil {
+		since = previous.EndTimestamp
+	}
+
+	toCompact := c.selector.SelectAgedOut(eventList, since)
+	if len(toCompact) == 0 {
+		return nil // No compaction needed
+	}
+
+	summarizer := NewLLMSummarizer(c.agentLLM, c.config)
+	compactionEvent, _, err := summarizer.SummarizeRolling(ctx, previous, toCompact)
+	if err != nil {
+		return fmt.Errorf("error summarizing events: %w", err)
+	}
+
+	// The event supersedes the previous summary event and, through its state
+	// delta, replaces the stored summary
+	return c.sessionService.AppendEvent(ctx, sess, compactionEvent)
+}
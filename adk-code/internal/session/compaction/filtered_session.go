@@ -103,6 +103,7 @@ func filterCompactedEvents(events session.Events) []*session.Event {
 		end   time.Time
 	}
 	compactionRanges := make([]timeRange, 0)
+	compactionEvents := make([]*session.Event, 0)
 
 	for _, event := range allEvents {
 		if metadata, err := GetCompactionMetadata(event); err == nil {
@@ -110,6 +111,19 @@ func filterCompactedEvents(events session.Events) []*session.Event {
 				start: metadata.StartTimestamp,
 				end:   metadata.EndTimestamp,
 			})
+			compactionEvents = append(compactionEvents, event)
+		}
+	}
+
+	// A summary whose range a later summary covers is superseded by it, as
+	// each update of a rolling summary is
+	superseded := make(map[*session.Event]bool)
+	for i, r := range compactionRanges {
+		for _, later := range compactionRanges[i+1:] {
+			if !later.start.After(r.start) && !later.end.Before(r.end) {
+				superseded[compactionEvents[i]] = true
+				break
+			}
 		}
 	}
 
@@ -117,6 +131,9 @@ func filterCompactedEvents(events session.Events) []*session.Event {
 	filtered := make([]*session.Event, 0, events.Len())
 
 	for _, event := range allEvents {
+		if superseded[event] {
+			continue
+		}
 		if IsCompactionEvent(event) {
 			// Include compaction event (contains summary)
 			// But restore Content from the stored summary
@@ -77,6 +77,39 @@ func (s *Selector) SelectEventsToCompact(events []*session.Event) ([]*session.Ev
 	return s.filterEventsByInvocationRange(events, startInvocationID, endInvocationID), nil
 }
 
+// SelectAgedOut selects the events a rolling summary ending at since does
+// not cover yet, except those of the OverlapSize most recent invocations,
+// which stay verbatim. Nothing is selected until at least
+// InvocationThreshold invocations have aged out.
+func (s *Selector) SelectAgedOut(events []*session.Event, since time.Time) []*session.Event {
+	invocationMap := make(map[string]time.Time)
+	for _, event := range events {
+		if event == nil || IsCompactionEvent(event) || !event.Timestamp.After(since) {
+			continue
+		}
+		if event.InvocationID != "" {
+			invocationMap[event.InvocationID] = event.Timestamp
+		}
+	}
+
+	agedOut := len(invocationMap) - s.config.OverlapSize
+	if agedOut <= 0 || agedOut < s.config.InvocationThreshold {
+		return nil
+	}
+	// Events up to the last aged-out invocation's, which is also the range
+	// the summary will hide
+	invocationIDs := s.sortInvocationsByTime(invocationMap)
+	until := invocationMap[invocationIDs[agedOut-1]]
+
+	result := make([]*session.Event, 0, len(events))
+	for _, event := range events {
+		if event != nil && !IsCompactionEvent(event) && event.Timestamp.After(since) && !event.Timestamp.After(until) {
+			result = append(result, event)
+		}
+	}
+	return result
+}
+
 // sortInvocationsByTime returns sorted invocation IDs by timestamp
 func (s *Selector) sortInvocationsByTime(invocationMap map[string]time.Time) []string {
 	type invocation struct {
@@ -40,6 +40,111 @@ func (ls *LLMSummarizer) Summarize(
 	conversationText := ls.formatEvents(events)
 	prompt := fmt.Sprintf(ls.config.PromptTemplate, conversationText)
 
+	summaryContent, compactedTokens, err := ls.generate(ctx, prompt)
+	if err != nil {
+		return nil, err
+	}
+
+	// Create compaction metadata
+	startTime := events[0].Timestamp
+	endTime := events[len(events)-1].Timestamp
+	if endTime.IsZero() {
+		endTime = time.Now()
+	}
+
+	metadata := &CompactionMetadata{
+		StartTimestamp:    startTime,
+		EndTimestamp:      endTime,
+		StartInvocationID: events[0].InvocationID,
+		EndInvocationID:   events[len(events)-1].InvocationID,
+		EventCount:        len(events),
+		OriginalTokens:    ls.countTokens(events),
+		CompactedTokens:   compactedTokens,
+	}
+	return newCompactionEvent(summaryContent, metadata)
+}
+
+// SummarizeRolling folds newly aged-out events into the previous rolling
+// summary, or starts one when previous is nil. Only the previous summary
+// text and the new events are sent to the LLM. The returned event replaces
+// the previous summary in the session and carries the updated summary as a
+// state delta.
+func (ls *LLMSummarizer) SummarizeRolling(
+	ctx context.Context,
+	previous *RollingSummary,
+	events []*session.Event,
+) (*session.Event, *RollingSummary, error) {
+	if len(events) == 0 {
+		return nil, nil, fmt.Errorf("cannot summarize empty event list")
+	}
+
+	conversationText := ls.formatEvents(events)
+	var prompt string
+	if previous == nil || previous.Text == "" {
+		prompt = fmt.Sprintf(ls.config.PromptTemplate, conversationText)
+	} else {
+		template := ls.config.RollingPromptTemplate
+		if template == "" {
+			template = defaultRollingPromptTemplate
+		}
+		prompt = fmt.Sprintf(template, previous.Text, conversationText)
+	}
+
+	summaryContent, compactedTokens, err := ls.generate(ctx, prompt)
+	if err != nil {
+		return nil, nil, err
+	}
+
+	endTime := events[len(events)-1].Timestamp
+	if endTime.IsZero() {
+		endTime = time.Now()
+	}
+	summary := &RollingSummary{
+		Version:           1,
+		Text:              contentText(summaryContent),
+		StartTimestamp:    events[0].Timestamp,
+		EndTimestamp:      endTime,
+		StartInvocationID: events[0].InvocationID,
+		EndInvocationID:   events[len(events)-1].InvocationID,
+		EventCount:        len(events),
+		OriginalTokens:    ls.countTokens(events),
+	}
+	if previous != nil {
+		summary.Version = previous.Version + 1
+		summary.StartTimestamp = previous.StartTimestamp
+		summary.StartInvocationID = previous.StartInvocationID
+		summary.EventCount += previous.EventCount
+		summary.OriginalTokens += previous.OriginalTokens
+	}
+
+	// The event's range spans the whole history summarized so far, so it
+	// supersedes the previous summary event
+	metadata := &CompactionMetadata{
+		StartTimestamp:    summary.StartTimestamp,
+		EndTimestamp:      summary.EndTimestamp,
+		StartInvocationID: summary.StartInvocationID,
+		EndInvocationID:   summary.EndInvocationID,
+		EventCount:        summary.EventCount,
+		OriginalTokens:    summary.OriginalTokens,
+		CompactedTokens:   compactedTokens,
+		SummaryVersion:    summary.Version,
+	}
+	compactionEvent, err := newCompactionEvent(summaryContent, metadata)
+	if err != nil {
+		return nil, nil, err
+	}
+
+	stateValue, err := summary.stateValue()
+	if err != nil {
+		return nil, nil, fmt.Errorf("failed to encode rolling summary: %w", err)
+	}
+	compactionEvent.Actions.StateDelta = map[string]any{RollingSummaryStateKey: stateValue}
+	return compactionEvent, summary, nil
+}
+
+// generate runs the summarization prompt and returns the summary and the
+// tokens the call used.
+func (ls *LLMSummarizer) generate(ctx context.Context, prompt string) (*genai.Content, int, error) {
 	// Create LLM request
 	llmRequest := &model.LLMRequest{
 		Model: ls.llm.Name(),
@@ -71,46 +176,31 @@ func (ls *LLMSummarizer) Summarize(
 	}
 
 	if summaryContent == nil {
-		return nil, fmt.Errorf("no summary content generated")
+		return nil, 0, fmt.Errorf("no summary content generated")
 	}
 
 	// Ensure role is 'model' (following ADK Python)
 	summaryContent.Role = "model"
 
-	// Calculate metrics
-	originalTokens := ls.countTokens(events)
 	compactedTokens := 0
 	if usageMetadata != nil {
 		compactedTokens = int(usageMetadata.TotalTokenCount)
 	}
+	return summaryContent, compactedTokens, nil
+}
 
+// newCompactionEvent wraps a summary and its metadata in a compaction event
+func newCompactionEvent(summaryContent *genai.Content, metadata *CompactionMetadata) (*session.Event, error) {
 	// Serialize summary content to JSON
 	summaryJSON, err := json.Marshal(summaryContent)
 	if err != nil {
 		return nil, fmt.Errorf("failed to marshal summary content: %w", err)
 	}
-
-	// Create compaction metadata
-	startTime := events[0].Timestamp
-	endTime := events[len(events)-1].Timestamp
-	if endTime.IsZero() {
-		endTime = time.Now()
-	}
-
-	metadata := &CompactionMetadata{
-		StartTimestamp:       startTime,
-		EndTimestamp:         endTime,
-		StartInvocationID:    events[0].InvocationID,
-		EndInvocationID:      events[len(events)-1].InvocationID,
-		CompactedContentJSON: string(summaryJSON),
-		EventCount:           len(events),
-		OriginalTokens:       originalTokens,
-		CompactedTokens:      compactedTokens,
-	}
+	metadata.CompactedContentJSON = string(summaryJSON)
 
 	// Calculate compression ratio safely
-	if compactedTokens > 0 {
-		metadata.CompressionRatio = float64(originalTokens) / float64(compactedTokens)
+	if metadata.CompactedTokens > 0 {
+		metadata.CompressionRatio = float64(metadata.OriginalTokens) / float64(metadata.CompactedTokens)
 	}
 
 	// Create compaction event (following ADK Python pattern)
@@ -132,6 +222,17 @@ func (ls *LLMSummarizer) Summarize(
 	return compactionEvent, nil
 }
 
+// contentText joins the text parts of a content
+func contentText(content *genai.Content) string {
+	var parts []string
+	for _, part := range content.Parts {
+		if part != nil && part.Text != "" {
+			parts = append(parts, part.Text)
+		}
+	}
+	return strings.Join(parts, "\n")
+}
+
 // formatEvents formats events for the summarization prompt
 func (ls *LLMSummarizer) formatEvents(events []*session.Event) string {
 	var sb strings.Builder
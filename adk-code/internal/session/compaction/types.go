@@ -3,6 +3,7 @@ package compaction
 
 import (
 	"encoding/json"
+	"errors"
 	"fmt"
 	"time"
 
@@ -20,10 +21,68 @@ type CompactionMetadata struct {
 	OriginalTokens       int       `json:"original_tokens"`
 	CompactedTokens      int       `json:"compacted_tokens"`
 	CompressionRatio     float64   `json:"compression_ratio"`
+	// SummaryVersion is the rolling summary version the event holds, 0 for
+	// a windowed summary
+	SummaryVersion int `json:"summary_version,omitempty"`
 }
 
 const CompactionMetadataKey = "_adk_compaction"
 
+// RollingSummaryStateKey is the session state key of the rolling summary
+const RollingSummaryStateKey = "_adk_rolling_summary"
+
+// RollingSummary is the single running summary of a session in rolling
+// mode. Each update covers the previous summary plus the events aged out
+// since EndTimestamp, and bumps Version.
+type RollingSummary struct {
+	Version           int       `json:"version"`
+	Text              string    `json:"text"`
+	StartTimestamp    time.Time `json:"start_timestamp"`
+	EndTimestamp      time.Time `json:"end_timestamp"`
+	StartInvocationID string    `json:"start_invocation_id,omitempty"`
+	EndInvocationID   string    `json:"end_invocation_id,omitempty"`
+	EventCount        int       `json:"event_count"`
+	OriginalTokens    int       `json:"original_tokens"`
+}
+
+// GetRollingSummary reads the rolling summary from session state. It returns
+// nil without error when the session has none yet.
+func GetRollingSummary(state session.State) (*RollingSummary, error) {
+	if state == nil {
+		return nil, nil
+	}
+	value, err := state.Get(RollingSummaryStateKey)
+	if errors.Is(err, session.ErrStateKeyNotExist) || value == nil {
+		return nil, nil
+	} else if err != nil {
+		return nil, err
+	}
+
+	// State round-trips through JSON when persisted
+	jsonData, err := json.Marshal(value)
+	if err != nil {
+		return nil, err
+	}
+	var summary RollingSummary
+	if err := json.Unmarshal(jsonData, &summary); err != nil {
+		return nil, fmt.Errorf("invalid rolling summary in session state: %w", err)
+	}
+	return &summary, nil
+}
+
+// stateValue converts the summary to the JSON-compatible map stored in state.
+func (rs *RollingSummary) stateValue() (map[string]any, error) {
+	jsonData, err := json.Marshal(rs)
+	if err != nil {
+		return nil, err
+	}
+	var dataMap map[string]any
+	if err := json.Unmarshal(jsonData, &dataMap); err != nil {
+		return nil, err
+	}
+	return dataMap, nil
+}
+
 // IsCompactionEvent checks if an event contains compaction metadata
 func IsCompactionEvent(event *session.Event) bool {
 	if event == nil || event.CustomMetadata == nil {
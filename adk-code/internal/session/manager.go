@@ -7,6 +7,7 @@ import (
 
 	"adk-code/internal/session/compaction"
 	"adk-code/internal/session/persistence"
+	"adk-code/internal/tracking"
 	pkgerrors "adk-code/pkg/errors"
 
 	"google.golang.org/adk/session"
@@ -112,6 +113,15 @@ func (sm *SessionManager) GetDBPath() string {
 	return sm.dbPath
 }
 
+// ToolLatencyStore returns the store that persists tool run latencies, or
+// nil when the session service has no database.
+func (sm *SessionManager) ToolLatencyStore() tracking.LatencyStore {
+	if sqlite, ok := sm.sessionService.(*persistence.SQLiteSessionService); ok {
+		return sqlite.ToolLatencies()
+	}
+	return nil
+}
+
 // Close closes the session service
 func (sm *SessionManager) Close() error {
 	if sqlite, ok := sm.sessionService.(*persistence.SQLiteSessionService); ok {
@@ -0,0 +1,521 @@
+package persistence
+
+import (
+	"encoding/binary"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"math"
+
+	"google.golang.org/genai"
+)
+
+// Event payload codec
+//
+// Content and CustomMetadata are the largest and most frequently written event
+// columns. Instead of reflection-based JSON they are stored in a compact
+// binary layout:
+//
+//	0x00 | version | kind | body
+//
+// A leading 0x00 can never start a JSON document, so rows written before the
+// codec existed (plain JSON text) are still recognized and decoded, and are
+// rewritten in the binary layout the first time they are read.
+//
+// Fields the codec does not know about (e.g. new genai.Part members) are
+// carried in a JSON "residual" so nothing is lost when the SDK evolves.
+
+const (
+	payloadMagic   byte = 0x00
+	payloadVersion byte = 1
+
+	payloadKindContent byte = 1
+	payloadKindMap     byte = 2
+
+	payloadHeaderLen = 3
+)
+
+// Value tags for the generic any codec
+const (
+	tagNil byte = iota
+	tagFalse
+	tagTrue
+	tagNumber
+	tagString
+	tagArray
+	tagObject
+	tagJSON // anything else, as JSON (decoded with JSON semantics)
+)
+
+// Part field flags
+const (
+	partNil = 1 << iota
+	partText
+	partThought
+	partSignature
+	partFunctionCall
+	partFunctionResponse
+	partResidual
+)
+
+var errCorruptPayload = errors.New("corrupt binary event payload")
+
+// isBinaryPayload reports whether a stored column uses the binary codec.
+func isBinaryPayload(data []byte) bool {
+	return len(data) >= payloadHeaderLen && data[0] == payloadMagic
+}
+
+// encodeContent serializes content in the binary layout.
+func encodeContent(content *genai.Content) ([]byte, error) {
+	w := newPayloadWriter(payloadKindContent, 256)
+	w.string(content.Role)
+	w.uvarint(uint64(len(content.Parts)))
+	for _, part := range content.Parts {
+		if err := w.part(part); err != nil {
+			return nil, err
+		}
+	}
+	return w.buf, nil
+}
+
+// decodeContent deserializes content stored either as binary or legacy JSON.
+func decodeContent(data []byte) (*genai.Content, error) {
+	if !isBinaryPayload(data) {
+		var content *genai.Content
+		if err := json.Unmarshal(data, &content); err != nil {
+			return nil, err
+		}
+		return content, nil
+	}
+
+	r, err := newPayloadReader(data, payloadKindContent)
+	if err != nil {
+		return nil, err
+	}
+	content := &genai.Content{Role: r.string()}
+	if n := r.length(); n > 0 {
+		content.Parts = make([]*genai.Part, n)
+		for i := range content.Parts {
+			content.Parts[i] = r.part()
+		}
+	}
+	return content, r.finish()
+}
+
+// encodeMap serializes a map[string]any (custom metadata) in the binary layout.
+func encodeMap(m map[string]any) ([]byte, error) {
+	w := newPayloadWriter(payloadKindMap, 64)
+	if err := w.object(m); err != nil {
+		return nil, err
+	}
+	return w.buf, nil
+}
+
+// decodeMap deserializes a map stored either as binary or legacy JSON.
+func decodeMap(data []byte) (map[string]any, error) {
+	if !isBinaryPayload(data) {
+		var m map[string]any
+		if err := json.Unmarshal(data, &m); err != nil {
+			return nil, err
+		}
+		return m, nil
+	}
+
+	r, err := newPayloadReader(data, payloadKindMap)
+	if err != nil {
+		return nil, err
+	}
+	var m map[string]any
+	switch tag := r.byte(); tag {
+	case tagNil:
+	case tagObject:
+		m = r.object()
+	default:
+		return nil, fmt.Errorf("%w: unexpected tag %d for map", errCorruptPayload, tag)
+	}
+	return m, r.finish()
+}
+
+// payloadWriter appends binary fields to a buffer.
+type payloadWriter struct {
+	buf []byte
+}
+
+func newPayloadWriter(kind byte, capacity int) *payloadWriter {
+	buf := make([]byte, 0, capacity)
+	buf = append(buf, payloadMagic, payloadVersion, kind)
+	return &payloadWriter{buf: buf}
+}
+
+func (w *payloadWriter) uvarint(v uint64) {
+	w.buf = binary.AppendUvarint(w.buf, v)
+}
+
+func (w *payloadWriter) string(s string) {
+	w.uvarint(uint64(len(s)))
+	w.buf = append(w.buf, s...)
+}
+
+func (w *payloadWriter) bytes(b []byte) {
+	w.uvarint(uint64(len(b)))
+	w.buf = append(w.buf, b...)
+}
+
+func (w *payloadWriter) part(p *genai.Part) error {
+	if p == nil {
+		w.uvarint(partNil)
+		return nil
+	}
+
+	// Everything not handled natively goes into the residual
+	residual := *p
+	residual.Text = ""
+	residual.Thought = false
+	residual.ThoughtSignature = nil
+	residual.FunctionCall = nil
+	residual.FunctionResponse = nil
+	leftover, err := residualJSON(&residual)
+	if err != nil {
+		return err
+	}
+
+	var flags uint64
+	if p.Text != "" {
+		flags |= partText
+	}
+	if p.Thought {
+		flags |= partThought
+	}
+	if len(p.ThoughtSignature) > 0 {
+		flags |= partSignature
+	}
+	if p.FunctionCall != nil {
+		flags |= partFunctionCall
+	}
+	if p.FunctionResponse != nil {
+		flags |= partFunctionResponse
+	}
+	if leftover != nil {
+		flags |= partResidual
+	}
+	w.uvarint(flags)
+
+	if flags&partText != 0 {
+		w.string(p.Text)
+	}
+	if flags&partSignature != 0 {
+		w.bytes(p.ThoughtSignature)
+	}
+	if fc := p.FunctionCall; fc != nil {
+		rest := *fc
+		rest.ID, rest.Name, rest.Args = "", "", nil
+		extra, err := residualJSON(&rest)
+		if err != nil {
+			return err
+		}
+		w.string(fc.ID)
+		w.string(fc.Name)
+		if err := w.object(fc.Args); err != nil {
+			return err
+		}
+		w.bytes(extra)
+	}
+	if fr := p.FunctionResponse; fr != nil {
+		rest := *fr
+		rest.ID, rest.Name, rest.Response = "", "", nil
+		extra, err := residualJSON(&rest)
+		if err != nil {
+			return err
+		}
+		w.string(fr.ID)
+		w.string(fr.Name)
+		if err := w.object(fr.Response); err != nil {
+			return err
+		}
+		w.bytes(extra)
+	}
+	if leftover != nil {
+		w.bytes(leftover)
+	}
+	return nil
+}
+
+// residualJSON marshals the fields left after the natively encoded ones were
+// cleared, returning nil when nothing remains.
+func residualJSON(v any) ([]byte, error) {
+	data, err := json.Marshal(v)
+	if err != nil {
+		return nil, err
+	}
+	if string(data) == "{}" {
+		return nil, nil
+	}
+	return data, nil
+}
+
+// object writes a map; empty maps are written as nil to match the omitempty
+// behaviour of the JSON encoding.
+func (w *payloadWriter) object(m map[string]any) error {
+	if len(m) == 0 {
+		w.buf = append(w.buf, tagNil)
+		return nil
+	}
+	w.buf = append(w.buf, tagObject)
+	return w.objectBody(m)
+}
+
+func (w *payloadWriter) objectBody(m map[string]any) error {
+	w.uvarint(uint64(len(m)))
+	for k, v := range m {
+		w.string(k)
+		if err := w.value(v); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+// value writes any JSON-compatible value. Numbers are stored as float64 so a
+// round trip yields exactly what encoding/json would have produced.
+func (w *payloadWriter) value(v any) error {
+	switch x := v.(type) {
+	case nil:
+		w.buf = append(w.buf, tagNil)
+	case bool:
+		if x {
+			w.buf = append(w.buf, tagTrue)
+		} else {
+			w.buf = append(w.buf, tagFalse)
+		}
+	case string:
+		w.buf = append(w.buf, tagString)
+		w.string(x)
+	case float64:
+		w.number(x)
+	case int:
+		w.number(float64(x))
+	case int32:
+		w.number(float64(x))
+	case int64:
+		w.number(float64(x))
+	case []any:
+		w.buf = append(w.buf, tagArray)
+		w.uvarint(uint64(len(x)))
+		for _, item := range x {
+			if err := w.value(item); err != nil {
+				return err
+			}
+		}
+	case map[string]any:
+		if x == nil {
+			w.buf = append(w.buf, tagNil)
+			return nil
+		}
+		w.buf = append(w.buf, tagObject)
+		return w.objectBody(x)
+	default:
+		data, err := json.Marshal(x)
+		if err != nil {
+			return err
+		}
+		w.buf = append(w.buf, tagJSON)
+		w.bytes(data)
+	}
+	return nil
+}
+
+func (w *payloadWriter) number(f float64) {
+	w.buf = append(w.buf, tagNumber)
+	w.buf = binary.LittleEndian.AppendUint64(w.buf, math.Float64bits(f))
+}
+
+// payloadReader decodes binary fields with a sticky error.
+type payloadReader struct {
+	data []byte
+	off  int
+	err  error
+}
+
+func newPayloadReader(data []byte, kind byte) (*payloadReader, error) {
+	if !isBinaryPayload(data) {
+		return nil, errCorruptPayload
+	}
+	if data[1] != payloadVersion {
+		return nil, fmt.Errorf("unsupported event payload version %d", data[1])
+	}
+	if data[2] != kind {
+		return nil, fmt.Errorf("%w: payload kind %d, expected %d", errCorruptPayload, data[2], kind)
+	}
+	return &payloadReader{data: data, off: payloadHeaderLen}, nil
+}
+
+func (r *payloadReader) fail() {
+	if r.err == nil {
+		r.err = errCorruptPayload
+	}
+	r.off = len(r.data)
+}
+
+func (r *payloadReader) finish() error {
+	if r.err == nil && r.off != len(r.data) {
+		return fmt.Errorf("%w: %d trailing bytes", errCorruptPayload, len(r.data)-r.off)
+	}
+	return r.err
+}
+
+func (r *payloadReader) byte() byte {
+	if r.off >= len(r.data) {
+		r.fail()
+		return 0
+	}
+	b := r.data[r.off]
+	r.off++
+	return b
+}
+
+func (r *payloadReader) uvarint() uint64 {
+	v, n := binary.Uvarint(r.data[r.off:])
+	if n <= 0 {
+		r.fail()
+		return 0
+	}
+	r.off += n
+	return v
+}
+
+// length reads a count, rejecting values larger than the remaining input so
+// corrupt data cannot trigger huge allocations.
+func (r *payloadReader) length() int {
+	n := r.uvarint()
+	if n > uint64(len(r.data)-r.off) {
+		r.fail()
+		return 0
+	}
+	return int(n)
+}
+
+func (r *payloadReader) raw() []byte {
+	n := r.length()
+	b := r.data[r.off : r.off+n]
+	r.off += n
+	return b
+}
+
+func (r *payloadReader) string() string {
+	return string(r.raw())
+}
+
+func (r *payloadReader) bytes() []byte {
+	b := r.raw()
+	if len(b) == 0 {
+		return nil
+	}
+	return append([]byte(nil), b...)
+}
+
+func (r *payloadReader) part() *genai.Part {
+	flags := r.uvarint()
+	if flags&partNil != 0 {
+		return nil
+	}
+	p := &genai.Part{}
+	if flags&partText != 0 {
+		p.Text = r.string()
+	}
+	p.Thought = flags&partThought != 0
+	if flags&partSignature != 0 {
+		p.ThoughtSignature = r.bytes()
+	}
+	if flags&partFunctionCall != 0 {
+		fc := &genai.FunctionCall{}
+		fc.ID = r.string()
+		fc.Name = r.string()
+		fc.Args = r.optionalObject()
+		r.residual(fc)
+		p.FunctionCall = fc
+	}
+	if flags&partFunctionResponse != 0 {
+		fr := &genai.FunctionResponse{}
+		fr.ID = r.string()
+		fr.Name = r.string()
+		fr.Response = r.optionalObject()
+		r.residual(fr)
+		p.FunctionResponse = fr
+	}
+	if flags&partResidual != 0 {
+		r.residual(p)
+	}
+	return p
+}
+
+// residual merges JSON-encoded leftover fields into target.
+func (r *payloadReader) residual(target any) {
+	data := r.raw()
+	if len(data) == 0 || r.err != nil {
+		return
+	}
+	if err := json.Unmarshal(data, target); err != nil {
+		r.err = err
+	}
+}
+
+func (r *payloadReader) optionalObject() map[string]any {
+	switch tag := r.byte(); tag {
+	case tagNil:
+		return nil
+	case tagObject:
+		return r.object()
+	default:
+		r.fail()
+		return nil
+	}
+}
+
+func (r *payloadReader) object() map[string]any {
+	n := r.length()
+	m := make(map[string]any, n)
+	for i := 0; i < n && r.err == nil; i++ {
+		k := r.string()
+		m[k] = r.value()
+	}
+	return m
+}
+
+func (r *payloadReader) value() any {
+	switch tag := r.byte(); tag {
+	case tagNil:
+		return nil
+	case tagFalse:
+		return false
+	case tagTrue:
+		return true
+	case tagNumber:
+		if len(r.data)-r.off < 8 {
+			r.fail()
+			return nil
+		}
+		bits := binary.LittleEndian.Uint64(r.data[r.off:])
+		r.off += 8
+		return math.Float64frombits(bits)
+	case tagString:
+		return r.string()
+	case tagArray:
+		n := r.length()
+		items := make([]any, n)
+		for i := 0; i < n && r.err == nil; i++ {
+			items[i] = r.value()
+		}
+		return items
+	case tagObject:
+		return r.object()
+	case tagJSON:
+		var v any
+		if err := json.Unmarshal(r.raw(), &v); err != nil && r.err == nil {
+			r.err = err
+		}
+		return v
+	default:
+		r.fail()
+		return nil
+	}
+}
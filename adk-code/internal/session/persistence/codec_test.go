@@ -0,0 +1,181 @@
+package persistence
+
+import (
+	"encoding/json"
+	"errors"
+	"reflect"
+	"strings"
+	"testing"
+
+	"google.golang.org/genai"
+)
+
+func sampleContent() *genai.Content {
+	return &genai.Content{
+		Role: "model",
+		Parts: []*genai.Part{
+			{Text: "Let me look at the file first.", Thought: true, ThoughtSignature: []byte{1, 2, 3}},
+			{FunctionCall: &genai.FunctionCall{
+				ID:   "call-1",
+				Name: "read_file",
+				Args: map[string]any{"path": "main.go", "offset": 10, "nested": map[string]any{"ok": true, "list": []any{"a", 2.5, nil}}},
+			}},
+			{FunctionResponse: &genai.FunctionResponse{
+				ID:       "call-1",
+				Name:     "read_file",
+				Response: map[string]any{"content": strings.Repeat("package main\n", 50), "success": true},
+			}},
+			{InlineData: &genai.Blob{MIMEType: "image/png", Data: []byte{0x89, 'P', 'N', 'G'}}},
+		},
+	}
+}
+
+// viaJSON returns what the legacy JSON path would have produced.
+func viaJSON[T any](t testing.TB, v T) T {
+	t.Helper()
+	data, err := json.Marshal(v)
+	if err != nil {
+		t.Fatalf("json marshal failed: %v", err)
+	}
+	var out T
+	if err := json.Unmarshal(data, &out); err != nil {
+		t.Fatalf("json unmarshal failed: %v", err)
+	}
+	return out
+}
+
+func TestContentCodecMatchesJSONRoundTrip(t *testing.T) {
+	content := sampleContent()
+
+	data, err := encodeContent(content)
+	if err != nil {
+		t.Fatalf("encodeContent failed: %v", err)
+	}
+	if !isBinaryPayload(data) {
+		t.Fatal("expected binary payload header")
+	}
+	decoded, err := decodeContent(data)
+	if err != nil {
+		t.Fatalf("decodeContent failed: %v", err)
+	}
+
+	if want := viaJSON(t, content); !reflect.DeepEqual(decoded, want) {
+		t.Errorf("binary round trip differs from JSON round trip\n got: %#v\nwant: %#v", decoded, want)
+	}
+}
+
+func TestContentCodecNilAndEmptyParts(t *testing.T) {
+	content := &genai.Content{Role: "user", Parts: []*genai.Part{nil, {}}}
+
+	data, err := encodeContent(content)
+	if err != nil {
+		t.Fatalf("encodeContent failed: %v", err)
+	}
+	decoded, err := decodeContent(data)
+	if err != nil {
+		t.Fatalf("decodeContent failed: %v", err)
+	}
+	if !reflect.DeepEqual(decoded, viaJSON(t, content)) {
+		t.Errorf("unexpected decoded content: %#v", decoded)
+	}
+}
+
+func TestDecodeLegacyJSONPayloads(t *testing.T) {
+	content, err := decodeContent([]byte(`{"role":"user","parts":[{"text":"hello"}]}`))
+	if err != nil {
+		t.Fatalf("decodeContent failed on legacy JSON: %v", err)
+	}
+	if content.Role != "user" || len(content.Parts) != 1 || content.Parts[0].Text != "hello" {
+		t.Errorf("unexpected legacy content: %#v", content)
+	}
+
+	m, err := decodeMap([]byte(`{"_adk_compaction":{"event_count":5}}`))
+	if err != nil {
+		t.Fatalf("decodeMap failed on legacy JSON: %v", err)
+	}
+	if _, ok := m["_adk_compaction"].(map[string]any); !ok {
+		t.Errorf("unexpected legacy map: %#v", m)
+	}
+}
+
+func TestMapCodecFallsBackToJSONForUnknownTypes(t *testing.T) {
+	type metadata struct {
+		EventCount int    `json:"event_count"`
+		Summary    string `json:"summary"`
+	}
+	m := map[string]any{"meta": metadata{EventCount: 3, Summary: "done"}, "tags": []string{"a", "b"}, "n": int64(7)}
+
+	data, err := encodeMap(m)
+	if err != nil {
+		t.Fatalf("encodeMap failed: %v", err)
+	}
+	decoded, err := decodeMap(data)
+	if err != nil {
+		t.Fatalf("decodeMap failed: %v", err)
+	}
+	if want := viaJSON(t, m); !reflect.DeepEqual(decoded, want) {
+		t.Errorf("got %#v, want %#v", decoded, want)
+	}
+}
+
+func TestDecodeRejectsCorruptPayloads(t *testing.T) {
+	data, err := encodeContent(sampleContent())
+	if err != nil {
+		t.Fatalf("encodeContent failed: %v", err)
+	}
+
+	for _, cut := range []int{payloadHeaderLen, len(data) / 2, len(data) - 1} {
+		if _, err := decodeContent(data[:cut]); !errors.Is(err, errCorruptPayload) {
+			t.Errorf("truncated at %d: expected corrupt payload error, got %v", cut, err)
+		}
+	}
+
+	future := append([]byte(nil), data...)
+	future[1] = payloadVersion + 1
+	if _, err := decodeContent(future); err == nil {
+		t.Error("expected error for unsupported payload version")
+	}
+}
+
+func BenchmarkEncodeContentJSON(b *testing.B) {
+	content := sampleContent()
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		if _, err := json.Marshal(content); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkEncodeContentBinary(b *testing.B) {
+	content := sampleContent()
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		if _, err := encodeContent(content); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkDecodeContentJSON(b *testing.B) {
+	data, _ := json.Marshal(sampleContent())
+	b.ReportAllocs()
+	b.SetBytes(int64(len(data)))
+	for i := 0; i < b.N; i++ {
+		var content *genai.Content
+		if err := json.Unmarshal(data, &content); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkDecodeContentBinary(b *testing.B) {
+	data, _ := encodeContent(sampleContent())
+	b.ReportAllocs()
+	b.SetBytes(int64(len(data)))
+	for i := 0; i < b.N; i++ {
+		if _, err := decodeContent(data); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
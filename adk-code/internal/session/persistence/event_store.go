@@ -0,0 +1,258 @@
+package persistence
+
+import (
+	"container/list"
+	"sync"
+
+	"google.golang.org/adk/session"
+	"google.golang.org/genai"
+)
+
+const (
+	// inlinePayloadLimit is the encoded Content size up to which payloads stay
+	// attached to their event header permanently
+	inlinePayloadLimit = 4 * 1024
+	// defaultPayloadCacheBytes bounds the memory used by large payloads across
+	// all sessions of a service
+	defaultPayloadCacheBytes = 64 * 1024 * 1024
+	// scanBatchBytes and scanBatchEvents bound one batched reload of evicted
+	// payloads during a scan over the history
+	scanBatchBytes  = 8 * 1024 * 1024
+	scanBatchEvents = 256
+)
+
+// eventHeader is the permanently resident part of an event. For large events
+// the Content payload is detached and kept in the payload cache, from which it
+// is reloaded (or, once evicted, read back from SQLite) on access.
+type eventHeader struct {
+	event       *session.Event // Content is nil when external is set
+	payloadSize int            // encoded size of Content in bytes
+	external    bool
+}
+
+// payloadLoader reads the Content of several events back from storage in one
+// query, keyed by event ID.
+type payloadLoader func(eventIDs []string) (map[string]*genai.Content, error)
+
+// eventStore is the tiered event list behind localSession: headers in a slice,
+// large payloads in a shared size-bounded LRU. Only appends evict from the
+// cache; payloads reloaded from storage merely fill free space, so a scan over
+// a history larger than the cache cannot flush the hot tail of the session.
+type eventStore struct {
+	mu      sync.RWMutex
+	headers []*eventHeader
+
+	scope string // cache key prefix identifying the session
+	cache *payloadCache
+	load  payloadLoader
+}
+
+func newEventStore(scope string, cache *payloadCache, load payloadLoader) *eventStore {
+	return &eventStore{scope: scope, cache: cache, load: load}
+}
+
+// append adds an event. payloadSize is the encoded size of its Content; the
+// caller's event is never modified.
+func (s *eventStore) append(event *session.Event, payloadSize int) {
+	h := &eventHeader{event: event, payloadSize: payloadSize}
+	if event.Content != nil && payloadSize > inlinePayloadLimit && s.cache != nil && s.load != nil {
+		header := *event
+		header.Content = nil
+		h.event = &header
+		h.external = true
+		s.cache.put(s.scope+event.ID, event.Content, payloadSize)
+	}
+
+	s.mu.Lock()
+	s.headers = append(s.headers, h)
+	s.mu.Unlock()
+}
+
+// snapshot returns the headers present now; later appends are not visible.
+func (s *eventStore) snapshot() []*eventHeader {
+	s.mu.RLock()
+	defer s.mu.RUnlock()
+	return s.headers[:len(s.headers):len(s.headers)]
+}
+
+// len returns the number of events.
+func (s *eventStore) len() int {
+	s.mu.RLock()
+	defer s.mu.RUnlock()
+	return len(s.headers)
+}
+
+// materialize returns the full event for a header, reloading its payload if needed.
+func (s *eventStore) materialize(h *eventHeader) *session.Event {
+	if !h.external {
+		return h.event
+	}
+
+	key := s.scope + h.event.ID
+	content, ok := s.cache.get(key)
+	if !ok {
+		loaded, err := s.load([]string{h.event.ID})
+		if err != nil {
+			// Surface the header rather than failing the whole history
+			return h.event
+		}
+		content = loaded[h.event.ID]
+		s.cache.putIfRoom(key, content, h.payloadSize)
+	}
+	return withContent(h, content)
+}
+
+// scan yields the full events for headers in order. Payloads missing from the
+// cache are read back in batched queries covering the following evicted
+// events, and are not cached unless there is free room.
+func (s *eventStore) scan(headers []*eventHeader, yield func(*session.Event) bool) {
+	var batch map[string]*genai.Content
+	for i, h := range headers {
+		if !h.external {
+			if !yield(h.event) {
+				return
+			}
+			continue
+		}
+
+		key := s.scope + h.event.ID
+		content, ok := batch[h.event.ID]
+		if !ok {
+			content, ok = s.cache.get(key)
+		}
+		if !ok {
+			loaded, err := s.load(s.missingIDs(headers[i:]))
+			if err != nil {
+				// Surface the header rather than failing the whole history
+				if !yield(h.event) {
+					return
+				}
+				continue
+			}
+			batch = loaded
+			content = batch[h.event.ID]
+			s.cache.putIfRoom(key, content, h.payloadSize)
+		}
+		if !yield(withContent(h, content)) {
+			return
+		}
+	}
+}
+
+// missingIDs returns the IDs of the leading external headers whose payloads
+// are not cached, up to one batch.
+func (s *eventStore) missingIDs(headers []*eventHeader) []string {
+	var ids []string
+	bytes := 0
+	for _, h := range headers {
+		if len(ids) == scanBatchEvents || (len(ids) > 0 && bytes+h.payloadSize > scanBatchBytes) {
+			break
+		}
+		if h.external && !s.cache.contains(s.scope+h.event.ID) {
+			ids = append(ids, h.event.ID)
+			bytes += h.payloadSize
+		}
+	}
+	return ids
+}
+
+// withContent returns a copy of the header's event carrying content.
+func withContent(h *eventHeader, content *genai.Content) *session.Event {
+	event := *h.event
+	event.Content = content
+	return &event
+}
+
+// payloadCache is an LRU of event Content payloads bounded by total size.
+type payloadCache struct {
+	mu       sync.Mutex
+	maxBytes int
+	size     int
+	order    *list.List
+	entries  map[string]*list.Element
+	hits     int
+	misses   int
+}
+
+type payloadEntry struct {
+	key     string
+	content *genai.Content
+	size    int
+}
+
+func newPayloadCache(maxBytes int) *payloadCache {
+	return &payloadCache{
+		maxBytes: maxBytes,
+		order:    list.New(),
+		entries:  make(map[string]*list.Element),
+	}
+}
+
+func (c *payloadCache) get(key string) (*genai.Content, bool) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	elem, ok := c.entries[key]
+	if !ok {
+		c.misses++
+		return nil, false
+	}
+	c.hits++
+	c.order.MoveToFront(elem)
+	return elem.Value.(*payloadEntry).content, true
+}
+
+// contains reports whether key is cached without counting a hit or miss.
+func (c *payloadCache) contains(key string) bool {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	_, ok := c.entries[key]
+	return ok
+}
+
+// putIfRoom caches a payload read back from storage only if it fits without
+// evicting anything.
+func (c *payloadCache) putIfRoom(key string, content *genai.Content, size int) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	if _, ok := c.entries[key]; ok || c.size+size > c.maxBytes {
+		return
+	}
+	c.entries[key] = c.order.PushBack(&payloadEntry{key: key, content: content, size: size})
+	c.size += size
+}
+
+func (c *payloadCache) put(key string, content *genai.Content, size int) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	if elem, ok := c.entries[key]; ok {
+		entry := elem.Value.(*payloadEntry)
+		c.size += size - entry.size
+		entry.content, entry.size = content, size
+		c.order.MoveToFront(elem)
+	} else {
+		c.entries[key] = c.order.PushFront(&payloadEntry{key: key, content: content, size: size})
+		c.size += size
+	}
+	// Always keep the newest entry, even if it alone exceeds the budget
+	for c.size > c.maxBytes && c.order.Len() > 1 {
+		oldest := c.order.Back()
+		entry := oldest.Value.(*payloadEntry)
+		c.order.Remove(oldest)
+		delete(c.entries, entry.key)
+		c.size -= entry.size
+	}
+}
+
+// payloadCacheStats describes the resident payload cache.
+type payloadCacheStats struct {
+	Entries int
+	Bytes   int
+	Hits    int
+	Misses  int
+}
+
+func (c *payloadCache) stats() payloadCacheStats {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return payloadCacheStats{Entries: c.order.Len(), Bytes: c.size, Hits: c.hits, Misses: c.misses}
+}
@@ -0,0 +1,139 @@
+package persistence
+
+import (
+	"errors"
+	"strings"
+	"testing"
+
+	"google.golang.org/adk/session"
+	"google.golang.org/genai"
+)
+
+// newTestStore returns an event store whose loader serves payloads from a map
+// standing in for the SQLite events table.
+func newTestStore(maxBytes int) (*eventStore, map[string]*genai.Content, *int) {
+	stored := make(map[string]*genai.Content)
+	loads := 0
+	load := func(eventIDs []string) (map[string]*genai.Content, error) {
+		loads++
+		contents := make(map[string]*genai.Content)
+		for _, id := range eventIDs {
+			content, ok := stored[id]
+			if !ok {
+				return nil, errors.New("not found")
+			}
+			contents[id] = content
+		}
+		return contents, nil
+	}
+	return newEventStore("app\x00user\x00sess\x00", newPayloadCache(maxBytes), load), stored, &loads
+}
+
+func largeEvent(id string) *session.Event {
+	event := &session.Event{ID: id, Author: "model"}
+	event.Content = genai.NewContentFromText(strings.Repeat(id, inlinePayloadLimit), genai.RoleUser)
+	return event
+}
+
+func TestEventStoreKeepsSmallPayloadsInline(t *testing.T) {
+	store, _, loads := newTestStore(1)
+	event := &session.Event{ID: "small"}
+	event.Content = genai.NewContentFromText("hi", genai.RoleUser)
+	store.append(event, 10)
+
+	events := &localEvents{store: store, headers: store.snapshot()}
+	if got := events.At(0); got != event {
+		t.Errorf("expected small event to be returned as-is")
+	}
+	if *loads != 0 {
+		t.Errorf("expected no storage loads, got %d", *loads)
+	}
+}
+
+func TestEventStoreEvictsAndReloadsLargePayloads(t *testing.T) {
+	size := 2 * inlinePayloadLimit
+	store, stored, loads := newTestStore(2 * size)
+
+	var originals []*session.Event
+	for _, id := range []string{"a", "b", "c"} {
+		event := largeEvent(id)
+		stored[id] = event.Content
+		originals = append(originals, event)
+		store.append(event, size)
+	}
+
+	// The caller's events are never stripped
+	for _, event := range originals {
+		if event.Content == nil {
+			t.Fatal("append must not modify the caller's event")
+		}
+	}
+	if stats := store.cache.stats(); stats.Entries != 2 || stats.Bytes != 2*size {
+		t.Errorf("expected cache bounded to 2 payloads, got %+v", stats)
+	}
+
+	events := &localEvents{store: store, headers: store.snapshot()}
+	first := events.At(0)
+	if first.Content == nil || first.Content.Parts[0].Text != originals[0].Content.Parts[0].Text {
+		t.Fatalf("expected evicted payload to be reloaded, got %+v", first.Content)
+	}
+	if *loads != 1 {
+		t.Errorf("expected one reload from storage, got %d", *loads)
+	}
+	if first.ID != "a" || first.Author != "model" {
+		t.Errorf("expected header fields to be preserved, got %+v", first)
+	}
+}
+
+func TestEventStoreScanBatchesReloadsAndKeepsTail(t *testing.T) {
+	size := 2 * inlinePayloadLimit
+	store, stored, loads := newTestStore(2 * size)
+
+	ids := []string{"a", "b", "c", "d", "e"}
+	for _, id := range ids {
+		event := largeEvent(id)
+		stored[id] = event.Content
+		store.append(event, size)
+	}
+
+	events := &localEvents{store: store, headers: store.snapshot()}
+	for round := 0; round < 3; round++ {
+		var got []string
+		for event := range events.All() {
+			if event.Content == nil {
+				t.Fatalf("expected payload for %s", event.ID)
+			}
+			got = append(got, event.ID)
+		}
+		if strings.Join(got, "") != "abcde" {
+			t.Fatalf("expected events in order, got %v", got)
+		}
+	}
+
+	// Each scan reloads the three evicted payloads in one query, and the two
+	// newest payloads stay cached instead of being flushed by the scan
+	if *loads != 3 {
+		t.Errorf("expected one batched reload per scan, got %d", *loads)
+	}
+	if !store.cache.contains(store.scope+"d") || !store.cache.contains(store.scope+"e") {
+		t.Errorf("expected the session tail to stay cached, got %+v", store.cache.stats())
+	}
+	if stats := store.cache.stats(); stats.Hits != 6 {
+		t.Errorf("expected the tail to hit on every scan, got %+v", stats)
+	}
+}
+
+func TestEventsSnapshotIgnoresLaterAppends(t *testing.T) {
+	store, _, _ := newTestStore(defaultPayloadCacheBytes)
+	store.append(&session.Event{ID: "1"}, 0)
+
+	events := &localEvents{store: store, headers: store.snapshot()}
+	store.append(&session.Event{ID: "2"}, 0)
+
+	if events.Len() != 1 || store.len() != 2 {
+		t.Errorf("expected snapshot of 1 event and store of 2, got %d and %d", events.Len(), store.len())
+	}
+	if events.At(1) != nil {
+		t.Error("expected out-of-range access to return nil")
+	}
+}
@@ -9,6 +9,7 @@ import (
 	"fmt"
 	"iter"
 	"log"
+	"net/url"
 	"os"
 	"path/filepath"
 	"strings"
@@ -100,6 +101,9 @@ func (j dynamicJSON) Value() (driver.Value, error) {
 	if len(j) == 0 {
 		return nil, nil
 	}
+	if isBinaryPayload(j) {
+		return []byte(j), nil
+	}
 	return string(j), nil
 }
 
@@ -128,7 +132,7 @@ func (j *dynamicJSON) Scan(value any) error {
 		return pkgerrors.InternalError(fmt.Sprintf("failed to unmarshal JSON value: %T", value))
 	}
 
-	if !json.Valid(bytes) {
+	if !isBinaryPayload(bytes) && !json.Valid(bytes) {
 		return pkgerrors.InvalidInputError(fmt.Sprintf("invalid JSON received from database: %s", string(bytes)))
 	}
 	*j = dynamicJSON(bytes)
@@ -162,17 +166,23 @@ func (js dynamicJSON) GormValue(ctx context.Context, db *gorm.DB) clause.Expr {
 	if len(js) == 0 {
 		return gorm.Expr("NULL")
 	}
+	if isBinaryPayload(js) {
+		// Binary payloads are stored as BLOBs so SQLite keeps them byte-exact
+		return gorm.Expr("?", []byte(js))
+	}
 	return gorm.Expr("?", string(js))
 }
 
 // storageSession represents a session in the database
 type storageSession struct {
-	AppName    string   `gorm:"primaryKey;"`
-	UserID     string   `gorm:"primaryKey;"`
-	ID         string   `gorm:"primaryKey;"`
-	State      stateMap `gorm:"type:text;serializer:json"`
-	CreateTime time.Time
-	UpdateTime time.Time
+	AppName string   `gorm:"primaryKey;"`
+	UserID  string   `gorm:"primaryKey;"`
+	ID      string   `gorm:"primaryKey;"`
+	State   stateMap `gorm:"type:text;serializer:json"`
+	// SnapshotSeq is the last state delta folded into State
+	SnapshotSeq int64
+	CreateTime  time.Time
+	UpdateTime  time.Time
 }
 
 // TableName sets the table name
@@ -210,11 +220,18 @@ func (storageEvent) TableName() string {
 	return "events"
 }
 
+// hasLegacyPayload reports whether the row predates the binary event codec.
+func (e *storageEvent) hasLegacyPayload() bool {
+	return (len(e.Content) > 0 && !isBinaryPayload(e.Content)) ||
+		(len(e.CustomMetadata) > 0 && !isBinaryPayload(e.CustomMetadata))
+}
+
 // storageAppState represents application state
 type storageAppState struct {
-	AppName    string   `gorm:"primaryKey;"`
-	State      stateMap `gorm:"type:text;serializer:json"`
-	UpdateTime time.Time
+	AppName     string   `gorm:"primaryKey;"`
+	State       stateMap `gorm:"type:text;serializer:json"`
+	SnapshotSeq int64
+	UpdateTime  time.Time
 }
 
 // TableName sets the table name
@@ -224,10 +241,11 @@ func (storageAppState) TableName() string {
 
 // storageUserState represents user state
 type storageUserState struct {
-	AppName    string   `gorm:"primaryKey;"`
-	UserID     string   `gorm:"primaryKey;"`
-	State      stateMap `gorm:"type:text;serializer:json"`
-	UpdateTime time.Time
+	AppName     string   `gorm:"primaryKey;"`
+	UserID      string   `gorm:"primaryKey;"`
+	State       stateMap `gorm:"type:text;serializer:json"`
+	SnapshotSeq int64
+	UpdateTime  time.Time
 }
 
 // TableName sets the table name
@@ -242,7 +260,7 @@ type localSession struct {
 	sessionID string
 	state     stateMap
 	updatedAt time.Time
-	events    []*session.Event
+	events    *eventStore
 }
 
 // ID returns the session ID
@@ -258,7 +276,9 @@ func (s *localSession) UserID() string { return s.userID }
 func (s *localSession) State() session.State { return &localState{state: s.state} }
 
 // Events returns the events
-func (s *localSession) Events() session.Events { return &localEvents{events: s.events} }
+func (s *localSession) Events() session.Events {
+	return &localEvents{store: s.events, headers: s.events.snapshot()}
+}
 
 // LastUpdateTime returns the last update time
 func (s *localSession) LastUpdateTime() time.Time { return s.updatedAt }
@@ -288,33 +308,35 @@ func (s *localState) All() iter.Seq2[string, any] {
 	}
 }
 
-// localEvents implements session.Events
-type localEvents struct{ events []*session.Event }
+// localEvents implements session.Events over a snapshot of the tiered event
+// store; detached payloads are reloaded transparently on access.
+type localEvents struct {
+	store   *eventStore
+	headers []*eventHeader
+}
 
 // All returns an iterator over all events
 func (e *localEvents) All() iter.Seq[*session.Event] {
 	return func(yield func(*session.Event) bool) {
-		for _, event := range e.events {
-			if !yield(event) {
-				return
-			}
-		}
+		e.store.scan(e.headers, yield)
 	}
 }
 
 // Len returns the number of events
-func (e *localEvents) Len() int { return len(e.events) }
+func (e *localEvents) Len() int { return len(e.headers) }
 
 // At returns the event at the given index
 func (e *localEvents) At(i int) *session.Event {
-	if i >= 0 && i < len(e.events) {
-		return e.events[i]
+	if i >= 0 && i < len(e.headers) {
+		return e.store.materialize(e.headers[i])
 	}
 	return nil
 }
 
-// appendEvent adds an event to the session and updates session state from event deltas
-func (s *localSession) appendEvent(event *session.Event) error {
+// appendEvent adds an event to the session and updates session state from event deltas.
+// payloadSize is the encoded size of the event content, used to decide whether
+// the payload stays resident or moves to the bounded payload cache.
+func (s *localSession) appendEvent(event *session.Event, payloadSize int) error {
 	if event.Partial {
 		return nil
 	}
@@ -322,14 +344,17 @@ func (s *localSession) appendEvent(event *session.Event) error {
 	if err := updateSessionState(s, processedEvent); err != nil {
 		return pkgerrors.Wrap(pkgerrors.CodeInternal, "error updating session state from event", err)
 	}
-	s.events = append(s.events, event)
+	s.events.append(event, payloadSize)
 	s.updatedAt = event.Timestamp
 	return nil
 }
 
 // SQLiteSessionService provides SQLite-backed session persistence
 type SQLiteSessionService struct {
-	db *gorm.DB
+	db        *gorm.DB
+	payloads  *payloadCache
+	compactor *stateCompactor
+	logFile   *os.File
 }
 
 // NewSQLiteSessionService creates a new SQLite-backed session service
@@ -341,9 +366,18 @@ func NewSQLiteSessionService(dbPath string) (*SQLiteSessionService, error) {
 		return nil, pkgerrors.Wrap(pkgerrors.CodePermission, "failed to create database directory", err)
 	}
 
+	// Database errors, including those of background compactions and
+	// latency writes, go to a log file next to the database rather than
+	// stdout, where they would corrupt the REPL display
+	logFile, err := os.OpenFile(filepath.Join(dir, "sessions.log"), os.O_CREATE|os.O_WRONLY|os.O_APPEND, 0644)
+	if err != nil {
+		return nil, pkgerrors.Wrap(pkgerrors.CodePermission, "failed to open database log", err)
+	}
+	errorLog := log.New(logFile, "", log.LstdFlags)
+
 	// Configure GORM logger to only show errors (not warnings like "record not found")
 	gormLogger := logger.New(
-		log.New(os.Stdout, "\r\n", log.LstdFlags),
+		errorLog,
 		logger.Config{
 			LogLevel:                  logger.Error, // Only log actual errors
 			IgnoreRecordNotFoundError: true,         // Don't log "record not found"
@@ -351,22 +385,43 @@ func NewSQLiteSessionService(dbPath string) (*SQLiteSessionService, error) {
 		},
 	)
 
-	// Open SQLite connection using ncruces/go-sqlite3 (pure Go, no CGO required)
-	db, err := gorm.Open(gormlite.Open(dbPath), &gorm.Config{Logger: gormLogger})
+	// Open SQLite connection using ncruces/go-sqlite3 (pure Go, no CGO required).
+	// Background compactions and latency writes share the database with the
+	// foreground, so writers wait for the lock instead of failing with
+	// SQLITE_BUSY, and WAL lets readers proceed while one of them writes.
+	db, err := gorm.Open(gormlite.Open(sqliteDSN(dbPath)), &gorm.Config{Logger: gormLogger})
 	if err != nil {
+		logFile.Close()
 		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to open SQLite database", err)
 	}
 
-	service := &SQLiteSessionService{db: db}
+	service := &SQLiteSessionService{
+		db:        db,
+		payloads:  newPayloadCache(defaultPayloadCacheBytes),
+		compactor: newStateCompactor(db, errorLog),
+		logFile:   logFile,
+	}
 
 	// Run migrations to ensure schema exists
 	if err := service.migrate(); err != nil {
+		_ = service.Close()
 		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to run migrations", err)
 	}
 
 	return service, nil
 }
 
+// sqliteBusyTimeoutMS is how long a connection waits for a lock held by
+// another writer
+const sqliteBusyTimeoutMS = 10000
+
+// sqliteDSN returns the connection URI for the database at dbPath with a busy
+// timeout and WAL journaling applied to every connection.
+func sqliteDSN(dbPath string) string {
+	uri := url.URL{Scheme: "file", OmitHost: true, Path: filepath.ToSlash(dbPath)}
+	return uri.String() + fmt.Sprintf("?_pragma=busy_timeout(%d)&_pragma=journal_mode(wal)", sqliteBusyTimeoutMS)
+}
+
 // migrate creates the database schema if it doesn't exist
 func (s *SQLiteSessionService) migrate() error {
 	return s.db.AutoMigrate(
@@ -374,6 +429,8 @@ func (s *SQLiteSessionService) migrate() error {
 		&storageEvent{},
 		&storageAppState{},
 		&storageUserState{},
+		&storageStateDelta{},
+		&storageToolLatency{},
 	)
 }
 
@@ -413,66 +470,32 @@ func (s *SQLiteSessionService) Create(ctx context.Context, req *session.CreateRe
 	// Extract state deltas
 	appDelta, userDelta, sessionState := extractStateDeltas(state)
 
-	// Get or create app state
-	var appState storageAppState
-	if err := tx.Where("app_name = ?", req.AppName).First(&appState).Error; err != nil {
-		if errors.Is(err, gorm.ErrRecordNotFound) {
-			// Create new app state
-			appState = storageAppState{AppName: req.AppName, State: make(stateMap), UpdateTime: time.Now()}
-			if err := tx.Create(&appState).Error; err != nil {
-				tx.Rollback()
-				return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to create app state", err)
-			}
-		} else {
-			tx.Rollback()
-			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch app state", err)
-		}
-	}
-
-	// Merge app state delta
-	if appState.State == nil {
-		appState.State = make(stateMap)
+	// Ensure the app and user snapshot rows exist; their changes are logged as deltas
+	now := time.Now()
+	if err := tx.Where(storageAppState{AppName: req.AppName}).
+		Attrs(storageAppState{State: make(stateMap), UpdateTime: now}).
+		FirstOrCreate(&storageAppState{}).Error; err != nil {
+		tx.Rollback()
+		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to create app state", err)
 	}
-	for k, v := range appDelta {
-		appState.State[k] = v
+	if err := tx.Where(storageUserState{AppName: req.AppName, UserID: req.UserID}).
+		Attrs(storageUserState{State: make(stateMap), UpdateTime: now}).
+		FirstOrCreate(&storageUserState{}).Error; err != nil {
+		tx.Rollback()
+		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to create user state", err)
 	}
-	appState.UpdateTime = time.Now()
-	if err := tx.Save(&appState).Error; err != nil {
+	appWritten, err := appendStateDelta(tx, appScope(req.AppName), appDelta)
+	if err != nil {
 		tx.Rollback()
 		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to save app state", err)
 	}
-
-	// Get or create user state
-	var userState storageUserState
-	if err := tx.Where("app_name = ? AND user_id = ?", req.AppName, req.UserID).First(&userState).Error; err != nil {
-		if errors.Is(err, gorm.ErrRecordNotFound) {
-			// Create new user state
-			userState = storageUserState{AppName: req.AppName, UserID: req.UserID, State: make(stateMap), UpdateTime: time.Now()}
-			if err := tx.Create(&userState).Error; err != nil {
-				tx.Rollback()
-				return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to create user state", err)
-			}
-		} else {
-			tx.Rollback()
-			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch user state", err)
-		}
-	}
-
-	// Merge user state delta
-	if userState.State == nil {
-		userState.State = make(stateMap)
-	}
-	for k, v := range userDelta {
-		userState.State[k] = v
-	}
-	userState.UpdateTime = time.Now()
-	if err := tx.Save(&userState).Error; err != nil {
+	userWritten, err := appendStateDelta(tx, userScope(req.AppName, req.UserID), userDelta)
+	if err != nil {
 		tx.Rollback()
 		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to save user state", err)
 	}
 
-	// Create session
-	now := time.Now()
+	// Create session; its initial state is the first snapshot
 	storageSession := &storageSession{AppName: req.AppName, UserID: req.UserID, ID: sessionID, State: sessionState, CreateTime: now, UpdateTime: now}
 	if err := tx.Create(storageSession).Error; err != nil {
 		tx.Rollback()
@@ -484,8 +507,19 @@ func (s *SQLiteSessionService) Create(ctx context.Context, req *session.CreateRe
 		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to commit transaction", err)
 	}
 
+	if appWritten {
+		s.compactor.note(appScope(req.AppName), 1)
+	}
+	if userWritten {
+		s.compactor.note(userScope(req.AppName, req.UserID), 1)
+	}
+
 	// Create response session
-	localSession := &localSession{appName: req.AppName, userID: req.UserID, sessionID: sessionID, state: mergeStates(appState.State, userState.State, sessionState), updatedAt: now, events: make([]*session.Event, 0)}
+	merged, err := s.mergedState(ctx, storageSession)
+	if err != nil {
+		return nil, err
+	}
+	localSession := s.newLocalSession(req.AppName, req.UserID, sessionID, merged, now)
 
 	return &session.CreateResponse{Session: localSession}, nil
 }
@@ -504,17 +538,9 @@ func (s *SQLiteSessionService) Get(ctx context.Context, req *session.GetRequest)
 		}
 		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch session", err)
 	}
-	var appState storageAppState
-	if err := s.db.WithContext(ctx).
-		Where("app_name = ?", req.AppName).
-		First(&appState).Error; err != nil && !errors.Is(err, gorm.ErrRecordNotFound) {
-		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch app state", err)
-	}
-	var userState storageUserState
-	if err := s.db.WithContext(ctx).
-		Where("app_name = ? AND user_id = ?", req.AppName, req.UserID).
-		First(&userState).Error; err != nil && !errors.Is(err, gorm.ErrRecordNotFound) {
-		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch user state", err)
+	state, err := s.mergedState(ctx, &storageSession)
+	if err != nil {
+		return nil, err
 	}
 	var events []storageEvent
 	eventQuery := s.db.WithContext(ctx).
@@ -536,13 +562,9 @@ func (s *SQLiteSessionService) Get(ctx context.Context, req *session.GetRequest)
 			events[i], events[opp] = events[opp], events[i]
 		}
 	}
-	localSession := &localSession{appName: req.AppName, userID: req.UserID, sessionID: req.SessionID, state: mergeStates(appState.State, userState.State, storageSession.State), updatedAt: storageSession.UpdateTime, events: make([]*session.Event, len(events))}
-	for i, e := range events {
-		evt, err := convertStorageEventToSessionEvent(&e)
-		if err != nil {
-			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to convert event", err)
-		}
-		localSession.events[i] = evt
+	localSession := s.newLocalSession(req.AppName, req.UserID, req.SessionID, state, storageSession.UpdateTime)
+	if err := s.loadEvents(ctx, localSession, events); err != nil {
+		return nil, err
 	}
 	return &session.GetResponse{Session: localSession}, nil
 }
@@ -560,36 +582,21 @@ func (s *SQLiteSessionService) List(ctx context.Context, req *session.ListReques
 	if err := query.Find(&sessions).Error; err != nil {
 		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to list sessions", err)
 	}
-	var appState storageAppState
-	if err := s.db.WithContext(ctx).Where("app_name = ?", req.AppName).First(&appState).Error; err != nil && !errors.Is(err, gorm.ErrRecordNotFound) {
-		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch app state", err)
-	}
 	response := &session.ListResponse{Sessions: make([]session.Session, len(sessions))}
-	for i, sess := range sessions {
-		var userState storageUserState
-		if err := s.db.WithContext(ctx).Where("app_name = ? AND user_id = ?", req.AppName, sess.UserID).First(&userState).Error; err != nil && !errors.Is(err, gorm.ErrRecordNotFound) {
-			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch user state", err)
+	for i := range sessions {
+		sess := &sessions[i]
+		state, err := s.mergedState(ctx, sess)
+		if err != nil {
+			return nil, err
 		}
 
 		var events []storageEvent
 		if err := s.db.WithContext(ctx).Where("app_name = ? AND user_id = ? AND session_id = ?", req.AppName, sess.UserID, sess.ID).Order("timestamp ASC").Find(&events).Error; err != nil {
 			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch events", err)
 		}
-		sessionEvents := make([]*session.Event, len(events))
-		for j, e := range events {
-			evt, err := convertStorageEventToSessionEvent(&e)
-			if err != nil {
-				return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to convert event", err)
-			}
-			sessionEvents[j] = evt
-		}
-		localSession := &localSession{
-			appName:   sess.AppName,
-			userID:    sess.UserID,
-			sessionID: sess.ID,
-			state:     mergeStates(appState.State, userState.State, sess.State),
-			updatedAt: sess.UpdateTime,
-			events:    sessionEvents,
+		localSession := s.newLocalSession(sess.AppName, sess.UserID, sess.ID, state, sess.UpdateTime)
+		if err := s.loadEvents(ctx, localSession, events); err != nil {
+			return nil, err
 		}
 		response.Sessions[i] = localSession
 	}
@@ -613,6 +620,10 @@ func (s *SQLiteSessionService) Delete(ctx context.Context, req *session.DeleteRe
 		tx.Rollback()
 		return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to delete session", err)
 	}
+	if err := sessionScope(req.AppName, req.UserID, req.SessionID).deltaQuery(tx).Delete(&storageStateDelta{}).Error; err != nil {
+		tx.Rollback()
+		return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to delete session state", err)
+	}
 	if err := tx.Commit().Error; err != nil {
 		return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to commit transaction", err)
 	}
@@ -635,91 +646,41 @@ func (s *SQLiteSessionService) AppendEvent(ctx context.Context, sess session.Ses
 	if !ok {
 		return pkgerrors.InternalError(fmt.Sprintf("unexpected session type: %T", sess))
 	}
-	if err := localSession.appendEvent(event); err != nil {
+	storageEvent, err := convertSessionEventToStorageEvent(localSession, event)
+	if err != nil {
+		return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to convert event", err)
+	}
+	if err := localSession.appendEvent(event, len(storageEvent.Content)); err != nil {
 		return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to append event to in-memory session", err)
 	}
 	tx := s.db.WithContext(ctx).Begin()
 	if tx.Error != nil {
 		return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to start transaction", tx.Error)
 	}
-	storageEvent, err := convertSessionEventToStorageEvent(localSession, event)
-	if err != nil {
-		tx.Rollback()
-		return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to convert event", err)
-	}
 	if err := tx.Create(storageEvent).Error; err != nil {
 		tx.Rollback()
 		return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to append event", err)
 	}
+	// State changes are appended to the delta log; snapshots are rebuilt in the background
+	var written []stateScope
 	if len(event.Actions.StateDelta) > 0 {
 		appDelta, userDelta, sessionDelta := extractStateDeltas(event.Actions.StateDelta)
-		if len(appDelta) > 0 {
-			var appState storageAppState
-			if err := tx.Where("app_name = ?", localSession.appName).First(&appState).Error; err != nil {
-				if errors.Is(err, gorm.ErrRecordNotFound) {
-					appState = storageAppState{AppName: localSession.appName, State: make(stateMap), UpdateTime: time.Now()}
-					if err := tx.Create(&appState).Error; err != nil {
-						tx.Rollback()
-						return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to create app state", err)
-					}
-				} else {
-					tx.Rollback()
-					return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch app state", err)
-				}
-			}
-			if appState.State == nil {
-				appState.State = make(stateMap)
-			}
-			for k, v := range appDelta {
-				appState.State[k] = v
-			}
-			appState.UpdateTime = time.Now()
-			if err := tx.Save(&appState).Error; err != nil {
-				tx.Rollback()
-				return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to update app state", err)
-			}
-		}
-		if len(userDelta) > 0 {
-			var userState storageUserState
-			if err := tx.Where("app_name = ? AND user_id = ?", localSession.appName, localSession.userID).First(&userState).Error; err != nil {
-				if errors.Is(err, gorm.ErrRecordNotFound) {
-					userState = storageUserState{AppName: localSession.appName, UserID: localSession.userID, State: make(stateMap), UpdateTime: time.Now()}
-					if err := tx.Create(&userState).Error; err != nil {
-						tx.Rollback()
-						return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to create user state", err)
-					}
-				} else {
-					tx.Rollback()
-					return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch user state", err)
-				}
-			}
-			if userState.State == nil {
-				userState.State = make(stateMap)
-			}
-			for k, v := range userDelta {
-				userState.State[k] = v
-			}
-			userState.UpdateTime = time.Now()
-			if err := tx.Save(&userState).Error; err != nil {
-				tx.Rollback()
-				return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to update user state", err)
-			}
-		}
-		if len(sessionDelta) > 0 {
-			var currentSession storageSession
-			if err := tx.Where("app_name = ? AND user_id = ? AND id = ?", localSession.appName, localSession.userID, localSession.sessionID).First(&currentSession).Error; err != nil {
+		for _, d := range []struct {
+			scope stateScope
+			delta map[string]any
+			what  string
+		}{
+			{appScope(localSession.appName), appDelta, "app"},
+			{userScope(localSession.appName, localSession.userID), userDelta, "user"},
+			{sessionScope(localSession.appName, localSession.userID, localSession.sessionID), sessionDelta, "session"},
+		} {
+			ok, err := appendStateDelta(tx, d.scope, d.delta)
+			if err != nil {
 				tx.Rollback()
-				return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch session for state update", err)
+				return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to update "+d.what+" state", err)
 			}
-			if currentSession.State == nil {
-				currentSession.State = make(stateMap)
-			}
-			for k, v := range sessionDelta {
-				currentSession.State[k] = v
-			}
-			if err := tx.Model(&storageSession{}).Where("app_name = ? AND user_id = ? AND id = ?", localSession.appName, localSession.userID, localSession.sessionID).Update("state", currentSession.State).Error; err != nil {
-				tx.Rollback()
-				return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to update session state", err)
+			if ok {
+				written = append(written, d.scope)
 			}
 		}
 	}
@@ -730,11 +691,116 @@ func (s *SQLiteSessionService) AppendEvent(ctx context.Context, sess session.Ses
 	if err := tx.Commit().Error; err != nil {
 		return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to commit transaction", err)
 	}
+	for _, scope := range written {
+		s.compactor.note(scope, 1)
+	}
 	return nil
 }
 
-// Close closes the database connection
+// newLocalSession creates an in-memory session whose large event payloads are
+// kept in the service's bounded payload cache and reloaded from SQLite.
+func (s *SQLiteSessionService) newLocalSession(appName, userID, sessionID string, state stateMap, updatedAt time.Time) *localSession {
+	scope := appName + "\x00" + userID + "\x00" + sessionID + "\x00"
+	load := func(eventIDs []string) (map[string]*genai.Content, error) {
+		var rows []storageEvent
+		if err := s.db.Select("id", "content").
+			Where("app_name = ? AND user_id = ? AND session_id = ? AND id IN ?", appName, userID, sessionID, eventIDs).
+			Find(&rows).Error; err != nil {
+			return nil, err
+		}
+		if len(rows) == 0 {
+			return nil, gorm.ErrRecordNotFound
+		}
+		contents := make(map[string]*genai.Content, len(rows))
+		for _, row := range rows {
+			if len(row.Content) == 0 {
+				continue
+			}
+			content, err := decodeContent(row.Content)
+			if err != nil {
+				return nil, err
+			}
+			contents[row.ID] = content
+		}
+		return contents, nil
+	}
+	return &localSession{
+		appName:   appName,
+		userID:    userID,
+		sessionID: sessionID,
+		state:     state,
+		updatedAt: updatedAt,
+		events:    newEventStore(scope, s.payloads, load),
+	}
+}
+
+// loadEvents decodes stored rows into the session's event store.
+func (s *SQLiteSessionService) loadEvents(ctx context.Context, sess *localSession, rows []storageEvent) error {
+	events := make([]*session.Event, len(rows))
+	for i := range rows {
+		evt, err := convertStorageEventToSessionEvent(&rows[i])
+		if err != nil {
+			return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to convert event", err)
+		}
+		events[i] = evt
+	}
+	s.upgradeLegacyEvents(ctx, rows, events)
+	for i, evt := range events {
+		sess.events.append(evt, len(rows[i].Content))
+	}
+	return nil
+}
+
+// upgradeLegacyEvents rewrites rows still holding JSON payloads in the binary
+// event codec, using the already decoded events. It runs lazily on read so old
+// databases migrate without a blocking upgrade step; failures are ignored
+// because the legacy format remains readable.
+func (s *SQLiteSessionService) upgradeLegacyEvents(ctx context.Context, rows []storageEvent, events []*session.Event) {
+	var legacy []int
+	for i := range rows {
+		if rows[i].hasLegacyPayload() {
+			legacy = append(legacy, i)
+		}
+	}
+	if len(legacy) == 0 {
+		return
+	}
+
+	_ = s.db.WithContext(ctx).Transaction(func(tx *gorm.DB) error {
+		for _, i := range legacy {
+			row := &rows[i]
+			updates := map[string]any{}
+			if len(row.Content) > 0 && events[i].Content != nil {
+				content, err := encodeContent(events[i].Content)
+				if err != nil {
+					continue
+				}
+				updates["content"] = dynamicJSON(content)
+			}
+			if len(row.CustomMetadata) > 0 && len(events[i].CustomMetadata) > 0 {
+				custom, err := encodeMap(events[i].CustomMetadata)
+				if err != nil {
+					continue
+				}
+				updates["custom_metadata"] = dynamicJSON(custom)
+			}
+			if len(updates) == 0 {
+				continue
+			}
+			if err := tx.Model(&storageEvent{}).
+				Where("id = ? AND app_name = ? AND user_id = ? AND session_id = ?", row.ID, row.AppName, row.UserID, row.SessionID).
+				Updates(updates).Error; err != nil {
+				return err
+			}
+		}
+		return nil
+	})
+}
+
+// Close waits for running state compactions and closes the database connection
 func (s *SQLiteSessionService) Close() error {
+	s.compactor.wait()
+	defer s.logFile.Close()
 	sqlDB, err := s.db.DB()
 	if err != nil {
 		return err
@@ -795,8 +861,9 @@ func convertStorageEventToSessionEvent(se *storageEvent) (*session.Event, error)
 	}
 	var content *genai.Content
 	if len(se.Content) > 0 {
-		if err := json.Unmarshal(se.Content, &content); err != nil {
-			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to unmarshal content", err)
+		var err error
+		if content, err = decodeContent(se.Content); err != nil {
+			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to decode content", err)
 		}
 	}
 	var groundingMetadata *genai.GroundingMetadata
@@ -807,8 +874,9 @@ func convertStorageEventToSessionEvent(se *storageEvent) (*session.Event, error)
 	}
 	var customMetadata map[string]any
 	if len(se.CustomMetadata) > 0 {
-		if err := json.Unmarshal(se.CustomMetadata, &customMetadata); err != nil {
-			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to unmarshal custom metadata", err)
+		var err error
+		if customMetadata, err = decodeMap(se.CustomMetadata); err != nil {
+			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to decode custom metadata", err)
 		}
 	}
 	var usageMetadata *genai.GenerateContentResponseUsageMetadata
@@ -884,11 +952,11 @@ func convertSessionEventToStorageEvent(sess *localSession, event *session.Event)
 	storageEv.TurnComplete = &event.TurnComplete
 	storageEv.Interrupted = &event.Interrupted
 	if event.Content != nil {
-		contentJSON, err := json.Marshal(event.Content)
+		contentBytes, err := encodeContent(event.Content)
 		if err != nil {
-			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to marshal content", err)
+			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to encode content", err)
 		}
-		storageEv.Content = contentJSON
+		storageEv.Content = contentBytes
 	}
 	if event.GroundingMetadata != nil {
 		groundingJSON, err := json.Marshal(event.GroundingMetadata)
@@ -898,11 +966,11 @@ func convertSessionEventToStorageEvent(sess *localSession, event *session.Event)
 		storageEv.GroundingMetadata = groundingJSON
 	}
 	if len(event.CustomMetadata) > 0 {
-		customJSON, err := json.Marshal(event.CustomMetadata)
+		customBytes, err := encodeMap(event.CustomMetadata)
 		if err != nil {
-			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to marshal custom metadata", err)
+			return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to encode custom metadata", err)
 		}
-		storageEv.CustomMetadata = customJSON
+		storageEv.CustomMetadata = customBytes
 	}
 	if event.UsageMetadata != nil {
 		usageJSON, err := json.Marshal(event.UsageMetadata)
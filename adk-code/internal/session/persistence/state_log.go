@@ -0,0 +1,267 @@
+package persistence
+
+import (
+	"context"
+	"errors"
+	"log"
+	"sync"
+	"time"
+
+	"gorm.io/gorm"
+
+	pkgerrors "adk-code/pkg/errors"
+)
+
+// stateCompactionThreshold is the number of deltas after which a scope's
+// snapshot is rebuilt in the background
+const stateCompactionThreshold = 64
+
+// State is event-sourced: the State column of app_states, user_states and
+// sessions is a snapshot covering every delta up to its SnapshotSeq, and each
+// state change is appended to state_deltas. Reads fold the tail of deltas over
+// the snapshot; writes insert only the delta.
+
+// storageStateDelta is one state change for an app (UserID and SessionID
+// empty), a user (SessionID empty) or a session.
+type storageStateDelta struct {
+	Seq        int64    `gorm:"primaryKey;autoIncrement"`
+	AppName    string   `gorm:"index:idx_state_deltas_scope,priority:1"`
+	UserID     string   `gorm:"index:idx_state_deltas_scope,priority:2"`
+	SessionID  string   `gorm:"index:idx_state_deltas_scope,priority:3"`
+	Delta      stateMap `gorm:"type:text;serializer:json"`
+	CreateTime time.Time
+}
+
+// TableName sets the table name
+func (storageStateDelta) TableName() string {
+	return "state_deltas"
+}
+
+// stateScope identifies the owner of a state snapshot and its deltas.
+type stateScope struct {
+	appName, userID, sessionID string
+}
+
+func appScope(appName string) stateScope { return stateScope{appName: appName} }
+func userScope(appName, userID string) stateScope {
+	return stateScope{appName: appName, userID: userID}
+}
+func sessionScope(appName, userID, sessionID string) stateScope {
+	return stateScope{appName: appName, userID: userID, sessionID: sessionID}
+}
+
+// snapshotQuery selects the scope's snapshot row.
+func (sc stateScope) snapshotQuery(tx *gorm.DB) *gorm.DB {
+	switch {
+	case sc.userID == "":
+		return tx.Model(&storageAppState{}).Where("app_name = ?", sc.appName)
+	case sc.sessionID == "":
+		return tx.Model(&storageUserState{}).Where("app_name = ? AND user_id = ?", sc.appName, sc.userID)
+	default:
+		return tx.Model(&storageSession{}).Where("app_name = ? AND user_id = ? AND id = ?", sc.appName, sc.userID, sc.sessionID)
+	}
+}
+
+// deltaQuery selects the scope's deltas.
+func (sc stateScope) deltaQuery(tx *gorm.DB) *gorm.DB {
+	return tx.Model(&storageStateDelta{}).
+		Where("app_name = ? AND user_id = ? AND session_id = ?", sc.appName, sc.userID, sc.sessionID)
+}
+
+// appendStateDelta inserts a delta for the scope and reports whether one was written.
+func appendStateDelta(tx *gorm.DB, scope stateScope, delta map[string]any) (bool, error) {
+	if len(delta) == 0 {
+		return false, nil
+	}
+	row := &storageStateDelta{
+		AppName:    scope.appName,
+		UserID:     scope.userID,
+		SessionID:  scope.sessionID,
+		Delta:      delta,
+		CreateTime: time.Now(),
+	}
+	if err := tx.Create(row).Error; err != nil {
+		return false, err
+	}
+	return true, nil
+}
+
+// foldState applies the deltas recorded after snapshotSeq to a copy of the
+// snapshot. It also returns how many deltas were applied.
+func foldState(tx *gorm.DB, scope stateScope, snapshot stateMap, snapshotSeq int64) (stateMap, int, error) {
+	var tail []storageStateDelta
+	if err := scope.deltaQuery(tx).Where("seq > ?", snapshotSeq).Order("seq ASC").Find(&tail).Error; err != nil {
+		return nil, 0, err
+	}
+	state := make(stateMap, len(snapshot))
+	for k, v := range snapshot {
+		state[k] = v
+	}
+	for _, d := range tail {
+		for k, v := range d.Delta {
+			state[k] = v
+		}
+	}
+	return state, len(tail), nil
+}
+
+// stateCompactor rebuilds snapshots in the background once enough deltas
+// have accumulated for a scope.
+type stateCompactor struct {
+	db       *gorm.DB
+	errorLog *log.Logger
+
+	mu       sync.Mutex
+	pending  map[stateScope]int // deltas appended since the last compaction
+	inFlight map[stateScope]bool
+	wg       sync.WaitGroup
+}
+
+func newStateCompactor(db *gorm.DB, errorLog *log.Logger) *stateCompactor {
+	return &stateCompactor{
+		db:       db,
+		errorLog: errorLog,
+		pending:  make(map[stateScope]int),
+		inFlight: make(map[stateScope]bool),
+	}
+}
+
+// note records that a scope has count more deltas than its snapshot and
+// starts a compaction once the threshold is reached.
+func (c *stateCompactor) note(scope stateScope, count int) {
+	c.mu.Lock()
+	c.pending[scope] += count
+	if c.pending[scope] < stateCompactionThreshold {
+		c.mu.Unlock()
+		return
+	}
+	c.startLocked(scope)
+	c.mu.Unlock()
+}
+
+// start compacts a scope in the background unless a compaction is running.
+func (c *stateCompactor) start(scope stateScope) {
+	c.mu.Lock()
+	c.startLocked(scope)
+	c.mu.Unlock()
+}
+
+func (c *stateCompactor) startLocked(scope stateScope) {
+	if c.inFlight[scope] {
+		return
+	}
+	c.pending[scope] = 0
+	c.inFlight[scope] = true
+	c.wg.Add(1)
+
+	go func() {
+		defer c.wg.Done()
+		// Failures are retried when the next threshold is reached
+		if err := c.compact(context.Background(), scope); err != nil {
+			c.errorLog.Printf("state compaction of %+v failed: %v", scope, err)
+		}
+		c.mu.Lock()
+		delete(c.inFlight, scope)
+		c.mu.Unlock()
+	}()
+}
+
+// compact folds all deltas of a scope into its snapshot and deletes them.
+func (c *stateCompactor) compact(ctx context.Context, scope stateScope) error {
+	return c.db.WithContext(ctx).Transaction(func(tx *gorm.DB) error {
+		var snapshot struct {
+			State       stateMap
+			SnapshotSeq int64
+		}
+		err := scope.snapshotQuery(tx).Select("state", "snapshot_seq").Take(&snapshot).Error
+		if errors.Is(err, gorm.ErrRecordNotFound) {
+			// The owner was deleted; its deltas are garbage
+			return scope.deltaQuery(tx).Delete(&storageStateDelta{}).Error
+		}
+		if err != nil {
+			return err
+		}
+
+		var lastSeq int64
+		if err := scope.deltaQuery(tx).Select("COALESCE(MAX(seq), 0)").Scan(&lastSeq).Error; err != nil {
+			return err
+		}
+		if lastSeq <= snapshot.SnapshotSeq {
+			return nil
+		}
+		state, _, err := foldState(tx, scope, snapshot.State, snapshot.SnapshotSeq)
+		if err != nil {
+			return err
+		}
+
+		if err := scope.snapshotQuery(tx).Updates(map[string]any{"state": state, "snapshot_seq": lastSeq}).Error; err != nil {
+			return err
+		}
+		return scope.deltaQuery(tx).Where("seq <= ?", lastSeq).Delete(&storageStateDelta{}).Error
+	})
+}
+
+// wait blocks until running compactions finish.
+func (c *stateCompactor) wait() {
+	c.wg.Wait()
+}
+
+// mergedState reads the folded app, user and session state for a session
+// in one transaction, so a concurrent compaction is never observed halfway.
+// It schedules compaction for scopes whose delta tail has grown long.
+func (s *SQLiteSessionService) mergedState(ctx context.Context, sess *storageSession) (stateMap, error) {
+	var merged stateMap
+	tails := make(map[stateScope]int, 3)
+	err := s.db.WithContext(ctx).Transaction(func(tx *gorm.DB) error {
+		var appState storageAppState
+		if err := tx.Where("app_name = ?", sess.AppName).First(&appState).Error; err != nil && !errors.Is(err, gorm.ErrRecordNotFound) {
+			return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch app state", err)
+		}
+		var userState storageUserState
+		if err := tx.Where("app_name = ? AND user_id = ?", sess.AppName, sess.UserID).First(&userState).Error; err != nil && !errors.Is(err, gorm.ErrRecordNotFound) {
+			return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch user state", err)
+		}
+		// The caller's row may predate a compaction that has since moved the
+		// snapshot forward and deleted the deltas it folded
+		var sessionState struct {
+			State       stateMap
+			SnapshotSeq int64
+		}
+		if err := sessionScope(sess.AppName, sess.UserID, sess.ID).snapshotQuery(tx).
+			Select("state", "snapshot_seq").Take(&sessionState).Error; err != nil {
+			return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fetch session state", err)
+		}
+
+		scopes := []struct {
+			scope    stateScope
+			snapshot stateMap
+			seq      int64
+		}{
+			{appScope(sess.AppName), appState.State, appState.SnapshotSeq},
+			{userScope(sess.AppName, sess.UserID), userState.State, userState.SnapshotSeq},
+			{sessionScope(sess.AppName, sess.UserID, sess.ID), sessionState.State, sessionState.SnapshotSeq},
+		}
+		folded := make([]stateMap, len(scopes))
+		for i, sc := range scopes {
+			state, tail, err := foldState(tx, sc.scope, sc.snapshot, sc.seq)
+			if err != nil {
+				return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to fold state deltas", err)
+			}
+			folded[i] = state
+			tails[sc.scope] = tail
+		}
+		merged = mergeStates(folded[0], folded[1], folded[2])
+		return nil
+	})
+	if err != nil {
+		return nil, err
+	}
+
+	// Long tails left over from earlier runs are compacted on read
+	for scope, tail := range tails {
+		if tail >= stateCompactionThreshold {
+			s.compactor.start(scope)
+		}
+	}
+	return merged, nil
+}
@@ -0,0 +1,123 @@
+package persistence
+
+import (
+	"context"
+	"fmt"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"google.golang.org/adk/session"
+)
+
+func TestStateDeltasFoldAndCompact(t *testing.T) {
+	ctx := context.Background()
+	dbPath := filepath.Join(t.TempDir(), "sessions.db")
+	service, err := NewSQLiteSessionService(dbPath)
+	if err != nil {
+		t.Fatalf("NewSQLiteSessionService failed: %v", err)
+	}
+
+	created, err := service.Create(ctx, &session.CreateRequest{
+		AppName: "app", UserID: "user", SessionID: "sess",
+		State: map[string]any{"mode": "plan", "app:theme": "dark"},
+	})
+	if err != nil {
+		t.Fatalf("Create failed: %v", err)
+	}
+
+	// Enough events to cross the compaction threshold for the session scope
+	events := stateCompactionThreshold + 3
+	for i := 0; i < events; i++ {
+		event := &session.Event{ID: fmt.Sprintf("e%d", i), Author: "model", Timestamp: time.Now()}
+		event.Actions.StateDelta = map[string]any{"counter": float64(i)}
+		if i == events-1 {
+			event.Actions.StateDelta["user:name"] = "ada"
+		}
+		if err := service.AppendEvent(ctx, created.Session, event); err != nil {
+			t.Fatalf("AppendEvent %d failed: %v", i, err)
+		}
+	}
+	if err := service.Close(); err != nil {
+		t.Fatalf("Close failed: %v", err)
+	}
+
+	reopened, err := NewSQLiteSessionService(dbPath)
+	if err != nil {
+		t.Fatalf("reopen failed: %v", err)
+	}
+	defer reopened.Close()
+
+	got, err := reopened.Get(ctx, &session.GetRequest{AppName: "app", UserID: "user", SessionID: "sess"})
+	if err != nil {
+		t.Fatalf("Get failed: %v", err)
+	}
+	want := map[string]any{"mode": "plan", "counter": float64(events - 1), "app:theme": "dark", "user:name": "ada"}
+	for key, value := range want {
+		if v, err := got.Session.State().Get(key); err != nil || v != value {
+			t.Errorf("state %q: expected %v, got %v (%v)", key, value, v, err)
+		}
+	}
+
+	// Compaction folded the session deltas into the snapshot
+	var snapshot storageSession
+	if err := reopened.db.Where("app_name = ? AND user_id = ? AND id = ?", "app", "user", "sess").First(&snapshot).Error; err != nil {
+		t.Fatalf("fetch session failed: %v", err)
+	}
+	if snapshot.SnapshotSeq == 0 {
+		t.Error("expected the session snapshot to have been compacted")
+	}
+	var tail int64
+	sessionScope("app", "user", "sess").deltaQuery(reopened.db).Count(&tail)
+	if tail >= stateCompactionThreshold {
+		t.Errorf("expected compaction to trim the delta log, %d deltas remain", tail)
+	}
+
+	// Deleting the session drops its deltas
+	if err := reopened.Delete(ctx, &session.DeleteRequest{AppName: "app", UserID: "user", SessionID: "sess"}); err != nil {
+		t.Fatalf("Delete failed: %v", err)
+	}
+	sessionScope("app", "user", "sess").deltaQuery(reopened.db).Count(&tail)
+	if tail != 0 {
+		t.Errorf("expected no session deltas after delete, got %d", tail)
+	}
+}
+
+func TestMergedStateSeesCompactionAfterSessionRead(t *testing.T) {
+	ctx := context.Background()
+	service, err := NewSQLiteSessionService(filepath.Join(t.TempDir(), "sessions.db"))
+	if err != nil {
+		t.Fatalf("NewSQLiteSessionService failed: %v", err)
+	}
+	defer service.Close()
+
+	created, err := service.Create(ctx, &session.CreateRequest{AppName: "app", UserID: "user", SessionID: "sess"})
+	if err != nil {
+		t.Fatalf("Create failed: %v", err)
+	}
+	for i := 0; i < 3; i++ {
+		event := &session.Event{ID: fmt.Sprintf("e%d", i), Author: "model", Timestamp: time.Now()}
+		event.Actions.StateDelta = map[string]any{"counter": float64(i)}
+		if err := service.AppendEvent(ctx, created.Session, event); err != nil {
+			t.Fatalf("AppendEvent %d failed: %v", i, err)
+		}
+	}
+
+	// Read the session row as Get does, then let a compaction fold and
+	// delete the deltas before the state is merged
+	var stale storageSession
+	if err := service.db.Where("app_name = ? AND user_id = ? AND id = ?", "app", "user", "sess").First(&stale).Error; err != nil {
+		t.Fatalf("fetch session failed: %v", err)
+	}
+	if err := service.compactor.compact(ctx, sessionScope("app", "user", "sess")); err != nil {
+		t.Fatalf("compact failed: %v", err)
+	}
+
+	state, err := service.mergedState(ctx, &stale)
+	if err != nil {
+		t.Fatalf("mergedState failed: %v", err)
+	}
+	if state["counter"] != float64(2) {
+		t.Errorf("expected the compacted deltas to be visible, got %v", state)
+	}
+}
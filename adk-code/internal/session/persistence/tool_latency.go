@@ -0,0 +1,83 @@
+package persistence
+
+import (
+	"context"
+	"time"
+
+	"gorm.io/gorm"
+
+	"adk-code/internal/tracking"
+	pkgerrors "adk-code/pkg/errors"
+)
+
+// storageToolLatency is one recorded tool run, kept so adaptive timeouts
+// survive restarts.
+type storageToolLatency struct {
+	ID         int64  `gorm:"primaryKey;autoIncrement"`
+	Tool       string `gorm:"index:idx_tool_latencies_key,priority:1"`
+	Prefix     string `gorm:"index:idx_tool_latencies_key,priority:2"`
+	DurationMS int64
+	TimedOut   bool
+	CreateTime time.Time
+}
+
+// TableName sets the table name
+func (storageToolLatency) TableName() string {
+	return "tool_latencies"
+}
+
+// recentLatencyRows ranks each tool and prefix's runs from newest to oldest
+const recentLatencyRows = `SELECT id, row_number() OVER (PARTITION BY tool, prefix ORDER BY id DESC) AS pos FROM tool_latencies`
+
+// ToolLatencyStore persists tool latency samples in the session database.
+// It implements tracking.LatencyStore.
+type ToolLatencyStore struct {
+	db *gorm.DB
+}
+
+// ToolLatencies returns the tool latency store backed by this database.
+func (s *SQLiteSessionService) ToolLatencies() *ToolLatencyStore {
+	return &ToolLatencyStore{db: s.db}
+}
+
+// AppendLatency records one tool run.
+func (s *ToolLatencyStore) AppendLatency(ctx context.Context, sample tracking.LatencySample) error {
+	row := storageToolLatency{
+		Tool:       sample.Tool,
+		Prefix:     sample.Prefix,
+		DurationMS: sample.Duration.Milliseconds(),
+		TimedOut:   sample.TimedOut,
+		CreateTime: sample.Time,
+	}
+	if err := s.db.WithContext(ctx).Create(&row).Error; err != nil {
+		return pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to record tool latency", err)
+	}
+	return nil
+}
+
+// RecentLatencies returns the newest perKey runs of each tool and prefix,
+// oldest first, and deletes older runs.
+func (s *ToolLatencyStore) RecentLatencies(ctx context.Context, perKey int) ([]tracking.LatencySample, error) {
+	var rows []storageToolLatency
+	err := s.db.WithContext(ctx).Transaction(func(tx *gorm.DB) error {
+		if err := tx.Exec(`DELETE FROM tool_latencies WHERE id IN (SELECT id FROM (`+recentLatencyRows+`) WHERE pos > ?)`, perKey).Error; err != nil {
+			return err
+		}
+		return tx.Order("id").Find(&rows).Error
+	})
+	if err != nil {
+		return nil, pkgerrors.Wrap(pkgerrors.CodeInternal, "failed to load tool latencies", err)
+	}
+
+	samples := make([]tracking.LatencySample, len(rows))
+	for i, row := range rows {
+		samples[i] = tracking.LatencySample{
+			Tool:     row.Tool,
+			Prefix:   row.Prefix,
+			Duration: time.Duration(row.DurationMS) * time.Millisecond,
+			TimedOut: row.TimedOut,
+			Time:     row.CreateTime,
+		}
+	}
+	return samples, nil
+}
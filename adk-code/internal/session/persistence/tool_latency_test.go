@@ -0,0 +1,48 @@
+package persistence
+
+import (
+	"context"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"adk-code/internal/tracking"
+)
+
+func TestToolLatenciesKeepNewestPerKey(t *testing.T) {
+	ctx := context.Background()
+	service, err := NewSQLiteSessionService(filepath.Join(t.TempDir(), "sessions.db"))
+	if err != nil {
+		t.Fatalf("NewSQLiteSessionService failed: %v", err)
+	}
+	defer service.Close()
+
+	store := service.ToolLatencies()
+	for i := 1; i <= 5; i++ {
+		sample := tracking.LatencySample{Tool: "cmd", Prefix: "go test", Duration: time.Duration(i) * time.Second, Time: time.Now()}
+		if err := store.AppendLatency(ctx, sample); err != nil {
+			t.Fatalf("AppendLatency failed: %v", err)
+		}
+	}
+	if err := store.AppendLatency(ctx, tracking.LatencySample{Tool: "fetch", Duration: time.Second, TimedOut: true, Time: time.Now()}); err != nil {
+		t.Fatalf("AppendLatency failed: %v", err)
+	}
+
+	samples, err := store.RecentLatencies(ctx, 3)
+	if err != nil {
+		t.Fatalf("RecentLatencies failed: %v", err)
+	}
+	if len(samples) != 4 {
+		t.Fatalf("expected 3 cmd samples and 1 fetch sample, got %+v", samples)
+	}
+	if samples[0].Duration != 3*time.Second || samples[2].Duration != 5*time.Second || !samples[3].TimedOut {
+		t.Errorf("expected the newest runs oldest first, got %+v", samples)
+	}
+
+	// Older runs were pruned
+	var count int64
+	service.db.Model(&storageToolLatency{}).Count(&count)
+	if count != 4 {
+		t.Errorf("expected 4 stored runs after pruning, got %d", count)
+	}
+}
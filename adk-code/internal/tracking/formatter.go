@@ -3,6 +3,7 @@ package tracking
 import (
 	"fmt"
 	"strings"
+	"time"
 )
 
 // FormatTokenMetrics returns a formatted string of token metrics for display.
@@ -94,6 +95,10 @@ func FormatSessionSummary(summary *Summary) string {
 		lines = append(lines, fmt.Sprintf("  ├─ Cache Hit Rate:   %.1f%% (excellent!)", cacheEfficiency))
 	}
 
+	if summary.TurnCount > 0 {
+		lines = append(lines, fmt.Sprintf("  ├─ Avg First Token:  %s", summary.AvgFirstToken.Round(time.Millisecond)))
+	}
+
 	lines = append(lines, fmt.Sprintf("  └─ Duration:         %s", formatDuration(summary.SessionDuration)))
 
 	lines = append(lines, "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n")
@@ -0,0 +1,289 @@
+package tracking
+
+import (
+	"context"
+	"path/filepath"
+	"sort"
+	"strings"
+	"sync"
+	"time"
+)
+
+const (
+	// DefaultTimeoutPercentile is the latency percentile adaptive timeouts cover
+	DefaultTimeoutPercentile = 0.95
+	// timeoutHeadroom multiplies the percentile latency to get the timeout
+	timeoutHeadroom = 2.0
+	// minTimeoutSamples is how many runs a key needs before its timeout adapts
+	minTimeoutSamples = 5
+	// latencyWindow is how many recent runs are kept per key
+	latencyWindow = 200
+)
+
+// LatencySample is one tool run.
+type LatencySample struct {
+	Tool     string
+	Prefix   string // command prefix or host; empty for tool-wide samples
+	Duration time.Duration
+	TimedOut bool
+	Time     time.Time
+}
+
+// LatencyStore persists tool latency samples across sessions.
+type LatencyStore interface {
+	AppendLatency(ctx context.Context, sample LatencySample) error
+	RecentLatencies(ctx context.Context, perKey int) ([]LatencySample, error)
+}
+
+// latencyKey identifies a tool or a tool and command prefix.
+type latencyKey struct {
+	tool   string
+	prefix string
+}
+
+func (k latencyKey) String() string {
+	if k.prefix == "" {
+		return k.tool
+	}
+	return k.tool + " " + k.prefix
+}
+
+// latencyStats holds the recent runs of one key.
+type latencyStats struct {
+	samples  []LatencySample // ring buffer of the last latencyWindow runs
+	next     int
+	slo      time.Duration // the default timeout the tool would otherwise use
+	lastUsed time.Duration // the timeout handed out most recently
+}
+
+func (s *latencyStats) add(sample LatencySample) {
+	if len(s.samples) < latencyWindow {
+		s.samples = append(s.samples, sample)
+		return
+	}
+	s.samples[s.next] = sample
+	s.next = (s.next + 1) % latencyWindow
+}
+
+// percentile returns the p-th latency of the recorded runs. Runs that timed
+// out are censored (they would have taken longer), so they count double.
+func (s *latencyStats) percentile(p float64) time.Duration {
+	durations := make([]time.Duration, len(s.samples))
+	for i, sample := range s.samples {
+		durations[i] = sample.Duration
+		if sample.TimedOut {
+			durations[i] *= 2
+		}
+	}
+	sort.Slice(durations, func(i, j int) bool { return durations[i] < durations[j] })
+	idx := int(p*float64(len(durations))+0.5) - 1
+	idx = max(0, min(len(durations)-1, idx))
+	return durations[idx]
+}
+
+// TimeoutPolicy picks tool timeouts from the latency distribution of past
+// runs, per tool and per command prefix, and tracks how often each exceeds
+// its SLO (the tool's static default timeout).
+type TimeoutPolicy struct {
+	mu         sync.Mutex
+	percentile float64
+	stats      map[latencyKey]*latencyStats
+	store      LatencyStore
+}
+
+// NewTimeoutPolicy creates an empty policy at DefaultTimeoutPercentile.
+func NewTimeoutPolicy() *TimeoutPolicy {
+	return &TimeoutPolicy{
+		percentile: DefaultTimeoutPercentile,
+		stats:      make(map[latencyKey]*latencyStats),
+	}
+}
+
+var (
+	defaultPolicyOnce sync.Once
+	defaultPolicy     *TimeoutPolicy
+)
+
+// DefaultTimeoutPolicy returns the process-wide policy used by tools.
+func DefaultTimeoutPolicy() *TimeoutPolicy {
+	defaultPolicyOnce.Do(func() {
+		defaultPolicy = NewTimeoutPolicy()
+	})
+	return defaultPolicy
+}
+
+// SetPercentile sets the latency percentile adaptive timeouts cover.
+// Values outside (0, 1] are ignored.
+func (p *TimeoutPolicy) SetPercentile(percentile float64) {
+	if percentile <= 0 || percentile > 1 {
+		return
+	}
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	p.percentile = percentile
+}
+
+// Load attaches store, seeding the policy with the samples it holds. Later
+// samples are appended to it.
+func (p *TimeoutPolicy) Load(ctx context.Context, store LatencyStore) error {
+	samples, err := store.RecentLatencies(ctx, latencyWindow)
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	p.store = store
+	if err != nil {
+		return err
+	}
+	for _, sample := range samples {
+		p.statsLocked(latencyKey{sample.Tool, ""}).add(sample)
+		if sample.Prefix != "" {
+			p.statsLocked(latencyKey{sample.Tool, sample.Prefix}).add(sample)
+		}
+	}
+	return nil
+}
+
+func (p *TimeoutPolicy) statsLocked(key latencyKey) *latencyStats {
+	s, ok := p.stats[key]
+	if !ok {
+		s = &latencyStats{}
+		p.stats[key] = s
+	}
+	return s
+}
+
+// Timeout returns the timeout for a run of tool with the given command
+// prefix (may be empty). It uses the prefix's history when there is enough
+// of it, then the tool's, and falls back to def. The result is the
+// configured percentile with headroom, clamped to [def, max]: history only
+// ever lengthens a timeout, so a run that is slower than usual is never
+// killed before the static default.
+func (p *TimeoutPolicy) Timeout(tool, prefix string, def, maxTimeout time.Duration) time.Duration {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+
+	timeout := def
+	keys := []latencyKey{{tool, prefix}, {tool, ""}}
+	if prefix == "" {
+		keys = keys[1:]
+	}
+	for _, key := range keys {
+		if s, ok := p.stats[key]; ok && len(s.samples) >= minTimeoutSamples {
+			timeout = time.Duration(float64(s.percentile(p.percentile)) * timeoutHeadroom)
+			timeout = max(timeout, def)
+			break
+		}
+	}
+	if maxTimeout > 0 {
+		timeout = min(timeout, maxTimeout)
+	}
+
+	for _, key := range keys {
+		s := p.statsLocked(key)
+		s.slo = def
+		s.lastUsed = timeout
+	}
+	return timeout
+}
+
+// Record adds a finished run under both the tool and its command prefix,
+// and appends it to the attached store in the background.
+func (p *TimeoutPolicy) Record(tool, prefix string, duration time.Duration, timedOut bool) {
+	sample := LatencySample{Tool: tool, Prefix: prefix, Duration: duration, TimedOut: timedOut, Time: time.Now()}
+	p.mu.Lock()
+	p.statsLocked(latencyKey{tool, ""}).add(LatencySample{Tool: tool, Duration: duration, TimedOut: timedOut, Time: sample.Time})
+	if prefix != "" {
+		p.statsLocked(latencyKey{tool, prefix}).add(sample)
+	}
+	store := p.store
+	p.mu.Unlock()
+
+	if store != nil {
+		go func() {
+			// A lost sample only weakens the history; the store logs the
+			// failure to its own error log
+			_ = store.AppendLatency(context.Background(), sample)
+		}()
+	}
+}
+
+// TimeoutStats summarizes the recorded runs of one tool or command prefix.
+type TimeoutStats struct {
+	Key        string
+	Runs       int
+	TimedOut   int
+	P50        time.Duration
+	P95        time.Duration
+	Timeout    time.Duration // the timeout most recently handed out
+	SLO        time.Duration
+	Violations int // runs that timed out or took longer than the SLO
+}
+
+// ViolationRate is the fraction of runs that missed the SLO.
+func (s TimeoutStats) ViolationRate() float64 {
+	if s.Runs == 0 {
+		return 0
+	}
+	return float64(s.Violations) / float64(s.Runs)
+}
+
+// Stats returns a summary of every key with recorded runs, sorted by key.
+func (p *TimeoutPolicy) Stats() []TimeoutStats {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+
+	result := make([]TimeoutStats, 0, len(p.stats))
+	for key, s := range p.stats {
+		if len(s.samples) == 0 {
+			continue
+		}
+		st := TimeoutStats{
+			Key:     key.String(),
+			Runs:    len(s.samples),
+			P50:     s.percentile(0.5),
+			P95:     s.percentile(0.95),
+			Timeout: s.lastUsed,
+			SLO:     s.slo,
+		}
+		for _, sample := range s.samples {
+			if sample.TimedOut {
+				st.TimedOut++
+			}
+			if sample.TimedOut || (s.slo > 0 && sample.Duration > s.slo) {
+				st.Violations++
+			}
+		}
+		result = append(result, st)
+	}
+	sort.Slice(result, func(i, j int) bool { return result[i].Key < result[j].Key })
+	return result
+}
+
+// SLOViolators returns the keys that miss their SLO more often than the
+// configured percentile allows, e.g. more than 5% of runs at p95.
+func (p *TimeoutPolicy) SLOViolators() []TimeoutStats {
+	p.mu.Lock()
+	allowed := 1 - p.percentile
+	p.mu.Unlock()
+
+	var violators []TimeoutStats
+	for _, st := range p.Stats() {
+		if st.Runs >= minTimeoutSamples && st.Violations > 0 && st.ViolationRate() > allowed {
+			violators = append(violators, st)
+		}
+	}
+	return violators
+}
+
+// CommandPrefix returns the part of a command line that identifies what
+// kind of work it does: the program name plus a subcommand when there is one
+// ("go test ./..." is "go test", "python script.py" is "python").
+func CommandPrefix(program string, args []string) string {
+	prefix := filepath.Base(program)
+	if len(args) > 0 {
+		sub := args[0]
+		if sub != "" && !strings.HasPrefix(sub, "-") && !strings.ContainsAny(sub, "/.=:\\ ") {
+			prefix += " " + sub
+		}
+	}
+	return prefix
+}
@@ -0,0 +1,122 @@
+package tracking
+
+import (
+	"context"
+	"sync"
+	"testing"
+	"time"
+)
+
+type memoryLatencyStore struct {
+	mu      sync.Mutex
+	samples []LatencySample
+}
+
+func (m *memoryLatencyStore) AppendLatency(ctx context.Context, sample LatencySample) error {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	m.samples = append(m.samples, sample)
+	return nil
+}
+
+func (m *memoryLatencyStore) RecentLatencies(ctx context.Context, perKey int) ([]LatencySample, error) {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	return append([]LatencySample(nil), m.samples...), nil
+}
+
+func TestTimeoutPolicyFallsBackWithoutHistory(t *testing.T) {
+	p := NewTimeoutPolicy()
+	if got := p.Timeout("cmd", "go test", 30*time.Second, 0); got != 30*time.Second {
+		t.Errorf("expected the default, got %v", got)
+	}
+	if got := p.Timeout("fetch", "", 10*time.Minute, 5*time.Minute); got != 5*time.Minute {
+		t.Errorf("expected the cap, got %v", got)
+	}
+}
+
+func TestTimeoutPolicyAdaptsPerPrefix(t *testing.T) {
+	p := NewTimeoutPolicy()
+	for i := 0; i < 10; i++ {
+		p.Record("cmd", "go test", 40*time.Second, false)
+		p.Record("cmd", "ls", 100*time.Millisecond, false)
+	}
+
+	// Slow prefix grows beyond the static default
+	if got := p.Timeout("cmd", "go test", 30*time.Second, 10*time.Minute); got != 80*time.Second {
+		t.Errorf("expected 80s for go test, got %v", got)
+	}
+	// Fast prefix never drops below the static default
+	if got := p.Timeout("cmd", "ls", 30*time.Second, 10*time.Minute); got != 30*time.Second {
+		t.Errorf("expected the default for ls, got %v", got)
+	}
+	// Unknown prefix uses the tool-wide distribution
+	if got := p.Timeout("cmd", "make", 30*time.Second, 10*time.Minute); got != 80*time.Second {
+		t.Errorf("expected the tool-wide timeout for make, got %v", got)
+	}
+}
+
+func TestTimeoutPolicyGrowsAfterTimeouts(t *testing.T) {
+	p := NewTimeoutPolicy()
+	for i := 0; i < 5; i++ {
+		p.Record("cmd", "npm install", 30*time.Second, true)
+	}
+	if got := p.Timeout("cmd", "npm install", 30*time.Second, 0); got != 120*time.Second {
+		t.Errorf("expected censored samples to widen the timeout to 120s, got %v", got)
+	}
+}
+
+func TestTimeoutPolicySLOViolatorsAndStore(t *testing.T) {
+	store := &memoryLatencyStore{}
+	for i := 0; i < 8; i++ {
+		store.samples = append(store.samples, LatencySample{Tool: "fetch", Prefix: "slow.example", Duration: time.Second})
+	}
+	p := NewTimeoutPolicy()
+	if err := p.Load(context.Background(), store); err != nil {
+		t.Fatalf("Load failed: %v", err)
+	}
+	p.Timeout("fetch", "slow.example", 30*time.Second, 0)
+	if v := p.SLOViolators(); len(v) != 0 {
+		t.Fatalf("expected no violators, got %+v", v)
+	}
+
+	p.Record("fetch", "slow.example", 45*time.Second, false)
+	p.Record("fetch", "slow.example", 30*time.Second, true)
+	violators := p.SLOViolators()
+	if len(violators) != 2 || violators[1].Key != "fetch slow.example" || violators[1].Violations != 2 {
+		t.Fatalf("expected fetch and fetch slow.example to violate their SLO, got %+v", violators)
+	}
+
+	// Recorded samples reach the store in the background
+	deadline := time.Now().Add(time.Second)
+	for {
+		store.mu.Lock()
+		n := len(store.samples)
+		store.mu.Unlock()
+		if n == 10 {
+			break
+		}
+		if time.Now().After(deadline) {
+			t.Fatalf("expected 10 stored samples, got %d", n)
+		}
+		time.Sleep(5 * time.Millisecond)
+	}
+}
+
+func TestCommandPrefix(t *testing.T) {
+	cases := []struct {
+		program string
+		args    []string
+		want    string
+	}{
+		{"go", []string{"test", "./..."}, "go test"},
+		{"/usr/bin/python3", []string{"script.py"}, "python3"},
+		{"npm", []string{"--silent", "run"}, "npm"},
+		{"make", nil, "make"},
+	}
+	for _, c := range cases {
+		if got := CommandPrefix(c.program, c.args); got != c.want {
+			t.Errorf("CommandPrefix(%q, %v) = %q, want %q", c.program, c.args, got, c.want)
+		}
+	}
+}
@@ -39,6 +39,12 @@ type SessionTokens struct {
 	PreviousResponseTotal int32
 	PreviousThoughtTotal  int32
 	PreviousToolUseTotal  int32
+	// Per-turn latency: time from sending the user message to the first
+	// visible token of the response
+	TurnCount        int
+	TotalFirstToken  time.Duration
+	LastFirstToken   time.Duration
+	LastTurnDuration time.Duration
 }
 
 // NewSessionTokens creates a new session token tracker.
@@ -121,6 +127,20 @@ func (st *SessionTokens) RecordMetrics(metadata *genai.GenerateContentResponseUs
 	st.RequestCount++
 }
 
+// RecordTurnLatency records the time to first visible token and the total
+// duration of a user turn. A zero firstToken means nothing was shown.
+func (st *SessionTokens) RecordTurnLatency(firstToken, total time.Duration) {
+	st.mu.Lock()
+	defer st.mu.Unlock()
+
+	st.LastTurnDuration = total
+	st.LastFirstToken = firstToken
+	if firstToken > 0 {
+		st.TurnCount++
+		st.TotalFirstToken += firstToken
+	}
+}
+
 // GetLastMetric returns the most recently recorded metric (for current request).
 // This provides the per-request token breakdown that should be displayed.
 func (st *SessionTokens) GetLastMetric() *TokenMetrics {
@@ -153,6 +173,8 @@ func (st *SessionTokens) GetSummary() *Summary {
 		AvgTokensPerRequest: getAverage(st.TotalTokens, int64(st.RequestCount)),
 		SessionDuration:     duration,
 		RequestMetrics:      st.Metrics,
+		TurnCount:           st.TurnCount,
+		AvgFirstToken:       getAverageDuration(st.TotalFirstToken, st.TurnCount),
 	}
 }
 
@@ -168,6 +190,8 @@ type Summary struct {
 	AvgTokensPerRequest float64
 	SessionDuration     time.Duration
 	RequestMetrics      []TokenMetrics
+	TurnCount           int
+	AvgFirstToken       time.Duration
 }
 
 // GlobalTracker tracks tokens across all sessions.
@@ -244,3 +268,10 @@ func getAverage(total int64, count int64) float64 {
 	}
 	return float64(total) / float64(count)
 }
+
+func getAverageDuration(total time.Duration, count int) time.Duration {
+	if count == 0 {
+		return 0
+	}
+	return total / time.Duration(count)
+}
@@ -308,3 +308,27 @@ func contains(s, substr string) bool {
 	}
 	return false
 }
+
+func TestSessionTokensRecordTurnLatency(t *testing.T) {
+	st := NewSessionTokens()
+
+	st.RecordTurnLatency(200*time.Millisecond, time.Second)
+	st.RecordTurnLatency(400*time.Millisecond, 2*time.Second)
+	// A turn that showed nothing does not count toward the average
+	st.RecordTurnLatency(0, 3*time.Second)
+
+	summary := st.GetSummary()
+	if summary.TurnCount != 2 {
+		t.Errorf("Expected TurnCount=2, got %d", summary.TurnCount)
+	}
+	if summary.AvgFirstToken != 300*time.Millisecond {
+		t.Errorf("Expected AvgFirstToken=300ms, got %v", summary.AvgFirstToken)
+	}
+	if st.LastTurnDuration != 3*time.Second {
+		t.Errorf("Expected LastTurnDuration=3s, got %v", st.LastTurnDuration)
+	}
+
+	if !contains(FormatSessionSummary(summary), "Avg First Token:  300ms") {
+		t.Error("Expected session summary to include the average time to first token")
+	}
+}
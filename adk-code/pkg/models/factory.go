@@ -24,8 +24,10 @@ type GeminiConfig struct {
 
 // OpenAIConfig holds configuration for OpenAI API backend
 type OpenAIConfig struct {
-	APIKey    string
-	ModelName string
+	APIKey       string
+	ModelName    string
+	BaseURL      string // API base URL (optional, defaults to OPENAI_BASE_URL or the public endpoint)
+	ResponsesAPI bool   // Use the Responses API with server-side conversation state instead of Chat Completions
 }
 
 // OllamaConfig holds configuration for Ollama backend
@@ -1,7 +1,18 @@
 package models
 
 import (
+	"context"
+	"encoding/json"
+	"fmt"
+	"net/http"
+	"net/http/httptest"
+	"net/url"
+	"strings"
 	"testing"
+
+	"github.com/ollama/ollama/api"
+	"google.golang.org/adk/model"
+	"google.golang.org/genai"
 )
 
 func TestModelRegistry(t *testing.T) {
@@ -136,3 +147,244 @@ func TestDefaultModel(t *testing.T) {
 		t.Error("Default model should have a backend")
 	}
 }
+
+func TestSelectOllamaNumCtx(t *testing.T) {
+	tests := []struct {
+		name          string
+		prompt        int
+		output        int
+		contextWindow int
+		expected      int
+	}{
+		{"short prompt", 500, 0, 131072, 4096},
+		{"reply counts", 1000, 4000, 131072, 8192},
+		{"margin counts", 12000, 2048, 131072, 16384},
+		{"capped by the model", 20000, 0, 8192, 8192},
+		{"window between buckets", 20000, 0, 32000, 32000},
+		{"beyond the largest bucket", 150000, 0, 262144, 262144},
+		{"unknown window", 150000, 0, 0, 131072},
+	}
+
+	for _, tt := range tests {
+		t.Run(tt.name, func(t *testing.T) {
+			if got := selectOllamaNumCtx(tt.prompt, tt.output, tt.contextWindow); got != tt.expected {
+				t.Errorf("Expected num_ctx %d, got %d", tt.expected, got)
+			}
+		})
+	}
+}
+
+func TestEstimateOllamaTokens(t *testing.T) {
+	contents := []*genai.Content{
+		genai.NewContentFromText(strings.Repeat("a", 4000), "user"),
+		{Role: "model", Parts: []*genai.Part{genai.NewPartFromFunctionCall("read_file", map[string]any{"path": strings.Repeat("b", 400)})}},
+	}
+	base := estimateOllamaTokens(contents, nil)
+	if base < 1100 || base > 1200 {
+		t.Errorf("Expected about 1100 tokens, got %d", base)
+	}
+
+	tools := []*genai.Tool{{FunctionDeclarations: []*genai.FunctionDeclaration{{Name: "read_file", Description: strings.Repeat("c", 800)}}}}
+	if withTools := estimateOllamaTokens(contents, tools); withTools < base+200 {
+		t.Errorf("Expected tool declarations to be counted, got %d (without: %d)", withTools, base)
+	}
+}
+
+func TestOllamaContextLength(t *testing.T) {
+	info := map[string]any{"general.architecture": "qwen2", "qwen2.context_length": float64(32768)}
+	if got := ollamaContextLength(info); got != 32768 {
+		t.Errorf("Expected 32768, got %d", got)
+	}
+	if got := ollamaContextLength(map[string]any{"llama.context_length": float64(8192)}); got != 8192 {
+		t.Errorf("Expected 8192 without an architecture, got %d", got)
+	}
+	if got := ollamaContextLength(nil); got != 0 {
+		t.Errorf("Expected 0 for missing metadata, got %d", got)
+	}
+}
+
+// mockResponsesServer emulates the Responses API: it answers a user message
+// with a read_file call and a function output with text, remembers the
+// responses it created, and records every request body.
+type mockResponsesServer struct {
+	*httptest.Server
+	requests []responsesRequest
+	stored   map[string]bool
+}
+
+func newMockResponsesServer(t *testing.T) *mockResponsesServer {
+	m := &mockResponsesServer{stored: make(map[string]bool)}
+	m.Server = httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		var body responsesRequest
+		if r.URL.Path != "/responses" || json.NewDecoder(r.Body).Decode(&body) != nil {
+			http.Error(w, "bad request", http.StatusBadRequest)
+			return
+		}
+		m.requests = append(m.requests, body)
+		if body.PreviousResponseID != "" && !m.stored[body.PreviousResponseID] {
+			w.WriteHeader(http.StatusNotFound)
+			fmt.Fprintf(w, `{"error":{"message":"Previous response with id '%s' not found.","param":"previous_response_id"}}`, body.PreviousResponseID)
+			return
+		}
+
+		id := fmt.Sprintf("resp_%d", len(m.requests))
+		m.stored[id] = true
+		output := fmt.Sprintf(`[{"type":"function_call","call_id":"call_%d","name":"read_file","arguments":"{\"path\":\"main.go\"}"}]`, len(m.requests))
+		if last := body.Input[len(body.Input)-1]; last.Type == "function_call_output" {
+			output = `[{"type":"message","role":"assistant","content":[{"type":"output_text","text":"Fixed."}]}]`
+		}
+		response := fmt.Sprintf(`{"id":"%s","status":"completed","output":%s,"usage":{"input_tokens":10,"output_tokens":5,"total_tokens":15}}`, id, output)
+		if !body.Stream {
+			w.Write([]byte(response))
+			return
+		}
+		w.Header().Set("Content-Type", "text/event-stream")
+		fmt.Fprint(w, "event: response.output_text.delta\ndata: {\"type\":\"response.output_text.delta\",\"delta\":\"Fix\"}\n\n")
+		fmt.Fprint(w, "event: response.output_text.delta\ndata: {\"type\":\"response.output_text.delta\",\"delta\":\"ed.\"}\n\n")
+		fmt.Fprintf(w, "event: response.completed\ndata: {\"type\":\"response.completed\",\"response\":%s}\n\n", response)
+	}))
+	t.Cleanup(m.Close)
+	return m
+}
+
+// generate runs a request and returns the final response
+func generate(t *testing.T, llm model.LLM, contents []*genai.Content, stream bool) (*model.LLMResponse, int) {
+	t.Helper()
+	req := &model.LLMRequest{
+		Contents: contents,
+		Config: &genai.GenerateContentConfig{
+			SystemInstruction: genai.NewContentFromText("You are a coding agent.", "user"),
+			Tools:             []*genai.Tool{{FunctionDeclarations: []*genai.FunctionDeclaration{{Name: "read_file", Description: "Read a file"}}}},
+		},
+	}
+	var final *model.LLMResponse
+	partials := 0
+	for resp, err := range llm.GenerateContent(context.Background(), req, stream) {
+		if err != nil {
+			t.Fatalf("GenerateContent failed: %v", err)
+		}
+		if resp.Partial {
+			partials++
+		} else {
+			final = resp
+		}
+	}
+	if final == nil || final.Content == nil {
+		t.Fatal("expected a final response with content")
+	}
+	return final, partials
+}
+
+func functionResult(id string) *genai.Content {
+	return &genai.Content{Role: "user", Parts: []*genai.Part{{FunctionResponse: &genai.FunctionResponse{
+		ID: id, Name: "read_file", Response: map[string]any{"content": "package main"},
+	}}}}
+}
+
+func TestOpenAIResponsesChainsTurns(t *testing.T) {
+	server := newMockResponsesServer(t)
+	adapter := newOpenAIResponsesAdapter(server.URL, "test-key", "gpt-test", server.Client())
+
+	history := []*genai.Content{genai.NewContentFromText("Fix main.go", "user")}
+	reply, _ := generate(t, adapter, history, false)
+	call := reply.Content.Parts[0].FunctionCall
+	if call == nil || call.ID != "call_1" || call.Args["path"] != "main.go" {
+		t.Fatalf("Expected a read_file call, got %+v", reply.Content.Parts[0])
+	}
+	first := server.requests[0]
+	if first.PreviousResponseID != "" || len(first.Input) != 1 || first.Instructions != "You are a coding agent." || len(first.Tools) != 1 || !first.Store {
+		t.Errorf("Unexpected first request %+v", first)
+	}
+
+	// The next turn continues the stored response with only the new item
+	history = append(history, reply.Content, functionResult("call_1"))
+	reply, _ = generate(t, adapter, history, false)
+	second := server.requests[1]
+	if second.PreviousResponseID != "resp_1" || len(second.Input) != 1 || second.Input[0].Type != "function_call_output" || second.Input[0].CallID != "call_1" {
+		t.Errorf("Expected only the function output chained to resp_1, got %+v", second)
+	}
+	if reply.Content.Parts[0].Text != "Fixed." || reply.UsageMetadata.TotalTokenCount != 15 {
+		t.Errorf("Unexpected reply %+v", reply)
+	}
+
+	// A rewritten history (e.g. compaction) is sent in full
+	compacted := []*genai.Content{genai.NewContentFromText("Summary: main.go was fixed", "user"), genai.NewContentFromText("Now add a test", "user")}
+	generate(t, adapter, compacted, false)
+	if third := server.requests[2]; third.PreviousResponseID != "" || len(third.Input) != 2 {
+		t.Errorf("Expected a full resend after compaction, got %+v", third)
+	}
+
+	// So is the same history for another model
+	other := newOpenAIResponsesAdapter(server.URL, "test-key", "gpt-test", server.Client())
+	other.chains = adapter.chains
+	other.modelName = "gpt-other"
+	generate(t, other, history, false)
+	if fourth := server.requests[3]; fourth.PreviousResponseID != "" || len(fourth.Input) != 3 {
+		t.Errorf("Expected a full resend after a model switch, got %+v", fourth)
+	}
+}
+
+func TestOpenAIResponsesFallsBackAndStreams(t *testing.T) {
+	server := newMockResponsesServer(t)
+	adapter := newOpenAIResponsesAdapter(server.URL, "test-key", "gpt-test", server.Client())
+
+	history := []*genai.Content{genai.NewContentFromText("Fix main.go", "user")}
+	reply, _ := generate(t, adapter, history, true)
+	history = append(history, reply.Content, functionResult("call_1"))
+
+	// The server forgot the response, so the chained request is resent in full
+	delete(server.stored, "resp_1")
+	reply, partials := generate(t, adapter, history, true)
+	if n := len(server.requests); n != 3 {
+		t.Fatalf("Expected a rejected chained request and a full resend, got %d requests", n)
+	}
+	if rejected, resent := server.requests[1], server.requests[2]; rejected.PreviousResponseID != "resp_1" || resent.PreviousResponseID != "" || len(resent.Input) != 3 {
+		t.Errorf("Unexpected fallback requests %+v, %+v", rejected, resent)
+	}
+	if partials != 2 || reply.Content.Parts[0].Text != "Fixed." || !reply.TurnComplete {
+		t.Errorf("Expected 2 streamed deltas and the complete text, got %d and %+v", partials, reply)
+	}
+
+	// The resent response is chained from again
+	history = append(history, reply.Content, genai.NewContentFromText("Thanks", "user"))
+	generate(t, adapter, history, false)
+	if last := server.requests[3]; last.PreviousResponseID != "resp_3" || len(last.Input) != 1 {
+		t.Errorf("Expected the next turn chained to resp_3, got %+v", last)
+	}
+}
+
+func TestOllamaStreamingAggregatesResponse(t *testing.T) {
+	var chatReq api.ChatRequest
+	server := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		switch r.URL.Path {
+		case "/api/show":
+			fmt.Fprint(w, `{"model_info":{"general.architecture":"llama","llama.context_length":8192}}`)
+		case "/api/chat":
+			json.NewDecoder(r.Body).Decode(&chatReq)
+			fmt.Fprintln(w, `{"message":{"role":"assistant","content":"Let me "},"done":false}`)
+			fmt.Fprintln(w, `{"message":{"role":"assistant","content":"look."},"done":false}`)
+			fmt.Fprintln(w, `{"message":{"role":"assistant","content":"","tool_calls":[{"function":{"name":"read_file","arguments":{"path":"main.go"}}}]},"done":true,"done_reason":"stop"}`)
+		default:
+			http.NotFound(w, r)
+		}
+	}))
+	defer server.Close()
+	baseURL, _ := url.Parse(server.URL)
+	adapter := &OllamaModelAdapter{
+		client:         api.NewClient(baseURL, server.Client()),
+		modelName:      "llama3",
+		contextWindows: make(map[string]int),
+	}
+
+	final, partials := generate(t, adapter, []*genai.Content{genai.NewContentFromText("Fix main.go", "user")}, true)
+	if partials != 2 {
+		t.Errorf("Expected each text delta as a partial response, got %d", partials)
+	}
+	parts := final.Content.Parts
+	if len(parts) != 2 || parts[0].Text != "Let me look." || parts[1].FunctionCall == nil || parts[1].FunctionCall.Args["path"] != "main.go" || !final.TurnComplete {
+		t.Errorf("Expected the final response to hold the whole text and the tool call, got %+v", final)
+	}
+	if numCtx, _ := chatReq.Options["num_ctx"].(float64); numCtx != 4096 {
+		t.Errorf("Expected num_ctx 4096, got %v", chatReq.Options["num_ctx"])
+	}
+}
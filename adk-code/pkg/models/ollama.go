@@ -4,10 +4,12 @@ package models
 import (
 	"context"
 	"encoding/json"
+	"errors"
 	"fmt"
 	"iter"
 	"net/url"
 	"strings"
+	"sync"
 
 	"github.com/ollama/ollama/api"
 	"google.golang.org/adk/model"
@@ -25,6 +27,9 @@ type ollamaToolCallAccumulator struct {
 type OllamaModelAdapter struct {
 	client    *api.Client
 	modelName string
+
+	mu             sync.Mutex
+	contextWindows map[string]int // context window per model, looked up once
 }
 
 // createOllamaModelInternal creates a model using the Ollama API backend (internal implementation)
@@ -60,11 +65,40 @@ func createOllamaModelInternal(ctx context.Context, cfg OllamaConfig) (model.LLM
 	}
 
 	return &OllamaModelAdapter{
-		client:    client,
-		modelName: actualModelName,
+		client:         client,
+		modelName:      actualModelName,
+		contextWindows: make(map[string]int),
 	}, nil
 }
 
+// contextWindow returns the largest context a model supports: the context
+// length its metadata reports, or the window DetectCapabilitiesFromName
+// assumes when the server cannot tell.
+func (a *OllamaModelAdapter) contextWindow(ctx context.Context, modelName string) int {
+	a.mu.Lock()
+	window, ok := a.contextWindows[modelName]
+	a.mu.Unlock()
+	if ok {
+		return window
+	}
+
+	family := ""
+	if showResp, err := a.client.Show(ctx, &api.ShowRequest{Name: modelName}); err == nil {
+		window = ollamaContextLength(showResp.ModelInfo)
+		family = showResp.Details.Family
+	} else if ctx.Err() != nil {
+		return 0 // not cached, so the next request asks again
+	}
+	if window <= 0 {
+		window = DetectCapabilitiesFromName(modelName, family).ContextWindow
+	}
+
+	a.mu.Lock()
+	a.contextWindows[modelName] = window
+	a.mu.Unlock()
+	return window
+}
+
 // Name returns the model name
 func (a *OllamaModelAdapter) Name() string {
 	return a.modelName
@@ -98,10 +132,20 @@ func (a *OllamaModelAdapter) GenerateContent(
 			Stream:   &stream,
 		}
 
-		// Apply config if provided
+		// Size the context to the request, as Ollama otherwise truncates
+		// prompts beyond its small default window
+		ollamaReq.Options = make(map[string]any)
+		var tools []*genai.Tool
+		outputTokens := 0
 		if req.Config != nil {
-			ollamaReq.Options = make(map[string]any)
+			tools = req.Config.Tools
+			outputTokens = int(req.Config.MaxOutputTokens)
+		}
+		ollamaReq.Options["num_ctx"] = selectOllamaNumCtx(
+			estimateOllamaTokens(req.Contents, tools), outputTokens, a.contextWindow(ctx, modelName))
 
+		// Apply config if provided
+		if req.Config != nil {
 			if req.Config.Temperature != nil {
 				ollamaReq.Options["temperature"] = *req.Config.Temperature
 			}
@@ -125,7 +169,8 @@ func (a *OllamaModelAdapter) GenerateContent(
 			}
 		}
 
-		// Accumulate the full response for non-streaming mode
+		// Accumulate the full response; in streaming mode each text delta is
+		// also yielded as a partial response as it arrives
 		var fullContent string
 		var fullResponse *api.ChatResponse
 
@@ -134,130 +179,62 @@ func (a *OllamaModelAdapter) GenerateContent(
 
 		// Use the Chat API with streaming
 		err = a.client.Chat(ctx, ollamaReq, func(resp api.ChatResponse) error {
-			// For streaming responses, accumulate and convert
-			if stream {
-				// Accumulate content text
-				fullContent += resp.Message.Content
-
-				// Accumulate tool calls (they only appear in the final chunk when done=true)
-				if len(resp.Message.ToolCalls) > 0 {
-					for _, toolCall := range resp.Message.ToolCalls {
-						// Use function index as key if available, otherwise just accumulate
-						idx := 0
-						if toolCall.Function.Index > 0 {
-							idx = int(toolCall.Function.Index)
-						}
-
-						accum, exists := toolCallsAccum[idx]
-						if !exists {
-							accum = &ollamaToolCallAccumulator{}
-							toolCallsAccum[idx] = accum
-						}
-
-						// Update fields (in final chunk, these will be complete)
-						if toolCall.ID != "" {
-							accum.id = toolCall.ID
-						}
-						if toolCall.Function.Name != "" {
-							accum.name = toolCall.Function.Name
-						}
-						// Arguments come as a map directly from Ollama
-						if toolCall.Function.Arguments != nil {
-							accum.arguments = toolCall.Function.Arguments
-						}
-					}
+			fullContent += resp.Message.Content
+			fullResponse = &resp
+
+			// Accumulate tool calls (they only appear in the final chunk when done=true)
+			for _, toolCall := range resp.Message.ToolCalls {
+				// Use function index as key if available
+				idx := 0
+				if toolCall.Function.Index > 0 {
+					idx = int(toolCall.Function.Index)
 				}
 
-				// Build response with current state
-				parts := []*genai.Part{}
-
-				// Add text content if present
-				if fullContent != "" {
-					parts = append(parts, &genai.Part{
-						Text: fullContent,
-					})
+				accum, exists := toolCallsAccum[idx]
+				if !exists {
+					accum = &ollamaToolCallAccumulator{}
+					toolCallsAccum[idx] = accum
 				}
 
-				// Add accumulated tool calls if any
-				if len(toolCallsAccum) > 0 {
-					for idx := 0; idx < len(toolCallsAccum); idx++ {
-						if accum, exists := toolCallsAccum[idx]; exists {
-							args := accum.arguments
-							if args == nil {
-								args = make(map[string]any)
-							}
-
-							parts = append(parts, &genai.Part{
-								FunctionCall: &genai.FunctionCall{
-									ID:   accum.id,
-									Name: accum.name,
-									Args: args,
-								},
-							})
-						}
-					}
+				// Update fields (in final chunk, these will be complete)
+				if toolCall.ID != "" {
+					accum.id = toolCall.ID
+				}
+				if toolCall.Function.Name != "" {
+					accum.name = toolCall.Function.Name
+				}
+				// Arguments come as a map directly from Ollama
+				if toolCall.Function.Arguments != nil {
+					accum.arguments = toolCall.Function.Arguments
 				}
+			}
 
-				// Only yield if we have something to say
-				if len(parts) > 0 {
-					modelResp := &model.LLMResponse{
-						Content: &genai.Content{
-							Role:  "model",
-							Parts: parts,
-						},
-						Partial:      !resp.Done,
-						TurnComplete: resp.Done,
-						FinishReason: stringToFinishReason(resp.DoneReason),
-					}
-					if !yield(modelResp, nil) {
-						return context.Canceled
-					}
-					// Clear accumulated content and tool calls after yielding
-					// (we'll accumulate fresh for next chunk if needed)
-					fullContent = ""
-					toolCallsAccum = make(map[int]*ollamaToolCallAccumulator)
+			if stream && resp.Message.Content != "" {
+				delta := &model.LLMResponse{
+					Content: &genai.Content{
+						Role:  "model",
+						Parts: []*genai.Part{{Text: resp.Message.Content}},
+					},
+					Partial: true,
 				}
-			} else {
-				// Accumulate content for non-streaming
-				fullContent += resp.Message.Content
-				fullResponse = &resp
-				// Also accumulate tool calls
-				if len(resp.Message.ToolCalls) > 0 {
-					for _, toolCall := range resp.Message.ToolCalls {
-						idx := 0
-						if toolCall.Function.Index > 0 {
-							idx = int(toolCall.Function.Index)
-						}
-
-						accum, exists := toolCallsAccum[idx]
-						if !exists {
-							accum = &ollamaToolCallAccumulator{}
-							toolCallsAccum[idx] = accum
-						}
-
-						if toolCall.ID != "" {
-							accum.id = toolCall.ID
-						}
-						if toolCall.Function.Name != "" {
-							accum.name = toolCall.Function.Name
-						}
-						if toolCall.Function.Arguments != nil {
-							accum.arguments = toolCall.Function.Arguments
-						}
-					}
+				if !yield(delta, nil) {
+					return context.Canceled
 				}
 			}
 			return nil
 		})
 
 		if err != nil {
+			if errors.Is(err, context.Canceled) && ctx.Err() == nil {
+				return // the consumer stopped reading
+			}
 			yield(nil, fmt.Errorf("ollama chat request failed: %w", err))
 			return
 		}
 
-		// For non-streaming mode, yield the accumulated response
-		if !stream && fullResponse != nil {
-			fullResponse.Message.Content = fullContent
+		// Yield the aggregated response; in streaming mode this is the only
+		// non-partial response, the one session history keeps
+		if fullResponse != nil {
 			modelResp := convertOllamaChatResponseToGenAIWithAccumulatedTools(*fullResponse, fullContent, toolCallsAccum)
 			modelResp.TurnComplete = true
 			yield(modelResp, nil)
@@ -472,10 +449,9 @@ func convertOllamaChatResponseToGenAIWithAccumulatedTools(
 	toolCallsAccum map[int]*ollamaToolCallAccumulator,
 ) *model.LLMResponse {
 	// Create the response content with accumulated text
-	parts := []*genai.Part{
-		{
-			Text: content,
-		},
+	parts := []*genai.Part{}
+	if content != "" {
+		parts = append(parts, &genai.Part{Text: content})
 	}
 
 	// Add accumulated tool calls
@@ -0,0 +1,110 @@
+// Package models - Ollama context window sizing
+package models
+
+import (
+	"encoding/json"
+	"strings"
+
+	"google.golang.org/genai"
+)
+
+// ollamaContextBuckets are the num_ctx values requests are rounded up to.
+// Ollama reloads a model whenever num_ctx changes, so a few fixed sizes let
+// requests of similar length keep reusing the loaded runner.
+var ollamaContextBuckets = []int{4096, 8192, 16384, 32768, 65536, 131072}
+
+const (
+	// ollamaCharsPerToken approximates tokenizers of common local models
+	ollamaCharsPerToken = 4
+	// ollamaMessageOverhead covers the chat template tokens around each message
+	ollamaMessageOverhead = 8
+	// ollamaDefaultOutputTokens is reserved for the reply when the request
+	// sets no num_predict
+	ollamaDefaultOutputTokens = 2048
+)
+
+// estimateOllamaTokens approximates the prompt tokens of a chat request from
+// the size of its messages, tool calls, tool results and tool declarations.
+func estimateOllamaTokens(contents []*genai.Content, tools []*genai.Tool) int {
+	chars := 0
+	messages := 0
+	for _, content := range contents {
+		if content == nil {
+			continue
+		}
+		messages++
+		for _, part := range content.Parts {
+			if part == nil {
+				continue
+			}
+			chars += len(part.Text)
+			if part.FunctionCall != nil {
+				chars += len(part.FunctionCall.Name) + jsonLength(part.FunctionCall.Args)
+			}
+			if part.FunctionResponse != nil {
+				chars += jsonLength(part.FunctionResponse.Response)
+			}
+		}
+	}
+	for _, tool := range tools {
+		if tool != nil {
+			chars += jsonLength(tool.FunctionDeclarations)
+		}
+	}
+	return chars/ollamaCharsPerToken + messages*ollamaMessageOverhead
+}
+
+// jsonLength returns the length of v's JSON encoding, 0 if it has none.
+func jsonLength(v any) int {
+	data, err := json.Marshal(v)
+	if err != nil {
+		return 0
+	}
+	return len(data)
+}
+
+// selectOllamaNumCtx picks the smallest bucket that holds the prompt, with a
+// 10% margin for estimation error, plus the reply. The result never exceeds
+// the model's context window (when known); prompts beyond the largest bucket
+// get the whole window.
+func selectOllamaNumCtx(promptTokens, outputTokens, contextWindow int) int {
+	if outputTokens <= 0 {
+		outputTokens = ollamaDefaultOutputTokens
+	}
+	needed := promptTokens + promptTokens/10 + outputTokens
+
+	numCtx := 0
+	for _, bucket := range ollamaContextBuckets {
+		if bucket >= needed {
+			numCtx = bucket
+			break
+		}
+	}
+	if numCtx == 0 {
+		numCtx = ollamaContextBuckets[len(ollamaContextBuckets)-1]
+		if contextWindow > numCtx {
+			numCtx = contextWindow
+		}
+	}
+	if contextWindow > 0 && numCtx > contextWindow {
+		numCtx = contextWindow
+	}
+	return numCtx
+}
+
+// ollamaContextLength returns the trained context length reported in a
+// model's Show metadata (the "<architecture>.context_length" key), 0 if
+// absent.
+func ollamaContextLength(modelInfo map[string]any) int {
+	if arch, ok := modelInfo["general.architecture"].(string); ok {
+		if n, ok := modelInfo[arch+".context_length"].(float64); ok {
+			return int(n)
+		}
+	}
+	for key, value := range modelInfo {
+		if n, ok := value.(float64); ok && strings.HasSuffix(key, ".context_length") {
+			return int(n)
+		}
+	}
+	return 0
+}
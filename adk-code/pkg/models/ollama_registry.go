@@ -143,6 +143,9 @@ func (r *OllamaModelRegistry) fetchDetailedModelInfo(ctx context.Context, modelN
 	if info.Family != "" {
 		info.Capabilities = DetectCapabilitiesFromName(modelName, info.Family)
 	}
+	if contextLength := ollamaContextLength(showResp.ModelInfo); contextLength > 0 {
+		info.Capabilities.ContextWindow = contextLength
+	}
 
 	return info, nil
 }
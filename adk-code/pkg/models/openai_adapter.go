@@ -5,6 +5,7 @@ import (
 	"encoding/json"
 	"fmt"
 	"iter"
+	"sort"
 	"strings"
 
 	"github.com/openai/openai-go/v3"
@@ -29,7 +30,15 @@ func createOpenAIModelInternal(ctx context.Context, cfg OpenAIConfig) (model.LLM
 		return nil, fmt.Errorf("model name is required")
 	}
 
-	client := openai.NewClient(option.WithAPIKey(cfg.APIKey))
+	if cfg.ResponsesAPI {
+		return newOpenAIResponsesAdapter(cfg.BaseURL, cfg.APIKey, cfg.ModelName, nil), nil
+	}
+
+	opts := []option.RequestOption{option.WithAPIKey(cfg.APIKey)}
+	if cfg.BaseURL != "" {
+		opts = append(opts, option.WithBaseURL(cfg.BaseURL))
+	}
+	client := openai.NewClient(opts...)
 
 	return &OpenAIModelAdapter{
 		client:    client,
@@ -168,93 +177,58 @@ func (a *OpenAIModelAdapter) GenerateContent(
 			}
 			toolCallsAccum := make(map[int]*toolCallAccumulator)
 
+			// Aggregate the streamed text for the final response
+			var fullText strings.Builder
+			var finishReason string
+
 			// Process stream events
 			for streamResp.Next() {
 				event := streamResp.Current()
-				if len(event.Choices) > 0 {
-					choice := event.Choices[0]
-
-					// Convert to LLMResponse
-					resp := &model.LLMResponse{
-						Partial: true,
-					}
-
-					// Build content with both text and tool calls
-					content := &genai.Content{
-						Role:  "model",
-						Parts: []*genai.Part{},
+				if len(event.Choices) == 0 {
+					continue
+				}
+				choice := event.Choices[0]
+
+				// Accumulate tool call deltas
+				// OpenAI sends tool calls with an Index field to track which call is being updated
+				for _, toolCall := range choice.Delta.ToolCalls {
+					// Argument fragments after the first delta carry no type, so every
+					// delta is accumulated
+					idx := toolCall.Index
+
+					// Get or create accumulator for this index
+					accum, exists := toolCallsAccum[int(idx)]
+					if !exists {
+						accum = &toolCallAccumulator{}
+						toolCallsAccum[int(idx)] = accum
 					}
 
-					// Extract text content from delta
-					if choice.Delta.Content != "" {
-						content.Parts = append(content.Parts, &genai.Part{
-							Text: choice.Delta.Content,
-						})
+					// Accumulate fields (they may arrive in separate deltas)
+					if toolCall.ID != "" {
+						accum.id = toolCall.ID
 					}
-
-					// Accumulate tool call deltas
-					// OpenAI sends tool calls with an Index field to track which call is being updated
-					for _, toolCall := range choice.Delta.ToolCalls {
-						if toolCall.Type == "function" {
-							idx := toolCall.Index
-
-							// Get or create accumulator for this index
-							accum, exists := toolCallsAccum[int(idx)]
-							if !exists {
-								accum = &toolCallAccumulator{}
-								toolCallsAccum[int(idx)] = accum
-							}
-
-							// Accumulate fields (they may arrive in separate deltas)
-							if toolCall.ID != "" {
-								accum.id = toolCall.ID
-							}
-							if toolCall.Function.Name != "" {
-								accum.name = toolCall.Function.Name
-							}
-							if toolCall.Function.Arguments != "" {
-								accum.arguments += toolCall.Function.Arguments
-							}
-						}
+					if toolCall.Function.Name != "" {
+						accum.name = toolCall.Function.Name
 					}
-
-					// On finish reason, parse accumulated tool calls
-					if choice.FinishReason != "" {
-						// Parse all accumulated tool calls now that we have complete JSON
-						for _, accum := range toolCallsAccum {
-							var args map[string]any
-							if accum.arguments != "" {
-								var argsData interface{}
-								if err := json.Unmarshal([]byte(accum.arguments), &argsData); err == nil {
-									if argsMap, ok := argsData.(map[string]interface{}); ok {
-										args = argsMap
-									}
-								}
-								// If parsing fails, args remains nil - tool will receive empty args
-							}
-
-							content.Parts = append(content.Parts, &genai.Part{
-								FunctionCall: &genai.FunctionCall{
-									Name: accum.name,
-									Args: args,
-									ID:   accum.id,
-								},
-							})
-						}
+					if toolCall.Function.Arguments != "" {
+						accum.arguments += toolCall.Function.Arguments
 					}
+				}
 
-					// Only set content if we have parts
-					if len(content.Parts) > 0 {
-						resp.Content = content
-					}
+				if choice.FinishReason != "" {
+					finishReason = choice.FinishReason
+				}
 
-					// Map finish reason if present - note FinishReason is a string
-					// When finish reason is set, the turn is complete
-					if choice.FinishReason != "" {
-						resp.FinishReason = mapFinishReason(choice.FinishReason)
-						resp.TurnComplete = true
+				// Yield text deltas as partial responses
+				if choice.Delta.Content != "" {
+					fullText.WriteString(choice.Delta.Content)
+					resp := &model.LLMResponse{
+						Content: &genai.Content{
+							Role:  "model",
+							Parts: []*genai.Part{{Text: choice.Delta.Content}},
+						},
+						Partial: true,
 					}
-
 					if !yield(resp, nil) {
 						return
 					}
@@ -263,7 +237,49 @@ func (a *OpenAIModelAdapter) GenerateContent(
 
 			if err := streamResp.Err(); err != nil {
 				yield(nil, fmt.Errorf("stream error: %w", err))
+				return
+			}
+
+			// Yield the aggregated response with the text and the parsed tool
+			// calls; it is the only non-partial response, the one session
+			// history keeps
+			content := &genai.Content{
+				Role:  "model",
+				Parts: []*genai.Part{},
+			}
+			if fullText.Len() > 0 {
+				content.Parts = append(content.Parts, &genai.Part{Text: fullText.String()})
+			}
+			// Tool calls are added in index order
+			indices := make([]int, 0, len(toolCallsAccum))
+			for idx := range toolCallsAccum {
+				indices = append(indices, idx)
+			}
+			sort.Ints(indices)
+			for _, idx := range indices {
+				accum := toolCallsAccum[idx]
+				var args map[string]any
+				if accum.arguments != "" {
+					// If parsing fails, args remains nil - tool will receive empty args
+					json.Unmarshal([]byte(accum.arguments), &args)
+				}
+				content.Parts = append(content.Parts, &genai.Part{
+					FunctionCall: &genai.FunctionCall{
+						Name: accum.name,
+						Args: args,
+						ID:   accum.id,
+					},
+				})
+			}
+
+			resp := &model.LLMResponse{TurnComplete: true}
+			if len(content.Parts) > 0 {
+				resp.Content = content
+			}
+			if finishReason != "" {
+				resp.FinishReason = mapFinishReason(finishReason)
 			}
+			yield(resp, nil)
 		} else {
 			// Non-streaming path
 			completion, err := a.client.Chat.Completions.New(ctx, openaiReq)
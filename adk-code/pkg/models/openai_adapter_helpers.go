@@ -74,35 +74,7 @@ func convertToOpenAIMessages(contents []*genai.Content) ([]openai.ChatCompletion
 		if len(functionResponses) > 0 {
 			// Tool response messages
 			for _, funcResp := range functionResponses {
-				// Convert response to JSON string
-				respJSON := ""
-				if funcResp.Response != nil {
-					// Convert error types to strings before marshaling
-					// The Response map may contain error types which don't marshal properly
-					cleanedResponse := make(map[string]any)
-					for k, v := range funcResp.Response {
-						// Check if the value is an error type and convert to string
-						if err, isError := v.(error); isError {
-							cleanedResponse[k] = err.Error()
-						} else {
-							cleanedResponse[k] = v
-						}
-					}
-
-					// Marshal the cleaned response
-					respBytes, err := json.Marshal(cleanedResponse)
-					if err == nil {
-						respJSON = string(respBytes)
-					} else {
-						// Fallback to error message if marshaling fails
-						respJSON = fmt.Sprintf("{\"error\": \"failed to marshal response: %v\"}", err)
-					}
-				} else {
-					// Empty response
-					respJSON = "{}"
-				}
-
-				messages = append(messages, openai.ToolMessage(respJSON, funcResp.ID))
+				messages = append(messages, openai.ToolMessage(functionResponseJSON(funcResp), funcResp.ID))
 			}
 			continue // Skip normal role handling
 		}
@@ -153,6 +125,35 @@ func convertToOpenAIMessages(contents []*genai.Content) ([]openai.ChatCompletion
 	return messages, nil
 }
 
+// functionResponseJSON encodes a function response as the JSON string
+// OpenAI expects for a tool result
+func functionResponseJSON(funcResp genai.FunctionResponse) string {
+	if funcResp.Response == nil {
+		// Empty response
+		return "{}"
+	}
+
+	// Convert error types to strings before marshaling
+	// The Response map may contain error types which don't marshal properly
+	cleanedResponse := make(map[string]any)
+	for k, v := range funcResp.Response {
+		// Check if the value is an error type and convert to string
+		if err, isError := v.(error); isError {
+			cleanedResponse[k] = err.Error()
+		} else {
+			cleanedResponse[k] = v
+		}
+	}
+
+	// Marshal the cleaned response
+	respBytes, err := json.Marshal(cleanedResponse)
+	if err != nil {
+		// Fallback to error message if marshaling fails
+		return fmt.Sprintf("{\"error\": \"failed to marshal response: %v\"}", err)
+	}
+	return string(respBytes)
+}
+
 // convertFromOpenAICompletion converts an OpenAI ChatCompletion to genai.LLMResponse
 func convertFromOpenAICompletion(completion *openai.ChatCompletion) (*model.LLMResponse, error) {
 	resp := &model.LLMResponse{
@@ -275,37 +276,12 @@ func convertToOpenAITools(tools []*genai.Tool) ([]openai.ChatCompletionToolUnion
 				}
 
 				// Convert parameters schema
-				// ADK uses genai.Schema or JSON Schema format
-				if funcDecl.Parameters != nil {
-					// Convert genai.Schema to map for OpenAI
-					params, err := convertSchemaToMapWithError(funcDecl.Parameters)
-					if err != nil {
-						return nil, fmt.Errorf("failed to convert schema for function %s: %w", funcDecl.Name, err)
-					}
-					if params != nil {
-						functionDef.Parameters = params
-					}
-				} else if funcDecl.ParametersJsonSchema != nil {
-					// Use JSON Schema directly - convert via JSON marshaling
-					// Try direct map type assertions first
-					if params, ok := funcDecl.ParametersJsonSchema.(map[string]interface{}); ok {
-						functionDef.Parameters = params
-					} else if params, ok := funcDecl.ParametersJsonSchema.(map[string]any); ok {
-						functionDef.Parameters = params
-					} else {
-						// Type is not a map - try to convert via JSON marshaling
-						// This handles types like *jsonschema.Schema
-						schemaBytes, err := json.Marshal(funcDecl.ParametersJsonSchema)
-						if err != nil {
-							return nil, fmt.Errorf("failed to marshal ParametersJsonSchema for function %s: %w", funcDecl.Name, err)
-						}
-
-						var params map[string]interface{}
-						if err := json.Unmarshal(schemaBytes, &params); err != nil {
-							return nil, fmt.Errorf("failed to unmarshal ParametersJsonSchema for function %s: %w", funcDecl.Name, err)
-						}
-						functionDef.Parameters = params
-					}
+				params, err := functionParametersSchema(funcDecl)
+				if err != nil {
+					return nil, err
+				}
+				if params != nil {
+					functionDef.Parameters = params
 				}
 
 				// Create OpenAI tool using the helper function
@@ -319,6 +295,40 @@ func convertToOpenAITools(tools []*genai.Tool) ([]openai.ChatCompletionToolUnion
 	return openaiTools, nil
 }
 
+// functionParametersSchema returns a function declaration's parameters as a
+// JSON Schema map, nil if it declares none
+// ADK uses genai.Schema or JSON Schema format
+func functionParametersSchema(funcDecl *genai.FunctionDeclaration) (map[string]any, error) {
+	if funcDecl.Parameters != nil {
+		// Convert genai.Schema to map for OpenAI
+		params, err := convertSchemaToMapWithError(funcDecl.Parameters)
+		if err != nil {
+			return nil, fmt.Errorf("failed to convert schema for function %s: %w", funcDecl.Name, err)
+		}
+		return params, nil
+	}
+	if funcDecl.ParametersJsonSchema == nil {
+		return nil, nil
+	}
+
+	// Use JSON Schema directly - try a direct map type assertion first
+	if params, ok := funcDecl.ParametersJsonSchema.(map[string]any); ok {
+		return params, nil
+	}
+
+	// Type is not a map - try to convert via JSON marshaling
+	// This handles types like *jsonschema.Schema
+	schemaBytes, err := json.Marshal(funcDecl.ParametersJsonSchema)
+	if err != nil {
+		return nil, fmt.Errorf("failed to marshal ParametersJsonSchema for function %s: %w", funcDecl.Name, err)
+	}
+	var params map[string]any
+	if err := json.Unmarshal(schemaBytes, &params); err != nil {
+		return nil, fmt.Errorf("failed to unmarshal ParametersJsonSchema for function %s: %w", funcDecl.Name, err)
+	}
+	return params, nil
+}
+
 // convertSchemaToMapWithError converts a genai.Schema to a map suitable for OpenAI
 // Returns error if conversion fails (e.g., circular references)
 func convertSchemaToMapWithError(schema *genai.Schema) (map[string]interface{}, error) {
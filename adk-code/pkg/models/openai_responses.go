@@ -0,0 +1,622 @@
+// Package models - OpenAI Responses API adapter with server-side conversation state
+package models
+
+import (
+	"bufio"
+	"bytes"
+	"context"
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"io"
+	"iter"
+	"net/http"
+	"os"
+	"strings"
+	"sync"
+	"time"
+
+	"google.golang.org/adk/model"
+	"google.golang.org/genai"
+)
+
+const (
+	// defaultOpenAIBaseURL is used when neither the config nor OPENAI_BASE_URL sets one
+	defaultOpenAIBaseURL = "https://api.openai.com/v1"
+	// maxResponseChains bounds the conversations whose last response is remembered
+	maxResponseChains = 64
+	// responsesTimeout bounds a whole request, streamed body included, so a
+	// stalled endpoint fails the turn instead of hanging it
+	responsesTimeout = 10 * time.Minute
+)
+
+// OpenAIResponsesAdapter implements the model.LLM interface on the OpenAI
+// Responses API. The server keeps each conversation's state, so after the
+// first turn a request names the previous response (previous_response_id)
+// and sends only the items added since. When the history no longer extends
+// a remembered response, e.g. after compaction or a model switch, the full
+// history is sent instead.
+type OpenAIResponsesAdapter struct {
+	httpClient *http.Client
+	baseURL    string
+	apiKey     string
+	modelName  string
+
+	mu     sync.Mutex
+	chains map[string]*responseChain // by chainKey of the history a response ends
+	seq    int64
+}
+
+// responseChain is a stored response a later request can continue from
+type responseChain struct {
+	responseID string
+	used       int64 // adapter seq at last use, for eviction
+}
+
+// newOpenAIResponsesAdapter creates a Responses API adapter. An empty baseURL
+// falls back to OPENAI_BASE_URL and then to the public endpoint.
+func newOpenAIResponsesAdapter(baseURL, apiKey, modelName string, httpClient *http.Client) *OpenAIResponsesAdapter {
+	if baseURL == "" {
+		baseURL = os.Getenv("OPENAI_BASE_URL")
+	}
+	if baseURL == "" {
+		baseURL = defaultOpenAIBaseURL
+	}
+	if httpClient == nil {
+		httpClient = &http.Client{Timeout: responsesTimeout}
+	}
+	return &OpenAIResponsesAdapter{
+		httpClient: httpClient,
+		baseURL:    strings.TrimSuffix(baseURL, "/"),
+		apiKey:     apiKey,
+		modelName:  modelName,
+		chains:     make(map[string]*responseChain),
+	}
+}
+
+// Name returns the model name
+func (a *OpenAIResponsesAdapter) Name() string {
+	return a.modelName
+}
+
+// responsesRequest is the body of POST /responses
+type responsesRequest struct {
+	Model              string               `json:"model"`
+	Input              []responsesInputItem `json:"input"`
+	Instructions       string               `json:"instructions,omitempty"`
+	PreviousResponseID string               `json:"previous_response_id,omitempty"`
+	Tools              []responsesTool      `json:"tools,omitempty"`
+	ToolChoice         string               `json:"tool_choice,omitempty"`
+	Temperature        *float64             `json:"temperature,omitempty"`
+	TopP               *float64             `json:"top_p,omitempty"`
+	MaxOutputTokens    int64                `json:"max_output_tokens,omitempty"`
+	Store              bool                 `json:"store"`
+	Stream             bool                 `json:"stream,omitempty"`
+}
+
+// responsesInputItem is a message, function call or function call output
+type responsesInputItem struct {
+	Type      string `json:"type"`
+	Role      string `json:"role,omitempty"`
+	Content   string `json:"content,omitempty"`
+	CallID    string `json:"call_id,omitempty"`
+	Name      string `json:"name,omitempty"`
+	Arguments string `json:"arguments,omitempty"`
+	Output    string `json:"output,omitempty"`
+}
+
+// responsesTool is a function tool declaration
+type responsesTool struct {
+	Type        string         `json:"type"`
+	Name        string         `json:"name"`
+	Description string         `json:"description,omitempty"`
+	Parameters  map[string]any `json:"parameters"`
+	Strict      bool           `json:"strict"` // the API defaults to true, which our schemas don't satisfy
+}
+
+// responsesResponse is a response object, returned directly or inside
+// stream events
+type responsesResponse struct {
+	ID                string                `json:"id"`
+	Status            string                `json:"status"`
+	Output            []responsesOutputItem `json:"output"`
+	Error             *responsesErrorBody   `json:"error"`
+	IncompleteDetails *struct {
+		Reason string `json:"reason"`
+	} `json:"incomplete_details"`
+	Usage *struct {
+		InputTokens        int32 `json:"input_tokens"`
+		OutputTokens       int32 `json:"output_tokens"`
+		TotalTokens        int32 `json:"total_tokens"`
+		InputTokensDetails struct {
+			CachedTokens int32 `json:"cached_tokens"`
+		} `json:"input_tokens_details"`
+	} `json:"usage"`
+}
+
+// responsesOutputItem is a message or function call the model produced
+type responsesOutputItem struct {
+	Type    string `json:"type"`
+	Content []struct {
+		Type string `json:"type"`
+		Text string `json:"text"`
+	} `json:"content"`
+	CallID    string `json:"call_id"`
+	Name      string `json:"name"`
+	Arguments string `json:"arguments"`
+}
+
+// responsesStreamEvent is one server-sent event of a streamed response
+type responsesStreamEvent struct {
+	Type     string             `json:"type"`
+	Delta    string             `json:"delta"`
+	Response *responsesResponse `json:"response"`
+	Message  string             `json:"message"`
+}
+
+type responsesErrorBody struct {
+	Message string `json:"message"`
+	Type    string `json:"type"`
+	Param   string `json:"param"`
+	Code    string `json:"code"`
+}
+
+// responsesAPIError is an error status returned by the Responses API
+type responsesAPIError struct {
+	StatusCode int
+	responsesErrorBody
+}
+
+func (e *responsesAPIError) Error() string {
+	if e.Message == "" {
+		return fmt.Sprintf("OpenAI Responses API returned status %d", e.StatusCode)
+	}
+	return fmt.Sprintf("OpenAI Responses API returned status %d: %s", e.StatusCode, e.Message)
+}
+
+// GenerateContent implements the model.LLM interface
+// It continues the conversation's stored response when the request extends
+// it, and sends the whole history otherwise
+func (a *OpenAIResponsesAdapter) GenerateContent(
+	ctx context.Context,
+	req *model.LLMRequest,
+	stream bool,
+) iter.Seq2[*model.LLMResponse, error] {
+	return func(yield func(*model.LLMResponse, error) bool) {
+		modelName := a.modelName
+		if req.Model != "" {
+			modelName = req.Model
+		}
+
+		body, err := buildResponsesRequest(modelName, req, stream)
+		if err != nil {
+			yield(nil, err)
+			return
+		}
+
+		// Send only the items after the stored response when there is one
+		full := body.Input
+		chainKey, previousID, newItems := a.findChain(modelName, req.Contents)
+		if previousID != "" {
+			body.PreviousResponseID = previousID
+			body.Input = convertToResponsesInput(newItems)
+		}
+
+		httpResp, err := a.post(ctx, body)
+		var apiErr *responsesAPIError
+		if previousID != "" && errors.As(err, &apiErr) && (apiErr.StatusCode == http.StatusBadRequest || apiErr.StatusCode == http.StatusNotFound) {
+			// The stored response expired or was rejected, so resend everything
+			a.forget(chainKey)
+			body.PreviousResponseID = ""
+			body.Input = full
+			httpResp, err = a.post(ctx, body)
+		}
+		if err != nil {
+			yield(nil, err)
+			return
+		}
+		defer httpResp.Body.Close()
+
+		var final *responsesResponse
+		if stream {
+			final, err = readResponsesStream(httpResp.Body, func(delta string) bool {
+				return yield(&model.LLMResponse{
+					Content: &genai.Content{Role: "model", Parts: []*genai.Part{{Text: delta}}},
+					Partial: true,
+				}, nil)
+			})
+			if errors.Is(err, errStreamStopped) {
+				return
+			}
+		} else {
+			final = &responsesResponse{}
+			err = json.NewDecoder(httpResp.Body).Decode(final)
+		}
+		if err != nil {
+			yield(nil, fmt.Errorf("failed to read OpenAI response: %w", err))
+			return
+		}
+
+		resp, err := convertFromResponsesResponse(final)
+		if err != nil {
+			yield(nil, err)
+			return
+		}
+		if final.ID != "" && resp.Content != nil {
+			a.remember(historyKey(modelName, req.Contents, resp.Content), final.ID)
+		}
+		yield(resp, nil)
+	}
+}
+
+// buildResponsesRequest converts an LLM request to a Responses API request
+// carrying the full history
+func buildResponsesRequest(modelName string, req *model.LLMRequest, stream bool) (*responsesRequest, error) {
+	body := &responsesRequest{
+		Model:  modelName,
+		Input:  convertToResponsesInput(req.Contents),
+		Store:  true, // previous_response_id needs the response stored
+		Stream: stream,
+	}
+	if req.Config == nil {
+		return body, nil
+	}
+
+	// The server does not carry instructions over from earlier responses,
+	// so they are sent with every request
+	if req.Config.SystemInstruction != nil {
+		var texts []string
+		for _, part := range req.Config.SystemInstruction.Parts {
+			if part != nil && part.Text != "" {
+				texts = append(texts, part.Text)
+			}
+		}
+		body.Instructions = strings.Join(texts, "\n")
+	}
+
+	// Temperature and TopP are not supported by reasoning models
+	if !isReasoningModel(modelName) {
+		if req.Config.Temperature != nil {
+			temperature := float64(*req.Config.Temperature)
+			body.Temperature = &temperature
+		}
+		if req.Config.TopP != nil {
+			topP := float64(*req.Config.TopP)
+			body.TopP = &topP
+		}
+	}
+	if req.Config.MaxOutputTokens > 0 {
+		body.MaxOutputTokens = int64(req.Config.MaxOutputTokens)
+	}
+
+	for _, tool := range req.Config.Tools {
+		if tool == nil {
+			continue
+		}
+		for _, funcDecl := range tool.FunctionDeclarations {
+			if funcDecl == nil {
+				continue
+			}
+			params, err := functionParametersSchema(funcDecl)
+			if err != nil {
+				return nil, fmt.Errorf("failed to convert tools: %w", err)
+			}
+			if params == nil {
+				params = map[string]any{"type": "object", "properties": map[string]any{}}
+			}
+			body.Tools = append(body.Tools, responsesTool{
+				Type:        "function",
+				Name:        funcDecl.Name,
+				Description: funcDecl.Description,
+				Parameters:  params,
+			})
+		}
+	}
+	if len(body.Tools) > 0 {
+		body.ToolChoice = "auto"
+		if req.Config.ToolConfig != nil && req.Config.ToolConfig.FunctionCallingConfig != nil {
+			switch req.Config.ToolConfig.FunctionCallingConfig.Mode {
+			case genai.FunctionCallingConfigModeAny:
+				body.ToolChoice = "required"
+			case genai.FunctionCallingConfigModeNone:
+				body.ToolChoice = "none"
+			}
+		}
+	}
+	return body, nil
+}
+
+// convertToResponsesInput converts genai.Content to Responses API input items
+func convertToResponsesInput(contents []*genai.Content) []responsesInputItem {
+	items := make([]responsesInputItem, 0, len(contents))
+	for _, content := range contents {
+		if content == nil {
+			continue
+		}
+
+		role := "user"
+		switch strings.ToLower(content.Role) {
+		case "model", "assistant":
+			role = "assistant"
+		case "system":
+			role = "system"
+		}
+
+		var texts []string
+		var calls, outputs []responsesInputItem
+		for _, part := range content.Parts {
+			if part == nil {
+				continue
+			}
+			if part.Text != "" && !part.Thought {
+				texts = append(texts, part.Text)
+			}
+			if part.FunctionCall != nil {
+				args := "{}"
+				if part.FunctionCall.Args != nil {
+					if data, err := json.Marshal(part.FunctionCall.Args); err == nil {
+						args = string(data)
+					}
+				}
+				calls = append(calls, responsesInputItem{
+					Type:      "function_call",
+					CallID:    part.FunctionCall.ID,
+					Name:      part.FunctionCall.Name,
+					Arguments: args,
+				})
+			}
+			if part.FunctionResponse != nil {
+				outputs = append(outputs, responsesInputItem{
+					Type:   "function_call_output",
+					CallID: part.FunctionResponse.ID,
+					Output: functionResponseJSON(*part.FunctionResponse),
+				})
+			}
+		}
+
+		if len(texts) > 0 {
+			items = append(items, responsesInputItem{Type: "message", Role: role, Content: strings.Join(texts, "\n")})
+		}
+		items = append(items, calls...)
+		items = append(items, outputs...)
+	}
+	return items
+}
+
+// convertFromResponsesResponse converts a finished Responses API response to
+// a complete LLMResponse
+func convertFromResponsesResponse(r *responsesResponse) (*model.LLMResponse, error) {
+	if r.Status == "failed" || r.Status == "cancelled" {
+		if r.Error != nil && r.Error.Message != "" {
+			return nil, fmt.Errorf("OpenAI response %s: %s", r.Status, r.Error.Message)
+		}
+		return nil, fmt.Errorf("OpenAI response %s", r.Status)
+	}
+
+	content := &genai.Content{Role: "model"}
+	var text strings.Builder
+	for _, item := range r.Output {
+		switch item.Type {
+		case "message":
+			for _, c := range item.Content {
+				if c.Type == "output_text" {
+					text.WriteString(c.Text)
+				}
+			}
+		case "function_call":
+			// If parsing fails, args remains nil - tool will receive empty args
+			var args map[string]any
+			if item.Arguments != "" {
+				json.Unmarshal([]byte(item.Arguments), &args)
+			}
+			content.Parts = append(content.Parts, &genai.Part{
+				FunctionCall: &genai.FunctionCall{ID: item.CallID, Name: item.Name, Args: args},
+			})
+		}
+	}
+	if text.Len() > 0 {
+		content.Parts = append([]*genai.Part{{Text: text.String()}}, content.Parts...)
+	}
+
+	resp := &model.LLMResponse{TurnComplete: true, FinishReason: genai.FinishReasonStop}
+	if len(content.Parts) > 0 {
+		resp.Content = content
+	}
+	if r.Status == "incomplete" {
+		resp.FinishReason = genai.FinishReasonOther
+		if r.IncompleteDetails != nil {
+			switch r.IncompleteDetails.Reason {
+			case "max_output_tokens":
+				resp.FinishReason = genai.FinishReasonMaxTokens
+			case "content_filter":
+				resp.FinishReason = genai.FinishReasonSafety
+			}
+		}
+	}
+	if r.Usage != nil {
+		resp.UsageMetadata = &genai.GenerateContentResponseUsageMetadata{
+			PromptTokenCount:        r.Usage.InputTokens,
+			CandidatesTokenCount:    r.Usage.OutputTokens,
+			TotalTokenCount:         r.Usage.TotalTokens,
+			CachedContentTokenCount: r.Usage.InputTokensDetails.CachedTokens,
+		}
+	}
+	return resp, nil
+}
+
+// post sends a request to the /responses endpoint, returning an error for
+// any non-success status
+func (a *OpenAIResponsesAdapter) post(ctx context.Context, body *responsesRequest) (*http.Response, error) {
+	data, err := json.Marshal(body)
+	if err != nil {
+		return nil, fmt.Errorf("failed to encode OpenAI request: %w", err)
+	}
+	httpReq, err := http.NewRequestWithContext(ctx, http.MethodPost, a.baseURL+"/responses", bytes.NewReader(data))
+	if err != nil {
+		return nil, err
+	}
+	httpReq.Header.Set("Content-Type", "application/json")
+	httpReq.Header.Set("Authorization", "Bearer "+a.apiKey)
+	if body.Stream {
+		httpReq.Header.Set("Accept", "text/event-stream")
+	}
+
+	httpResp, err := a.httpClient.Do(httpReq)
+	if err != nil {
+		return nil, fmt.Errorf("OpenAI request failed: %w", err)
+	}
+	if httpResp.StatusCode >= 300 {
+		defer httpResp.Body.Close()
+		apiErr := &responsesAPIError{StatusCode: httpResp.StatusCode}
+		var envelope struct {
+			Error *responsesErrorBody `json:"error"`
+		}
+		if json.NewDecoder(io.LimitReader(httpResp.Body, 1<<20)).Decode(&envelope) == nil && envelope.Error != nil {
+			apiErr.responsesErrorBody = *envelope.Error
+		}
+		return nil, apiErr
+	}
+	return httpResp, nil
+}
+
+// errStreamStopped reports that the consumer stopped reading a stream
+var errStreamStopped = errors.New("stream stopped by consumer")
+
+// readResponsesStream reads server-sent events, passing text deltas to
+// onDelta, and returns the finished response
+func readResponsesStream(r io.Reader, onDelta func(string) bool) (*responsesResponse, error) {
+	reader := bufio.NewReader(r)
+	var data strings.Builder
+	for {
+		line, err := reader.ReadString('\n')
+		line = strings.TrimRight(line, "\r\n")
+		if strings.HasPrefix(line, "data:") {
+			data.WriteString(strings.TrimPrefix(strings.TrimPrefix(line, "data:"), " "))
+		} else if line == "" && data.Len() > 0 {
+			// A blank line ends the event
+			var event responsesStreamEvent
+			if jsonErr := json.Unmarshal([]byte(data.String()), &event); jsonErr != nil {
+				return nil, fmt.Errorf("malformed stream event: %w", jsonErr)
+			}
+			data.Reset()
+
+			switch event.Type {
+			case "response.output_text.delta":
+				if event.Delta != "" && !onDelta(event.Delta) {
+					return nil, errStreamStopped
+				}
+			case "response.completed", "response.incomplete", "response.failed":
+				if event.Response == nil {
+					return nil, fmt.Errorf("%s event without a response", event.Type)
+				}
+				return event.Response, nil
+			case "error":
+				return nil, fmt.Errorf("stream error: %s", event.Message)
+			}
+		}
+		if err == io.EOF {
+			return nil, fmt.Errorf("stream ended before the response finished")
+		}
+		if err != nil {
+			return nil, err
+		}
+	}
+}
+
+// historyKey identifies a conversation history that ends with a model
+// reply: the model, the contents before the reply, and the reply's text and
+// function calls (all the session records of it, so the key can be
+// recomputed from a later request's history)
+func historyKey(modelName string, contents []*genai.Content, reply *genai.Content) string {
+	h := sha256.New()
+	h.Write([]byte(modelName))
+	h.Write([]byte{0})
+	for _, content := range contents {
+		data, _ := json.Marshal(content)
+		h.Write(data)
+		h.Write([]byte{0})
+	}
+	return replyKey(h.Sum(nil), reply)
+}
+
+// replyKey combines the hash of the contents before a reply with the reply
+func replyKey(prefix []byte, reply *genai.Content) string {
+	h := sha256.New()
+	h.Write(prefix)
+	for _, part := range reply.Parts {
+		if part == nil {
+			continue
+		}
+		if part.Text != "" && !part.Thought {
+			h.Write([]byte("t:" + part.Text))
+			h.Write([]byte{0})
+		}
+		if part.FunctionCall != nil {
+			h.Write([]byte("c:" + part.FunctionCall.ID + ":" + part.FunctionCall.Name))
+			h.Write([]byte{0})
+		}
+	}
+	return hex.EncodeToString(h.Sum(nil))
+}
+
+// findChain finds the latest model reply in contents that ends a stored
+// response, returning its key, the response ID and the contents after it.
+// The response ID is empty when there is none to continue.
+func (a *OpenAIResponsesAdapter) findChain(modelName string, contents []*genai.Content) (string, string, []*genai.Content) {
+	// prefixes[i] hashes the model and contents[:i]
+	prefixes := make([][]byte, len(contents))
+	h := sha256.New()
+	h.Write([]byte(modelName))
+	h.Write([]byte{0})
+	for i, content := range contents {
+		prefixes[i] = h.Sum(nil)
+		data, _ := json.Marshal(content)
+		h.Write(data)
+		h.Write([]byte{0})
+	}
+
+	a.mu.Lock()
+	defer a.mu.Unlock()
+	// The last content is the new turn, so a reply that ends a chain comes before it
+	for i := len(contents) - 2; i >= 0; i-- {
+		content := contents[i]
+		if content == nil || (content.Role != "model" && content.Role != "assistant") {
+			continue
+		}
+		key := replyKey(prefixes[i], content)
+		if chain, ok := a.chains[key]; ok {
+			a.seq++
+			chain.used = a.seq
+			return key, chain.responseID, contents[i+1:]
+		}
+	}
+	return "", "", nil
+}
+
+// remember stores a response for later requests to continue from, evicting
+// the least recently used when over maxResponseChains
+func (a *OpenAIResponsesAdapter) remember(key, responseID string) {
+	a.mu.Lock()
+	defer a.mu.Unlock()
+	a.seq++
+	a.chains[key] = &responseChain{responseID: responseID, used: a.seq}
+	if len(a.chains) <= maxResponseChains {
+		return
+	}
+	oldestKey, oldest := "", int64(0)
+	for k, chain := range a.chains {
+		if oldestKey == "" || chain.used < oldest {
+			oldestKey, oldest = k, chain.used
+		}
+	}
+	delete(a.chains, oldestKey)
+}
+
+// forget drops a stored response the server no longer accepts
+func (a *OpenAIResponsesAdapter) forget(key string) {
+	a.mu.Lock()
+	defer a.mu.Unlock()
+	delete(a.chains, key)
+}
@@ -0,0 +1,126 @@
+package workspace
+
+import (
+	"context"
+	"path/filepath"
+	"sync"
+	"sync/atomic"
+)
+
+var (
+	activeMu      sync.RWMutex
+	activeManager *Manager
+)
+
+// SetActive makes manager the workspace that workspace-scoped tools search.
+func SetActive(manager *Manager) {
+	activeMu.Lock()
+	defer activeMu.Unlock()
+	activeManager = manager
+}
+
+// Active returns the workspace set with SetActive, or nil.
+func Active() *Manager {
+	activeMu.RLock()
+	defer activeMu.RUnlock()
+	return activeManager
+}
+
+// RootsByPriority returns the roots in search priority order: the primary
+// root first, then the others in configured order.
+func (m *Manager) RootsByPriority() []WorkspaceRoot {
+	if len(m.roots) == 0 {
+		return nil
+	}
+	roots := make([]WorkspaceRoot, 0, len(m.roots))
+	roots = append(roots, m.roots[m.primaryIndex])
+	for i, root := range m.roots {
+		if i != m.primaryIndex {
+			roots = append(roots, root)
+		}
+	}
+	return roots
+}
+
+// ResultBudget is the result limit of one root's search.
+type ResultBudget struct {
+	remaining  atomic.Int64
+	overflowed atomic.Bool
+	cancel     context.CancelFunc
+}
+
+// Take reserves one result slot. It returns false once the budget is spent,
+// after which the search owning the budget is cancelled.
+func (b *ResultBudget) Take() bool {
+	if b.remaining.Add(-1) >= 0 {
+		return true
+	}
+	b.overflowed.Store(true)
+	b.cancel()
+	return false
+}
+
+// RootResults holds one root's matches from a workspace-scoped search.
+type RootResults[T any] struct {
+	Root  WorkspaceRoot
+	Items []T
+	Err   error
+}
+
+// RootSearch searches a single root. It must call budget.Take before keeping
+// each result and stop when Take returns false or ctx is cancelled.
+type RootSearch[T any] func(ctx context.Context, root WorkspaceRoot, budget *ResultBudget) ([]T, error)
+
+// SearchRoots runs search concurrently on every root of the manager. Each
+// root collects up to maxResults on its own budget, so a fast root cannot
+// crowd out the others; the per-root results are then kept in priority order
+// until maxResults are taken. The returned set therefore does not depend on
+// which root finished first. truncated reports whether any results were
+// dropped.
+func SearchRoots[T any](ctx context.Context, m *Manager, maxResults int, search RootSearch[T]) (results []RootResults[T], truncated bool) {
+	roots := m.RootsByPriority()
+	budgets := make([]*ResultBudget, len(roots))
+
+	results = make([]RootResults[T], len(roots))
+	var wg sync.WaitGroup
+	for i, root := range roots {
+		rootCtx, cancel := context.WithCancel(ctx)
+		budgets[i] = &ResultBudget{cancel: cancel}
+		budgets[i].remaining.Store(int64(maxResults))
+
+		wg.Add(1)
+		go func(i int, root WorkspaceRoot) {
+			defer wg.Done()
+			defer cancel()
+			items, err := search(rootCtx, root, budgets[i])
+			if err != nil && budgets[i].overflowed.Load() {
+				// Cancelled because the budget ran out; keep what was found
+				err = nil
+			}
+			results[i] = RootResults[T]{Root: root, Items: items, Err: err}
+		}(i, root)
+	}
+	wg.Wait()
+
+	remaining := maxResults
+	for i := range results {
+		if budgets[i].overflowed.Load() {
+			truncated = true
+		}
+		if len(results[i].Items) > remaining {
+			results[i].Items = results[i].Items[:remaining]
+			truncated = true
+		}
+		remaining -= len(results[i].Items)
+	}
+	return results, truncated
+}
+
+// HintedPath labels a path under root with the root's workspace hint.
+func HintedPath(root WorkspaceRoot, absolutePath string) string {
+	rel, err := filepath.Rel(root.Path, absolutePath)
+	if err != nil {
+		rel = absolutePath
+	}
+	return FormatPathWithHint(root.Name, filepath.ToSlash(rel))
+}
@@ -0,0 +1,78 @@
+package workspace
+
+import (
+	"context"
+	"fmt"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+)
+
+func TestRootsByPriorityPutsPrimaryFirst(t *testing.T) {
+	m := NewManager([]WorkspaceRoot{{Name: "a"}, {Name: "b"}, {Name: "c"}}, 1)
+	roots := m.RootsByPriority()
+	got := []string{roots[0].Name, roots[1].Name, roots[2].Name}
+	if fmt.Sprint(got) != "[b a c]" {
+		t.Errorf("expected [b a c], got %v", got)
+	}
+}
+
+func TestSearchRootsMergesByPriority(t *testing.T) {
+	tempDir := t.TempDir()
+	var roots []WorkspaceRoot
+	for _, name := range []string{"frontend", "backend"} {
+		dir := filepath.Join(tempDir, name)
+		if err := os.MkdirAll(dir, 0755); err != nil {
+			t.Fatalf("Failed to create %s: %v", name, err)
+		}
+		roots = append(roots, WorkspaceRoot{Name: name, Path: dir})
+	}
+	m := NewManager(roots, 1)
+
+	// Each root can produce 10 results, but only 12 fit the budget. The
+	// secondary root answers immediately while the primary one is slow.
+	search := func(ctx context.Context, root WorkspaceRoot, budget *ResultBudget) ([]string, error) {
+		var items []string
+		for i := 0; i < 10; i++ {
+			if root.Name == "backend" {
+				time.Sleep(time.Millisecond)
+			}
+			if ctx.Err() != nil || !budget.Take() {
+				return items, ctx.Err()
+			}
+			items = append(items, HintedPath(root, filepath.Join(root.Path, fmt.Sprintf("f%d.go", i))))
+		}
+		return items, nil
+	}
+	results, truncated := SearchRoots(context.Background(), m, 12, search)
+
+	if !truncated {
+		t.Error("expected the search to report truncation")
+	}
+	if results[0].Root.Name != "backend" || results[1].Root.Name != "frontend" {
+		t.Fatalf("expected primary root first, got %s, %s", results[0].Root.Name, results[1].Root.Name)
+	}
+	total := 0
+	for _, r := range results {
+		if r.Err != nil {
+			t.Errorf("expected budget cancellation not to surface as an error, got %v", r.Err)
+		}
+		total += len(r.Items)
+	}
+	if total != 12 {
+		t.Errorf("expected 12 results in total, got %d", total)
+	}
+	if len(results[0].Items) != 10 || len(results[1].Items) != 2 {
+		t.Errorf("expected the primary root to fill the budget first, got %d and %d",
+			len(results[0].Items), len(results[1].Items))
+	}
+	if len(results[0].Items) > 0 && results[0].Items[0] != "@backend:f0.go" {
+		t.Errorf("expected hinted path, got %s", results[0].Items[0])
+	}
+
+	// A budget that is never exceeded is not truncated
+	if _, truncated := SearchRoots(context.Background(), m, 20, search); truncated {
+		t.Error("expected an exact fit not to be reported as truncated")
+	}
+}
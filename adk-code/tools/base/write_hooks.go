@@ -0,0 +1,36 @@
+package common
+
+import (
+	"path/filepath"
+	"sync"
+)
+
+// FileWriteHook is called after a tool writes a file. path is absolute, or
+// empty when a tool may have changed arbitrary files (e.g. a shell command).
+type FileWriteHook func(path string)
+
+var (
+	writeHooksMu sync.RWMutex
+	writeHooks   []FileWriteHook
+)
+
+// OnFileWrite registers a hook that is notified of tool file writes.
+func OnFileWrite(hook FileWriteHook) {
+	writeHooksMu.Lock()
+	defer writeHooksMu.Unlock()
+	writeHooks = append(writeHooks, hook)
+}
+
+// NotifyFileWrite reports a write to every registered hook.
+func NotifyFileWrite(path string) {
+	if path != "" {
+		if abs, err := filepath.Abs(path); err == nil {
+			path = abs
+		}
+	}
+	writeHooksMu.RLock()
+	defer writeHooksMu.RUnlock()
+	for _, hook := range writeHooks {
+		hook(path)
+	}
+}
@@ -0,0 +1,607 @@
+package data
+
+import (
+	"context"
+	"encoding/json"
+	"fmt"
+	"regexp"
+	"sort"
+	"strconv"
+	"strings"
+)
+
+// step is one part of a path: a key, an array index, or an iteration over
+// every element ([]).
+type step struct {
+	key     string
+	index   int
+	isIndex bool
+	iterate bool
+}
+
+// parsePath parses a jq-style path such as ".items[].name", ".[0]" or
+// `.["key with spaces"]`. A bare name ("status") is a single key, which lets
+// CSV columns be named as they appear in the header.
+func parsePath(s string) ([]step, error) {
+	s = strings.TrimSpace(s)
+	if s == "" || s == "." {
+		return nil, nil
+	}
+	if s[0] != '.' && s[0] != '[' {
+		return []step{{key: s}}, nil
+	}
+
+	var steps []step
+	for i := 0; i < len(s); {
+		switch s[i] {
+		case '.':
+			i++
+			if i < len(s) && s[i] == '[' {
+				continue
+			}
+			start := i
+			for i < len(s) && s[i] != '.' && s[i] != '[' {
+				i++
+			}
+			if i == start {
+				return nil, fmt.Errorf("empty key in path %q", s)
+			}
+			steps = append(steps, step{key: s[start:i]})
+		case '[':
+			end := strings.IndexByte(s[i:], ']')
+			if end < 0 {
+				return nil, fmt.Errorf("unclosed [ in path %q", s)
+			}
+			inner := strings.TrimSpace(s[i+1 : i+end])
+			i += end + 1
+			switch {
+			case inner == "":
+				steps = append(steps, step{iterate: true})
+			case inner[0] == '"':
+				var key string
+				if err := json.Unmarshal([]byte(inner), &key); err != nil {
+					return nil, fmt.Errorf("invalid key %s in path %q", inner, s)
+				}
+				steps = append(steps, step{key: key})
+			default:
+				n, err := strconv.Atoi(inner)
+				if err != nil || n < 0 {
+					return nil, fmt.Errorf("invalid index [%s] in path %q", inner, s)
+				}
+				steps = append(steps, step{index: n, isIndex: true})
+			}
+		default:
+			return nil, fmt.Errorf("unexpected %q in path %q", s[i], s)
+		}
+	}
+	return steps, nil
+}
+
+// evalPath returns the values steps select from v. Missing keys select
+// nothing; iteration selects every element of an array or object.
+func evalPath(v any, steps []step) []any {
+	if len(steps) == 0 {
+		return []any{v}
+	}
+	st, rest := steps[0], steps[1:]
+	switch {
+	case st.iterate:
+		var out []any
+		switch c := v.(type) {
+		case []any:
+			for _, e := range c {
+				out = append(out, evalPath(e, rest)...)
+			}
+		case map[string]any:
+			keys := make([]string, 0, len(c))
+			for k := range c {
+				keys = append(keys, k)
+			}
+			sort.Strings(keys)
+			for _, k := range keys {
+				out = append(out, evalPath(c[k], rest)...)
+			}
+		}
+		return out
+	case st.isIndex:
+		if a, ok := v.([]any); ok && st.index < len(a) {
+			return evalPath(a[st.index], rest)
+		}
+	default:
+		if m, ok := v.(map[string]any); ok {
+			if e, ok := m[st.key]; ok {
+				return evalPath(e, rest)
+			}
+		}
+	}
+	return nil
+}
+
+// condition is one "path op value" filter.
+type condition struct {
+	path  []step
+	op    string
+	value any // string, float64, bool or nil
+	re    *regexp.Regexp
+}
+
+// operators in match order, longer first so "<=" is not read as "<"
+var operators = []string{"==", "!=", "<=", ">=", "=~", "<", ">", " contains "}
+
+// parseWhere parses conditions joined by "and", e.g.
+// `.status == "error" and .latency_ms > 250`.
+func parseWhere(s string) ([]condition, error) {
+	if strings.TrimSpace(s) == "" {
+		return nil, nil
+	}
+	var conds []condition
+	for _, part := range regexp.MustCompile(`(?i)\s+and\s+`).Split(s, -1) {
+		c, err := parseCondition(part)
+		if err != nil {
+			return nil, err
+		}
+		conds = append(conds, c)
+	}
+	return conds, nil
+}
+
+func parseCondition(s string) (condition, error) {
+	for _, op := range operators {
+		i := strings.Index(s, op)
+		if i <= 0 {
+			continue
+		}
+		path, err := parsePath(s[:i])
+		if err != nil {
+			return condition{}, err
+		}
+		c := condition{path: path, op: strings.TrimSpace(op), value: parseLiteral(strings.TrimSpace(s[i+len(op):]))}
+		if c.op == "=~" {
+			pattern, _ := c.value.(string)
+			if c.re, err = regexp.Compile(pattern); err != nil {
+				return condition{}, fmt.Errorf("invalid regex in %q: %v", s, err)
+			}
+		}
+		return c, nil
+	}
+	return condition{}, fmt.Errorf("no operator in condition %q (use ==, !=, <, <=, >, >=, =~ or contains)", s)
+}
+
+// parseLiteral reads a JSON literal, or takes the text as a string.
+func parseLiteral(s string) any {
+	var v any
+	if err := json.Unmarshal([]byte(s), &v); err == nil {
+		return v
+	}
+	return s
+}
+
+// match reports whether any value the condition's path selects satisfies it.
+func (c condition) match(record any) bool {
+	for _, v := range evalPath(record, c.path) {
+		if c.matchValue(v) {
+			return true
+		}
+	}
+	return false
+}
+
+func (c condition) matchValue(v any) bool {
+	switch c.op {
+	case "=~":
+		return c.re.MatchString(text(v))
+	case "contains":
+		if a, ok := v.([]any); ok {
+			for _, e := range a {
+				if compare(e, c.value) == 0 {
+					return true
+				}
+			}
+			return false
+		}
+		return strings.Contains(text(v), text(c.value))
+	}
+	cmp := compare(v, c.value)
+	switch c.op {
+	case "==":
+		return cmp == 0
+	case "!=":
+		return cmp != 0
+	case "<":
+		return cmp == -1
+	case "<=":
+		return cmp == -1 || cmp == 0
+	case ">":
+		return cmp == 1
+	case ">=":
+		return cmp == 1 || cmp == 0
+	}
+	return false
+}
+
+// compare orders a and b numerically when both are numbers (CSV fields and
+// json.Number included), otherwise as text. It returns 2 when they cannot
+// be ordered: one is missing, or only one is a number.
+func compare(a, b any) int {
+	if a == nil || b == nil {
+		if a == b {
+			return 0
+		}
+		return 2
+	}
+	x, aNumber := number(a)
+	y, bNumber := number(b)
+	switch {
+	case aNumber && bNumber:
+		switch {
+		case x < y:
+			return -1
+		case x > y:
+			return 1
+		}
+		return 0
+	case aNumber != bNumber:
+		return 2
+	}
+	return strings.Compare(text(a), text(b))
+}
+
+// number returns v as a float if it is numeric.
+func number(v any) (float64, bool) {
+	switch n := v.(type) {
+	case float64:
+		return n, true
+	case json.Number:
+		f, err := n.Float64()
+		return f, err == nil
+	case string:
+		f, err := strconv.ParseFloat(strings.TrimSpace(n), 64)
+		return f, err == nil
+	}
+	return 0, false
+}
+
+// text returns v as a string, JSON-encoding composite values.
+func text(v any) string {
+	switch s := v.(type) {
+	case string:
+		return s
+	case json.Number:
+		return s.String()
+	case nil:
+		return "null"
+	}
+	b, _ := json.Marshal(v)
+	return string(b)
+}
+
+// aggregate is one "fn(path)" output column.
+type aggregate struct {
+	name string // as written, used as the output key
+	fn   string
+	path []step
+}
+
+var aggregatePattern = regexp.MustCompile(`^(count|sum|avg|min|max|distinct)(?:\((.*)\))?$`)
+
+// parseAggregates parses a comma-separated list such as
+// "count, sum(.bytes), avg(latency)".
+func parseAggregates(s string) ([]aggregate, error) {
+	if strings.TrimSpace(s) == "" {
+		return nil, nil
+	}
+	var aggs []aggregate
+	for _, part := range strings.Split(s, ",") {
+		part = strings.TrimSpace(part)
+		m := aggregatePattern.FindStringSubmatch(part)
+		if m == nil {
+			return nil, fmt.Errorf("unknown aggregate %q (use count, sum(p), avg(p), min(p), max(p) or distinct(p))", part)
+		}
+		if m[1] != "count" && strings.TrimSpace(m[2]) == "" {
+			return nil, fmt.Errorf("%s needs a path, e.g. %s(.bytes)", m[1], m[1])
+		}
+		path, err := parsePath(m[2])
+		if err != nil {
+			return nil, err
+		}
+		aggs = append(aggs, aggregate{name: part, fn: m[1], path: path})
+	}
+	return aggs, nil
+}
+
+// maxDistinctValues bounds the set distinct() keeps per group
+const maxDistinctValues = 100_000
+
+// aggState accumulates one aggregate in constant memory (distinct is
+// capped).
+type aggState struct {
+	count    int
+	sum      float64
+	min, max float64
+	seen     bool
+	distinct map[string]struct{}
+	capped   bool
+}
+
+func (st *aggState) add(agg aggregate, record any) {
+	if agg.fn == "count" && len(agg.path) == 0 {
+		st.count++
+		return
+	}
+	for _, v := range evalPath(record, agg.path) {
+		if agg.fn == "count" {
+			st.count++
+			continue
+		}
+		if agg.fn == "distinct" {
+			if st.distinct == nil {
+				st.distinct = make(map[string]struct{})
+			}
+			if len(st.distinct) < maxDistinctValues {
+				st.distinct[text(v)] = struct{}{}
+			} else if _, ok := st.distinct[text(v)]; !ok {
+				st.capped = true
+			}
+			continue
+		}
+		f, ok := number(v)
+		if !ok {
+			continue
+		}
+		st.count++
+		st.sum += f
+		if !st.seen || f < st.min {
+			st.min = f
+		}
+		if !st.seen || f > st.max {
+			st.max = f
+		}
+		st.seen = true
+	}
+}
+
+func (st *aggState) result(fn string) any {
+	switch fn {
+	case "count":
+		return st.count
+	case "sum":
+		return st.sum
+	case "distinct":
+		if st.capped {
+			return fmt.Sprintf(">%d", maxDistinctValues)
+		}
+		return len(st.distinct)
+	}
+	if !st.seen {
+		return nil
+	}
+	switch fn {
+	case "avg":
+		return st.sum / float64(st.count)
+	case "min":
+		return st.min
+	default:
+		return st.max
+	}
+}
+
+const (
+	// maxGroups bounds group_by; later groups are folded into otherGroup
+	maxGroups  = 1000
+	otherGroup = "(other)"
+	// cancelCheckInterval is how many records pass between context checks
+	cancelCheckInterval = 4096
+)
+
+// query is a parsed query over the records of one input.
+type query struct {
+	rows     []step
+	where    []condition
+	fields   []string // select paths as written
+	paths    [][]step
+	aggs     []aggregate
+	groupBy  string
+	group    []step
+	maxRows  int
+	maxBytes int
+}
+
+// queryResult is the output of a query: one JSON value per line.
+type queryResult struct {
+	content   string
+	scanned   int
+	matched   int
+	returned  int
+	truncated bool
+}
+
+// group is the aggregate state of one group_by value.
+type group struct {
+	key    any
+	states []aggState
+}
+
+// run streams the input's records through the query. Without aggregates it
+// stops reading once the row or byte budget is spent; with them it reads
+// the whole input and returns one row per group.
+func (q query) run(ctx context.Context, in *input) (queryResult, error) {
+	var result queryResult
+	var out strings.Builder
+	aggregating := len(q.aggs) > 0
+	groups := make(map[string]*group)
+	var order []string
+
+	err := in.scan(q.rows, func(record any) bool {
+		result.scanned++
+		if result.scanned%cancelCheckInterval == 0 && ctx.Err() != nil {
+			return false
+		}
+		for _, c := range q.where {
+			if !c.match(record) {
+				return true
+			}
+		}
+		result.matched++
+
+		if aggregating {
+			var key any
+			if q.group != nil {
+				if values := evalPath(record, q.group); len(values) > 0 {
+					key = values[0]
+				}
+			}
+			name := text(key)
+			g, ok := groups[name]
+			if !ok {
+				if len(groups) >= maxGroups {
+					name, key = otherGroup, otherGroup
+					g, ok = groups[name]
+				}
+				if !ok {
+					g = &group{key: key, states: make([]aggState, len(q.aggs))}
+					groups[name] = g
+					order = append(order, name)
+				}
+			}
+			for i, agg := range q.aggs {
+				g.states[i].add(agg, record)
+			}
+			return true
+		}
+
+		line := q.project(record)
+		if result.returned == q.maxRows || out.Len()+len(line) > q.maxBytes {
+			result.truncated = true
+			return false
+		}
+		out.WriteString(line)
+		out.WriteByte('\n')
+		result.returned++
+		return true
+	})
+	if err == nil {
+		err = ctx.Err()
+	}
+	if err != nil {
+		return result, err
+	}
+
+	if aggregating {
+		if q.group == nil && len(order) == 0 {
+			// Aggregates over no records still produce a row
+			order = append(order, "")
+			groups[""] = &group{states: make([]aggState, len(q.aggs))}
+		}
+		sort.SliceStable(order, func(i, j int) bool {
+			a, b := groups[order[i]].key, groups[order[j]].key
+			if a == nil || b == nil {
+				return a == nil && b != nil
+			}
+			if a == otherGroup || b == otherGroup {
+				return b == otherGroup && a != otherGroup
+			}
+			return compare(a, b) < 0
+		})
+		for _, name := range order {
+			g := groups[name]
+			var keys []string
+			var values []any
+			if q.group != nil {
+				keys, values = append(keys, q.groupBy), append(values, g.key)
+			}
+			for i, agg := range q.aggs {
+				keys, values = append(keys, agg.name), append(values, g.states[i].result(agg.fn))
+			}
+			line := encodeObject(keys, values)
+			if result.returned == q.maxRows || out.Len()+len(line) > q.maxBytes {
+				result.truncated = true
+				break
+			}
+			out.WriteString(line)
+			out.WriteByte('\n')
+			result.returned++
+		}
+	}
+	result.content = out.String()
+	return result, nil
+}
+
+// project returns the selected fields of record as one line of JSON: the
+// record itself without select, the value of a single path, or an object
+// keyed by path for several.
+func (q query) project(record any) string {
+	switch len(q.paths) {
+	case 0:
+		return encode(record)
+	case 1:
+		return encode(selectOne(record, q.paths[0]))
+	}
+	values := make([]any, len(q.paths))
+	for i, path := range q.paths {
+		values[i] = selectOne(record, path)
+	}
+	return encodeObject(q.fields, values)
+}
+
+// selectOne returns the value path selects, an array if it selects several,
+// or nil if none.
+func selectOne(record any, path []step) any {
+	values := evalPath(record, path)
+	switch len(values) {
+	case 0:
+		return nil
+	case 1:
+		return values[0]
+	}
+	return values
+}
+
+func encode(v any) string {
+	b, err := json.Marshal(v)
+	if err != nil {
+		return "null"
+	}
+	return string(b)
+}
+
+// encodeObject encodes keys and values as a JSON object, keeping the order
+// of keys.
+func encodeObject(keys []string, values []any) string {
+	var b strings.Builder
+	b.WriteByte('{')
+	for i, key := range keys {
+		if i > 0 {
+			b.WriteByte(',')
+		}
+		b.WriteString(encode(key))
+		b.WriteByte(':')
+		b.WriteString(encode(values[i]))
+	}
+	b.WriteByte('}')
+	return b.String()
+}
+
+// splitFields splits a comma-separated select list, ignoring commas inside
+// brackets and quotes.
+func splitFields(s string) []string {
+	var fields []string
+	depth, quoted, start := 0, false, 0
+	for i := 0; i < len(s); i++ {
+		switch c := s[i]; {
+		case c == '"' && (i == 0 || s[i-1] != '\\'):
+			quoted = !quoted
+		case quoted:
+		case c == '[':
+			depth++
+		case c == ']':
+			depth--
+		case c == ',' && depth == 0:
+			fields = append(fields, strings.TrimSpace(s[start:i]))
+			start = i + 1
+		}
+	}
+	if last := strings.TrimSpace(s[start:]); last != "" {
+		fields = append(fields, last)
+	}
+	return fields
+}
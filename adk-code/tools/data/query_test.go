@@ -0,0 +1,170 @@
+package data
+
+import (
+	"bufio"
+	"compress/gzip"
+	"context"
+	"fmt"
+	"os"
+	"path/filepath"
+	"strings"
+	"testing"
+)
+
+func writeFile(t *testing.T, name, content string) string {
+	t.Helper()
+	path := filepath.Join(t.TempDir(), name)
+	if err := os.WriteFile(path, []byte(content), 0644); err != nil {
+		t.Fatal(err)
+	}
+	return path
+}
+
+// runQuery parses and runs input, failing the test on error.
+func runQuery(t *testing.T, input QueryDataInput) queryResult {
+	t.Helper()
+	q, err := parseQuery(input)
+	if err != nil {
+		t.Fatalf("parseQuery failed: %v", err)
+	}
+	in, err := openInput(input.Path, input.Format)
+	if err != nil {
+		t.Fatalf("openInput failed: %v", err)
+	}
+	defer in.close()
+	result, err := q.run(context.Background(), in)
+	if err != nil {
+		t.Fatalf("run failed: %v", err)
+	}
+	return result
+}
+
+func TestParsePath(t *testing.T) {
+	steps, err := parsePath(`.data[].users[2]["full name"]`)
+	if err != nil {
+		t.Fatal(err)
+	}
+	want := []step{{key: "data"}, {iterate: true}, {key: "users"}, {index: 2, isIndex: true}, {key: "full name"}}
+	if fmt.Sprint(steps) != fmt.Sprint(want) {
+		t.Errorf("parsePath = %v, want %v", steps, want)
+	}
+	if steps, _ := parsePath("unit price"); len(steps) != 1 || steps[0].key != "unit price" {
+		t.Errorf("expected a bare CSV column name to be one key, got %v", steps)
+	}
+	for _, bad := range []string{".a[", ".a..b", ".a[x]"} {
+		if _, err := parsePath(bad); err == nil {
+			t.Errorf("expected an error for %q", bad)
+		}
+	}
+}
+
+func TestQueryStreamsNestedJSON(t *testing.T) {
+	path := writeFile(t, "dump.json", `{
+		"meta": {"skipped": [1, 2, {"deep": [3]}]},
+		"data": {"groups": [
+			{"name": "a", "users": [{"id": 1, "age": 31, "tags": ["x"]}, {"id": 2, "age": 25}]},
+			{"name": "b", "other": [9]},
+			{"name": "c", "users": [{"id": 3, "age": 40, "tags": ["y", "x"]}]}
+		]},
+		"after": true
+	}`)
+	result := runQuery(t, QueryDataInput{Path: path, Rows: ".data.groups[].users[]", Where: ".age >= 30 and .tags contains \"x\"", Select: ".id"})
+	if result.content != "1\n3\n" || result.scanned != 3 || result.matched != 2 {
+		t.Errorf("unexpected result %+v", result)
+	}
+
+	result = runQuery(t, QueryDataInput{Path: path, Rows: ".data.groups[]", Select: ".name, .users[0].id"})
+	want := `{".name":"a",".users[0].id":1}` + "\n" + `{".name":"b",".users[0].id":null}` + "\n" + `{".name":"c",".users[0].id":3}` + "\n"
+	if result.content != want {
+		t.Errorf("unexpected projection:\n%s", result.content)
+	}
+}
+
+func TestQueryStopsAtBudget(t *testing.T) {
+	var b strings.Builder
+	b.WriteString("[")
+	for i := 0; i < 10000; i++ {
+		if i > 0 {
+			b.WriteString(",")
+		}
+		fmt.Fprintf(&b, `{"n":%d}`, i)
+	}
+	b.WriteString("]")
+	path := writeFile(t, "big.json", b.String())
+
+	maxRows := 5
+	result := runQuery(t, QueryDataInput{Path: path, Where: ".n > 100", Select: ".n", MaxRows: &maxRows})
+	if result.content != "101\n102\n103\n104\n105\n" || !result.truncated || result.scanned > 200 {
+		t.Errorf("expected 5 rows and an early stop, got %+v", result)
+	}
+}
+
+func TestQueryAggregatesCSV(t *testing.T) {
+	path := writeFile(t, "sales.csv", "region,amount,item\n"+
+		"east,10,a\nwest,5,b\neast,2.5,\"c, d\"\nnorth,x,e\nwest,7,a\n")
+	result := runQuery(t, QueryDataInput{Path: path, GroupBy: "region", Aggregate: "count, sum(amount), max(amount), distinct(item)"})
+	want := `{"region":"east","count":2,"sum(amount)":12.5,"max(amount)":10,"distinct(item)":2}` + "\n" +
+		`{"region":"north","count":1,"sum(amount)":0,"max(amount)":null,"distinct(item)":1}` + "\n" +
+		`{"region":"west","count":2,"sum(amount)":12,"max(amount)":7,"distinct(item)":2}` + "\n"
+	if result.content != want || result.matched != 5 {
+		t.Errorf("unexpected aggregates:\n%s", result.content)
+	}
+
+	result = runQuery(t, QueryDataInput{Path: path, Where: "amount > 3", Aggregate: "count, avg(.amount)"})
+	if result.content != `{"count":3,"avg(.amount)":7.333333333333333}`+"\n" {
+		t.Errorf("unexpected filtered aggregates: %s", result.content)
+	}
+}
+
+func TestQueryJSONLGzipAndSniffing(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "events")
+	f, err := os.Create(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	gz := gzip.NewWriter(f)
+	w := bufio.NewWriter(gz)
+	for i := 0; i < 1000; i++ {
+		level := "info"
+		if i%100 == 0 {
+			level = "error"
+		}
+		fmt.Fprintf(w, `{"i":%d,"level":%q,"msg":"event %d"}`+"\n", i, level, i)
+	}
+	w.Flush()
+	gz.Close()
+	f.Close()
+
+	result := runQuery(t, QueryDataInput{Path: path, Where: `.level == "error" and .msg =~ "event [1-3]00$"`, Select: ".i"})
+	if result.content != "100\n200\n300\n" || result.scanned != 1000 {
+		t.Errorf("unexpected result %+v", result)
+	}
+}
+
+func TestSniffFormat(t *testing.T) {
+	cases := map[string]string{
+		"[1,2]":                  formatJSON,
+		"{\"a\":1}\n{\"a\":2}\n": formatJSONL,
+		"{\n  \"a\": 1\n}":       formatJSON,
+		"a,b\n1,2\n":             formatCSV,
+	}
+	for head, want := range cases {
+		if got := sniffFormat([]byte(head)); got != want {
+			t.Errorf("sniffFormat(%q) = %s, want %s", head, got, want)
+		}
+	}
+}
+
+func TestParseQueryErrors(t *testing.T) {
+	for _, input := range []QueryDataInput{
+		{Where: ".a ?? 3"},
+		{Aggregate: "median(.a)"},
+		{Aggregate: "sum"},
+		{Select: ".a", Aggregate: "count"},
+		{Where: `.a =~ "("`},
+	} {
+		if _, err := parseQuery(input); err == nil {
+			t.Errorf("expected an error for %+v", input)
+		}
+	}
+}
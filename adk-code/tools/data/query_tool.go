@@ -0,0 +1,165 @@
+// Package data provides tools for querying structured data files.
+package data
+
+import (
+	"fmt"
+
+	"google.golang.org/adk/tool"
+	"google.golang.org/adk/tool/functiontool"
+
+	common "adk-code/tools/base"
+)
+
+const (
+	defaultQueryRows  = 100
+	defaultQueryBytes = 50_000
+)
+
+// QueryDataInput defines the input parameters for querying a data file.
+type QueryDataInput struct {
+	// Path is the JSON, JSONL, CSV or TSV file to query.
+	Path string `json:"path" jsonschema:"Path to the data file (.json, .jsonl/.ndjson, .csv, .tsv, optionally .gz or .zst)"`
+	// Format overrides format detection.
+	Format string `json:"format,omitempty" jsonschema:"json, jsonl, csv or tsv (default: from the extension, then the content)"`
+	// Rows is the path to the records within each JSON document.
+	Rows string `json:"rows,omitempty" jsonschema:"JSON/JSONL only: path to the records, e.g. '.items[]' or '.data.users[]' (default: the elements of a top-level array, else each document)"`
+	// Where filters records.
+	Where string `json:"where,omitempty" jsonschema:"Conditions joined by 'and': path op value, with op one of == != < <= > >= =~ (regex) contains; e.g. '.status == \"error\" and .latency_ms > 250'. CSV columns are named as in the header."`
+	// Select projects fields of matching records.
+	Select string `json:"select,omitempty" jsonschema:"Comma-separated paths to return, e.g. '.id, .user.name' (default: whole records)"`
+	// Aggregate computes aggregates instead of returning records.
+	Aggregate string `json:"aggregate,omitempty" jsonschema:"Comma-separated aggregates over matching records: count, count(p), sum(p), avg(p), min(p), max(p), distinct(p)"`
+	// GroupBy groups the aggregates by a path.
+	GroupBy string `json:"group_by,omitempty" jsonschema:"Path to group aggregates by; implies count if no aggregate is given"`
+	// MaxRows limits the rows returned.
+	MaxRows *int `json:"max_rows,omitempty" jsonschema:"Maximum rows to return (default: 100)"`
+	// MaxBytes limits the content returned.
+	MaxBytes *int `json:"max_bytes,omitempty" jsonschema:"Maximum bytes of content to return (default: 50000)"`
+}
+
+// QueryDataOutput defines the output of querying a data file.
+type QueryDataOutput struct {
+	// Content is the result rows, one JSON value per line.
+	Content string `json:"content"`
+	// Format is the format the file was read as.
+	Format string `json:"format,omitempty"`
+	// Scanned is the number of records read.
+	Scanned int `json:"scanned"`
+	// Matched is the number of records that passed the filter.
+	Matched int `json:"matched"`
+	// Returned is the number of rows in content.
+	Returned int `json:"returned"`
+	// Truncated reports whether a budget cut the result short. Without
+	// aggregates, reading stops there, so scanned and matched are partial.
+	Truncated bool `json:"truncated,omitempty"`
+	// Success indicates whether the operation was successful.
+	Success bool `json:"success"`
+	// Error contains error message if the operation failed.
+	Error string `json:"error,omitempty"`
+}
+
+// parseQuery validates the input's expressions.
+func parseQuery(input QueryDataInput) (query, error) {
+	q := query{maxRows: defaultQueryRows, maxBytes: defaultQueryBytes, groupBy: input.GroupBy}
+	if input.MaxRows != nil && *input.MaxRows > 0 {
+		q.maxRows = *input.MaxRows
+	}
+	if input.MaxBytes != nil && *input.MaxBytes > 0 {
+		q.maxBytes = *input.MaxBytes
+	}
+
+	var err error
+	if q.rows, err = parsePath(input.Rows); err != nil {
+		return q, fmt.Errorf("invalid rows: %v", err)
+	}
+	if q.where, err = parseWhere(input.Where); err != nil {
+		return q, fmt.Errorf("invalid where: %v", err)
+	}
+	for _, field := range splitFields(input.Select) {
+		path, err := parsePath(field)
+		if err != nil {
+			return q, fmt.Errorf("invalid select: %v", err)
+		}
+		q.fields, q.paths = append(q.fields, field), append(q.paths, path)
+	}
+	if q.aggs, err = parseAggregates(input.Aggregate); err != nil {
+		return q, fmt.Errorf("invalid aggregate: %v", err)
+	}
+	if input.GroupBy != "" {
+		if q.group, err = parsePath(input.GroupBy); err != nil {
+			return q, fmt.Errorf("invalid group_by: %v", err)
+		}
+		if q.group == nil {
+			return q, fmt.Errorf("group_by needs a path, e.g. .status")
+		}
+		if len(q.aggs) == 0 {
+			q.aggs = []aggregate{{name: "count", fn: "count"}}
+		}
+	}
+	if len(q.aggs) > 0 && len(q.paths) > 0 {
+		return q, fmt.Errorf("select cannot be combined with aggregate or group_by")
+	}
+	return q, nil
+}
+
+// NewQueryDataTool creates a tool that filters, projects and aggregates the
+// records of a JSON, JSONL or CSV file, streaming it at constant memory.
+func NewQueryDataTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input QueryDataInput) QueryDataOutput {
+		q, err := parseQuery(input)
+		if err != nil {
+			return QueryDataOutput{Success: false, Error: err.Error()}
+		}
+
+		in, err := openInput(input.Path, input.Format)
+		if err != nil {
+			return QueryDataOutput{Success: false, Error: fmt.Sprintf("Cannot query %s: %v", input.Path, err)}
+		}
+		defer in.close()
+
+		result, err := q.run(ctx, in)
+		output := QueryDataOutput{
+			Content:   result.content,
+			Format:    in.format,
+			Scanned:   result.scanned,
+			Matched:   result.matched,
+			Returned:  result.returned,
+			Truncated: result.truncated,
+			Success:   err == nil,
+		}
+		if err != nil {
+			output.Error = fmt.Sprintf("Query failed after %d records: %v", result.scanned, err)
+		}
+		return output
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name: "builtin_query_data",
+		Description: `Queries a JSON, JSONL or CSV/TSV file without reading it into context: filters records, projects fields, and computes aggregates, returning only the result rows as JSON lines. The file is streamed at constant memory, so it works on multi-GB files (gzip and zstd included). Use it instead of builtin_read_file on data files.
+
+**Paths** are jq-style: .a.b, .items[], .[0], .["odd key"]. CSV columns are named as in the header (bare or .column).
+
+**Examples:**
+- Errors in a JSONL log: path="events.jsonl", where=".level == \"error\"", select=".ts, .msg"
+- Records of a nested array: path="dump.json", rows=".data.users[]", where=".age >= 30"
+- Aggregates per group: path="sales.csv", group_by="region", aggregate="count, sum(amount), avg(amount)"
+
+Without aggregate, reading stops once max_rows or max_bytes is reached (truncated=true).`,
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategorySearchDiscovery,
+			Priority:  3,
+			UsageHint: "Filter/aggregate large JSON, JSONL and CSV files at constant memory",
+		})
+	}
+
+	return t, err
+}
+
+// init registers the data tools automatically at package initialization.
+func init() {
+	_, _ = NewQueryDataTool()
+}
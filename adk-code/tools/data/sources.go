@@ -0,0 +1,364 @@
+package data
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/csv"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"strings"
+
+	"adk-code/internal/compressed"
+)
+
+// Input formats
+const (
+	formatJSON  = "json"
+	formatJSONL = "jsonl"
+	formatCSV   = "csv"
+	formatTSV   = "tsv"
+)
+
+// sniffBytes is how much of a file format detection looks at
+const sniffBytes = 64 * 1024
+
+// errStop ends a scan early once the caller has what it needs.
+var errStop = errors.New("stop scan")
+
+// input is an open data file, decompressed if needed.
+type input struct {
+	r      *bufio.Reader
+	closer io.Closer
+	format string
+}
+
+// openInput opens path, decompressing gzip and zstd files, and resolves
+// format ("" detects it from the extension, then the content).
+func openInput(path, format string) (*input, error) {
+	kind, err := compressed.Sniff(path)
+	if err != nil {
+		return nil, err
+	}
+	in := &input{}
+	if kind != compressed.None {
+		cr, err := compressed.Open(path)
+		if err != nil {
+			return nil, err
+		}
+		in.r, in.closer = bufio.NewReaderSize(cr, sniffBytes), cr
+	} else {
+		f, err := os.Open(path)
+		if err != nil {
+			return nil, err
+		}
+		if info, err := f.Stat(); err == nil && info.IsDir() {
+			f.Close()
+			return nil, fmt.Errorf("%s is a directory", path)
+		}
+		in.r, in.closer = bufio.NewReaderSize(f, sniffBytes), f
+	}
+
+	switch format = strings.ToLower(format); format {
+	case formatJSON, formatJSONL, formatCSV, formatTSV:
+	case "ndjson":
+		format = formatJSONL
+	case "":
+		format = formatFromExt(path)
+		if format == "" {
+			head, _ := in.r.Peek(sniffBytes)
+			format = sniffFormat(head)
+		}
+	default:
+		in.close()
+		return nil, fmt.Errorf("unknown format %q (use json, jsonl, csv or tsv)", format)
+	}
+	in.format = format
+	return in, nil
+}
+
+func (in *input) close() {
+	in.closer.Close()
+}
+
+// formatFromExt maps a file extension, ignoring compression suffixes, to a
+// format.
+func formatFromExt(path string) string {
+	name := strings.ToLower(filepath.Base(path))
+	for _, ext := range []string{".gz", ".zst", ".zstd"} {
+		name = strings.TrimSuffix(name, ext)
+	}
+	switch filepath.Ext(name) {
+	case ".json":
+		return formatJSON
+	case ".jsonl", ".ndjson":
+		return formatJSONL
+	case ".csv":
+		return formatCSV
+	case ".tsv", ".tab":
+		return formatTSV
+	}
+	return ""
+}
+
+// sniffFormat guesses a format from the start of a file: a top-level array
+// is JSON, one object per line is JSONL, and anything else is CSV.
+func sniffFormat(head []byte) string {
+	trimmed := bytes.TrimLeft(head, " \t\r\n\uFEFF")
+	if len(trimmed) == 0 {
+		return formatCSV
+	}
+	switch trimmed[0] {
+	case '[':
+		return formatJSON
+	case '{':
+		line, rest, found := bytes.Cut(trimmed, []byte{'\n'})
+		rest = bytes.TrimLeft(rest, " \t\r\n")
+		if found && json.Valid(line) && (len(rest) == 0 || rest[0] == '{') {
+			return formatJSONL
+		}
+		return formatJSON
+	}
+	return formatCSV
+}
+
+// scan calls yield with each record of the input until it returns false.
+// JSON is streamed token by token up to the first [] of rows, so only one
+// element is decoded at a time; JSONL and CSV are read a record at a time.
+func (in *input) scan(rows []step, yield func(record any) bool) error {
+	var err error
+	switch in.format {
+	case formatJSON:
+		err = scanJSON(in.r, rows, yield)
+	case formatJSONL:
+		err = scanJSONL(in.r, rows, yield)
+	case formatCSV, formatTSV:
+		if len(rows) > 0 {
+			return errors.New("rows applies to JSON and JSONL only")
+		}
+		comma := ','
+		if in.format == formatTSV {
+			comma = '\t'
+		}
+		err = scanCSV(in.r, comma, yield)
+	}
+	if err == errStop {
+		return nil
+	}
+	return err
+}
+
+func scanJSON(r *bufio.Reader, rows []step, yield func(any) bool) error {
+	if len(rows) == 0 {
+		// A top-level array is a list of records by default
+		if b, err := peekNonSpace(r); err == nil && b == '[' {
+			rows = []step{{iterate: true}}
+		}
+	}
+	dec := json.NewDecoder(r)
+	dec.UseNumber()
+	if err := descend(dec, rows, yield); err != io.EOF {
+		return err
+	}
+	return nil
+}
+
+// peekNonSpace returns the first byte that is not whitespace or a BOM
+// without consuming it.
+func peekNonSpace(r *bufio.Reader) (byte, error) {
+	for i := 1; ; i++ {
+		head, err := r.Peek(i)
+		if len(head) < i {
+			return 0, err
+		}
+		switch c := head[i-1]; c {
+		case ' ', '\t', '\r', '\n', 0xEF, 0xBB, 0xBF:
+		default:
+			return c, nil
+		}
+	}
+}
+
+// descend follows steps through the token stream, decoding values only
+// once it reaches an iteration over scalars or the end of the path. It
+// consumes exactly one value, so it can be called for each element of an
+// enclosing iteration.
+func descend(dec *json.Decoder, steps []step, yield func(any) bool) error {
+	if len(steps) == 0 {
+		var v any
+		if err := dec.Decode(&v); err != nil {
+			return err
+		}
+		if !yield(v) {
+			return errStop
+		}
+		return nil
+	}
+
+	tok, err := dec.Token()
+	if err != nil {
+		return err
+	}
+	st := steps[0]
+	switch {
+	case st.iterate && (tok == json.Delim('[') || tok == json.Delim('{')):
+		isObject := tok == json.Delim('{')
+		for dec.More() {
+			if isObject {
+				if _, err := dec.Token(); err != nil {
+					return err
+				}
+			}
+			if !isScalarStep(steps[1:]) {
+				if err := descend(dec, steps[1:], yield); err != nil {
+					return err
+				}
+				continue
+			}
+			var v any
+			if err := dec.Decode(&v); err != nil {
+				return err
+			}
+			for _, r := range evalPath(v, steps[1:]) {
+				if !yield(r) {
+					return errStop
+				}
+			}
+		}
+	case st.isIndex && tok == json.Delim('['):
+		for i := 0; dec.More(); i++ {
+			var err error
+			if i == st.index {
+				err = descend(dec, steps[1:], yield)
+			} else {
+				err = skipValue(dec)
+			}
+			if err != nil {
+				return err
+			}
+		}
+	case !st.iterate && !st.isIndex && tok == json.Delim('{'):
+		for dec.More() {
+			key, err := dec.Token()
+			if err != nil {
+				return err
+			}
+			if key == st.key {
+				err = descend(dec, steps[1:], yield)
+			} else {
+				err = skipValue(dec)
+			}
+			if err != nil {
+				return err
+			}
+		}
+	case tok == json.Delim('[') || tok == json.Delim('{'):
+		// The path does not apply to this container; skip it
+		return skipRest(dec, 1)
+	default:
+		return nil // a scalar has nothing to descend into
+	}
+	_, err = dec.Token() // the closing delimiter
+	return err
+}
+
+// isScalarStep reports whether steps contain no further iteration, so an
+// element is small enough to decode whole and evaluate in memory.
+func isScalarStep(steps []step) bool {
+	for _, st := range steps {
+		if st.iterate {
+			return false
+		}
+	}
+	return true
+}
+
+// skipValue consumes the next value without decoding it.
+func skipValue(dec *json.Decoder) error {
+	return skipRest(dec, 0)
+}
+
+// skipRest consumes tokens until depth containers have been closed, or
+// one value if depth is 0.
+func skipRest(dec *json.Decoder, depth int) error {
+	for {
+		tok, err := dec.Token()
+		if err != nil {
+			return err
+		}
+		switch tok {
+		case json.Delim('{'), json.Delim('['):
+			depth++
+		case json.Delim('}'), json.Delim(']'):
+			depth--
+		}
+		if depth == 0 {
+			return nil
+		}
+	}
+}
+
+func scanJSONL(r *bufio.Reader, rows []step, yield func(any) bool) error {
+	dec := json.NewDecoder(r)
+	dec.UseNumber()
+	for n := 1; ; n++ {
+		var v any
+		if err := dec.Decode(&v); err != nil {
+			if err == io.EOF {
+				return nil
+			}
+			return fmt.Errorf("record %d: %v", n, err)
+		}
+		for _, rec := range evalPath(v, rows) {
+			if !yield(rec) {
+				return errStop
+			}
+		}
+	}
+}
+
+// scanCSV yields each row after the header as a map from column name to
+// field. Columns without a header are named by their 1-based position.
+func scanCSV(r *bufio.Reader, comma rune, yield func(any) bool) error {
+	cr := csv.NewReader(r)
+	cr.Comma = comma
+	cr.FieldsPerRecord = -1
+	cr.LazyQuotes = true
+	cr.ReuseRecord = true
+
+	header, err := cr.Read()
+	if err != nil {
+		if err == io.EOF {
+			return nil
+		}
+		return err
+	}
+	columns := make([]string, len(header))
+	for i, name := range header {
+		columns[i] = strings.TrimSpace(strings.TrimPrefix(name, "\uFEFF"))
+	}
+
+	for {
+		fields, err := cr.Read()
+		if err != nil {
+			if err == io.EOF {
+				return nil
+			}
+			return err
+		}
+		rec := make(map[string]any, len(fields))
+		for i, field := range fields {
+			name := fmt.Sprint(i + 1)
+			if i < len(columns) && columns[i] != "" {
+				name = columns[i]
+			}
+			rec[name] = field
+		}
+		if !yield(rec) {
+			return errStop
+		}
+	}
+}
@@ -0,0 +1,159 @@
+package exec
+
+import (
+	"context"
+	"io/fs"
+	"os"
+	"path/filepath"
+	"strings"
+
+	"adk-code/internal/compressed"
+)
+
+// compressedExts are the extensions considered when a search walks a
+// directory for compressed files. Each candidate is confirmed by its magic
+// bytes.
+var compressedExts = []string{".gz", ".zst", ".zstd"}
+
+// grepBatchFiles and grepBatchBytes bound the file names passed to one grep
+// run, well below the argument size limit.
+const (
+	grepBatchFiles = 512
+	grepBatchBytes = 64 * 1024
+)
+
+// defaultCompressedGrepResults caps matches from compressed files when
+// max_results is not given, since a rotated log can match on every line.
+const defaultCompressedGrepResults = 200
+
+func isCompressedExt(ext string) bool {
+	for _, e := range compressedExts {
+		if strings.EqualFold(ext, e) {
+			return true
+		}
+	}
+	return false
+}
+
+func matchesFilePattern(pattern, name, ext string) bool {
+	if pattern == "" {
+		return true
+	}
+	if ok, _ := filepath.Match(pattern, name); ok {
+		return true
+	}
+	ok, _ := filepath.Match(pattern, strings.TrimSuffix(name, ext))
+	return ok
+}
+
+// compressedGrepArgs builds the grep command line for searching a
+// decompressed file on stdin, labeled with its path.
+func compressedGrepArgs(input GrepSearchInput, label string) []string {
+	args := []string{"-n", "-H", "--label=" + label}
+	if input.CaseSensitive == nil || !*input.CaseSensitive {
+		args = append(args, "-i")
+	}
+	return append(args, input.Pattern, "-")
+}
+
+// grepPath searches path with a single directory walk. The walk hands
+// regular files to grep in batches as it finds them and collects compressed
+// files, which are then searched decompressed. FilePattern selects compressed
+// files by their name with and without the compression extension, so "*.log"
+// also selects "app.log.gz". Plain matches go to keepPlain and compressed ones
+// to keepCompressed; the search stops as soon as either returns false, and
+// stopped reports whether it did. Files that fail to decompress are skipped
+// when found by walking a directory.
+func grepPath(ctx context.Context, input GrepSearchInput, path string, keepPlain, keepCompressed func(GrepMatch) bool) (stopped bool, err error) {
+	plain := func(match GrepMatch) bool {
+		if !keepPlain(match) {
+			stopped = true
+			return false
+		}
+		return true
+	}
+
+	info, err := os.Stat(path)
+	if err != nil {
+		return false, err
+	}
+	if !info.IsDir() {
+		if format, _ := compressed.Sniff(path); format != compressed.None {
+			return grepCompressed(ctx, input, []string{path}, false, keepCompressed)
+		}
+		return stopped, streamGrep(ctx, grepArgs(input, path), nil, plain)
+	}
+
+	var batch, files []string
+	batchBytes := 0
+	flush := func() error {
+		err := streamGrep(ctx, grepArgs(input, batch...), nil, plain)
+		batch, batchBytes = batch[:0], 0
+		return err
+	}
+	// The trailing separator makes the walk follow a symlinked root, as grep -r does
+	err = filepath.WalkDir(path+string(filepath.Separator), func(p string, d fs.DirEntry, err error) error {
+		if ctx.Err() != nil {
+			return ctx.Err()
+		}
+		if err != nil || !d.Type().IsRegular() {
+			return nil
+		}
+		name := d.Name()
+		if ext := filepath.Ext(name); isCompressedExt(ext) && !strings.Contains(filepath.ToSlash(p), "/.git/") {
+			if format, _ := compressed.Sniff(p); format != compressed.None {
+				if matchesFilePattern(input.FilePattern, name, ext) {
+					files = append(files, p)
+				}
+				return nil
+			}
+		}
+		batch = append(batch, p)
+		batchBytes += len(p)
+		if len(batch) < grepBatchFiles && batchBytes < grepBatchBytes {
+			return nil
+		}
+		if err := flush(); err != nil {
+			return err
+		}
+		if stopped {
+			return fs.SkipAll
+		}
+		return nil
+	})
+	if err == nil && !stopped && len(batch) > 0 {
+		err = flush()
+	}
+	if err != nil || stopped {
+		return stopped, err
+	}
+	return grepCompressed(ctx, input, files, true, keepCompressed)
+}
+
+// grepCompressed searches the decompressed content of files, passing matches
+// to keep. Decompression stops as soon as keep returns false, and stopped
+// reports whether it did. Files that fail to open are skipped when
+// skipUnreadable is set.
+func grepCompressed(ctx context.Context, input GrepSearchInput, files []string, skipUnreadable bool, keep func(GrepMatch) bool) (stopped bool, err error) {
+	for _, file := range files {
+		r, err := compressed.Open(file)
+		if err != nil {
+			if !skipUnreadable {
+				return false, err
+			}
+			continue
+		}
+		err = streamGrep(ctx, compressedGrepArgs(input, file), r, func(match GrepMatch) bool {
+			if !keep(match) {
+				stopped = true
+				return false
+			}
+			return true
+		})
+		r.Close()
+		if err != nil || stopped {
+			return stopped, err
+		}
+	}
+	return false, nil
+}
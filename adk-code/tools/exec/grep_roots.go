@@ -0,0 +1,143 @@
+package exec
+
+import (
+	"bufio"
+	"context"
+	"fmt"
+	"io"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"strings"
+	"sync/atomic"
+
+	"adk-code/pkg/workspace"
+)
+
+// defaultWorkspaceGrepResults is the match limit for all_roots searches
+const defaultWorkspaceGrepResults = 200
+
+// grepArgs builds the grep command line for searching files. -H keeps the
+// file name when only one file is given.
+func grepArgs(input GrepSearchInput, files ...string) []string {
+	args := []string{"-n", "-H"}
+
+	caseSensitive := false
+	if input.CaseSensitive != nil {
+		caseSensitive = *input.CaseSensitive
+	}
+	if !caseSensitive {
+		args = append(args, "-i") // case insensitive
+	}
+	if input.FilePattern != "" {
+		args = append(args, "--include="+input.FilePattern)
+	}
+	return append(append(args, input.Pattern), files...)
+}
+
+// parseGrepLine parses a "filename:linenumber:content" line.
+func parseGrepLine(line string) (GrepMatch, bool) {
+	parts := strings.SplitN(line, ":", 3)
+	if len(parts) < 3 {
+		return GrepMatch{}, false
+	}
+	lineNum := 0
+	fmt.Sscanf(parts[1], "%d", &lineNum)
+	return GrepMatch{File: parts[0], Line: lineNum, Content: parts[2]}, true
+}
+
+// streamGrep runs grep, reading stdin if it is not nil, and passes each match
+// to keep as it is printed, killing grep as soon as keep returns false.
+func streamGrep(ctx context.Context, args []string, stdin io.Reader, keep func(GrepMatch) bool) error {
+	ctx, cancel := context.WithCancel(ctx)
+	defer cancel()
+
+	cmd := exec.CommandContext(ctx, "grep", args...)
+	cmd.Stdin = stdin
+	var stderr strings.Builder
+	cmd.Stderr = &stderr
+	stdout, err := cmd.StdoutPipe()
+	if err != nil {
+		return err
+	}
+	if err := cmd.Start(); err != nil {
+		return err
+	}
+
+	stopped := false
+	scanner := bufio.NewScanner(stdout)
+	scanner.Buffer(make([]byte, 64*1024), 1024*1024)
+	for scanner.Scan() {
+		match, ok := parseGrepLine(scanner.Text())
+		if ok && !keep(match) {
+			stopped = true
+			cancel()
+			break
+		}
+	}
+
+	err = cmd.Wait()
+	if stopped {
+		return nil
+	}
+	// grep returns exit code 1 if no matches found, which is not an error
+	if exitErr, ok := err.(*exec.ExitError); ok && exitErr.ExitCode() == 1 {
+		return nil
+	}
+	if err != nil {
+		return fmt.Errorf("%v - %s", err, stderr.String())
+	}
+	return nil
+}
+
+// grepAllRoots greps the path in every workspace root concurrently and keeps
+// up to the match limit, primary root first. Files are labeled with their
+// workspace hint. Roots without the path are skipped, and a root whose grep
+// fails is reported in RootErrors without discarding the other roots' matches.
+func grepAllRoots(ctx context.Context, ws *workspace.Manager, input GrepSearchInput) GrepSearchOutput {
+	maxResults := defaultWorkspaceGrepResults
+	if input.MaxResults != nil && *input.MaxResults > 0 {
+		maxResults = *input.MaxResults
+	}
+
+	var searched atomic.Int32
+	results, truncated := workspace.SearchRoots(ctx, ws, maxResults,
+		func(ctx context.Context, root workspace.WorkspaceRoot, budget *workspace.ResultBudget) ([]GrepMatch, error) {
+			path := filepath.Join(root.Path, input.Path)
+			if _, err := os.Stat(path); err != nil {
+				return nil, nil
+			}
+			searched.Add(1)
+
+			var matches []GrepMatch
+			keep := func(match GrepMatch) bool {
+				if !budget.Take() {
+					return false
+				}
+				match.File = workspace.HintedPath(root, match.File)
+				matches = append(matches, match)
+				return true
+			}
+			_, err := grepPath(ctx, input, path, keep, keep)
+			return matches, err
+		})
+
+	output := GrepSearchOutput{Matches: make([]GrepMatch, 0), Truncated: truncated, Success: true}
+	for _, r := range results {
+		if r.Err != nil {
+			output.RootErrors = append(output.RootErrors, fmt.Sprintf("%s: %v", r.Root.Name, r.Err))
+		}
+		output.Matches = append(output.Matches, r.Items...)
+	}
+	output.Count = len(output.Matches)
+
+	switch {
+	case searched.Load() == 0:
+		output.Success = false
+		output.Error = fmt.Sprintf("Path %s not found in any workspace root", input.Path)
+	case len(output.RootErrors) == int(searched.Load()):
+		output.Success = false
+		output.Error = "Grep failed in every workspace root"
+	}
+	return output
+}
@@ -6,24 +6,32 @@ import (
 	"context"
 	"fmt"
 	"os/exec"
+	"path/filepath"
 	"strings"
 	"time"
 
 	"google.golang.org/adk/tool"
 	"google.golang.org/adk/tool/functiontool"
 
+	"adk-code/internal/tracking"
 	"adk-code/pkg/errors"
+	"adk-code/pkg/workspace"
 	common "adk-code/tools/base"
 )
 
+const (
+	executeCommandToolName = "builtin_execute_command"
+	executeProgramToolName = "execute_program"
+)
+
 // ExecuteCommandInput defines the input parameters for executing a command.
 type ExecuteCommandInput struct {
 	// Command is the command to execute.
 	Command string `json:"command" jsonschema:"Command to execute (e.g., 'ls -la', 'go test ./...')"`
 	// WorkingDir is the working directory for the command (optional, defaults to current directory).
 	WorkingDir string `json:"working_dir,omitempty" jsonschema:"Working directory for the command (optional)"`
-	// Timeout is the maximum time in seconds to wait for the command (default: 30).
-	Timeout *int `json:"timeout,omitempty" jsonschema:"Maximum time in seconds to wait for the command (default: 30)"`
+	// Timeout is the maximum time in seconds to wait for the command (default: adaptive).
+	Timeout *int `json:"timeout,omitempty" jsonschema:"Maximum time in seconds to wait for the command (default: learned from past runs of the same command, 30 for new commands)"`
 }
 
 // ExecuteCommandOutput defines the output of executing a command.
@@ -43,15 +51,6 @@ type ExecuteCommandOutput struct {
 // NewExecuteCommandTool creates a tool for executing shell commands.
 func NewExecuteCommandTool() (tool.Tool, error) {
 	handler := func(ctx tool.Context, input ExecuteCommandInput) ExecuteCommandOutput {
-		timeoutSecs := 30 // default
-		if input.Timeout != nil {
-			timeoutSecs = *input.Timeout
-		}
-		timeout := time.Duration(timeoutSecs) * time.Second
-
-		cmdCtx, cancel := context.WithTimeout(ctx, timeout)
-		defer cancel()
-
 		// Parse command into parts
 		parts := strings.Fields(input.Command)
 		if len(parts) == 0 {
@@ -61,6 +60,12 @@ func NewExecuteCommandTool() (tool.Tool, error) {
 			}
 		}
 
+		prefix := tracking.CommandPrefix(parts[0], parts[1:])
+		timeout := commandTimeout(executeCommandToolName, prefix, input.Timeout)
+
+		cmdCtx, cancel := context.WithTimeout(ctx, timeout)
+		defer cancel()
+
 		cmd := exec.CommandContext(cmdCtx, parts[0], parts[1:]...)
 		if input.WorkingDir != "" {
 			cmd.Dir = input.WorkingDir
@@ -70,7 +75,12 @@ func NewExecuteCommandTool() (tool.Tool, error) {
 		cmd.Stdout = &stdout
 		cmd.Stderr = &stderr
 
+		start := time.Now()
 		err := cmd.Run()
+		timedOut := cmdCtx.Err() == context.DeadlineExceeded
+		tracking.DefaultTimeoutPolicy().Record(executeCommandToolName, prefix, time.Since(start), timedOut)
+		// The command may have changed any file
+		common.NotifyFileWrite("")
 
 		exitCode := 0
 		if err != nil {
@@ -84,16 +94,20 @@ func NewExecuteCommandTool() (tool.Tool, error) {
 			}
 		}
 
-		return ExecuteCommandOutput{
+		output := ExecuteCommandOutput{
 			Stdout:   stdout.String(),
 			Stderr:   stderr.String(),
 			ExitCode: exitCode,
 			Success:  exitCode == 0,
 		}
+		if timedOut {
+			output.Error = fmt.Sprintf("Command timed out after %s; pass a larger timeout if it needs more time", timeout)
+		}
+		return output
 	}
 
 	t, err := functiontool.New(functiontool.Config{
-		Name:        "builtin_execute_command",
+		Name:        executeCommandToolName,
 		Description: "Executes a shell command and returns its output. Use this to run tests, build code, install dependencies, or run any command-line tools. The command runs in a shell environment with a timeout.",
 	}, handler)
 
@@ -119,6 +133,11 @@ type GrepSearchInput struct {
 	CaseSensitive *bool `json:"case_sensitive,omitempty" jsonschema:"Whether the search should be case-sensitive (default: false)"`
 	// FilePattern is an optional file pattern to limit the search (e.g., '*.go').
 	FilePattern string `json:"file_pattern,omitempty" jsonschema:"Optional file pattern to limit the search (e.g., '*.go')"`
+	// AllRoots searches Path relative to every workspace root.
+	AllRoots bool `json:"all_roots,omitempty" jsonschema:"Search path (relative, default '.') in every workspace root concurrently; files are labeled @workspace:path"`
+	// MaxResults limits matches across all roots in a workspace-wide search,
+	// and matches from compressed files in any search.
+	MaxResults *int `json:"max_results,omitempty" jsonschema:"Maximum matches across all workspace roots when all_roots is set, and from gzip/zstd files in any search (default: 200)"`
 }
 
 // GrepMatch represents a single match in a file.
@@ -137,6 +156,12 @@ type GrepSearchOutput struct {
 	Matches []GrepMatch `json:"matches"`
 	// Count is the total number of matches found.
 	Count int `json:"count"`
+	// Truncated indicates the result limit was reached in a workspace-wide
+	// search or while searching compressed files.
+	Truncated bool `json:"truncated,omitempty"`
+	// RootErrors lists the workspace roots whose search failed in a
+	// workspace-wide search, as "workspace: error".
+	RootErrors []string `json:"root_errors,omitempty"`
 	// Success indicates whether the operation was successful.
 	Success bool `json:"success"`
 	// Error contains error message if the operation failed.
@@ -151,8 +176,8 @@ type ExecuteProgramInput struct {
 	Args []string `json:"args" jsonschema:"Array of arguments (no shell quoting needed, e.g., ['5 + 3'], ['-o', 'output', 'input.c'])"`
 	// WorkingDir is the working directory (optional)
 	WorkingDir string `json:"working_dir,omitempty" jsonschema:"Working directory for the program (optional)"`
-	// Timeout is the maximum time in seconds (default: 30)
-	Timeout *int `json:"timeout,omitempty" jsonschema:"Maximum time in seconds to wait (default: 30)"`
+	// Timeout is the maximum time in seconds (default: adaptive)
+	Timeout *int `json:"timeout,omitempty" jsonschema:"Maximum time in seconds to wait (default: learned from past runs of the same program, 30 for new programs)"`
 }
 
 // ExecuteProgramOutput defines output of program execution
@@ -174,11 +199,8 @@ func NewExecuteProgramTool() (tool.Tool, error) {
 			}
 		}
 
-		timeoutSecs := 30
-		if input.Timeout != nil {
-			timeoutSecs = *input.Timeout
-		}
-		timeout := time.Duration(timeoutSecs) * time.Second
+		prefix := tracking.CommandPrefix(input.Program, input.Args)
+		timeout := commandTimeout(executeProgramToolName, prefix, input.Timeout)
 
 		cmdCtx, cancel := context.WithTimeout(ctx, timeout)
 		defer cancel()
@@ -193,7 +215,12 @@ func NewExecuteProgramTool() (tool.Tool, error) {
 		cmd.Stdout = &stdout
 		cmd.Stderr = &stderr
 
+		start := time.Now()
 		err := cmd.Run()
+		timedOut := cmdCtx.Err() == context.DeadlineExceeded
+		tracking.DefaultTimeoutPolicy().Record(executeProgramToolName, prefix, time.Since(start), timedOut)
+		// The command may have changed any file
+		common.NotifyFileWrite("")
 
 		exitCode := 0
 		if err != nil {
@@ -207,16 +234,20 @@ func NewExecuteProgramTool() (tool.Tool, error) {
 			}
 		}
 
-		return ExecuteProgramOutput{
+		output := ExecuteProgramOutput{
 			Stdout:   stdout.String(),
 			Stderr:   stderr.String(),
 			ExitCode: exitCode,
 			Success:  exitCode == 0,
 		}
+		if timedOut {
+			output.Error = fmt.Sprintf("Program timed out after %s; pass a larger timeout if it needs more time", timeout)
+		}
+		return output
 	}
 
 	t, err := functiontool.New(functiontool.Config{
-		Name: "execute_program",
+		Name: executeProgramToolName,
 		Description: `Execute a program with structured arguments (no shell quoting issues). 
 Use this tool when running programs that take arguments, especially arguments with spaces or special characters.
 
@@ -247,77 +278,52 @@ Examples:
 // NewGrepSearchTool creates a tool for searching text in files (similar to grep).
 func NewGrepSearchTool() (tool.Tool, error) {
 	handler := func(ctx tool.Context, input GrepSearchInput) GrepSearchOutput {
-		// Build grep command
-		args := []string{"-n", "-r"} // line numbers, recursive
-
-		caseSensitive := false
-		if input.CaseSensitive != nil {
-			caseSensitive = *input.CaseSensitive
-		}
-		if !caseSensitive {
-			args = append(args, "-i") // case insensitive
-		}
-		if input.FilePattern != "" {
-			args = append(args, "--include="+input.FilePattern)
+		// An absolute path names a single location, not one per root
+		if input.AllRoots && !filepath.IsAbs(input.Path) {
+			if ws := workspace.Active(); ws != nil {
+				return grepAllRoots(ctx, ws, input)
+			}
 		}
-		args = append(args, input.Pattern, input.Path)
-
-		cmd := exec.CommandContext(ctx, "grep", args...)
-		var stdout, stderr bytes.Buffer
-		cmd.Stdout = &stdout
-		cmd.Stderr = &stderr
 
-		err := cmd.Run()
-		// grep returns exit code 1 if no matches found, which is not an error
-		if err != nil {
-			if exitErr, ok := err.(*exec.ExitError); ok && exitErr.ExitCode() == 1 {
-				// No matches found, which is fine
-				return GrepSearchOutput{
-					Matches: []GrepMatch{},
-					Count:   0,
-					Success: true,
-				}
+		// Plain files are searched in full, gzip and zstd files decompressed
+		// up to the match limit
+		limit := defaultCompressedGrepResults
+		if input.MaxResults != nil && *input.MaxResults > 0 {
+			limit = *input.MaxResults
+		}
+		matches := make([]GrepMatch, 0)
+		found := 0
+		truncated, err := grepPath(ctx, input, input.Path, func(match GrepMatch) bool {
+			matches = append(matches, match)
+			return true
+		}, func(match GrepMatch) bool {
+			if found == limit {
+				return false
 			}
+			found++
+			matches = append(matches, match)
+			return true
+		})
+		if err != nil {
 			return GrepSearchOutput{
 				Matches: make([]GrepMatch, 0),
 				Count:   0,
 				Success: false,
-				Error:   fmt.Sprintf("Grep failed: %v - %s", err, stderr.String()),
-			}
-		}
-
-		// Parse grep output
-		lines := strings.Split(strings.TrimSpace(stdout.String()), "\n")
-		matches := make([]GrepMatch, 0, len(lines))
-
-		for _, line := range lines {
-			if line == "" {
-				continue
-			}
-
-			// Parse format: filename:linenumber:content
-			parts := strings.SplitN(line, ":", 3)
-			if len(parts) >= 3 {
-				lineNum := 0
-				fmt.Sscanf(parts[1], "%d", &lineNum)
-				matches = append(matches, GrepMatch{
-					File:    parts[0],
-					Line:    lineNum,
-					Content: parts[2],
-				})
+				Error:   fmt.Sprintf("Grep failed: %v", err),
 			}
 		}
 
 		return GrepSearchOutput{
-			Matches: matches,
-			Count:   len(matches),
-			Success: true,
+			Matches:   matches,
+			Count:     len(matches),
+			Truncated: truncated,
+			Success:   true,
 		}
 	}
 
 	t, err := functiontool.New(functiontool.Config{
 		Name:        "builtin_grep_search",
-		Description: "Searches for text patterns in files (like grep). Returns matching lines with file paths and line numbers. Useful for finding specific code patterns, function definitions, or error messages.",
+		Description: "Searches for text patterns in files (like grep). Returns matching lines with file paths and line numbers. Useful for finding specific code patterns, function definitions, or error messages. gzip (.gz) and zstd (.zst) files such as rotated logs are searched decompressed, stopping at max_results. Set all_roots to search every workspace root at once.",
 	}, handler)
 
 	if err == nil {
@@ -0,0 +1,23 @@
+package exec
+
+import (
+	"time"
+
+	"adk-code/internal/tracking"
+)
+
+const (
+	// defaultCommandTimeout applies until a command prefix has a latency history
+	defaultCommandTimeout = 30 * time.Second
+	// maxAdaptiveCommandTimeout caps timeouts learned from past runs
+	maxAdaptiveCommandTimeout = 10 * time.Minute
+)
+
+// commandTimeout returns the timeout the caller asked for or, when none was
+// given, the adaptive timeout for the command prefix.
+func commandTimeout(tool, prefix string, requestedSecs *int) time.Duration {
+	if requestedSecs != nil {
+		return time.Duration(*requestedSecs) * time.Second
+	}
+	return tracking.DefaultTimeoutPolicy().Timeout(tool, prefix, defaultCommandTimeout, maxAdaptiveCommandTimeout)
+}
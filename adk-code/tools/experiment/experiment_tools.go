@@ -0,0 +1,363 @@
+// Package experiment provides tools for trying changes in disposable copies
+// of the workspace.
+package experiment
+
+import (
+	"fmt"
+	"path/filepath"
+	"strings"
+
+	"google.golang.org/adk/tool"
+	"google.golang.org/adk/tool/functiontool"
+
+	"adk-code/internal/clone"
+	common "adk-code/tools/base"
+)
+
+const (
+	// maxStartClones bounds the clones one start call creates
+	maxStartClones = 4
+	// defaultDiffLines bounds the diff lines returned for a clone
+	defaultDiffLines = 300
+)
+
+// findClone returns the clone in use with the given ID.
+func findClone(id string) (*clone.Pool, *clone.Clone, error) {
+	for _, p := range clone.SharedPools() {
+		if c, ok := p.Get(id); ok {
+			return p, c, nil
+		}
+	}
+	return nil, nil, fmt.Errorf("no experiment clone %q; it may have been applied or discarded already", id)
+}
+
+// ExperimentClone is one clone handed out by builtin_experiment_start.
+type ExperimentClone struct {
+	// ID names the clone in the other experiment tools.
+	ID string `json:"id"`
+	// Path is the clone's root directory.
+	Path string `json:"path"`
+}
+
+// StartExperimentInput defines the input parameters for creating clones.
+type StartExperimentInput struct {
+	// Path is the workspace to clone.
+	Path string `json:"path,omitempty" jsonschema:"Workspace directory to clone (default: current directory)"`
+	// Count is the number of clones to create.
+	Count int `json:"count,omitempty" jsonschema:"Number of clones to create, one per approach to try (1-4, default: 1)"`
+}
+
+// StartExperimentOutput defines the output of creating clones.
+type StartExperimentOutput struct {
+	// Root is the workspace the clones copy.
+	Root string `json:"root"`
+	// Strategy is how the clones were made: reflink, worktree or copy.
+	Strategy string `json:"strategy"`
+	// Clones are the new clones.
+	Clones []ExperimentClone `json:"clones"`
+	// Success indicates whether the operation was successful.
+	Success bool `json:"success"`
+	// Error contains error message if the operation failed.
+	Error string `json:"error,omitempty"`
+}
+
+// NewStartExperimentTool creates a tool that hands out disposable clones of
+// the workspace.
+func NewStartExperimentTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input StartExperimentInput) StartExperimentOutput {
+		count := input.Count
+		if count <= 0 {
+			count = 1
+		}
+		if count > maxStartClones {
+			return StartExperimentOutput{Success: false, Error: fmt.Sprintf("count must be at most %d", maxStartClones)}
+		}
+		pool, err := clone.SharedPool(input.Path)
+		if err != nil {
+			return StartExperimentOutput{Success: false, Error: fmt.Sprintf("Cannot clone %s: %v", input.Path, err)}
+		}
+
+		output := StartExperimentOutput{Root: pool.Root(), Strategy: string(pool.Strategy()), Clones: make([]ExperimentClone, 0, count)}
+		for i := 0; i < count; i++ {
+			c, err := pool.Acquire()
+			if err != nil {
+				for _, made := range output.Clones {
+					if c, ok := pool.Get(made.ID); ok {
+						pool.Release(c)
+					}
+				}
+				return StartExperimentOutput{Success: false, Error: err.Error()}
+			}
+			output.Clones = append(output.Clones, ExperimentClone{ID: c.ID, Path: c.Path})
+		}
+		output.Success = true
+		return output
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name: "builtin_experiment_start",
+		Description: `Creates disposable copies ("clones") of the workspace for trying competing fixes side by side, each with its own edits and test runs, without touching the real tree. Clones share unchanged file data where the filesystem allows (copy-on-write), so they are cheap even for large trees; dependency directories such as node_modules are linked.
+
+**Workflow:**
+1. builtin_experiment_start(count=2) returns a path per clone
+2. Edit files under each clone's path, and run builds and tests with working_dir set to it
+3. builtin_experiment_diff(id) to review what a clone changed
+4. builtin_experiment_apply(id, discard_others=true) to copy the winner's changes back
+5. builtin_experiment_discard(id) for clones that are not applied`,
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategoryWorkspace,
+			Priority:  3,
+			UsageHint: "Try competing fixes in parallel in disposable workspace clones",
+		})
+	}
+
+	return t, err
+}
+
+// ExperimentChange is one file a clone changed.
+type ExperimentChange struct {
+	// Path is relative to the workspace root.
+	Path string `json:"path"`
+	// Kind is added, modified or deleted.
+	Kind string `json:"kind"`
+	// Diff is a unified diff from the workspace file to the clone's.
+	Diff string `json:"diff,omitempty"`
+}
+
+// ExperimentDiffInput defines the input parameters for reviewing a clone.
+type ExperimentDiffInput struct {
+	// ID names the clone.
+	ID string `json:"id" jsonschema:"Clone ID from builtin_experiment_start"`
+	// IncludeDiff adds each file's diff.
+	IncludeDiff *bool `json:"include_diff,omitempty" jsonschema:"Include a unified diff for each changed file (default: true)"`
+	// MaxLines bounds the diff lines returned.
+	MaxLines *int `json:"max_lines,omitempty" jsonschema:"Maximum diff lines across all files (default: 300)"`
+}
+
+// ExperimentDiffOutput defines the output of reviewing a clone.
+type ExperimentDiffOutput struct {
+	// ID names the clone.
+	ID string `json:"id"`
+	// Files are the changed files sorted by path.
+	Files []ExperimentChange `json:"files"`
+	// Count is the number of changed files.
+	Count int `json:"count"`
+	// Truncated reports whether max_lines cut the diffs short.
+	Truncated bool `json:"truncated,omitempty"`
+	// Success indicates whether the operation was successful.
+	Success bool `json:"success"`
+	// Error contains error message if the operation failed.
+	Error string `json:"error,omitempty"`
+}
+
+// NewExperimentDiffTool creates a tool that lists a clone's changes.
+func NewExperimentDiffTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input ExperimentDiffInput) ExperimentDiffOutput {
+		_, c, err := findClone(input.ID)
+		if err != nil {
+			return ExperimentDiffOutput{ID: input.ID, Files: make([]ExperimentChange, 0), Success: false, Error: err.Error()}
+		}
+		changes, err := c.Changes()
+		if err != nil {
+			return ExperimentDiffOutput{ID: input.ID, Files: make([]ExperimentChange, 0), Success: false, Error: err.Error()}
+		}
+		budget := defaultDiffLines
+		if input.MaxLines != nil && *input.MaxLines > 0 {
+			budget = *input.MaxLines
+		}
+		includeDiff := input.IncludeDiff == nil || *input.IncludeDiff
+
+		output := ExperimentDiffOutput{ID: input.ID, Files: make([]ExperimentChange, 0, len(changes)), Count: len(changes), Success: true}
+		for _, ch := range changes {
+			file := ExperimentChange{Path: ch.Path, Kind: string(ch.Kind)}
+			if includeDiff && budget > 0 {
+				diff, err := c.Diff(ch)
+				if err != nil {
+					diff = fmt.Sprintf("(no diff: %v)\n", err)
+				}
+				lines := strings.SplitAfter(diff, "\n")
+				if len(lines) > budget {
+					lines = append(lines[:budget], fmt.Sprintf("... %d more lines\n", len(lines)-budget))
+					output.Truncated = true
+				}
+				budget -= len(lines)
+				file.Diff = strings.Join(lines, "")
+			} else if includeDiff {
+				output.Truncated = true
+			}
+			output.Files = append(output.Files, file)
+		}
+		return output
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name:        "builtin_experiment_diff",
+		Description: `Lists the files an experiment clone added, modified or deleted compared with the workspace, with unified diffs. Files that .gitignore excludes, such as build output, are not listed.`,
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategoryWorkspace,
+			Priority:  4,
+			UsageHint: "Review the changes made in an experiment clone",
+		})
+	}
+
+	return t, err
+}
+
+// ApplyExperimentInput defines the input parameters for applying a clone.
+type ApplyExperimentInput struct {
+	// ID names the clone.
+	ID string `json:"id" jsonschema:"Clone ID from builtin_experiment_start"`
+	// Paths limits the files applied.
+	Paths []string `json:"paths,omitempty" jsonschema:"Changed files to apply, relative to the workspace root (default: all)"`
+	// Force applies changes even where the workspace file changed meanwhile.
+	Force bool `json:"force,omitempty" jsonschema:"Overwrite workspace files that changed since the clone was made (default: false)"`
+	// DiscardOthers discards every other clone once this one is applied.
+	DiscardOthers bool `json:"discard_others,omitempty" jsonschema:"Discard all other clones of the workspace after applying (default: false)"`
+}
+
+// ApplyExperimentOutput defines the output of applying a clone.
+type ApplyExperimentOutput struct {
+	// Applied are the files written to or deleted from the workspace.
+	Applied []string `json:"applied"`
+	// Conflicts are the files that changed in the workspace since the clone
+	// was made.
+	Conflicts []string `json:"conflicts,omitempty"`
+	// Discarded are the clones released.
+	Discarded []string `json:"discarded,omitempty"`
+	// Success indicates whether the operation was successful.
+	Success bool `json:"success"`
+	// Error contains error message if the operation failed.
+	Error string `json:"error,omitempty"`
+}
+
+// NewApplyExperimentTool creates a tool that copies a clone's changes back
+// into the workspace.
+func NewApplyExperimentTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input ApplyExperimentInput) ApplyExperimentOutput {
+		pool, c, err := findClone(input.ID)
+		if err != nil {
+			return ApplyExperimentOutput{Applied: make([]string, 0), Success: false, Error: err.Error()}
+		}
+		applied, conflicts, err := c.Apply(input.Paths, input.Force)
+		for _, path := range applied {
+			common.NotifyFileWrite(filepath.Join(pool.Root(), filepath.FromSlash(path)))
+		}
+		output := ApplyExperimentOutput{Applied: applied, Conflicts: conflicts}
+		if output.Applied == nil {
+			output.Applied = make([]string, 0)
+		}
+		switch {
+		case err != nil:
+			output.Error = fmt.Sprintf("Apply stopped after %d files: %v", len(applied), err)
+			return output
+		case len(conflicts) > 0 && !input.Force:
+			output.Error = fmt.Sprintf("Nothing applied: %d files changed in the workspace since the clone was made. Review them, then apply other paths or set force=true.", len(conflicts))
+			return output
+		}
+
+		if len(input.Paths) == 0 {
+			pool.Release(c)
+			output.Discarded = append(output.Discarded, c.ID)
+		}
+		if input.DiscardOthers {
+			for _, other := range pool.Active() {
+				if other != c {
+					pool.Release(other)
+					output.Discarded = append(output.Discarded, other.ID)
+				}
+			}
+		}
+		output.Success = true
+		return output
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name: "builtin_experiment_apply",
+		Description: `Copies an experiment clone's changes (added, modified and deleted files) into the workspace. Each file is replaced atomically. If a workspace file changed since the clone was made, nothing is applied and the conflicting files are listed, unless force=true.
+
+Applying all changes releases the clone; with discard_others=true the other clones of the workspace are released too.`,
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategoryWorkspace,
+			Priority:  5,
+			UsageHint: "Apply the winning experiment clone to the workspace",
+		})
+	}
+
+	return t, err
+}
+
+// DiscardExperimentInput defines the input parameters for discarding clones.
+type DiscardExperimentInput struct {
+	// ID names the clone, or "all".
+	ID string `json:"id" jsonschema:"Clone ID from builtin_experiment_start, or 'all' for every clone"`
+}
+
+// DiscardExperimentOutput defines the output of discarding clones.
+type DiscardExperimentOutput struct {
+	// Discarded are the clones released.
+	Discarded []string `json:"discarded"`
+	// Success indicates whether the operation was successful.
+	Success bool `json:"success"`
+	// Error contains error message if the operation failed.
+	Error string `json:"error,omitempty"`
+}
+
+// NewDiscardExperimentTool creates a tool that releases clones without
+// applying them.
+func NewDiscardExperimentTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input DiscardExperimentInput) DiscardExperimentOutput {
+		output := DiscardExperimentOutput{Discarded: make([]string, 0), Success: true}
+		if input.ID == "all" {
+			for _, p := range clone.SharedPools() {
+				for _, c := range p.Active() {
+					p.Release(c)
+					output.Discarded = append(output.Discarded, c.ID)
+				}
+			}
+			return output
+		}
+		pool, c, err := findClone(input.ID)
+		if err != nil {
+			return DiscardExperimentOutput{Discarded: output.Discarded, Success: false, Error: err.Error()}
+		}
+		pool.Release(c)
+		output.Discarded = append(output.Discarded, c.ID)
+		return output
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name:        "builtin_experiment_discard",
+		Description: `Discards an experiment clone, or all of them with id="all", leaving the workspace untouched. Released clones are recycled for later experiments and deleted after a while.`,
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategoryWorkspace,
+			Priority:  6,
+			UsageHint: "Discard experiment clones that are not applied",
+		})
+	}
+
+	return t, err
+}
+
+// init registers the experiment tools automatically at package initialization.
+func init() {
+	_, _ = NewStartExperimentTool()
+	_, _ = NewExperimentDiffTool()
+	_, _ = NewApplyExperimentTool()
+	_, _ = NewDiscardExperimentTool()
+}
@@ -5,6 +5,8 @@ import (
 	"fmt"
 	"os"
 	"path/filepath"
+
+	common "adk-code/tools/base"
 )
 
 // AtomicWrite performs a safe, atomic file write operation.
@@ -55,5 +57,6 @@ func AtomicWrite(path string, content []byte, perm os.FileMode) error {
 		return fmt.Errorf("failed to rename: %w", err)
 	}
 
+	common.NotifyFileWrite(path)
 	return nil
 }
@@ -0,0 +1,437 @@
+// Package file provides file operation tools for the coding agent.
+package file
+
+import (
+	"archive/tar"
+	"archive/zip"
+	"bytes"
+	"debug/elf"
+	"debug/macho"
+	"debug/pe"
+	"encoding/binary"
+	"encoding/hex"
+	"fmt"
+	"image"
+	"image/color"
+	_ "image/gif"  // register GIF for image.DecodeConfig
+	_ "image/jpeg" // register JPEG for image.DecodeConfig
+	_ "image/png"  // register PNG for image.DecodeConfig
+	"io"
+	"net/http"
+	"os"
+	"strings"
+	"unicode/utf8"
+)
+
+const (
+	// binarySniffBytes is how much of a file is read to decide whether it
+	// is text
+	binarySniffBytes = 8192
+	// maxBinaryDetails bounds the lines of a summary (archive entries,
+	// tables, libraries)
+	maxBinaryDetails = 50
+	// defaultHexdumpBytes and maxHexdumpBytes bound a hexdump range
+	defaultHexdumpBytes = 512
+	maxHexdumpBytes     = 64 * 1024
+)
+
+// BinaryInfo summarizes a file that is not text, in place of its content.
+type BinaryInfo struct {
+	// MIMEType is the sniffed media type.
+	MIMEType string `json:"mime_type"`
+	// Kind describes the format, e.g. "ELF executable" or "PNG image".
+	Kind string `json:"kind"`
+	// Size is the file size in bytes.
+	Size int64 `json:"size"`
+	// Details is a format-specific digest: header fields, image dimensions,
+	// archive entries or database tables.
+	Details []string `json:"details,omitempty"`
+}
+
+// binaryFormat is a recognized binary file format.
+type binaryFormat struct {
+	kind    string
+	mime    string
+	match   func(head []byte) bool
+	details func(f *os.File, size int64) ([]string, error)
+}
+
+func hasPrefix(prefix string) func([]byte) bool {
+	return func(head []byte) bool { return bytes.HasPrefix(head, []byte(prefix)) }
+}
+
+// binaryPrefix matches a magic too short to tell a binary file from text
+// that happens to start with it.
+func binaryPrefix(prefix string) func([]byte) bool {
+	return func(head []byte) bool { return bytes.HasPrefix(head, []byte(prefix)) && looksBinary(head) }
+}
+
+// binaryFormats are matched in order against a file's first bytes.
+var binaryFormats = []binaryFormat{
+	{kind: "ELF executable", mime: "application/x-executable", match: hasPrefix("\x7fELF"), details: elfDetails},
+	{kind: "PE executable", mime: "application/vnd.microsoft.portable-executable", match: binaryPrefix("MZ"), details: peDetails},
+	{kind: "Mach-O executable", mime: "application/x-mach-binary", match: isMachO, details: machoDetails},
+	{kind: "Java class", mime: "application/java-vm", match: hasPrefix("\xca\xfe\xba\xbe"), details: classDetails},
+	{kind: "PNG image", mime: "image/png", match: hasPrefix("\x89PNG\r\n\x1a\n"), details: imageDetails},
+	{kind: "JPEG image", mime: "image/jpeg", match: hasPrefix("\xff\xd8\xff"), details: imageDetails},
+	{kind: "GIF image", mime: "image/gif", match: hasPrefix("GIF8"), details: imageDetails},
+	{kind: "BMP image", mime: "image/bmp", match: binaryPrefix("BM"), details: bmpDetails},
+	{kind: "WebP image", mime: "image/webp", match: func(h []byte) bool { return len(h) >= 12 && string(h[:4]) == "RIFF" && string(h[8:12]) == "WEBP" }},
+	{kind: "PDF document", mime: "application/pdf", match: hasPrefix("%PDF-"), details: pdfDetails},
+	{kind: "SQLite database", mime: "application/vnd.sqlite3", match: hasPrefix(sqliteMagic), details: sqliteDetails},
+	{kind: "zip archive", mime: "application/zip", match: hasPrefix("PK\x03\x04"), details: zipDetails},
+	{kind: "tar archive", mime: "application/x-tar", match: func(h []byte) bool { return len(h) >= 262 && string(h[257:262]) == "ustar" }, details: tarDetails},
+	{kind: "WebAssembly module", mime: "application/wasm", match: hasPrefix("\x00asm")},
+}
+
+// isMachO matches thin Mach-O files of either byte order and fat binaries,
+// which share their magic with Java classes but have few architectures.
+func isMachO(head []byte) bool {
+	if len(head) < 8 {
+		return false
+	}
+	switch binary.BigEndian.Uint32(head) {
+	case 0xfeedface, 0xfeedfacf, 0xcefaedfe, 0xcffaedfe:
+		return true
+	case 0xcafebabe:
+		return binary.BigEndian.Uint32(head[4:]) < 45 // Java's major version is 45+
+	}
+	return false
+}
+
+// readHead returns the first binarySniffBytes of the file at path.
+func readHead(path string) ([]byte, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+	head := make([]byte, binarySniffBytes)
+	n, err := io.ReadFull(f, head)
+	if err != nil && err != io.ErrUnexpectedEOF && err != io.EOF {
+		return nil, err
+	}
+	return head[:n], nil
+}
+
+// sniffBinary returns the format head belongs to, a generic format if it is
+// unrecognized binary data, or nil if it looks like text.
+func sniffBinary(head []byte) *binaryFormat {
+	for i := range binaryFormats {
+		if binaryFormats[i].match(head) {
+			return &binaryFormats[i]
+		}
+	}
+	if !looksBinary(head) {
+		return nil
+	}
+	return &binaryFormat{kind: "binary data", mime: http.DetectContentType(head)}
+}
+
+// looksBinary reports whether head is not text: it contains a NUL byte, or
+// more than a tenth of it is control characters or invalid UTF-8.
+func looksBinary(head []byte) bool {
+	if bytes.IndexByte(head, 0) >= 0 {
+		return true
+	}
+	bad := 0
+	for i := 0; i < len(head); {
+		r, size := utf8.DecodeRune(head[i:])
+		switch {
+		case r == utf8.RuneError && size == 1:
+			if len(head)-i < utf8.UTFMax && !utf8.FullRune(head[i:]) {
+				i = len(head) // a rune cut by the sniff window
+				continue
+			}
+			bad++
+		case r < 0x20 && r != '\t' && r != '\n' && r != '\r' && r != '\f' && r != '\b' && r != 0x1b:
+			bad++
+		}
+		i += size
+	}
+	return bad*10 > len(head)
+}
+
+// describeBinary summarizes the file at path in the given format. A digest
+// that fails to parse is reported as a detail rather than an error.
+func describeBinary(path string, format *binaryFormat, head []byte, size int64) *BinaryInfo {
+	info := &BinaryInfo{MIMEType: format.mime, Kind: format.kind, Size: size}
+	if format.details == nil {
+		n := 64
+		if len(head) < n {
+			n = len(head)
+		}
+		info.Details = []string{"first bytes: " + hex.EncodeToString(head[:n])}
+		return info
+	}
+	f, err := os.Open(path)
+	if err != nil {
+		info.Details = []string{fmt.Sprintf("cannot open: %v", err)}
+		return info
+	}
+	defer f.Close()
+	details, err := format.details(f, size)
+	if err != nil {
+		details = append(details, fmt.Sprintf("cannot parse %s: %v", format.kind, err))
+	}
+	info.Details = details
+	return info
+}
+
+// summary renders info as the content returned in place of the file's.
+func (info *BinaryInfo) summary() string {
+	var b strings.Builder
+	fmt.Fprintf(&b, "[binary file: %s, %s, %d bytes; content not shown, use hexdump=true to read bytes]", info.Kind, info.MIMEType, info.Size)
+	for _, d := range info.Details {
+		b.WriteString("\n")
+		b.WriteString(d)
+	}
+	return b.String()
+}
+
+func libraryDetails(details []string, libs []string) []string {
+	if len(libs) == 0 {
+		return details
+	}
+	shown := libs
+	if len(shown) > maxBinaryDetails {
+		shown = shown[:maxBinaryDetails]
+	}
+	return append(details, fmt.Sprintf("libraries (%d): %s", len(libs), strings.Join(shown, ", ")))
+}
+
+func elfDetails(f *os.File, _ int64) ([]string, error) {
+	ef, err := elf.NewFile(f)
+	if err != nil {
+		return nil, err
+	}
+	details := []string{
+		fmt.Sprintf("class: %s, %s, machine: %s, type: %s, os/abi: %s", ef.Class, ef.Data, ef.Machine, ef.Type, ef.OSABI),
+		fmt.Sprintf("entry: %#x, sections: %d, program headers: %d", ef.Entry, len(ef.Sections), len(ef.Progs)),
+	}
+	for _, p := range ef.Progs {
+		if p.Type == elf.PT_INTERP {
+			interp := make([]byte, p.Filesz)
+			if _, err := p.ReadAt(interp, 0); err == nil {
+				details = append(details, "interpreter: "+strings.TrimRight(string(interp), "\x00"))
+			}
+		}
+	}
+	if ef.Section(".go.buildinfo") != nil {
+		details = append(details, "Go binary")
+	}
+	if ef.Section(".debug_info") != nil || ef.Section(".zdebug_info") != nil {
+		details = append(details, "has DWARF debug info")
+	}
+	libs, _ := ef.ImportedLibraries()
+	return libraryDetails(details, libs), nil
+}
+
+func peDetails(f *os.File, _ int64) ([]string, error) {
+	pf, err := pe.NewFile(f)
+	if err != nil {
+		return nil, err
+	}
+	kind := "executable"
+	if pf.Characteristics&pe.IMAGE_FILE_DLL != 0 {
+		kind = "DLL"
+	}
+	var names []string
+	for _, s := range pf.Sections {
+		names = append(names, s.Name)
+	}
+	details := []string{
+		fmt.Sprintf("%s, machine: %#x, sections: %s", kind, pf.Machine, strings.Join(names, " ")),
+	}
+	libs, _ := pf.ImportedLibraries()
+	return libraryDetails(details, libs), nil
+}
+
+func machoDetails(f *os.File, _ int64) ([]string, error) {
+	if fat, err := macho.NewFatFile(f); err == nil {
+		var details []string
+		for _, arch := range fat.Arches {
+			details = append(details, fmt.Sprintf("arch %s: %s, load commands: %d", arch.Cpu, arch.Type, arch.Ncmd))
+		}
+		return details, nil
+	}
+	mf, err := macho.NewFile(f)
+	if err != nil {
+		return nil, err
+	}
+	details := []string{fmt.Sprintf("cpu: %s, type: %s, load commands: %d, sections: %d", mf.Cpu, mf.Type, mf.Ncmd, len(mf.Sections))}
+	libs, _ := mf.ImportedLibraries()
+	return libraryDetails(details, libs), nil
+}
+
+func classDetails(f *os.File, _ int64) ([]string, error) {
+	var header [8]byte
+	if _, err := io.ReadFull(f, header[:]); err != nil {
+		return nil, err
+	}
+	major := binary.BigEndian.Uint16(header[6:])
+	return []string{fmt.Sprintf("class file version %d.%d (Java %d)", major, binary.BigEndian.Uint16(header[4:]), int(major)-44)}, nil
+}
+
+func imageDetails(f *os.File, _ int64) ([]string, error) {
+	cfg, format, err := image.DecodeConfig(f)
+	if err != nil {
+		return nil, err
+	}
+	return []string{fmt.Sprintf("%s, %dx%d, color model: %s", format, cfg.Width, cfg.Height, colorModelName(cfg))}, nil
+}
+
+func colorModelName(cfg image.Config) string {
+	if p, ok := cfg.ColorModel.(color.Palette); ok {
+		return fmt.Sprintf("paletted, %d colors", len(p))
+	}
+	switch cfg.ColorModel {
+	case color.RGBAModel, color.RGBA64Model:
+		return "RGBA"
+	case color.NRGBAModel, color.NRGBA64Model:
+		return "NRGBA"
+	case color.GrayModel, color.Gray16Model:
+		return "gray"
+	case color.YCbCrModel:
+		return "YCbCr"
+	case color.CMYKModel:
+		return "CMYK"
+	}
+	return "other"
+}
+
+func bmpDetails(f *os.File, _ int64) ([]string, error) {
+	var header [30]byte
+	if _, err := io.ReadFull(f, header[:]); err != nil {
+		return nil, err
+	}
+	width := int32(binary.LittleEndian.Uint32(header[18:]))
+	height := int32(binary.LittleEndian.Uint32(header[22:]))
+	if height < 0 {
+		height = -height
+	}
+	return []string{fmt.Sprintf("bmp, %dx%d, %d bits per pixel", width, height, binary.LittleEndian.Uint16(header[28:]))}, nil
+}
+
+func pdfDetails(f *os.File, size int64) ([]string, error) {
+	var header [16]byte
+	n, _ := io.ReadFull(f, header[:])
+	version, _, _ := strings.Cut(string(header[5:n]), "\n")
+	details := []string{"version " + strings.TrimSpace(version)}
+
+	// The page count is not known without parsing the document; the
+	// /Count of the page tree near the end is a cheap estimate
+	tail := make([]byte, min64(size, 64*1024))
+	if _, err := f.ReadAt(tail, size-int64(len(tail))); err == nil || err == io.EOF {
+		if i := bytes.LastIndex(tail, []byte("/Type /Pages")); i >= 0 {
+			if j := bytes.Index(tail[i:], []byte("/Count ")); j >= 0 {
+				var count int
+				if _, err := fmt.Sscanf(string(tail[i+j+7:]), "%d", &count); err == nil {
+					details = append(details, fmt.Sprintf("pages: %d", count))
+				}
+			}
+		}
+	}
+	return details, nil
+}
+
+func min64(a, b int64) int64 {
+	if a < b {
+		return a
+	}
+	return b
+}
+
+func zipDetails(f *os.File, size int64) ([]string, error) {
+	zr, err := zip.NewReader(f, size)
+	if err != nil {
+		return nil, err
+	}
+	details := []string{fmt.Sprintf("%d entries", len(zr.File))}
+	for i, zf := range zr.File {
+		if i == maxBinaryDetails {
+			break
+		}
+		details = append(details, fmt.Sprintf("%s (%d bytes)", zf.Name, zf.UncompressedSize64))
+	}
+	if len(zr.File) > maxBinaryDetails {
+		details = append(details, fmt.Sprintf("... and %d more", len(zr.File)-maxBinaryDetails))
+	}
+	return details, nil
+}
+
+func tarDetails(f *os.File, _ int64) ([]string, error) {
+	tr := tar.NewReader(f)
+	var details []string
+	for len(details) < maxBinaryDetails {
+		hdr, err := tr.Next()
+		if err == io.EOF {
+			return details, nil
+		}
+		if err != nil {
+			return details, err
+		}
+		details = append(details, fmt.Sprintf("%s (%d bytes)", hdr.Name, hdr.Size))
+	}
+	if _, err := tr.Next(); err == nil {
+		details = append(details, "... and more")
+	}
+	return details, nil
+}
+
+// hexdump formats count bytes of the file at path from offset in the style
+// of hexdump -C. A negative offset counts back from the end of the file.
+func hexdump(path string, offset int64, count int) (string, int64, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return "", 0, err
+	}
+	defer f.Close()
+	info, err := f.Stat()
+	if err != nil {
+		return "", 0, err
+	}
+	if offset < 0 {
+		offset += info.Size()
+		if offset < 0 {
+			offset = 0
+		}
+	}
+	if offset > info.Size() {
+		return "", info.Size(), fmt.Errorf("offset %d is past the end of the file (%d bytes)", offset, info.Size())
+	}
+	buf := make([]byte, min64(int64(count), info.Size()-offset))
+	n, err := f.ReadAt(buf, offset)
+	if err != nil && err != io.EOF {
+		return "", info.Size(), err
+	}
+	buf = buf[:n]
+
+	var b strings.Builder
+	for i := 0; i < len(buf); i += 16 {
+		row := buf[i:]
+		if len(row) > 16 {
+			row = row[:16]
+		}
+		fmt.Fprintf(&b, "%08x  ", offset+int64(i))
+		for j := 0; j < 16; j++ {
+			if j < len(row) {
+				fmt.Fprintf(&b, "%02x ", row[j])
+			} else {
+				b.WriteString("   ")
+			}
+			if j == 7 {
+				b.WriteByte(' ')
+			}
+		}
+		b.WriteString(" |")
+		for _, c := range row {
+			if c < 0x20 || c > 0x7e {
+				c = '.'
+			}
+			b.WriteByte(c)
+		}
+		b.WriteString("|\n")
+	}
+	return b.String(), info.Size(), nil
+}
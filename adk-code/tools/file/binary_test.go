@@ -0,0 +1,173 @@
+package file
+
+import (
+	"archive/zip"
+	"bytes"
+	"encoding/binary"
+	"image"
+	"image/png"
+	"os"
+	"path/filepath"
+	"strings"
+	"testing"
+)
+
+func TestLooksBinary(t *testing.T) {
+	cases := map[string]bool{
+		"package main\n\nfunc main() {}\n":        false,
+		"naïve café — ünïcödé\n":                  false,
+		"\x1b[31mred\x1b[0m log line\n":           false,
+		"text\x00with a NUL":                      true,
+		"\x01\x02\x03\x04\x05\x06abc\xff\xfe\x80": true,
+		"ends in a cut rune \xe2\x82":             false,
+	}
+	for in, want := range cases {
+		if got := looksBinary([]byte(in)); got != want {
+			t.Errorf("looksBinary(%q) = %v, want %v", in, got, want)
+		}
+	}
+	if sniffBinary([]byte("BM25 ranking notes\n")) != nil || sniffBinary([]byte("MZ is a text file\n")) != nil {
+		t.Error("expected text starting with a short magic to stay text")
+	}
+}
+
+// summarize sniffs and describes the file at path.
+func summarize(t *testing.T, path string) *BinaryInfo {
+	t.Helper()
+	head, err := readHead(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	format := sniffBinary(head)
+	if format == nil {
+		t.Fatalf("%s was not detected as binary", path)
+	}
+	info, _ := os.Stat(path)
+	return describeBinary(path, format, head, info.Size())
+}
+
+func TestDescribeBinaryFormats(t *testing.T) {
+	dir := t.TempDir()
+
+	pngPath := filepath.Join(dir, "pixel.png")
+	var img bytes.Buffer
+	png.Encode(&img, image.NewRGBA(image.Rect(0, 0, 32, 16)))
+	os.WriteFile(pngPath, img.Bytes(), 0644)
+	if info := summarize(t, pngPath); info.MIMEType != "image/png" || len(info.Details) != 1 || !strings.Contains(info.Details[0], "32x16") {
+		t.Errorf("unexpected PNG summary %+v", info)
+	}
+
+	zipPath := filepath.Join(dir, "bundle.zip")
+	var archive bytes.Buffer
+	zw := zip.NewWriter(&archive)
+	for _, name := range []string{"a.txt", "dir/b.txt"} {
+		w, _ := zw.Create(name)
+		w.Write([]byte("hello"))
+	}
+	zw.Close()
+	os.WriteFile(zipPath, archive.Bytes(), 0644)
+	info := summarize(t, zipPath)
+	if strings.Join(info.Details, "|") != "2 entries|a.txt (5 bytes)|dir/b.txt (5 bytes)" {
+		t.Errorf("unexpected zip summary %+v", info)
+	}
+
+	if exe, err := os.Executable(); err == nil {
+		if head, _ := readHead(exe); bytes.HasPrefix(head, []byte("\x7fELF")) {
+			info := summarize(t, exe)
+			if info.Kind != "ELF executable" || !strings.Contains(strings.Join(info.Details, "\n"), "Go binary") {
+				t.Errorf("unexpected ELF summary %+v", info)
+			}
+		}
+	}
+
+	blob := filepath.Join(dir, "blob.bin")
+	os.WriteFile(blob, []byte{0, 1, 2, 3, 0xff}, 0644)
+	if info := summarize(t, blob); info.Kind != "binary data" || info.Details[0] != "first bytes: 00010203ff" {
+		t.Errorf("unexpected generic summary %+v", info)
+	}
+}
+
+// sqliteRecord encodes text and small integer columns as a SQLite record.
+func sqliteRecord(columns ...any) []byte {
+	header := []byte{0}
+	var body []byte
+	for _, c := range columns {
+		switch v := c.(type) {
+		case string:
+			header = append(header, byte(13+2*len(v)))
+			body = append(body, v...)
+		case int:
+			header = append(header, 1)
+			body = append(body, byte(v))
+		}
+	}
+	header[0] = byte(len(header))
+	return append(header, body...)
+}
+
+func TestSQLiteSchema(t *testing.T) {
+	const pageSize = 512
+	page := make([]byte, pageSize)
+	copy(page, sqliteMagic)
+	binary.BigEndian.PutUint16(page[16:], pageSize)
+	binary.BigEndian.PutUint32(page[56:], 1)
+
+	records := [][]byte{
+		sqliteRecord("table", "users", "users", 2, "CREATE TABLE users(id INTEGER, name TEXT)"),
+		sqliteRecord("index", "users_name", "users", 3, "CREATE INDEX users_name ON users(name)"),
+	}
+	page[100] = 0x0d
+	binary.BigEndian.PutUint16(page[103:], uint16(len(records)))
+	end := pageSize
+	for i, rec := range records {
+		cell := append([]byte{byte(len(rec)), byte(i + 1)}, rec...)
+		end -= len(cell)
+		copy(page[end:], cell)
+		binary.BigEndian.PutUint16(page[108+2*i:], uint16(end))
+	}
+	binary.BigEndian.PutUint16(page[105:], uint16(end))
+
+	path := filepath.Join(t.TempDir(), "app.db")
+	os.WriteFile(path, page, 0644)
+	info := summarize(t, path)
+	want := "page size 512, 1 pages, 1 tables, 1 indexes|" +
+		"table users: CREATE TABLE users(id INTEGER, name TEXT)|" +
+		"indexes: users_name on users"
+	if strings.Join(info.Details, "|") != want {
+		t.Errorf("unexpected SQLite summary:\n%s", strings.Join(info.Details, "\n"))
+	}
+}
+
+func TestHexdump(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "data.bin")
+	os.WriteFile(path, []byte("\x7fELF\x02\x01\x01\x00hello, world!\n\x00\xff"), 0644)
+
+	dump, size, err := hexdump(path, 0, 512)
+	if err != nil || size != 24 {
+		t.Fatalf("hexdump failed: %v (size %d)", err, size)
+	}
+	want := "00000000  7f 45 4c 46 02 01 01 00  68 65 6c 6c 6f 2c 20 77  |.ELF....hello, w|\n" +
+		"00000010  6f 72 6c 64 21 0a 00 ff                           |orld!...|\n"
+	if dump != want {
+		t.Errorf("unexpected dump:\n%s\nwant:\n%s", dump, want)
+	}
+
+	dump, _, _ = hexdump(path, -2, 512)
+	if dump != "00000016  00 ff                                             |..|\n" {
+		t.Errorf("unexpected tail dump:\n%q", dump)
+	}
+	if _, _, err := hexdump(path, 100, 16); err == nil {
+		t.Error("expected an error for an offset past the end")
+	}
+}
+
+func TestParseRecordRejectsCorruptHeaderSize(t *testing.T) {
+	// A 9-byte varint with the top bit set decodes to a negative size
+	negative := append(bytes.Repeat([]byte{0xff}, 8), 0xff, 0x01)
+	if values := parseRecord(negative); values != nil {
+		t.Errorf("expected no values, got %v", values)
+	}
+	if values := parseRecord([]byte{0, 1, 2}); values != nil {
+		t.Errorf("expected a header size of 0 to be rejected, got %v", values)
+	}
+}
@@ -0,0 +1,42 @@
+// Package file provides file operation tools for the coding agent.
+package file
+
+import (
+	"io"
+
+	"adk-code/internal/compressed"
+)
+
+// readCompressedRange returns lines [offset, offset+limit) of a gzip or zstd
+// file, decompressing only up to one line past the range. total is the
+// file's line count when known (the range reached the end, or an earlier
+// read did), and 0 otherwise.
+func readCompressedRange(path string, offset, limit int) (lines []string, total int, format compressed.Format, err error) {
+	r, err := compressed.Open(path)
+	if err != nil {
+		return nil, 0, compressed.None, err
+	}
+	defer r.Close()
+
+	if err := r.SkipTo(offset); err != nil {
+		if err == io.EOF {
+			return nil, r.TotalLines(), r.Format(), nil
+		}
+		return nil, 0, r.Format(), err
+	}
+	for len(lines) < limit {
+		line, err := r.ReadLine()
+		if err == io.EOF {
+			break
+		}
+		if err != nil {
+			return nil, 0, r.Format(), err
+		}
+		lines = append(lines, string(line))
+	}
+	// One more line tells whether the range ended the file
+	if _, err := r.ReadLine(); err == io.EOF {
+		return lines, r.Line(), r.Format(), nil
+	}
+	return lines, r.TotalLines(), r.Format(), nil
+}
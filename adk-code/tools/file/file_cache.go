@@ -0,0 +1,125 @@
+// Package file provides file operation tools for the coding agent.
+package file
+
+import (
+	"container/list"
+	"os"
+	"path/filepath"
+	"sync"
+	"time"
+
+	common "adk-code/tools/base"
+)
+
+// File cache bounds. Files larger than maxCachedFileBytes are read directly.
+const (
+	defaultFileCacheBytes = 32 << 20
+	maxCachedFileBytes    = 4 << 20
+)
+
+// fileCache is a byte-bounded LRU of file contents shared by the read tools.
+// Entries are validated against the file's size and modification time on
+// every lookup, and dropped when a tool reports writing the file.
+type fileCache struct {
+	mu      sync.Mutex
+	max     int64
+	size    int64
+	order   *list.List
+	entries map[string]*list.Element
+}
+
+type fileCacheEntry struct {
+	path    string
+	modTime time.Time
+	size    int64
+	content []byte
+}
+
+func newFileCache(max int64) *fileCache {
+	return &fileCache{
+		max:     max,
+		order:   list.New(),
+		entries: make(map[string]*list.Element),
+	}
+}
+
+var defaultFileCache = newFileCache(defaultFileCacheBytes)
+
+func init() {
+	common.OnFileWrite(defaultFileCache.invalidate)
+}
+
+// read returns the content and info of the file at path, from the cache when
+// the file is unchanged since it was cached. The returned slice is shared and
+// must not be modified.
+func (c *fileCache) read(path string) ([]byte, os.FileInfo, error) {
+	info, err := os.Stat(path)
+	if err != nil {
+		return nil, nil, err
+	}
+	key, err := filepath.Abs(path)
+	if err != nil {
+		key = path
+	}
+
+	c.mu.Lock()
+	if elem, ok := c.entries[key]; ok {
+		entry := elem.Value.(*fileCacheEntry)
+		if entry.size == info.Size() && entry.modTime.Equal(info.ModTime()) {
+			c.order.MoveToFront(elem)
+			c.mu.Unlock()
+			return entry.content, info, nil
+		}
+		c.remove(elem)
+	}
+	c.mu.Unlock()
+
+	content, err := os.ReadFile(path)
+	if err != nil {
+		return nil, nil, err
+	}
+	if int64(len(content)) <= maxCachedFileBytes && int64(len(content)) == info.Size() {
+		c.put(&fileCacheEntry{path: key, modTime: info.ModTime(), size: info.Size(), content: content})
+	}
+	return content, info, nil
+}
+
+func (c *fileCache) put(entry *fileCacheEntry) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	if elem, ok := c.entries[entry.path]; ok {
+		c.remove(elem)
+	}
+	c.entries[entry.path] = c.order.PushFront(entry)
+	c.size += entry.size
+	for c.size > c.max {
+		c.remove(c.order.Back())
+	}
+}
+
+// remove drops elem; c.mu must be held.
+func (c *fileCache) remove(elem *list.Element) {
+	entry := elem.Value.(*fileCacheEntry)
+	c.order.Remove(elem)
+	delete(c.entries, entry.path)
+	c.size -= entry.size
+}
+
+// invalidate drops path from the cache, or everything when path is empty
+// (a command may have written any file).
+func (c *fileCache) invalidate(path string) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	if path == "" {
+		c.order.Init()
+		c.entries = make(map[string]*list.Element)
+		c.size = 0
+		return
+	}
+	if abs, err := filepath.Abs(path); err == nil {
+		path = abs
+	}
+	if elem, ok := c.entries[path]; ok {
+		c.remove(elem)
+	}
+}
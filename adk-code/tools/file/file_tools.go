@@ -101,6 +101,7 @@ func NewReplaceInFileTool() (tool.Tool, error) {
 				Error:   errors.Wrap(errors.CodeExecution, "failed to write file", err).Error(),
 			}
 		}
+		common.NotifyFileWrite(input.Path)
 
 		return ReplaceInFileOutput{
 			Success:          true,
@@ -0,0 +1,296 @@
+// Package file provides file operation tools for the coding agent.
+package file
+
+import (
+	"bytes"
+	"fmt"
+	"strconv"
+	"strings"
+	"sync"
+
+	"google.golang.org/adk/tool"
+	"google.golang.org/adk/tool/functiontool"
+
+	"adk-code/internal/compressed"
+	"adk-code/pkg/errors"
+	common "adk-code/tools/base"
+)
+
+// Batch read limits
+const (
+	defaultBatchMaxLines = 2000
+	defaultBatchMaxBytes = 100_000
+	defaultRangeLimit    = 1000
+	maxBatchSpecs        = 50
+	batchReadWorkers     = 8
+)
+
+// ReadRangeSpec is one file or line range in a batch read.
+type ReadRangeSpec struct {
+	// Path is the absolute or relative path to the file to read.
+	Path string `json:"path" jsonschema:"Path to the file to read"`
+	// Offset is the starting line number (1-indexed, optional).
+	Offset *int `json:"offset,omitempty" jsonschema:"Start line number (1-indexed, default: 1)"`
+	// Limit is the maximum number of lines to read (optional, default: 1000).
+	Limit *int `json:"limit,omitempty" jsonschema:"Number of lines to read (default: 1000)"`
+}
+
+// ReadFilesInput defines the input parameters for reading several files or
+// ranges in one call.
+type ReadFilesInput struct {
+	// Files lists the files and ranges to read, in output order.
+	Files []ReadRangeSpec `json:"files" jsonschema:"Files or line ranges to read, in order (max 50)"`
+	// MaxLines is the line budget shared by the whole batch (optional).
+	MaxLines *int `json:"max_lines,omitempty" jsonschema:"Combined line budget across all files (default: 2000)"`
+	// MaxBytes is the byte budget shared by the whole batch (optional).
+	MaxBytes *int `json:"max_bytes,omitempty" jsonschema:"Combined byte budget across all files (default: 100000)"`
+}
+
+// ReadFilesOutput defines the output of a batch read.
+type ReadFilesOutput struct {
+	// Content is every range in order, each under a "==> path [start-end of total] <==" header.
+	Content string `json:"content"`
+	// Success indicates whether at least one file was read.
+	Success bool `json:"success"`
+	// Error contains error message if the operation failed.
+	Error string `json:"error,omitempty"`
+	// FilesRead is the number of ranges that returned content.
+	FilesRead int `json:"files_read"`
+	// Truncated reports whether the batch budget cut the output short.
+	Truncated bool `json:"truncated,omitempty"`
+}
+
+// rangeResult is one spec's selected lines before the batch budget applies.
+type rangeResult struct {
+	selected []byte
+	start    int
+	total    int // 0 when unknown for a compressed file
+	format   compressed.Format
+	err      error
+}
+
+// readRange reads spec through the file cache and selects its lines.
+func readRange(spec ReadRangeSpec) rangeResult {
+	offset := 1
+	if spec.Offset != nil && *spec.Offset > 1 {
+		offset = *spec.Offset
+	}
+	limit := defaultRangeLimit
+	if spec.Limit != nil && *spec.Limit > 0 {
+		limit = *spec.Limit
+	}
+
+	head, err := readHead(spec.Path)
+	if err != nil {
+		return rangeResult{err: errors.FileNotFoundError(spec.Path)}
+	}
+	if compressed.Detect(head) != compressed.None {
+		lines, total, format, err := readCompressedRange(spec.Path, offset, limit)
+		if err != nil {
+			return rangeResult{err: err}
+		}
+		var selected []byte
+		if len(lines) > 0 {
+			selected = []byte(strings.Join(lines, "\n"))
+		}
+		return rangeResult{selected: selected, start: offset, total: total, format: format}
+	}
+	if format := sniffBinary(head); format != nil {
+		return rangeResult{err: fmt.Errorf("binary file (%s, %s); use builtin_read_file for a summary or hexdump", format.kind, format.mime)}
+	}
+
+	content, _, err := defaultFileCache.read(spec.Path)
+	if err != nil {
+		return rangeResult{err: errors.FileNotFoundError(spec.Path)}
+	}
+	selected, total := selectLines(content, offset, limit)
+	return rangeResult{selected: selected, start: offset, total: total}
+}
+
+// selectLines returns lines [offset, offset+limit) of content without
+// splitting the whole file, and the file's line count as strings.Split
+// would report it.
+func selectLines(content []byte, offset, limit int) ([]byte, int) {
+	total := bytes.Count(content, []byte{'\n'}) + 1
+	if offset > total {
+		return nil, total
+	}
+	rest := content
+	for i := 1; i < offset; i++ {
+		rest = rest[bytes.IndexByte(rest, '\n')+1:]
+	}
+	end := 0
+	for i := 0; i < limit; i++ {
+		nl := bytes.IndexByte(rest[end:], '\n')
+		if nl < 0 {
+			// The last line, which may be empty after a trailing newline
+			return rest, total
+		}
+		end += nl + 1
+	}
+	return rest[:end-1], total
+}
+
+// label names the range's file in its header, with the format it was
+// decompressed from.
+func (r rangeResult) label(path string) string {
+	if r.format != compressed.None {
+		return path + " (" + r.format.String() + ")"
+	}
+	return path
+}
+
+// totalText is the file's line count, or "?" when not known.
+func (r rangeResult) totalText() string {
+	if r.total == 0 {
+		return "?"
+	}
+	return strconv.Itoa(r.total)
+}
+
+// readRanges reads every spec concurrently and concatenates the results in
+// spec order, stopping at a line boundary once either budget is spent. A
+// range whose first line does not fit is skipped without ending the batch.
+func readRanges(specs []ReadRangeSpec, maxLines, maxBytes int) (content string, filesRead int, truncated bool) {
+	results := make([]rangeResult, len(specs))
+	work := make(chan int)
+	var wg sync.WaitGroup
+	for w := 0; w < batchReadWorkers && w < len(specs); w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for i := range work {
+				results[i] = readRange(specs[i])
+			}
+		}()
+	}
+	for i := range specs {
+		work <- i
+	}
+	close(work)
+	wg.Wait()
+
+	var b strings.Builder
+	lines, size := 0, 0
+	for i, r := range results {
+		path := specs[i].Path
+		switch {
+		case r.err != nil:
+			fmt.Fprintf(&b, "==> %s <==\n[error: %v]\n", path, r.err)
+			continue
+		case lines >= maxLines || size >= maxBytes:
+			truncated = true
+			fmt.Fprintf(&b, "==> %s <==\n[skipped: batch budget exhausted]\n", path)
+			continue
+		case len(r.selected) == 0:
+			fmt.Fprintf(&b, "==> %s [empty range, %s lines] <==\n", r.label(path), r.totalText())
+			continue
+		}
+
+		// Take whole lines while both budgets allow
+		taken, n := 0, 0
+		for taken < len(r.selected) {
+			if lines >= maxLines {
+				truncated = true
+				break
+			}
+			next := bytes.IndexByte(r.selected[taken:], '\n')
+			lineEnd := len(r.selected)
+			if next >= 0 {
+				lineEnd = taken + next + 1
+			}
+			if size+lineEnd-taken > maxBytes {
+				truncated = true
+				break
+			}
+			size += lineEnd - taken
+			taken = lineEnd
+			lines++
+			n++
+		}
+		if n == 0 {
+			// A line longer than what is left (say, minified code) only
+			// costs its own range; later files still get the budget
+			fmt.Fprintf(&b, "==> %s <==\n[skipped: line %d is longer than the remaining batch budget]\n", path, r.start)
+			continue
+		}
+
+		fmt.Fprintf(&b, "==> %s [%d-%d of %s] <==\n", r.label(path), r.start, r.start+n-1, r.totalText())
+		b.Write(bytes.TrimSuffix(r.selected[:taken], []byte{'\n'}))
+		b.WriteByte('\n')
+		if taken < len(r.selected) {
+			fmt.Fprintf(&b, "[truncated after line %d: batch budget exhausted]\n", r.start+n-1)
+		}
+		filesRead++
+	}
+	return b.String(), filesRead, truncated
+}
+
+// NewReadFilesTool creates a tool for reading several files or line ranges
+// in one call.
+func NewReadFilesTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input ReadFilesInput) ReadFilesOutput {
+		if len(input.Files) == 0 {
+			return ReadFilesOutput{Success: false, Error: "files must list at least one path"}
+		}
+		if len(input.Files) > maxBatchSpecs {
+			return ReadFilesOutput{
+				Success: false,
+				Error:   fmt.Sprintf("too many files: %d (max %d per call)", len(input.Files), maxBatchSpecs),
+			}
+		}
+
+		maxLines := defaultBatchMaxLines
+		if input.MaxLines != nil && *input.MaxLines > 0 {
+			maxLines = *input.MaxLines
+		}
+		maxBytes := defaultBatchMaxBytes
+		if input.MaxBytes != nil && *input.MaxBytes > 0 {
+			maxBytes = *input.MaxBytes
+		}
+
+		content, filesRead, truncated := readRanges(input.Files, maxLines, maxBytes)
+		output := ReadFilesOutput{
+			Content:   content,
+			Success:   filesRead > 0,
+			FilesRead: filesRead,
+			Truncated: truncated,
+		}
+		if filesRead == 0 {
+			output.Error = "no file could be read"
+		}
+		return output
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name: "builtin_read_files",
+		Description: `Reads several files or line ranges in one call, concurrently, under one shared budget.
+
+**Parameters:**
+- files (required): List of {path, offset, limit} specs, read in order (max 50). offset and limit work as in builtin_read_file.
+- max_lines (optional): Line budget for the whole batch (default: 2000)
+- max_bytes (optional): Byte budget for the whole batch (default: 100000)
+
+**Output:** Each range appears under a header "==> path [start-end of total] <==". gzip and zstd files are decompressed on the fly; their total may be "?" when the range stops before the end. Once the budget is spent, the current range is cut at a line boundary and the remaining files are listed as skipped; a range whose first line alone exceeds the remaining budget (e.g. minified code) is skipped on its own. Unreadable files show an inline error without failing the batch.
+
+**Example:** files=[{"path": "main.go"}, {"path": "pkg/server.go", "offset": 120, "limit": 60}]
+
+Prefer this over repeated builtin_read_file calls when you need several files to understand a change.`,
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategoryFileOperations,
+			Priority:  0,
+			UsageHint: "Read many files or ranges at once under a shared line/byte budget",
+		})
+	}
+
+	return t, err
+}
+
+// init registers the batch read tool automatically at package initialization.
+func init() {
+	_, _ = NewReadFilesTool()
+}
@@ -0,0 +1,188 @@
+package file
+
+import (
+	"bytes"
+	"compress/gzip"
+	"fmt"
+	"os"
+	"path/filepath"
+	"strings"
+	"testing"
+)
+
+func intPtr(v int) *int { return &v }
+
+func writeLines(t *testing.T, path string, n int) {
+	t.Helper()
+	lines := make([]string, n)
+	for i := range lines {
+		lines[i] = "line " + string(rune('a'+i%26))
+	}
+	if err := os.WriteFile(path, []byte(strings.Join(lines, "\n")), 0644); err != nil {
+		t.Fatalf("Failed to write %s: %v", path, err)
+	}
+}
+
+func TestSelectLinesMatchesSplit(t *testing.T) {
+	content := []byte("one\ntwo\nthree\n")
+	cases := []struct {
+		offset, limit int
+	}{
+		{1, 2},
+		{2, 10},
+		{4, 1},
+	}
+	for _, c := range cases {
+		got, total := selectLines(content, c.offset, c.limit)
+		lines := strings.Split(string(content), "\n")
+		end := c.offset + c.limit - 1
+		if end > len(lines) {
+			end = len(lines)
+		}
+		if want := strings.Join(lines[c.offset-1:end], "\n"); string(got) != want || total != 4 {
+			t.Errorf("selectLines(%d, %d) = %q, %d; want %q, 4", c.offset, c.limit, got, total, want)
+		}
+	}
+	if got, _ := selectLines(content, 9, 1); got != nil {
+		t.Errorf("expected nothing past the end, got %q", got)
+	}
+}
+
+func TestReadRangesConcatenatesInOrder(t *testing.T) {
+	dir := t.TempDir()
+	a, b := filepath.Join(dir, "a.txt"), filepath.Join(dir, "b.txt")
+	writeLines(t, a, 5)
+	writeLines(t, b, 30)
+
+	content, filesRead, truncated := readRanges([]ReadRangeSpec{
+		{Path: a},
+		{Path: filepath.Join(dir, "missing.txt")},
+		{Path: b, Offset: intPtr(10), Limit: intPtr(3)},
+	}, 100, 10000)
+
+	if filesRead != 2 || truncated {
+		t.Fatalf("expected 2 files and no truncation, got %d, %v", filesRead, truncated)
+	}
+	want := "==> " + a + " [1-5 of 5] <==\nline a\nline b\nline c\nline d\nline e\n" +
+		"==> " + filepath.Join(dir, "missing.txt") + " <==\n[error: "
+	if !strings.HasPrefix(content, want) {
+		t.Fatalf("unexpected content:\n%s", content)
+	}
+	if !strings.HasSuffix(content, "==> "+b+" [10-12 of 30] <==\nline j\nline k\nline l\n") {
+		t.Fatalf("expected the range of b last, got:\n%s", content)
+	}
+}
+
+func TestReadRangesSharesBudget(t *testing.T) {
+	dir := t.TempDir()
+	a, b, c := filepath.Join(dir, "a.txt"), filepath.Join(dir, "b.txt"), filepath.Join(dir, "c.txt")
+	writeLines(t, a, 4)
+	writeLines(t, b, 4)
+	writeLines(t, c, 4)
+
+	content, filesRead, truncated := readRanges([]ReadRangeSpec{{Path: a}, {Path: b}, {Path: c}}, 6, 10000)
+	if filesRead != 2 || !truncated {
+		t.Fatalf("expected 2 files read before the budget ran out, got %d, %v", filesRead, truncated)
+	}
+	if !strings.Contains(content, "==> "+b+" [1-2 of 4] <==\nline a\nline b\n[truncated after line 2") {
+		t.Errorf("expected b cut after two lines, got:\n%s", content)
+	}
+	if !strings.HasSuffix(content, "==> "+c+" <==\n[skipped: batch budget exhausted]\n") {
+		t.Errorf("expected c skipped, got:\n%s", content)
+	}
+
+	// The byte budget cuts at a line boundary too
+	content, _, truncated = readRanges([]ReadRangeSpec{{Path: a}}, 100, 15)
+	if !truncated || !strings.Contains(content, "[1-2 of 4] <==\nline a\nline b\n[truncated") {
+		t.Errorf("expected two 7-byte lines within 15 bytes, got:\n%s", content)
+	}
+}
+
+func TestReadRangesSkipsOnlyOversizedLines(t *testing.T) {
+	dir := t.TempDir()
+	minified, a := filepath.Join(dir, "app.min.js"), filepath.Join(dir, "a.txt")
+	if err := os.WriteFile(minified, []byte(strings.Repeat("x", 100)+"\n"), 0644); err != nil {
+		t.Fatal(err)
+	}
+	writeLines(t, a, 2)
+
+	content, filesRead, truncated := readRanges([]ReadRangeSpec{{Path: minified}, {Path: a}}, 100, 50)
+	if filesRead != 1 || !truncated {
+		t.Fatalf("expected only the minified file to be skipped, got %d, %v", filesRead, truncated)
+	}
+	if !strings.HasPrefix(content, "==> "+minified+" <==\n[skipped: line 1 is longer") {
+		t.Errorf("expected the minified file skipped, got:\n%s", content)
+	}
+	if !strings.HasSuffix(content, "==> "+a+" [1-2 of 2] <==\nline a\nline b\n") {
+		t.Errorf("expected the later file to be read, got:\n%s", content)
+	}
+}
+
+func TestFileCacheRevalidates(t *testing.T) {
+	cache := newFileCache(1 << 20)
+	path := filepath.Join(t.TempDir(), "f.txt")
+	if err := os.WriteFile(path, []byte("v1"), 0644); err != nil {
+		t.Fatal(err)
+	}
+	first, _, err := cache.read(path)
+	if err != nil || string(first) != "v1" {
+		t.Fatalf("read = %q, %v", first, err)
+	}
+	second, _, _ := cache.read(path)
+	if &first[0] != &second[0] {
+		t.Error("expected the second read to be served from the cache")
+	}
+
+	if err := os.WriteFile(path, []byte("v2, longer"), 0644); err != nil {
+		t.Fatal(err)
+	}
+	if got, _, _ := cache.read(path); string(got) != "v2, longer" {
+		t.Errorf("expected the changed file to be reread, got %q", got)
+	}
+
+	cache.invalidate(path)
+	if cache.order.Len() != 0 || cache.size != 0 {
+		t.Errorf("expected invalidate to empty the cache, got %d entries, %d bytes", cache.order.Len(), cache.size)
+	}
+}
+
+func TestFileCacheEvictsBySize(t *testing.T) {
+	cache := newFileCache(10)
+	dir := t.TempDir()
+	for _, name := range []string{"a", "b", "c"} {
+		path := filepath.Join(dir, name)
+		if err := os.WriteFile(path, []byte("12345"), 0644); err != nil {
+			t.Fatal(err)
+		}
+		if _, _, err := cache.read(path); err != nil {
+			t.Fatal(err)
+		}
+	}
+	if cache.order.Len() != 2 || cache.size != 10 {
+		t.Errorf("expected the oldest file evicted, got %d entries, %d bytes", cache.order.Len(), cache.size)
+	}
+}
+
+func TestReadRangesDecompressesGzip(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "app.log.gz")
+	var buf bytes.Buffer
+	zw := gzip.NewWriter(&buf)
+	for i := 1; i <= 500; i++ {
+		fmt.Fprintf(zw, "request %d\n", i)
+	}
+	zw.Close()
+	if err := os.WriteFile(path, buf.Bytes(), 0644); err != nil {
+		t.Fatal(err)
+	}
+
+	content, filesRead, _ := readRanges([]ReadRangeSpec{{Path: path, Offset: intPtr(10), Limit: intPtr(2)}}, 100, 10000)
+	if filesRead != 1 || content != "==> "+path+" (gzip) [10-11 of ?] <==\nrequest 10\nrequest 11\n" {
+		t.Fatalf("unexpected content:\n%s", content)
+	}
+
+	// Reading to the end makes the line count known
+	lines, total, _, err := readCompressedRange(path, 499, 10)
+	if err != nil || len(lines) != 3 || total != 501 {
+		t.Fatalf("expected the last 3 lines of 501, got %q, %d, %v", lines, total, err)
+	}
+}
@@ -2,6 +2,7 @@
 package file
 
 import (
+	"fmt"
 	"os"
 	"path/filepath"
 	"strings"
@@ -9,6 +10,7 @@ import (
 	"google.golang.org/adk/tool"
 	"google.golang.org/adk/tool/functiontool"
 
+	"adk-code/internal/compressed"
 	"adk-code/pkg/errors"
 	common "adk-code/tools/base"
 )
@@ -21,6 +23,12 @@ type ReadFileInput struct {
 	Offset *int `json:"offset,omitempty" jsonschema:"Start line number (1-indexed, default: 1)"`
 	// Limit is the maximum number of lines to read (optional, default: 1000).
 	Limit *int `json:"limit,omitempty" jsonschema:"Number of lines to read (default: 1000)"`
+	// Hexdump returns a byte range as a hex dump instead of lines.
+	Hexdump bool `json:"hexdump,omitempty" jsonschema:"Return a byte range as a hex dump (hexdump -C style) instead of lines; use when a binary file's bytes are needed"`
+	// ByteOffset is where a hexdump starts.
+	ByteOffset *int64 `json:"byte_offset,omitempty" jsonschema:"Hexdump start byte (0-based; negative counts back from the end, default: 0)"`
+	// ByteCount is the number of bytes a hexdump shows.
+	ByteCount *int `json:"byte_count,omitempty" jsonschema:"Hexdump length in bytes (default: 512, max: 65536)"`
 }
 
 // ReadFileOutput defines the output of reading a file.
@@ -31,7 +39,8 @@ type ReadFileOutput struct {
 	Success bool `json:"success"`
 	// Error contains error message if the operation failed.
 	Error string `json:"error,omitempty"`
-	// TotalLines is the total number of lines in the file.
+	// TotalLines is the total number of lines in the file. For a compressed
+	// file it is 0 until some read has reached the end.
 	TotalLines int `json:"total_lines"`
 	// ReturnedLines is the number of lines returned.
 	ReturnedLines int `json:"returned_lines"`
@@ -43,12 +52,35 @@ type ReadFileOutput struct {
 	DateCreated string `json:"date_created,omitempty"`
 	// DateModified is the last modification time of the file (RFC3339 format).
 	DateModified string `json:"date_modified"`
+	// Compression names the format the content was decompressed from, if any.
+	Compression string `json:"compression,omitempty"`
+	// Binary summarizes a binary file, whose content is not returned.
+	Binary *BinaryInfo `json:"binary,omitempty"`
+	// FileSize is the file size in bytes, for binary files and hexdumps.
+	FileSize int64 `json:"file_size,omitempty"`
 }
 
 // NewReadFileTool creates a tool for reading files.
 func NewReadFileTool() (tool.Tool, error) {
 	handler := func(ctx tool.Context, input ReadFileInput) ReadFileOutput {
-		content, err := os.ReadFile(input.Path)
+		if input.Hexdump {
+			return readHexdump(input)
+		}
+		head, err := readHead(input.Path)
+		if err != nil {
+			return ReadFileOutput{
+				Success: false,
+				Error:   errors.FileNotFoundError(input.Path).Error(),
+			}
+		}
+		if compressed.Detect(head) != compressed.None {
+			return readCompressedFile(input)
+		}
+		if format := sniffBinary(head); format != nil {
+			return readBinaryFile(input.Path, format, head)
+		}
+
+		content, info, err := defaultFileCache.read(input.Path)
 		if err != nil {
 			return ReadFileOutput{
 				Success: false,
@@ -86,16 +118,11 @@ func NewReadFileTool() (tool.Tool, error) {
 
 		// Get file stats for path, creation time, and modification time
 		absPath, _ := filepath.Abs(input.Path)
-		dateModified := ""
-		dateCreated := ""
-
-		if fileInfo, err := os.Stat(input.Path); err == nil {
-			dateModified = fileInfo.ModTime().Format("2006-01-02T15:04:05Z07:00")
-			// Note: On Unix systems, birth time is not readily available.
-			// On macOS, we would need system-specific code to get it.
-			// For now, we set it empty or use ModTime as fallback.
-			dateCreated = dateModified
-		}
+		dateModified := info.ModTime().Format("2006-01-02T15:04:05Z07:00")
+		// Note: On Unix systems, birth time is not readily available.
+		// On macOS, we would need system-specific code to get it.
+		// For now, we use ModTime as fallback.
+		dateCreated := dateModified
 
 		return ReadFileOutput{
 			Content:       strings.Join(selectedLines, "\n"),
@@ -118,6 +145,10 @@ func NewReadFileTool() (tool.Tool, error) {
 - offset (optional): Start line number (1-indexed, default: 1). Set offset=10 to start from line 10.
 - limit (optional): Maximum number of lines to read (default: 1000). Set limit=50 to read 50 lines.
 
+gzip (.gz) and zstd (.zst) files are decompressed on the fly, stopping after the requested lines, so rotated logs can be read directly.
+
+Binary files (executables, images, archives, SQLite databases, ...) return a summary instead of content: type, size and a digest such as ELF/PE/Mach-O headers and libraries, image dimensions, the archive listing or the database schema. Set hexdump=true with byte_offset/byte_count to read the bytes themselves.
+
 **Example:** Read lines 10-59 of a file: path="src/main.go", offset=10, limit=50
 
 Use this to examine code, configuration files, or any text files. For large files, use offset and limit to read specific sections efficiently.`,
@@ -135,6 +166,90 @@ Use this to examine code, configuration files, or any text files. For large file
 	return t, err
 }
 
+// readCompressedFile reads a line range of a gzip or zstd file.
+func readCompressedFile(input ReadFileInput) ReadFileOutput {
+	offset := 1
+	if input.Offset != nil && *input.Offset > 1 {
+		offset = *input.Offset
+	}
+	limit := 1000
+	if input.Limit != nil && *input.Limit > 0 {
+		limit = *input.Limit
+	}
+
+	lines, total, format, err := readCompressedRange(input.Path, offset, limit)
+	if err != nil {
+		return ReadFileOutput{
+			Success: false,
+			Error:   fmt.Sprintf("Failed to decompress %s: %v", input.Path, err),
+		}
+	}
+
+	absPath, _ := filepath.Abs(input.Path)
+	dateModified := ""
+	if info, err := os.Stat(input.Path); err == nil {
+		dateModified = info.ModTime().Format("2006-01-02T15:04:05Z07:00")
+	}
+	return ReadFileOutput{
+		Content:       strings.Join(lines, "\n"),
+		Success:       true,
+		TotalLines:    total,
+		ReturnedLines: len(lines),
+		StartLine:     offset,
+		FilePath:      absPath,
+		DateCreated:   dateModified,
+		DateModified:  dateModified,
+		Compression:   format.String(),
+	}
+}
+
+// readBinaryFile returns a summary of a binary file in place of its content.
+func readBinaryFile(path string, format *binaryFormat, head []byte) ReadFileOutput {
+	stat, err := os.Stat(path)
+	if err != nil {
+		return ReadFileOutput{Success: false, Error: errors.FileNotFoundError(path).Error()}
+	}
+	info := describeBinary(path, format, head, stat.Size())
+	absPath, _ := filepath.Abs(path)
+	dateModified := stat.ModTime().Format("2006-01-02T15:04:05Z07:00")
+	return ReadFileOutput{
+		Content:      info.summary(),
+		Success:      true,
+		FilePath:     absPath,
+		DateCreated:  dateModified,
+		DateModified: dateModified,
+		Binary:       info,
+		FileSize:     stat.Size(),
+	}
+}
+
+// readHexdump returns a byte range of any file as a hex dump.
+func readHexdump(input ReadFileInput) ReadFileOutput {
+	var offset int64
+	if input.ByteOffset != nil {
+		offset = *input.ByteOffset
+	}
+	count := defaultHexdumpBytes
+	if input.ByteCount != nil && *input.ByteCount > 0 {
+		count = *input.ByteCount
+	}
+	if count > maxHexdumpBytes {
+		count = maxHexdumpBytes
+	}
+
+	dump, size, err := hexdump(input.Path, offset, count)
+	if err != nil {
+		return ReadFileOutput{Success: false, Error: fmt.Sprintf("Cannot hexdump %s: %v", input.Path, err)}
+	}
+	absPath, _ := filepath.Abs(input.Path)
+	return ReadFileOutput{
+		Content:  dump,
+		Success:  true,
+		FilePath: absPath,
+		FileSize: size,
+	}
+}
+
 // init registers the read file tool automatically at package initialization.
 func init() {
 	_, _ = NewReadFileTool()
@@ -2,6 +2,7 @@
 package file
 
 import (
+	"context"
 	"fmt"
 	"os"
 	"path/filepath"
@@ -9,6 +10,7 @@ import (
 	"google.golang.org/adk/tool"
 	"google.golang.org/adk/tool/functiontool"
 
+	"adk-code/pkg/workspace"
 	common "adk-code/tools/base"
 )
 
@@ -20,6 +22,8 @@ type SearchFilesInput struct {
 	Pattern string `json:"pattern" jsonschema:"Search pattern (supports * and ? wildcards, e.g., '*.go', 'test_*.py')"`
 	// MaxResults is the maximum number of results to return.
 	MaxResults *int `json:"max_results,omitempty" jsonschema:"Maximum number of results to return (default: 100)"`
+	// AllRoots searches Path relative to every workspace root.
+	AllRoots bool `json:"all_roots,omitempty" jsonschema:"Search path (relative, default '.') in every workspace root concurrently; results are labeled @workspace:path"`
 }
 
 // SearchFilesOutput defines the output of searching files.
@@ -28,6 +32,8 @@ type SearchFilesOutput struct {
 	Matches []string `json:"matches"`
 	// Count is the total number of matches found.
 	Count int `json:"count"`
+	// Truncated indicates the result limit was reached in a workspace-wide search.
+	Truncated bool `json:"truncated,omitempty"`
 	// Success indicates whether the operation was successful.
 	Success bool `json:"success"`
 	// Error contains error message if the operation failed.
@@ -42,32 +48,21 @@ func NewSearchFilesTool() (tool.Tool, error) {
 			maxResults = *input.MaxResults
 		}
 
-		// Initialize with empty slice, not nil
-		matches := make([]string, 0)
-		err := filepath.Walk(input.Path, func(path string, info os.FileInfo, err error) error {
-			if err != nil {
-				return nil // Skip errors and continue
-			}
-			if info.IsDir() {
-				return nil
-			}
-
-			matched, err := filepath.Match(input.Pattern, filepath.Base(path))
-			if err != nil {
-				return err
-			}
-
-			if matched {
-				matches = append(matches, path)
-				if len(matches) >= maxResults {
-					return filepath.SkipAll
-				}
+		// An absolute path names a single location, not one per root
+		if input.AllRoots && !filepath.IsAbs(input.Path) {
+			if ws := workspace.Active(); ws != nil {
+				return searchFilesAllRoots(ctx, ws, input, maxResults)
 			}
+		}
 
-			return nil
+		// Initialize with empty slice, not nil
+		matches := make([]string, 0)
+		err := walkMatchingFiles(input.Path, input.Pattern, func(path string) bool {
+			matches = append(matches, path)
+			return len(matches) < maxResults
 		})
 
-		if err != nil && err != filepath.SkipAll {
+		if err != nil {
 			return SearchFilesOutput{
 				Matches: make([]string, 0),
 				Count:   0,
@@ -85,7 +80,7 @@ func NewSearchFilesTool() (tool.Tool, error) {
 
 	t, err := functiontool.New(functiontool.Config{
 		Name:        "builtin_search_files",
-		Description: "Searches for files matching a pattern in a directory tree. Supports wildcards (* for any characters, ? for single character). Example: '*.go' finds all Go files.",
+		Description: "Searches for files matching a pattern in a directory tree. Supports wildcards (* for any characters, ? for single character). Example: '*.go' finds all Go files. Set all_roots to search every workspace root at once.",
 	}, handler)
 
 	if err == nil {
@@ -100,6 +95,70 @@ func NewSearchFilesTool() (tool.Tool, error) {
 	return t, err
 }
 
+// walkMatchingFiles calls keep for each file under root whose name matches
+// pattern, until keep returns false.
+func walkMatchingFiles(root, pattern string, keep func(path string) bool) error {
+	err := filepath.Walk(root, func(path string, info os.FileInfo, err error) error {
+		if err != nil {
+			return nil // Skip errors and continue
+		}
+		if info.IsDir() {
+			return nil
+		}
+
+		matched, err := filepath.Match(pattern, filepath.Base(path))
+		if err != nil {
+			return err
+		}
+
+		if matched && !keep(path) {
+			return filepath.SkipAll
+		}
+
+		return nil
+	})
+	if err == filepath.SkipAll {
+		return nil
+	}
+	return err
+}
+
+// searchFilesAllRoots walks the path in every workspace root concurrently
+// and keeps up to maxResults matches, primary root first.
+func searchFilesAllRoots(ctx context.Context, ws *workspace.Manager, input SearchFilesInput, maxResults int) SearchFilesOutput {
+	results, truncated := workspace.SearchRoots(ctx, ws, maxResults,
+		func(ctx context.Context, root workspace.WorkspaceRoot, budget *workspace.ResultBudget) ([]string, error) {
+			var matches []string
+			err := walkMatchingFiles(filepath.Join(root.Path, input.Path), input.Pattern, func(path string) bool {
+				if ctx.Err() != nil || !budget.Take() {
+					return false
+				}
+				matches = append(matches, workspace.HintedPath(root, path))
+				return true
+			})
+			return matches, err
+		})
+
+	matches := make([]string, 0)
+	for _, r := range results {
+		if r.Err != nil {
+			return SearchFilesOutput{
+				Matches: make([]string, 0),
+				Success: false,
+				Error:   fmt.Sprintf("Failed to search files in workspace %s: %v", r.Root.Name, r.Err),
+			}
+		}
+		matches = append(matches, r.Items...)
+	}
+
+	return SearchFilesOutput{
+		Matches:   matches,
+		Count:     len(matches),
+		Truncated: truncated,
+		Success:   true,
+	}
+}
+
 // init registers the search files tool automatically at package initialization.
 func init() {
 	_, _ = NewSearchFilesTool()
@@ -0,0 +1,262 @@
+package file
+
+import (
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"math"
+	"os"
+	"strings"
+	"unicode/utf8"
+)
+
+const (
+	sqliteMagic = "SQLite format 3\x00"
+	// maxSchemaPages bounds the b-tree pages read to list a schema
+	maxSchemaPages = 1000
+	// maxSchemaPayload bounds one schema record, overflow included
+	maxSchemaPayload = 64 * 1024
+	// maxSchemaSQL cuts the CREATE statements shown
+	maxSchemaSQL = 200
+)
+
+// sqliteFile reads the b-tree pages of a SQLite database directly, so the
+// schema can be listed without a driver and without taking locks.
+type sqliteFile struct {
+	f        *os.File
+	pageSize int
+	usable   int
+	pages    int // pages read so far
+}
+
+// sqliteDetails lists the tables, indexes and views in sqlite_master.
+func sqliteDetails(f *os.File, size int64) ([]string, error) {
+	var header [100]byte
+	if _, err := f.ReadAt(header[:], 0); err != nil {
+		return nil, err
+	}
+	db := &sqliteFile{f: f, pageSize: int(binary.BigEndian.Uint16(header[16:]))}
+	if db.pageSize == 1 {
+		db.pageSize = 65536
+	}
+	if db.pageSize < 512 || db.pageSize&(db.pageSize-1) != 0 {
+		return nil, fmt.Errorf("invalid page size %d", db.pageSize)
+	}
+	db.usable = db.pageSize - int(header[20])
+	if encoding := binary.BigEndian.Uint32(header[56:]); encoding > 1 {
+		return []string{fmt.Sprintf("page size %d, UTF-16 text encoding (schema not listed)", db.pageSize)}, nil
+	}
+
+	var tables, indexes, others []string
+	err := db.walk(1, func(record []any) {
+		if len(record) < 5 {
+			return
+		}
+		kind, _ := record[0].(string)
+		name, _ := record[1].(string)
+		table, _ := record[2].(string)
+		sql, _ := record[4].(string)
+		switch kind {
+		case "table":
+			if len(sql) > maxSchemaSQL {
+				cut := maxSchemaSQL
+				for cut > 0 && !utf8.RuneStart(sql[cut]) {
+					cut--
+				}
+				sql = sql[:cut] + "..."
+			}
+			tables = append(tables, fmt.Sprintf("table %s: %s", name, strings.Join(strings.Fields(sql), " ")))
+		case "index":
+			indexes = append(indexes, fmt.Sprintf("%s on %s", name, table))
+		default:
+			others = append(others, fmt.Sprintf("%s %s", kind, name))
+		}
+	})
+
+	details := []string{fmt.Sprintf("page size %d, %d pages, %d tables, %d indexes", db.pageSize, size/int64(db.pageSize), len(tables), len(indexes))}
+	if len(tables) > maxBinaryDetails {
+		tables = append(tables[:maxBinaryDetails], fmt.Sprintf("... and %d more tables", len(tables)-maxBinaryDetails))
+	}
+	details = append(details, tables...)
+	details = append(details, others...)
+	if len(indexes) > 0 {
+		if len(indexes) > maxBinaryDetails {
+			indexes = append(indexes[:maxBinaryDetails], fmt.Sprintf("... and %d more", len(indexes)-maxBinaryDetails))
+		}
+		details = append(details, "indexes: "+strings.Join(indexes, ", "))
+	}
+	return details, err
+}
+
+// readPage returns page n (1-based) and the offset of its b-tree header.
+func (db *sqliteFile) readPage(n uint32) ([]byte, int, error) {
+	if db.pages++; db.pages > maxSchemaPages {
+		return nil, 0, errors.New("schema too large to list")
+	}
+	page := make([]byte, db.pageSize)
+	if _, err := db.f.ReadAt(page, int64(n-1)*int64(db.pageSize)); err != nil {
+		return nil, 0, fmt.Errorf("page %d: %v", n, err)
+	}
+	if n == 1 {
+		return page, 100, nil // after the database header
+	}
+	return page, 0, nil
+}
+
+// walk calls fn with every record of the table b-tree rooted at page root.
+func (db *sqliteFile) walk(root uint32, fn func([]any)) error {
+	page, h, err := db.readPage(root)
+	if err != nil {
+		return err
+	}
+	cells := int(binary.BigEndian.Uint16(page[h+3:]))
+	if h+12+2*cells > len(page) {
+		return fmt.Errorf("page %d: bad cell count %d", root, cells)
+	}
+	switch page[h] {
+	case 0x05: // interior table page: child pointers, then the rightmost
+		for i := 0; i < cells; i++ {
+			cell := int(binary.BigEndian.Uint16(page[h+12+2*i:]))
+			if cell+4 > len(page) {
+				return fmt.Errorf("page %d: bad cell offset", root)
+			}
+			if err := db.walk(binary.BigEndian.Uint32(page[cell:]), fn); err != nil {
+				return err
+			}
+		}
+		return db.walk(binary.BigEndian.Uint32(page[h+8:]), fn)
+	case 0x0d: // leaf table page: records
+		for i := 0; i < cells; i++ {
+			cell := int(binary.BigEndian.Uint16(page[h+8+2*i:]))
+			payload, err := db.cellPayload(page, cell)
+			if err != nil {
+				return err
+			}
+			fn(parseRecord(payload))
+		}
+		return nil
+	}
+	return fmt.Errorf("page %d: unexpected page type %#x", root, page[h])
+}
+
+// cellPayload returns a leaf cell's record, following overflow pages.
+func (db *sqliteFile) cellPayload(page []byte, cell int) ([]byte, error) {
+	if cell >= len(page) {
+		return nil, errors.New("bad cell offset")
+	}
+	size, n := sqliteVarint(page[cell:])
+	_, m := sqliteVarint(page[cell+n:]) // rowid
+	start := cell + n + m
+	if size < 0 || start > len(page) {
+		return nil, errors.New("bad cell")
+	}
+
+	// Local payload size, per the file format's overflow rules
+	u := int64(db.usable)
+	local := size
+	if maxLocal := u - 35; size > maxLocal {
+		minLocal := (u-12)*32/255 - 23
+		local = minLocal + (size-minLocal)%(u-4)
+		if local > maxLocal {
+			local = minLocal
+		}
+	}
+	end := start + int(local)
+	if local < size {
+		end += 4 // the first overflow page number
+	}
+	if end > len(page) {
+		return nil, errors.New("cell overflows page")
+	}
+	payload := append([]byte(nil), page[start:start+int(local)]...)
+	if local == size {
+		return payload, nil
+	}
+
+	next := binary.BigEndian.Uint32(page[start+int(local):])
+	for next != 0 && int64(len(payload)) < size && len(payload) < maxSchemaPayload {
+		overflow, _, err := db.readPage(next)
+		if err != nil {
+			return nil, err
+		}
+		chunk := overflow[4:db.usable]
+		if rest := size - int64(len(payload)); int64(len(chunk)) > rest {
+			chunk = chunk[:rest]
+		}
+		payload = append(payload, chunk...)
+		next = binary.BigEndian.Uint32(overflow)
+	}
+	return payload, nil
+}
+
+// parseRecord decodes a record's columns; a truncated record yields the
+// columns it holds.
+func parseRecord(payload []byte) []any {
+	headerSize, n := sqliteVarint(payload)
+	// A corrupt 9-byte varint can be negative or point into itself
+	if headerSize < int64(n) || headerSize > int64(len(payload)) {
+		return nil
+	}
+	var types []int64
+	for pos := n; pos < int(headerSize); {
+		t, m := sqliteVarint(payload[pos:])
+		types = append(types, t)
+		pos += m
+	}
+
+	var values []any
+	body := payload[headerSize:]
+	for _, t := range types {
+		var size int
+		switch {
+		case t >= 1 && t <= 4:
+			size = int(t)
+		case t == 5:
+			size = 6
+		case t == 6 || t == 7:
+			size = 8
+		case t >= 12:
+			size = int(t-12) / 2
+		}
+		if size > len(body) {
+			break
+		}
+		field := body[:size]
+		body = body[size:]
+		switch {
+		case t == 0:
+			values = append(values, nil)
+		case t >= 1 && t <= 6:
+			var v int64
+			for _, c := range field {
+				v = v<<8 | int64(c)
+			}
+			shift := 64 - 8*uint(size) // sign-extend
+			values = append(values, v<<shift>>shift)
+		case t == 7:
+			values = append(values, math.Float64frombits(binary.BigEndian.Uint64(field)))
+		case t == 8, t == 9:
+			values = append(values, t-8)
+		case t >= 13 && t%2 == 1:
+			values = append(values, string(field))
+		default:
+			values = append(values, field)
+		}
+	}
+	return values
+}
+
+// sqliteVarint decodes a SQLite big-endian varint of up to 9 bytes.
+func sqliteVarint(b []byte) (int64, int) {
+	var v int64
+	for i := 0; i < 9 && i < len(b); i++ {
+		if i == 8 {
+			return v<<8 | int64(b[i]), 9
+		}
+		v = v<<7 | int64(b[i]&0x7f)
+		if b[i]&0x80 == 0 {
+			return v, i + 1
+		}
+	}
+	return v, len(b)
+}
@@ -92,6 +92,9 @@ func NewWriteFileTool() (tool.Tool, error) {
 			err = AtomicWrite(input.Path, []byte(input.Content), 0644)
 		} else {
 			err = os.WriteFile(input.Path, []byte(input.Content), 0644)
+			if err == nil {
+				common.NotifyFileWrite(input.Path)
+			}
 		}
 
 		if err != nil {
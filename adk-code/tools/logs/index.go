@@ -0,0 +1,101 @@
+package logs
+
+import (
+	"os"
+	"path/filepath"
+	"sort"
+	"sync"
+	"time"
+)
+
+const (
+	// maxIndexedLogs bounds the number of files with a kept offset index
+	maxIndexedLogs = 32
+	// maxIndexPoints bounds one file's index; further points are dropped
+	maxIndexPoints = 8192
+)
+
+// indexPoint is a line start and the timestamp of that line.
+type indexPoint struct {
+	offset int64
+	ts     time.Time
+}
+
+// offsetIndex is a sparse map from byte offsets to line timestamps for one
+// file, filled in by every search so later searches start closer to their
+// window. Callers hold mu while using it.
+type offsetIndex struct {
+	mu      sync.Mutex
+	size    int64
+	modTime time.Time
+	format  timeFormat
+	points  []indexPoint // sorted by offset
+}
+
+var (
+	logIndexesMu sync.Mutex
+	logIndexes   = make(map[string]*offsetIndex)
+)
+
+// indexFor returns the offset index of the file at path, locked. An index
+// survives appends to the file but is reset when the file shrinks or is
+// rewritten in place.
+func indexFor(path string, info os.FileInfo) *offsetIndex {
+	if abs, err := filepath.Abs(path); err == nil {
+		path = abs
+	}
+	logIndexesMu.Lock()
+	idx, ok := logIndexes[path]
+	if !ok {
+		if len(logIndexes) >= maxIndexedLogs {
+			for k := range logIndexes {
+				delete(logIndexes, k)
+				break
+			}
+		}
+		idx = &offsetIndex{}
+		logIndexes[path] = idx
+	}
+	logIndexesMu.Unlock()
+
+	idx.mu.Lock()
+	switch {
+	case info.Size() > idx.size:
+		// Appended to; what is indexed is still there
+	case info.Size() == idx.size && info.ModTime().Equal(idx.modTime):
+	default:
+		idx.points, idx.format = nil, formatUnknown
+	}
+	idx.size, idx.modTime = info.Size(), info.ModTime()
+	return idx
+}
+
+// add records that the line starting at offset has timestamp ts.
+func (idx *offsetIndex) add(offset int64, ts time.Time) {
+	i := sort.Search(len(idx.points), func(i int) bool { return idx.points[i].offset >= offset })
+	if i < len(idx.points) && idx.points[i].offset == offset {
+		return
+	}
+	if len(idx.points) >= maxIndexPoints {
+		return
+	}
+	idx.points = append(idx.points, indexPoint{})
+	copy(idx.points[i+1:], idx.points[i:])
+	idx.points[i] = indexPoint{offset: offset, ts: ts}
+}
+
+// bounds narrows a search for the first line at or after from to
+// [lo, hi): lo is the last indexed line before from, hi the first indexed
+// line at or after it.
+func (idx *offsetIndex) bounds(from time.Time, size int64) (lo, hi int64) {
+	hi = size
+	for _, p := range idx.points {
+		if p.ts.Before(from) {
+			lo = p.offset
+		} else {
+			hi = p.offset
+			break
+		}
+	}
+	return lo, hi
+}
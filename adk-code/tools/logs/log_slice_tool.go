@@ -0,0 +1,145 @@
+// Package logs provides log investigation tools for the coding agent.
+package logs
+
+import (
+	"fmt"
+	"regexp"
+
+	"google.golang.org/adk/tool"
+	"google.golang.org/adk/tool/functiontool"
+
+	"adk-code/internal/compressed"
+	common "adk-code/tools/base"
+)
+
+const (
+	defaultSliceMatches = 200
+	defaultSliceBytes   = 50_000
+)
+
+// LogSliceInput defines the input parameters for slicing a log by time.
+type LogSliceInput struct {
+	// Path is the log file to search.
+	Path string `json:"path" jsonschema:"Path to the log file"`
+	// From is the start of the time window.
+	From string `json:"from,omitempty" jsonschema:"Window start: RFC3339, '2006-01-02 15:04[:05]', '15:04[:05]' on the day of the last entry, or '-15m' before the last entry (default: start of file)"`
+	// To is the end of the time window, inclusive.
+	To string `json:"to,omitempty" jsonschema:"Window end, inclusive, in the same forms as from (default: end of file)"`
+	// Level is the minimum severity to keep.
+	Level string `json:"level,omitempty" jsonschema:"Minimum level to keep: trace, debug, info, warn, error or fatal (default: all lines)"`
+	// Pattern is a regular expression entries must match.
+	Pattern string `json:"pattern,omitempty" jsonschema:"Regular expression (RE2) entries must match (optional)"`
+	// MaxMatches limits the entries returned.
+	MaxMatches *int `json:"max_matches,omitempty" jsonschema:"Maximum entries to return (default: 200)"`
+	// MaxBytes limits the content returned.
+	MaxBytes *int `json:"max_bytes,omitempty" jsonschema:"Maximum bytes of content to return (default: 50000)"`
+	// ResumeOffset continues a truncated slice.
+	ResumeOffset *int64 `json:"resume_offset,omitempty" jsonschema:"next_offset from a truncated result, to continue where it stopped"`
+}
+
+// LogSliceOutput defines the output of slicing a log by time.
+type LogSliceOutput struct {
+	// Content is the matching entries, continuation lines included.
+	Content string `json:"content"`
+	// Matches is the number of timestamped entries returned.
+	Matches int `json:"matches"`
+	// Format is the detected timestamp format.
+	Format string `json:"format,omitempty"`
+	// StartOffset is the byte offset of the window's first line.
+	StartOffset int64 `json:"start_offset"`
+	// NextOffset is where a truncated slice continues (pass as resume_offset).
+	NextOffset int64 `json:"next_offset,omitempty"`
+	// Truncated reports whether a budget cut the window short.
+	Truncated bool `json:"truncated,omitempty"`
+	// Success indicates whether the operation was successful.
+	Success bool `json:"success"`
+	// Error contains error message if the operation failed.
+	Error string `json:"error,omitempty"`
+}
+
+// NewLogSliceTool creates a tool that returns the lines of a log file in a
+// time window, finding the window by binary search over byte offsets.
+func NewLogSliceTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input LogSliceInput) LogSliceOutput {
+		if format, _ := compressed.Sniff(input.Path); format != compressed.None {
+			return LogSliceOutput{
+				Success: false,
+				Error:   fmt.Sprintf("%s is %s compressed and cannot be searched by offset; use builtin_grep_search or builtin_read_file on it", input.Path, format),
+			}
+		}
+
+		q := sliceQuery{maxMatches: defaultSliceMatches, maxBytes: defaultSliceBytes, resumeAt: -1}
+		if input.MaxMatches != nil && *input.MaxMatches > 0 {
+			q.maxMatches = *input.MaxMatches
+		}
+		if input.MaxBytes != nil && *input.MaxBytes > 0 {
+			q.maxBytes = *input.MaxBytes
+		}
+		if input.ResumeOffset != nil && *input.ResumeOffset >= 0 {
+			q.resumeAt = *input.ResumeOffset
+		}
+		var err error
+		if q.minLevel, err = parseLevel(input.Level); err != nil {
+			return LogSliceOutput{Success: false, Error: err.Error()}
+		}
+		if input.Pattern != "" {
+			if q.pattern, err = regexp.Compile(input.Pattern); err != nil {
+				return LogSliceOutput{Success: false, Error: fmt.Sprintf("Invalid pattern: %v", err)}
+			}
+		}
+
+		lf, err := openLog(input.Path)
+		if err != nil {
+			return LogSliceOutput{Success: false, Error: fmt.Sprintf("Cannot slice %s: %v", input.Path, err)}
+		}
+		defer lf.close()
+
+		if q.from, err = parseWindowTime(input.From, lf.lastTime); err != nil {
+			return LogSliceOutput{Success: false, Error: fmt.Sprintf("Invalid from: %v", err)}
+		}
+		if q.to, err = parseWindowTime(input.To, lf.lastTime); err != nil {
+			return LogSliceOutput{Success: false, Error: fmt.Sprintf("Invalid to: %v", err)}
+		}
+		if q.resumeAt > lf.size {
+			return LogSliceOutput{Success: false, Error: fmt.Sprintf("resume_offset %d is past the end of the file (%d bytes)", q.resumeAt, lf.size)}
+		}
+
+		result := lf.slice(q)
+		return LogSliceOutput{
+			Content:     result.content,
+			Matches:     result.matches,
+			Format:      result.format.String(),
+			StartOffset: result.startOffset,
+			NextOffset:  result.nextOffset,
+			Truncated:   result.truncated,
+			Success:     true,
+		}
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name: "builtin_log_slice",
+		Description: `Returns the entries of a log file within a time window, optionally filtered by level and regex. The window is found by binary search over byte offsets, and offsets learned are cached per file, so it takes milliseconds even on multi-GB logs. Use it instead of paging through logs with offset/limit.
+
+**Timestamps:** RFC3339/ISO 8601 (also "2006-01-02 15:04:05,000" and "2006/01/02 15:04:05"), syslog ("Jan  2 15:04:05"), and JSON lines with a ts, time, timestamp or @timestamp field (RFC3339 or epoch). Lines without a timestamp, such as stack traces, stay with the entry above them.
+
+**Example:** errors between 14:02 and 14:05 on the log's last day: path="/var/log/app.log", from="14:02", to="14:05", level="error"
+
+If truncated, call again with resume_offset=next_offset.`,
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategorySearchDiscovery,
+			Priority:  2,
+			UsageHint: "Log lines in a time window with level/regex filters, fast on huge files",
+		})
+	}
+
+	return t, err
+}
+
+// init registers the log tools automatically at package initialization.
+func init() {
+	_, _ = NewLogSliceTool()
+}
@@ -0,0 +1,177 @@
+package logs
+
+import (
+	"bufio"
+	"fmt"
+	"os"
+	"path/filepath"
+	"regexp"
+	"strings"
+	"testing"
+	"time"
+)
+
+// writeLog writes one entry per second from base, every tenth an ERROR
+// followed by a stack trace line.
+func writeLog(t *testing.T, path string, base time.Time, entries int) {
+	t.Helper()
+	f, err := os.Create(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	w := bufio.NewWriter(f)
+	for i := 0; i < entries; i++ {
+		ts := base.Add(time.Duration(i) * time.Second).Format(time.RFC3339)
+		if i%10 == 0 {
+			fmt.Fprintf(w, "%s ERROR request %d failed\n\tat handler.go:42\n", ts, i)
+		} else {
+			fmt.Fprintf(w, "%s INFO request %d ok\n", ts, i)
+		}
+	}
+	w.Flush()
+	f.Close()
+}
+
+func TestParseTimestamps(t *testing.T) {
+	modTime := time.Date(2024, 1, 10, 0, 0, 0, 0, time.UTC)
+	cases := []struct {
+		format timeFormat
+		line   string
+		want   time.Time
+	}{
+		{formatISO, "2024-03-01T14:02:03.5Z INFO ok", time.Date(2024, 3, 1, 14, 2, 3, 5e8, time.UTC)},
+		{formatISO, "[2024-03-01 14:02:03,250] WARN slow", time.Date(2024, 3, 1, 14, 2, 3, 25e7, time.UTC)},
+		{formatISO, "2024/03/01 14:02:03 +0100 started", time.Date(2024, 3, 1, 13, 2, 3, 0, time.UTC)},
+		{formatSyslog, "Jan  9 08:00:01 host sshd[1]: ok", time.Date(2024, 1, 9, 8, 0, 1, 0, time.UTC)},
+		{formatSyslog, "Dec 31 23:59:59 host cron: ok", time.Date(2023, 12, 31, 23, 59, 59, 0, time.UTC)},
+		{formatJSON, `{"level":"error","ts":1709301723.5,"msg":"x"}`, time.Date(2024, 3, 1, 14, 2, 3, 5e8, time.UTC)},
+		{formatJSON, `{"@timestamp":"2024-03-01T14:02:03Z"}`, time.Date(2024, 3, 1, 14, 2, 3, 0, time.UTC)},
+	}
+	for _, c := range cases {
+		p := timeParser{format: c.format, loc: time.UTC, modTime: modTime}
+		got, ok := p.parse([]byte(c.line))
+		if !ok || !got.Equal(c.want) {
+			t.Errorf("parse(%q) = %v, %v; want %v", c.line, got, ok, c.want)
+		}
+		if f := detectFormat([]byte(c.line)); f != c.format {
+			t.Errorf("detectFormat(%q) = %v, want %v", c.line, f, c.format)
+		}
+	}
+}
+
+func TestSliceFindsWindowByBinarySearch(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "app.log")
+	base := time.Date(2024, 3, 1, 12, 0, 0, 0, time.UTC)
+	writeLog(t, path, base, 20000)
+
+	lf, err := openLog(path)
+	if err != nil {
+		t.Fatalf("openLog failed: %v", err)
+	}
+	q := sliceQuery{
+		from:       base.Add(2*time.Hour + 2*time.Minute),
+		to:         base.Add(2*time.Hour + 3*time.Minute),
+		minLevel:   levelError,
+		maxMatches: 100,
+		maxBytes:   10000,
+		resumeAt:   -1,
+	}
+	result := lf.slice(q)
+	indexed := len(lf.idx.points)
+	lf.close()
+
+	lines := strings.Split(strings.TrimSpace(result.content), "\n")
+	if result.matches != 7 || len(lines) != 14 || result.truncated {
+		t.Fatalf("expected 7 errors with their stack lines, got %d:\n%s", result.matches, result.content)
+	}
+	if !strings.HasPrefix(lines[0], "2024-03-01T14:02:00Z ERROR request 7320") || lines[1] != "\tat handler.go:42" {
+		t.Errorf("unexpected first entry %q %q", lines[0], lines[1])
+	}
+	if result.startOffset == 0 || indexed == 0 {
+		t.Errorf("expected a binary search to start mid-file and fill the index, got offset %d, %d points", result.startOffset, indexed)
+	}
+
+	// A later call reuses the index and narrows the window
+	lf, _ = openLog(path)
+	lo, hi := lf.idx.bounds(q.from, lf.size)
+	lf.close()
+	if hi-lo > linearScanBytes*2 {
+		t.Errorf("expected the index to bracket the window, got [%d, %d)", lo, hi)
+	}
+}
+
+func TestSliceBudgetsAndResume(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "app.log")
+	base := time.Date(2024, 3, 1, 12, 0, 0, 0, time.UTC)
+	writeLog(t, path, base, 100)
+
+	lf, err := openLog(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer lf.close()
+	q := sliceQuery{pattern: regexp.MustCompile(`request \d*5 `), maxMatches: 3, maxBytes: 10000, resumeAt: -1}
+	first := lf.slice(q)
+	if first.matches != 3 || !first.truncated || first.nextOffset == 0 {
+		t.Fatalf("expected 3 matches then truncation, got %+v", first)
+	}
+	q.resumeAt = first.nextOffset
+	second := lf.slice(q)
+	if !strings.HasPrefix(second.content, "2024-03-01T12:00:35Z INFO request 35 ok") {
+		t.Errorf("expected the resumed slice to continue at request 35, got:\n%s", second.content)
+	}
+}
+
+func TestSliceCutsEntryLargerThanBudget(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "app.log")
+	huge := "2024-03-01T12:00:00Z INFO " + strings.Repeat("x", 2000) + "\n\tat handler.go:42\n"
+	if err := os.WriteFile(path, []byte(huge+"2024-03-01T12:00:01Z INFO small\n"), 0644); err != nil {
+		t.Fatal(err)
+	}
+
+	lf, err := openLog(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer lf.close()
+	q := sliceQuery{maxMatches: 10, maxBytes: 500, resumeAt: -1}
+	first := lf.slice(q)
+	if first.matches != 1 || !first.truncated || len(first.content) != 501 {
+		t.Fatalf("expected the entry cut to the budget, got %d matches, %d bytes", first.matches, len(first.content))
+	}
+
+	// Resuming moves past the oversized entry instead of returning it again
+	q.resumeAt = first.nextOffset
+	second := lf.slice(q)
+	if second.content != "2024-03-01T12:00:01Z INFO small\n" || second.truncated {
+		t.Errorf("expected the resumed slice to reach the next entry, got %+v", second)
+	}
+}
+
+func TestParseWindowTime(t *testing.T) {
+	last := time.Date(2024, 3, 1, 14, 30, 0, 0, time.Local)
+	ref := func() (time.Time, bool) { return last, true }
+	cases := map[string]time.Time{
+		"14:02":                time.Date(2024, 3, 1, 14, 2, 0, 0, time.Local),
+		"-15m":                 last.Add(-15 * time.Minute),
+		"2024-02-29 23:00":     time.Date(2024, 2, 29, 23, 0, 0, 0, time.Local),
+		"2024-03-01T10:00:00Z": time.Date(2024, 3, 1, 10, 0, 0, 0, time.UTC),
+	}
+	for in, want := range cases {
+		got, err := parseWindowTime(in, ref)
+		if err != nil || !got.Equal(want) {
+			t.Errorf("parseWindowTime(%q) = %v, %v; want %v", in, got, err, want)
+		}
+	}
+	if _, err := parseWindowTime("yesterday", ref); err == nil {
+		t.Error("expected an error for an unrecognized time")
+	}
+}
+
+func TestLineLevel(t *testing.T) {
+	if lineLevel([]byte("2024-03-01 12:00:00 WARN disk")) != levelWarn ||
+		lineLevel([]byte(`{"ts":1,"msg":"`+strings.Repeat("x", 200)+`","level":"error"}`)) != levelError ||
+		lineLevel([]byte("2024-03-01 12:00:00 "+strings.Repeat("x", 100)+" error in message")) != levelNone {
+		t.Error("unexpected levels")
+	}
+}
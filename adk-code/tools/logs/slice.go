@@ -0,0 +1,394 @@
+package logs
+
+import (
+	"bufio"
+	"bytes"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"regexp"
+	"strings"
+	"time"
+	"unicode/utf8"
+)
+
+const (
+	// probeChunk is how much a binary search probe reads at a time
+	probeChunk = 64 * 1024
+	// maxProbeBytes is how far a probe looks for a timestamped line
+	maxProbeBytes = 1024 * 1024
+	// linearScanBytes ends the binary search; the rest is scanned
+	linearScanBytes = 64 * 1024
+	// indexStride is how often a linear scan records an index point
+	indexStride = 256 * 1024
+	// maxScanBytes bounds the bytes one call scans within its window
+	maxScanBytes = 512 * 1024 * 1024
+	// maxLineBytes cuts pathologically long lines
+	maxLineBytes = 64 * 1024
+)
+
+// sliceQuery selects the lines of a log window.
+type sliceQuery struct {
+	from, to   time.Time // zero means unbounded
+	minLevel   int       // 0 keeps every line
+	pattern    *regexp.Regexp
+	maxMatches int
+	maxBytes   int
+	resumeAt   int64 // resume a truncated slice at this offset, or -1
+}
+
+// sliceResult is a log window.
+type sliceResult struct {
+	content     string
+	matches     int
+	format      timeFormat
+	startOffset int64
+	nextOffset  int64 // where a truncated slice continues
+	truncated   bool
+}
+
+// logFile is an open log being searched, with its index locked.
+type logFile struct {
+	f      *os.File
+	size   int64
+	parser timeParser
+	idx    *offsetIndex
+	buf    []byte
+}
+
+// openLog opens path and detects its timestamp format, reusing the format
+// and offset index learned by earlier calls.
+func openLog(path string) (*logFile, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	info, err := f.Stat()
+	if err != nil {
+		f.Close()
+		return nil, err
+	}
+	if info.IsDir() {
+		f.Close()
+		return nil, fmt.Errorf("%s is a directory", path)
+	}
+
+	lf := &logFile{f: f, size: info.Size(), idx: indexFor(path, info), buf: make([]byte, probeChunk)}
+	lf.parser = timeParser{loc: time.Local, modTime: info.ModTime()}
+	if lf.idx.format == formatUnknown {
+		n, _ := f.ReadAt(lf.buf, 0)
+		lf.idx.format = detectFormat(lf.buf[:n])
+	}
+	lf.parser.format = lf.idx.format
+	if lf.parser.format == formatUnknown {
+		lf.close()
+		return nil, errors.New("no RFC3339, syslog or JSON timestamps found in the first 64KB")
+	}
+	return lf, nil
+}
+
+func (lf *logFile) close() {
+	lf.idx.mu.Unlock()
+	lf.f.Close()
+}
+
+// timeAt returns the first timestamped line starting after offset (or at
+// it, for offset 0) and before limit.
+func (lf *logFile) timeAt(offset, limit int64) (int64, time.Time, bool) {
+	start := offset
+	atLineStart := offset == 0
+	for start < limit && start-offset < maxProbeBytes {
+		n, err := lf.f.ReadAt(lf.buf, start)
+		if n == 0 {
+			break
+		}
+		chunk := lf.buf[:n]
+		pos := 0
+		if !atLineStart {
+			nl := bytes.IndexByte(chunk, '\n')
+			if nl < 0 {
+				start += int64(n)
+				continue
+			}
+			pos, atLineStart = nl+1, true
+		}
+		for pos < n {
+			end := bytes.IndexByte(chunk[pos:], '\n')
+			if end < 0 && err == nil {
+				if pos == 0 {
+					// A line longer than the chunk: try its start, then
+					// skip the rest of it
+					if ts, ok := lf.parser.parse(chunk); ok {
+						lf.idx.add(start, ts)
+						return start, ts, true
+					}
+					pos, atLineStart = n, false
+				}
+				break // reread a partial line from its start
+			}
+			if end < 0 {
+				end = n - pos // the file's last line
+			}
+			lineStart := start + int64(pos)
+			if lineStart >= limit {
+				return 0, time.Time{}, false
+			}
+			if ts, ok := lf.parser.parse(chunk[pos : pos+end]); ok {
+				lf.idx.add(lineStart, ts)
+				return lineStart, ts, true
+			}
+			pos += end + 1
+		}
+		if err != nil {
+			break
+		}
+		start += int64(pos)
+	}
+	return 0, time.Time{}, false
+}
+
+// findStart returns a line start at or before the first line stamped at or
+// after from, binary searching by byte offset within the index's bounds.
+func (lf *logFile) findStart(from time.Time) int64 {
+	if from.IsZero() {
+		return 0
+	}
+	lo, hi := lf.idx.bounds(from, lf.size)
+	for hi-lo > linearScanBytes {
+		mid := lo + (hi-lo)/2
+		lineStart, ts, ok := lf.timeAt(mid, hi)
+		switch {
+		case !ok:
+			hi = mid
+		case ts.Before(from):
+			lo = lineStart
+		default:
+			hi = mid
+		}
+	}
+	return lo
+}
+
+// lastTime returns the timestamp of the file's last stamped line, looking
+// back at most maxProbeBytes from the end.
+func (lf *logFile) lastTime() (time.Time, bool) {
+	for back := int64(probeChunk); ; back *= 4 {
+		offset := lf.size - back
+		if offset < 0 {
+			offset = 0
+		}
+		tail := make([]byte, lf.size-offset)
+		n, _ := lf.f.ReadAt(tail, offset)
+		lines := bytes.Split(tail[:n], []byte{'\n'})
+		first := 0
+		if offset > 0 {
+			first = 1 // partial line
+		}
+		for i := len(lines) - 1; i >= first; i-- {
+			if ts, ok := lf.parser.parse(lines[i]); ok {
+				return ts, true
+			}
+		}
+		if offset == 0 || back >= maxProbeBytes {
+			return time.Time{}, false
+		}
+	}
+}
+
+// slice scans the window from its start, keeping lines that pass the
+// filters. Lines without a timestamp (stack traces, wrapped messages)
+// belong to the entry above them.
+func (lf *logFile) slice(q sliceQuery) sliceResult {
+	start := q.resumeAt
+	if start < 0 {
+		start = lf.findStart(q.from)
+	}
+	result := sliceResult{format: lf.parser.format, startOffset: start}
+
+	r := bufio.NewReaderSize(io.NewSectionReader(lf.f, start, lf.size-start), probeChunk)
+	var out strings.Builder
+	offset := start
+	nextIndex := start + indexStride
+	inWindow := q.from.IsZero() || q.resumeAt >= 0
+	keepEntry := false
+	var line []byte
+
+	for {
+		lineStart := offset
+		line = line[:0]
+		var err error
+		for {
+			var chunk []byte
+			chunk, err = r.ReadSlice('\n')
+			offset += int64(len(chunk))
+			if len(line) < maxLineBytes {
+				line = append(line, chunk...)
+			}
+			if err != bufio.ErrBufferFull {
+				break
+			}
+		}
+		if len(line) == 0 && err != nil {
+			break
+		}
+		text := bytes.TrimRight(line, "\r\n")
+
+		if ts, ok := lf.parser.parse(text); ok {
+			if lineStart >= nextIndex {
+				lf.idx.add(lineStart, ts)
+				nextIndex = lineStart + indexStride
+			}
+			if !inWindow && !ts.Before(q.from) {
+				inWindow = true
+				result.startOffset = lineStart
+			}
+			if !q.to.IsZero() && ts.After(q.to) {
+				break
+			}
+			keepEntry = inWindow && q.keep(text)
+			if keepEntry {
+				if out.Len() == 0 && len(text) > q.maxBytes && result.matches < q.maxMatches {
+					// An entry larger than the whole budget is cut, and the
+					// slice resumes past it instead of stopping on it forever
+					result.matches++
+					out.Write(cutAtRune(text, q.maxBytes))
+					out.WriteByte('\n')
+					result.truncated, result.nextOffset = true, offset
+					break
+				}
+				if result.matches == q.maxMatches || out.Len()+len(text) > q.maxBytes {
+					result.truncated, result.nextOffset = true, lineStart
+					break
+				}
+				result.matches++
+			}
+		} else if keepEntry && out.Len()+len(text) > q.maxBytes {
+			result.truncated, result.nextOffset = true, lineStart
+			break
+		}
+
+		if keepEntry {
+			out.Write(text)
+			out.WriteByte('\n')
+		}
+		if offset-start > maxScanBytes {
+			result.truncated, result.nextOffset = true, offset
+			break
+		}
+		if err != nil {
+			break
+		}
+	}
+	result.content = out.String()
+	return result
+}
+
+// cutAtRune returns the first n bytes of text, backing off to a UTF-8
+// rune boundary.
+func cutAtRune(text []byte, n int) []byte {
+	if n >= len(text) {
+		return text
+	}
+	for n > 0 && !utf8.RuneStart(text[n]) {
+		n--
+	}
+	return text[:n]
+}
+
+// keep applies the level and pattern filters to a timestamped line.
+func (q sliceQuery) keep(line []byte) bool {
+	if q.minLevel > 0 && lineLevel(line) < q.minLevel {
+		return false
+	}
+	return q.pattern == nil || q.pattern.Match(line)
+}
+
+// Log levels, in increasing severity
+const (
+	levelNone = iota
+	levelTrace
+	levelDebug
+	levelInfo
+	levelWarn
+	levelError
+	levelFatal
+)
+
+var (
+	levelPattern = regexp.MustCompile(`(?i)\b(trace|debug|info|warn|warning|err|error|fatal|crit|critical|panic)\b`)
+	levelNames   = map[string]int{
+		"trace": levelTrace, "debug": levelDebug, "info": levelInfo,
+		"warn": levelWarn, "warning": levelWarn,
+		"err": levelError, "error": levelError,
+		"fatal": levelFatal, "crit": levelFatal, "critical": levelFatal, "panic": levelFatal,
+	}
+)
+
+// maxLevelPrefix is how far into a text line the level is looked for, so
+// words in the message are not taken for it. JSON lines are searched whole.
+const maxLevelPrefix = 96
+
+// lineLevel returns the severity named in line, or levelNone.
+func lineLevel(line []byte) int {
+	if len(line) > maxLevelPrefix && line[0] != '{' {
+		line = line[:maxLevelPrefix]
+	}
+	m := levelPattern.Find(line)
+	if m == nil {
+		return levelNone
+	}
+	return levelNames[strings.ToLower(string(m))]
+}
+
+// parseLevel parses a level filter name.
+func parseLevel(name string) (int, error) {
+	if name == "" {
+		return levelNone, nil
+	}
+	level, ok := levelNames[strings.ToLower(name)]
+	if !ok {
+		return 0, fmt.Errorf("unknown level %q (use trace, debug, info, warn, error or fatal)", name)
+	}
+	return level, nil
+}
+
+// parseWindowTime parses a window bound. Besides RFC3339 and zoneless
+// dates, it accepts a time of day on the date of ref, the file's last entry,
+// and "-15m" style offsets before ref.
+func parseWindowTime(s string, ref func() (time.Time, bool)) (time.Time, error) {
+	s = strings.TrimSpace(s)
+	if s == "" {
+		return time.Time{}, nil
+	}
+	if strings.HasPrefix(s, "-") {
+		d, err := time.ParseDuration(s[1:])
+		if err != nil {
+			return time.Time{}, fmt.Errorf("invalid offset %q: %v", s, err)
+		}
+		last, ok := ref()
+		if !ok {
+			return time.Time{}, errors.New("no timestamped line to offset from")
+		}
+		return last.Add(-d), nil
+	}
+	if t, err := time.Parse(time.RFC3339Nano, s); err == nil {
+		return t, nil
+	}
+	for _, layout := range []string{"2006-01-02 15:04:05", "2006-01-02T15:04:05", "2006-01-02 15:04", "2006-01-02T15:04", "2006-01-02"} {
+		if t, err := time.ParseInLocation(layout, s, time.Local); err == nil {
+			return t, nil
+		}
+	}
+	for _, layout := range []string{"15:04:05", "15:04"} {
+		if clock, err := time.Parse(layout, s); err == nil {
+			last, ok := ref()
+			if !ok {
+				return time.Time{}, errors.New("no timestamped line to take the date from")
+			}
+			last = last.In(time.Local)
+			return time.Date(last.Year(), last.Month(), last.Day(), clock.Hour(), clock.Minute(), clock.Second(), 0, time.Local), nil
+		}
+	}
+	return time.Time{}, fmt.Errorf("unrecognized time %q (use RFC3339, 2006-01-02 15:04, 15:04 or -15m)", s)
+}
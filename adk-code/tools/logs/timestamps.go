@@ -0,0 +1,199 @@
+package logs
+
+import (
+	"bytes"
+	"regexp"
+	"strconv"
+	"time"
+)
+
+// timeFormat is a timestamp format recognized at the start of log lines.
+type timeFormat int
+
+const (
+	formatUnknown timeFormat = iota
+	// formatISO covers RFC3339 and "2006-01-02 15:04:05[.000]" with an
+	// optional zone, and Go's log package "2006/01/02 15:04:05"
+	formatISO
+	// formatSyslog is "Jan _2 15:04:05", which has no year
+	formatSyslog
+	// formatJSON is a JSON object with a ts, time, timestamp or @timestamp
+	// field holding an RFC3339 string or epoch seconds or milliseconds
+	formatJSON
+)
+
+// String names the format for tool output.
+func (f timeFormat) String() string {
+	switch f {
+	case formatISO:
+		return "iso8601"
+	case formatSyslog:
+		return "syslog"
+	case formatJSON:
+		return "json"
+	default:
+		return "unknown"
+	}
+}
+
+// maxTimestampPrefix is how far into a line a text timestamp may start,
+// allowing for a level or bracket before it.
+const maxTimestampPrefix = 48
+
+var (
+	isoPattern    = regexp.MustCompile(`(\d{4})[-/](\d{2})[-/](\d{2})[T ](\d{2}):(\d{2}):(\d{2})(?:[.,](\d{1,9}))?\s?(Z|[+-]\d{2}:?\d{2})?`)
+	syslogPattern = regexp.MustCompile(`^(Jan|Feb|Mar|Apr|May|Jun|Jul|Aug|Sep|Oct|Nov|Dec) {1,2}(\d{1,2}) (\d{2}):(\d{2}):(\d{2})`)
+	jsonTimeKeys  = [][]byte{[]byte(`"ts"`), []byte(`"time"`), []byte(`"timestamp"`), []byte(`"@timestamp"`)}
+)
+
+var months = map[string]time.Month{
+	"Jan": time.January, "Feb": time.February, "Mar": time.March, "Apr": time.April,
+	"May": time.May, "Jun": time.June, "Jul": time.July, "Aug": time.August,
+	"Sep": time.September, "Oct": time.October, "Nov": time.November, "Dec": time.December,
+}
+
+// timeParser parses timestamps of one file. Zoneless times are read in loc,
+// and syslog times, which have no year, are placed in the year that puts
+// them at or before the file's modification time.
+type timeParser struct {
+	format  timeFormat
+	loc     *time.Location
+	modTime time.Time
+}
+
+// detectFormat returns the format of the first line in sample that has a
+// recognizable timestamp.
+func detectFormat(sample []byte) timeFormat {
+	for _, line := range bytes.Split(sample, []byte{'\n'}) {
+		for _, f := range []timeFormat{formatJSON, formatISO, formatSyslog} {
+			p := timeParser{format: f, loc: time.UTC, modTime: time.Now()}
+			if _, ok := p.parse(line); ok {
+				return f
+			}
+		}
+	}
+	return formatUnknown
+}
+
+// parse returns the timestamp at the start of line.
+func (p *timeParser) parse(line []byte) (time.Time, bool) {
+	switch p.format {
+	case formatISO:
+		return p.parseISO(line)
+	case formatSyslog:
+		return p.parseSyslog(line)
+	case formatJSON:
+		return p.parseJSON(line)
+	}
+	return time.Time{}, false
+}
+
+func (p *timeParser) parseISO(line []byte) (time.Time, bool) {
+	if len(line) > maxTimestampPrefix+40 {
+		line = line[:maxTimestampPrefix+40]
+	}
+	m := isoPattern.FindSubmatchIndex(line)
+	if m == nil || m[0] > maxTimestampPrefix {
+		return time.Time{}, false
+	}
+	num := func(i int) int {
+		n, _ := strconv.Atoi(string(line[m[2*i]:m[2*i+1]]))
+		return n
+	}
+	nsec := 0
+	if m[14] >= 0 {
+		frac := string(line[m[14]:m[15]])
+		n, _ := strconv.Atoi(frac)
+		for i := len(frac); i < 9; i++ {
+			n *= 10
+		}
+		nsec = n
+	}
+	loc := p.loc
+	if m[16] >= 0 {
+		loc = parseZone(line[m[16]:m[17]])
+	}
+	return time.Date(num(1), time.Month(num(2)), num(3), num(4), num(5), num(6), nsec, loc), true
+}
+
+func parseZone(zone []byte) *time.Location {
+	if len(zone) == 1 {
+		return time.UTC
+	}
+	digits := bytes.ReplaceAll(zone[1:], []byte(":"), nil)
+	hours, _ := strconv.Atoi(string(digits[:2]))
+	minutes, _ := strconv.Atoi(string(digits[2:]))
+	offset := hours*3600 + minutes*60
+	if zone[0] == '-' {
+		offset = -offset
+	}
+	return time.FixedZone("", offset)
+}
+
+func (p *timeParser) parseSyslog(line []byte) (time.Time, bool) {
+	m := syslogPattern.FindSubmatch(line)
+	if m == nil {
+		return time.Time{}, false
+	}
+	day, _ := strconv.Atoi(string(m[2]))
+	hour, _ := strconv.Atoi(string(m[3]))
+	minute, _ := strconv.Atoi(string(m[4]))
+	sec, _ := strconv.Atoi(string(m[5]))
+	year := p.modTime.In(p.loc).Year()
+	t := time.Date(year, months[string(m[1])], day, hour, minute, sec, 0, p.loc)
+	if t.After(p.modTime.Add(24 * time.Hour)) {
+		// Written last year, e.g. December lines in a file modified in January
+		t = t.AddDate(-1, 0, 0)
+	}
+	return t, true
+}
+
+func (p *timeParser) parseJSON(line []byte) (time.Time, bool) {
+	line = bytes.TrimLeft(line, " \t")
+	if len(line) == 0 || line[0] != '{' {
+		return time.Time{}, false
+	}
+	for _, key := range jsonTimeKeys {
+		i := bytes.Index(line, key)
+		if i < 0 {
+			continue
+		}
+		value := bytes.TrimLeft(line[i+len(key):], " \t")
+		if len(value) == 0 || value[0] != ':' {
+			continue
+		}
+		value = bytes.TrimLeft(value[1:], " \t")
+		if len(value) > 0 && value[0] == '"' {
+			end := bytes.IndexByte(value[1:], '"')
+			if end < 0 {
+				continue
+			}
+			text := value[1 : 1+end]
+			if t, err := time.Parse(time.RFC3339Nano, string(text)); err == nil {
+				return t, true
+			}
+			if t, ok := (&timeParser{format: formatISO, loc: p.loc}).parseISO(text); ok {
+				return t, true
+			}
+			continue
+		}
+		end := 0
+		for end < len(value) && (value[end] >= '0' && value[end] <= '9' || value[end] == '.') {
+			end++
+		}
+		if epoch, err := strconv.ParseFloat(string(value[:end]), 64); err == nil && end > 0 {
+			return epochTime(epoch), true
+		}
+	}
+	return time.Time{}, false
+}
+
+// epochTime converts epoch seconds, or milliseconds when the value is too
+// large to be seconds, to a time.
+func epochTime(epoch float64) time.Time {
+	if epoch > 1e12 {
+		epoch /= 1000
+	}
+	sec := int64(epoch)
+	return time.Unix(sec, int64((epoch-float64(sec))*1e9)).UTC()
+}
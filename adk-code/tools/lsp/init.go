@@ -0,0 +1,19 @@
+// Package lsp provides language-server-backed code navigation tools for the coding agent.
+package lsp
+
+import (
+	lsppkg "adk-code/internal/lsp"
+	common "adk-code/tools/base"
+)
+
+// init registers all language server tools automatically at package initialization.
+func init() {
+	_, _ = NewDefinitionTool()
+	_, _ = NewReferencesTool()
+	_, _ = NewHoverTool()
+	_, _ = NewWorkspaceSymbolsTool()
+	_, _ = NewDiagnosticsTool()
+
+	// Keep running servers in sync with files the other tools write
+	common.OnFileWrite(lsppkg.DefaultManager().NotifyWrite)
+}
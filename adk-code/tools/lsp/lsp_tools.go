@@ -0,0 +1,544 @@
+package lsp
+
+import (
+	"bufio"
+	"context"
+	"fmt"
+	"os"
+	"path/filepath"
+	"strings"
+	"time"
+	"unicode"
+	"unicode/utf16"
+
+	"google.golang.org/adk/tool"
+	"google.golang.org/adk/tool/functiontool"
+
+	lsppkg "adk-code/internal/lsp"
+	common "adk-code/tools/base"
+)
+
+// Default result limits keep navigation answers compact
+const (
+	defaultMaxResults     = 50
+	defaultDiagnosticWait = 3 * time.Second
+)
+
+// PositionInput identifies a symbol in a file.
+type PositionInput struct {
+	// Path is the file containing the symbol.
+	Path string `json:"path" jsonschema:"File containing the symbol"`
+	// Line is the 1-indexed line number of the symbol.
+	Line int `json:"line" jsonschema:"Line number of the symbol (1-indexed)"`
+	// Column is the 1-indexed character column (optional if Symbol is given).
+	Column *int `json:"column,omitempty" jsonschema:"Column of the symbol (1-indexed, optional if symbol is given)"`
+	// Symbol is the identifier on the line, used to find the column.
+	Symbol string `json:"symbol,omitempty" jsonschema:"Identifier on that line (used to locate the column when column is omitted)"`
+}
+
+// ReferencesInput extends PositionInput with reference options.
+type ReferencesInput struct {
+	PositionInput
+	// IncludeDeclaration includes the declaration itself in the results.
+	IncludeDeclaration *bool `json:"include_declaration,omitempty" jsonschema:"Include the declaration in results (default: true)"`
+	// MaxResults caps the number of returned locations.
+	MaxResults *int `json:"max_results,omitempty" jsonschema:"Maximum number of locations to return (default: 50)"`
+}
+
+// WorkspaceSymbolsInput defines parameters for a workspace symbol search.
+type WorkspaceSymbolsInput struct {
+	// Query is the symbol name or prefix to search for.
+	Query string `json:"query" jsonschema:"Symbol name or fuzzy query (e.g., 'NewManager')"`
+	// Language selects the language server (go, python, rust).
+	Language string `json:"language" jsonschema:"Language server to query: go, python or rust"`
+	// MaxResults caps the number of returned symbols.
+	MaxResults *int `json:"max_results,omitempty" jsonschema:"Maximum number of symbols to return (default: 50)"`
+}
+
+// DiagnosticsInput defines parameters for post-edit diagnostics.
+type DiagnosticsInput struct {
+	// Path is the file to check.
+	Path string `json:"path" jsonschema:"File to collect diagnostics for"`
+	// WaitSeconds bounds how long to wait for the server to analyze the file.
+	WaitSeconds *int `json:"wait_seconds,omitempty" jsonschema:"Seconds to wait for analysis (default: 3)"`
+}
+
+// LocationEntry is a compact source location.
+type LocationEntry struct {
+	// File is the path relative to the server's workspace root when possible.
+	File string `json:"file"`
+	// Line is the 1-indexed line number.
+	Line int `json:"line"`
+	// Column is the 1-indexed column.
+	Column int `json:"column"`
+	// Text is the trimmed source line at the location.
+	Text string `json:"text,omitempty"`
+}
+
+// LocationsOutput is returned by the definition and references tools.
+type LocationsOutput struct {
+	Locations []LocationEntry `json:"locations"`
+	Count     int             `json:"count"`
+	Truncated bool            `json:"truncated,omitempty"`
+	Success   bool            `json:"success"`
+	Error     string          `json:"error,omitempty"`
+}
+
+// HoverOutput is returned by the hover tool.
+type HoverOutput struct {
+	Contents string `json:"contents"`
+	Success  bool   `json:"success"`
+	Error    string `json:"error,omitempty"`
+}
+
+// SymbolEntry is a compact workspace symbol.
+type SymbolEntry struct {
+	Name      string `json:"name"`
+	Kind      string `json:"kind"`
+	File      string `json:"file"`
+	Line      int    `json:"line"`
+	Container string `json:"container,omitempty"`
+}
+
+// WorkspaceSymbolsOutput is returned by the workspace symbols tool.
+type WorkspaceSymbolsOutput struct {
+	Symbols   []SymbolEntry `json:"symbols"`
+	Count     int           `json:"count"`
+	Truncated bool          `json:"truncated,omitempty"`
+	Success   bool          `json:"success"`
+	Error     string        `json:"error,omitempty"`
+}
+
+// DiagnosticEntry is a compact compiler/linter message.
+type DiagnosticEntry struct {
+	Line     int    `json:"line"`
+	Column   int    `json:"column"`
+	Severity string `json:"severity"`
+	Message  string `json:"message"`
+	Source   string `json:"source,omitempty"`
+}
+
+// DiagnosticsOutput is returned by the diagnostics tool.
+type DiagnosticsOutput struct {
+	File        string            `json:"file"`
+	Diagnostics []DiagnosticEntry `json:"diagnostics"`
+	Errors      int               `json:"errors"`
+	Warnings    int               `json:"warnings"`
+	Success     bool              `json:"success"`
+	Error       string            `json:"error,omitempty"`
+}
+
+// NewDefinitionTool creates the go-to-definition tool.
+func NewDefinitionTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input PositionInput) LocationsOutput {
+		client, path, pos, err := prepare(ctx, input)
+		if err != nil {
+			return LocationsOutput{Locations: []LocationEntry{}, Error: err.Error()}
+		}
+		locs, err := client.Definition(ctx, path, pos)
+		if err != nil {
+			return LocationsOutput{Locations: []LocationEntry{}, Error: fmt.Sprintf("definition request failed: %v", err)}
+		}
+		return buildLocationsOutput(client.Root(), locs, defaultMaxResults)
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name:        "lsp_definition",
+		Description: "Jumps to the definition of the symbol at a file position using the language server (gopls, pyright, rust-analyzer). Give path + line and either column or the symbol name on that line. Far more precise than grepping for the name.",
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategorySearchDiscovery,
+			Priority:  2,
+			UsageHint: "Precise go-to-definition via language server (path, line, symbol)",
+		})
+	}
+
+	return t, err
+}
+
+// NewReferencesTool creates the find-references tool.
+func NewReferencesTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input ReferencesInput) LocationsOutput {
+		client, path, pos, err := prepare(ctx, input.PositionInput)
+		if err != nil {
+			return LocationsOutput{Locations: []LocationEntry{}, Error: err.Error()}
+		}
+		includeDecl := true
+		if input.IncludeDeclaration != nil {
+			includeDecl = *input.IncludeDeclaration
+		}
+		locs, err := client.References(ctx, path, pos, includeDecl)
+		if err != nil {
+			return LocationsOutput{Locations: []LocationEntry{}, Error: fmt.Sprintf("references request failed: %v", err)}
+		}
+		return buildLocationsOutput(client.Root(), locs, maxResults(input.MaxResults))
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name:        "lsp_references",
+		Description: "Finds all references to the symbol at a file position using the language server. Returns compact file:line:column entries with the source line. Use instead of multi-round text searches when renaming or assessing impact.",
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategorySearchDiscovery,
+			Priority:  3,
+			UsageHint: "All usages of a symbol via language server, no false positives",
+		})
+	}
+
+	return t, err
+}
+
+// NewHoverTool creates the hover (type/signature/doc) tool.
+func NewHoverTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input PositionInput) HoverOutput {
+		client, path, pos, err := prepare(ctx, input)
+		if err != nil {
+			return HoverOutput{Error: err.Error()}
+		}
+		contents, err := client.Hover(ctx, path, pos)
+		if err != nil {
+			return HoverOutput{Error: fmt.Sprintf("hover request failed: %v", err)}
+		}
+		return HoverOutput{Contents: contents, Success: true}
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name:        "lsp_hover",
+		Description: "Shows the type, signature and documentation of the symbol at a file position using the language server, without reading the defining file.",
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategorySearchDiscovery,
+			Priority:  4,
+			UsageHint: "Type/signature/docs of a symbol via language server",
+		})
+	}
+
+	return t, err
+}
+
+// NewWorkspaceSymbolsTool creates the workspace symbol search tool.
+func NewWorkspaceSymbolsTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input WorkspaceSymbolsInput) WorkspaceSymbolsOutput {
+		if strings.TrimSpace(input.Query) == "" {
+			return WorkspaceSymbolsOutput{Symbols: []SymbolEntry{}, Error: "query is required"}
+		}
+		client, err := lsppkg.DefaultManager().ClientForLanguage(ctx, strings.ToLower(input.Language))
+		if err != nil {
+			return WorkspaceSymbolsOutput{Symbols: []SymbolEntry{}, Error: err.Error()}
+		}
+		symbols, err := client.WorkspaceSymbols(ctx, input.Query)
+		if err != nil {
+			return WorkspaceSymbolsOutput{Symbols: []SymbolEntry{}, Error: fmt.Sprintf("workspace symbol request failed: %v", err)}
+		}
+
+		limit := maxResults(input.MaxResults)
+		output := WorkspaceSymbolsOutput{Symbols: make([]SymbolEntry, 0, min(len(symbols), limit)), Success: true}
+		for _, sym := range symbols {
+			if len(output.Symbols) >= limit {
+				output.Truncated = true
+				break
+			}
+			output.Symbols = append(output.Symbols, SymbolEntry{
+				Name:      sym.Name,
+				Kind:      lsppkg.SymbolKindName(sym.Kind),
+				File:      relativeTo(client.Root(), lsppkg.URIToPath(sym.Location.URI)),
+				Line:      sym.Location.Range.Start.Line + 1,
+				Container: sym.ContainerName,
+			})
+		}
+		output.Count = len(output.Symbols)
+		return output
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name:        "lsp_workspace_symbols",
+		Description: "Searches type, function and variable declarations across the whole workspace by name using the language server. Returns name, kind and file:line for each match.",
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategorySearchDiscovery,
+			Priority:  5,
+			UsageHint: "Find declarations by name across the workspace via language server",
+		})
+	}
+
+	return t, err
+}
+
+// NewDiagnosticsTool creates the post-edit diagnostics tool.
+func NewDiagnosticsTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input DiagnosticsInput) DiagnosticsOutput {
+		path, err := absPath(input.Path)
+		if err != nil {
+			return DiagnosticsOutput{Diagnostics: []DiagnosticEntry{}, Error: err.Error()}
+		}
+		client, err := lsppkg.DefaultManager().ClientForFile(ctx, path)
+		if err != nil {
+			return DiagnosticsOutput{Diagnostics: []DiagnosticEntry{}, Error: err.Error()}
+		}
+
+		wait := defaultDiagnosticWait
+		if input.WaitSeconds != nil && *input.WaitSeconds > 0 {
+			wait = time.Duration(*input.WaitSeconds) * time.Second
+		}
+		diags, err := client.Diagnostics(ctx, path, wait)
+		if err != nil {
+			return DiagnosticsOutput{Diagnostics: []DiagnosticEntry{}, Error: fmt.Sprintf("diagnostics failed: %v", err)}
+		}
+
+		output := DiagnosticsOutput{
+			File:        relativeTo(client.Root(), path),
+			Diagnostics: make([]DiagnosticEntry, 0, len(diags)),
+			Success:     true,
+		}
+		wanted := make(map[int]bool, len(diags))
+		for _, d := range diags {
+			wanted[d.Range.Start.Line+1] = true
+		}
+		lines, _ := readLines(path, wanted)
+		for _, d := range diags {
+			severity := lsppkg.SeverityName(d.Severity)
+			switch severity {
+			case "error":
+				output.Errors++
+			case "warning":
+				output.Warnings++
+			}
+			output.Diagnostics = append(output.Diagnostics, DiagnosticEntry{
+				Line:     d.Range.Start.Line + 1,
+				Column:   runeColumn(lines[d.Range.Start.Line+1], d.Range.Start.Character) + 1,
+				Severity: severity,
+				Message:  d.Message,
+				Source:   d.Source,
+			})
+		}
+		return output
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name:        "lsp_diagnostics",
+		Description: "Returns compiler/type-checker diagnostics for a file from the language server. Run after editing a file to catch errors without a full build.",
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategorySearchDiscovery,
+			Priority:  6,
+			UsageHint: "Post-edit compile/type errors for a file via language server",
+		})
+	}
+
+	return t, err
+}
+
+// prepare resolves the file, starts (or reuses) its language server and
+// converts the 1-indexed input position into an LSP position.
+func prepare(ctx context.Context, input PositionInput) (*lsppkg.Client, string, lsppkg.Position, error) {
+	path, err := absPath(input.Path)
+	if err != nil {
+		return nil, "", lsppkg.Position{}, err
+	}
+	pos, err := resolvePosition(path, input)
+	if err != nil {
+		return nil, "", lsppkg.Position{}, err
+	}
+	client, err := lsppkg.DefaultManager().ClientForFile(ctx, path)
+	if err != nil {
+		return nil, "", lsppkg.Position{}, err
+	}
+	return client, path, pos, nil
+}
+
+// absPath validates the path and resolves it against the workspace roots.
+func absPath(path string) (string, error) {
+	if path == "" {
+		return "", fmt.Errorf("path is required")
+	}
+	abs, err := lsppkg.DefaultManager().ResolvePath(path)
+	if err != nil {
+		return "", fmt.Errorf("invalid path %s: %w", path, err)
+	}
+	if _, err := os.Stat(abs); err != nil {
+		return "", fmt.Errorf("file not found: %s", path)
+	}
+	return abs, nil
+}
+
+// resolvePosition converts a 1-indexed line plus column or symbol into an LSP
+// position (0-indexed line, UTF-16 character offset).
+func resolvePosition(path string, input PositionInput) (lsppkg.Position, error) {
+	if input.Line < 1 {
+		return lsppkg.Position{}, fmt.Errorf("line must be >= 1")
+	}
+	lineText, err := readLine(path, input.Line)
+	if err != nil {
+		return lsppkg.Position{}, err
+	}
+	runes := []rune(lineText)
+
+	col := -1 // 0-indexed rune offset
+	switch {
+	case input.Column != nil && *input.Column >= 1:
+		col = *input.Column - 1
+	case input.Symbol != "":
+		idx := indexIdentifier(lineText, input.Symbol)
+		if idx < 0 {
+			return lsppkg.Position{}, fmt.Errorf("symbol %q not found on line %d", input.Symbol, input.Line)
+		}
+		col = len([]rune(lineText[:idx]))
+	default:
+		// Fall back to the first identifier character on the line
+		for i, r := range runes {
+			if unicode.IsLetter(r) || r == '_' {
+				col = i
+				break
+			}
+		}
+		if col < 0 {
+			return lsppkg.Position{}, fmt.Errorf("no symbol on line %d; provide column or symbol", input.Line)
+		}
+	}
+	if col > len(runes) {
+		col = len(runes)
+	}
+
+	return lsppkg.Position{
+		Line:      input.Line - 1,
+		Character: len(utf16.Encode(runes[:col])),
+	}, nil
+}
+
+// runeColumn converts a UTF-16 character offset on line into the 0-indexed
+// rune offset tool inputs and outputs use.
+func runeColumn(line string, utf16Offset int) int {
+	units, col := 0, 0
+	for _, r := range line {
+		if units >= utf16Offset {
+			return col
+		}
+		units += len(utf16.Encode([]rune{r}))
+		col++
+	}
+	// Past the end of the line (or the line is unknown)
+	return col + max(utf16Offset-units, 0)
+}
+
+// indexIdentifier finds symbol as a whole identifier in line, returning its byte index.
+func indexIdentifier(line, symbol string) int {
+	isIdent := func(r rune) bool { return unicode.IsLetter(r) || unicode.IsDigit(r) || r == '_' }
+	for start := 0; start < len(line); {
+		idx := strings.Index(line[start:], symbol)
+		if idx < 0 {
+			return -1
+		}
+		idx += start
+		end := idx + len(symbol)
+		beforeOK := idx == 0 || !isIdent([]rune(line[:idx])[len([]rune(line[:idx]))-1])
+		afterOK := end >= len(line) || !isIdent([]rune(line[end:])[0])
+		if beforeOK && afterOK {
+			return idx
+		}
+		start = idx + 1
+	}
+	return -1
+}
+
+// readLine returns the given 1-indexed line of a file.
+func readLine(path string, line int) (string, error) {
+	lines, err := readLines(path, map[int]bool{line: true})
+	if err != nil {
+		return "", err
+	}
+	text, ok := lines[line]
+	if !ok {
+		return "", fmt.Errorf("line %d is past the end of %s", line, path)
+	}
+	return text, nil
+}
+
+// readLines reads only the requested 1-indexed lines of a file.
+func readLines(path string, wanted map[int]bool) (map[int]string, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+
+	result := make(map[int]string, len(wanted))
+	scanner := bufio.NewScanner(f)
+	scanner.Buffer(make([]byte, 64*1024), 4*1024*1024)
+	for n := 1; scanner.Scan(); n++ {
+		if wanted[n] {
+			result[n] = scanner.Text()
+			if len(result) == len(wanted) {
+				break
+			}
+		}
+	}
+	return result, scanner.Err()
+}
+
+// buildLocationsOutput converts locations into compact entries with source text.
+func buildLocationsOutput(root string, locs []lsppkg.Location, limit int) LocationsOutput {
+	output := LocationsOutput{Locations: make([]LocationEntry, 0, min(len(locs), limit)), Success: true}
+	if len(locs) > limit {
+		locs = locs[:limit]
+		output.Truncated = true
+	}
+
+	// Group wanted lines per file so each file is scanned once
+	wanted := make(map[string]map[int]bool)
+	for _, loc := range locs {
+		path := lsppkg.URIToPath(loc.URI)
+		if wanted[path] == nil {
+			wanted[path] = make(map[int]bool)
+		}
+		wanted[path][loc.Range.Start.Line+1] = true
+	}
+	texts := make(map[string]map[int]string, len(wanted))
+	for path, lines := range wanted {
+		if found, err := readLines(path, lines); err == nil {
+			texts[path] = found
+		}
+	}
+
+	for _, loc := range locs {
+		path := lsppkg.URIToPath(loc.URI)
+		line := loc.Range.Start.Line + 1
+		output.Locations = append(output.Locations, LocationEntry{
+			File:   relativeTo(root, path),
+			Line:   line,
+			Column: runeColumn(texts[path][line], loc.Range.Start.Character) + 1,
+			Text:   strings.TrimSpace(texts[path][line]),
+		})
+	}
+	output.Count = len(output.Locations)
+	return output
+}
+
+// relativeTo shortens path relative to root when it lies inside it.
+func relativeTo(root, path string) string {
+	if rel, err := filepath.Rel(root, path); err == nil && !strings.HasPrefix(rel, "..") {
+		return rel
+	}
+	return path
+}
+
+func maxResults(value *int) int {
+	if value != nil && *value > 0 {
+		return *value
+	}
+	return defaultMaxResults
+}
@@ -0,0 +1,89 @@
+package lsp
+
+import (
+	"os"
+	"path/filepath"
+	"testing"
+
+	lsppkg "adk-code/internal/lsp"
+)
+
+func writeSource(t *testing.T, content string) string {
+	t.Helper()
+	path := filepath.Join(t.TempDir(), "main.go")
+	if err := os.WriteFile(path, []byte(content), 0644); err != nil {
+		t.Fatalf("failed to write source: %v", err)
+	}
+	return path
+}
+
+func TestResolvePositionFromSymbol(t *testing.T) {
+	path := writeSource(t, "package main\n\nfunc mainHelper() { main() }\n")
+
+	pos, err := resolvePosition(path, PositionInput{Line: 3, Symbol: "main"})
+	if err != nil {
+		t.Fatalf("resolvePosition failed: %v", err)
+	}
+	// "main" as a whole identifier starts after "func mainHelper() { "
+	if pos.Line != 2 || pos.Character != 20 {
+		t.Errorf("expected 2:20, got %d:%d", pos.Line, pos.Character)
+	}
+}
+
+func TestResolvePositionUTF16Column(t *testing.T) {
+	path := writeSource(t, "package main\n\nvar s = \"😀\"; var target = 1\n")
+
+	pos, err := resolvePosition(path, PositionInput{Line: 3, Symbol: "target"})
+	if err != nil {
+		t.Fatalf("resolvePosition failed: %v", err)
+	}
+	// The emoji is one rune but two UTF-16 code units
+	if pos.Character != 18 {
+		t.Errorf("expected UTF-16 column 18, got %d", pos.Character)
+	}
+}
+
+func TestResolvePositionErrors(t *testing.T) {
+	path := writeSource(t, "package main\n")
+
+	if _, err := resolvePosition(path, PositionInput{Line: 0}); err == nil {
+		t.Error("expected error for line 0")
+	}
+	if _, err := resolvePosition(path, PositionInput{Line: 5}); err == nil {
+		t.Error("expected error for line past end of file")
+	}
+	if _, err := resolvePosition(path, PositionInput{Line: 1, Symbol: "missing"}); err == nil {
+		t.Error("expected error for unknown symbol")
+	}
+}
+
+func TestBuildLocationsOutputTruncatesAndReadsText(t *testing.T) {
+	path := writeSource(t, "package main\n\n  func main() {}\n")
+	root := filepath.Dir(path)
+	loc := lsppkg.Location{URI: lsppkg.PathToURI(path)}
+	loc.Range.Start = lsppkg.Position{Line: 2, Character: 7}
+
+	output := buildLocationsOutput(root, []lsppkg.Location{loc, loc, loc}, 2)
+	if !output.Success || output.Count != 2 || !output.Truncated {
+		t.Fatalf("unexpected output: %+v", output)
+	}
+	entry := output.Locations[0]
+	if entry.File != "main.go" || entry.Line != 3 || entry.Column != 8 || entry.Text != "func main() {}" {
+		t.Errorf("unexpected entry: %+v", entry)
+	}
+}
+
+func TestBuildLocationsOutputReportsRuneColumns(t *testing.T) {
+	path := writeSource(t, "package main\n\nvar s = \"😀\"; var target = 1\n")
+	loc := lsppkg.Location{URI: lsppkg.PathToURI(path)}
+	loc.Range.Start = lsppkg.Position{Line: 2, Character: 18} // UTF-16 offset of "target"
+
+	output := buildLocationsOutput(filepath.Dir(path), []lsppkg.Location{loc}, 10)
+	// Column 18 as input to resolvePosition (1-indexed runes) names the same symbol
+	if got := output.Locations[0].Column; got != 18 {
+		t.Errorf("expected rune column 18, got %d", got)
+	}
+	if got := runeColumn("", 4); got != 4 {
+		t.Errorf("expected an unknown line to keep the offset, got %d", got)
+	}
+}
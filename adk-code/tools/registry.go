@@ -4,13 +4,18 @@ package tools
 
 import (
 	common "adk-code/tools/base"
+	"adk-code/tools/data"
 	"adk-code/tools/discovery"
 	"adk-code/tools/display"
 	"adk-code/tools/edit"
 	"adk-code/tools/exec"
+	"adk-code/tools/experiment"
 	"adk-code/tools/file"
+	"adk-code/tools/logs"
+	"adk-code/tools/lsp"
 	"adk-code/tools/search"
 	"adk-code/tools/v4a"
+	"adk-code/tools/vcs"
 	"adk-code/tools/websearch"
 	"adk-code/tools/workspace"
 )
@@ -46,6 +51,11 @@ func RegisterAllTools(reg *common.ToolRegistry) error {
 	// - Workspace: workspace_tools (in tools/workspace/)
 	// - V4A Format: apply_v4a_patch (in tools/v4a/)
 	// - Web Search: google_search (in tools/websearch/)
+	// - Code Navigation: lsp_definition, lsp_references, lsp_hover, lsp_workspace_symbols, lsp_diagnostics (in tools/lsp/)
+	// - Version Control: git_changed_files (in tools/vcs/)
+	// - Logs: log_slice (in tools/logs/)
+	// - Data: query_data (in tools/data/)
+	// - Experiments: experiment_start, experiment_diff, experiment_apply, experiment_discard (in tools/experiment/)
 	//
 	// This function serves as documentation and a future refactoring point
 	// if explicit registration becomes necessary.
@@ -54,7 +64,7 @@ func RegisterAllTools(reg *common.ToolRegistry) error {
 }
 
 // init automatically triggers tool registration at package initialization.
-// This ensures all tools from subpackages (file, edit, exec, display, search, workspace, v4a, discovery, websearch)
+// This ensures all tools from subpackages (file, edit, exec, display, search, workspace, v4a, discovery, websearch, lsp, vcs, logs, data, experiment)
 // are registered when the tools package is imported.
 //
 // Each tool subpackage has its own init() function that calls tool constructors,
@@ -78,4 +88,9 @@ func init() {
 	_ = discovery.NewListModelsTool
 	_ = discovery.NewModelInfoTool
 	_ = websearch.NewGoogleSearchTool
+	_ = lsp.NewDefinitionTool
+	_ = vcs.NewChangedFilesTool
+	_ = logs.NewLogSliceTool
+	_ = data.NewQueryDataTool
+	_ = experiment.NewStartExperimentTool
 }
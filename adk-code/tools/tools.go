@@ -16,18 +16,28 @@
 //   - v4a: V4A patch format tools
 //   - agents: Agent definition discovery and management tools
 //   - websearch: Web search tools (Google Search)
+//   - lsp: Language server code navigation (definition, references, hover, symbols, diagnostics)
+//   - vcs: Version control status read natively from the git index
+//   - logs: Time-window log slicing
+//   - data: Streaming queries over JSON, JSONL and CSV files
+//   - experiment: Disposable workspace clones for trying competing changes
 package tools
 
 import (
 	"adk-code/tools/agents"
 	common "adk-code/tools/base"
+	"adk-code/tools/data"
 	"adk-code/tools/discovery"
 	"adk-code/tools/display"
 	"adk-code/tools/edit"
 	"adk-code/tools/exec"
+	"adk-code/tools/experiment"
 	"adk-code/tools/file"
+	"adk-code/tools/logs"
+	"adk-code/tools/lsp"
 	"adk-code/tools/search"
 	"adk-code/tools/v4a"
+	"adk-code/tools/vcs"
 	"adk-code/tools/web"
 	"adk-code/tools/websearch"
 	"adk-code/tools/workspace"
@@ -47,6 +57,9 @@ type (
 	// File tool types
 	ReadFileInput       = file.ReadFileInput
 	ReadFileOutput      = file.ReadFileOutput
+	ReadFilesInput      = file.ReadFilesInput
+	ReadFilesOutput     = file.ReadFilesOutput
+	ReadRangeSpec       = file.ReadRangeSpec
 	WriteFileInput      = file.WriteFileInput
 	WriteFileOutput     = file.WriteFileOutput
 	ListDirectoryInput  = file.ListDirectoryInput
@@ -109,6 +122,44 @@ type (
 	// Web tool types
 	FetchWebInput  = web.FetchWebInput
 	FetchWebOutput = web.FetchWebOutput
+
+	// Web search tool types
+	CachedSearchInput  = websearch.CachedSearchInput
+	CachedSearchOutput = websearch.CachedSearchOutput
+	SearchCacheStats   = websearch.SearchCacheStats
+
+	// Language server tool types
+	LSPPositionInput          = lsp.PositionInput
+	LSPReferencesInput        = lsp.ReferencesInput
+	LSPLocationsOutput        = lsp.LocationsOutput
+	LSPHoverOutput            = lsp.HoverOutput
+	LSPWorkspaceSymbolsInput  = lsp.WorkspaceSymbolsInput
+	LSPWorkspaceSymbolsOutput = lsp.WorkspaceSymbolsOutput
+	LSPDiagnosticsInput       = lsp.DiagnosticsInput
+	LSPDiagnosticsOutput      = lsp.DiagnosticsOutput
+
+	// Version control tool types
+	ChangedFilesInput  = vcs.ChangedFilesInput
+	ChangedFilesOutput = vcs.ChangedFilesOutput
+	ChangedFile        = vcs.ChangedFile
+
+	// Log tool types
+	LogSliceInput  = logs.LogSliceInput
+	LogSliceOutput = logs.LogSliceOutput
+
+	// Data query tool types
+	QueryDataInput  = data.QueryDataInput
+	QueryDataOutput = data.QueryDataOutput
+
+	// Experiment tool types
+	StartExperimentInput    = experiment.StartExperimentInput
+	StartExperimentOutput   = experiment.StartExperimentOutput
+	ExperimentDiffInput     = experiment.ExperimentDiffInput
+	ExperimentDiffOutput    = experiment.ExperimentDiffOutput
+	ApplyExperimentInput    = experiment.ApplyExperimentInput
+	ApplyExperimentOutput   = experiment.ApplyExperimentOutput
+	DiscardExperimentInput  = experiment.DiscardExperimentInput
+	DiscardExperimentOutput = experiment.DiscardExperimentOutput
 )
 
 // Re-export category constants for tool classification
@@ -126,6 +177,7 @@ const (
 var (
 	// File tools
 	NewReadFileTool      = file.NewReadFileTool
+	NewReadFilesTool     = file.NewReadFilesTool
 	NewWriteFileTool     = file.NewWriteFileTool
 	NewReplaceInFileTool = file.NewReplaceInFileTool
 	NewListDirectoryTool = file.NewListDirectoryTool
@@ -165,9 +217,33 @@ var (
 
 	// Web search tools
 	NewGoogleSearchTool = websearch.NewGoogleSearchTool
+	NewCachedSearchTool = websearch.NewCachedSearchTool
+	GetSearchCacheStats = websearch.GetSearchCacheStats
 
 	// Web tools
 	NewFetchWebTool = web.NewFetchWebTool
+
+	// Language server tools
+	NewLSPDefinitionTool       = lsp.NewDefinitionTool
+	NewLSPReferencesTool       = lsp.NewReferencesTool
+	NewLSPHoverTool            = lsp.NewHoverTool
+	NewLSPWorkspaceSymbolsTool = lsp.NewWorkspaceSymbolsTool
+	NewLSPDiagnosticsTool      = lsp.NewDiagnosticsTool
+
+	// Version control tools
+	NewChangedFilesTool = vcs.NewChangedFilesTool
+
+	// Log tools
+	NewLogSliceTool = logs.NewLogSliceTool
+
+	// Data query tools
+	NewQueryDataTool = data.NewQueryDataTool
+
+	// Experiment tools
+	NewStartExperimentTool   = experiment.NewStartExperimentTool
+	NewExperimentDiffTool    = experiment.NewExperimentDiffTool
+	NewApplyExperimentTool   = experiment.NewApplyExperimentTool
+	NewDiscardExperimentTool = experiment.NewDiscardExperimentTool
 )
 
 // Re-export registry functions for tool access and registration
@@ -0,0 +1,211 @@
+package vcs
+
+import (
+	"bytes"
+	"fmt"
+	"os"
+	"path/filepath"
+	"strings"
+
+	"google.golang.org/adk/tool"
+	"google.golang.org/adk/tool/functiontool"
+
+	"adk-code/internal/gitindex"
+	common "adk-code/tools/base"
+	"adk-code/tools/search"
+)
+
+const (
+	// defaultMaxDiffLines bounds each file's compact diff
+	defaultMaxDiffLines = 40
+	// diffContextLines is the unchanged context kept around each change
+	diffContextLines = 2
+	// maxDiffFileBytes skips diffs of files larger than this
+	maxDiffFileBytes = 1024 * 1024
+)
+
+// ChangedFilesInput defines the input parameters for listing changed files.
+type ChangedFilesInput struct {
+	// Path is any path inside the repository.
+	Path string `json:"path,omitempty" jsonschema:"Any path inside the git repository (default: current directory)"`
+	// IncludeDiff adds a compact diff for each changed file.
+	IncludeDiff bool `json:"include_diff,omitempty" jsonschema:"Include a compact diff for each changed file (default: false)"`
+	// MaxDiffLines limits each file's diff.
+	MaxDiffLines *int `json:"max_diff_lines,omitempty" jsonschema:"Maximum diff lines per file (default: 40)"`
+	// IncludeUntracked lists files not tracked by git.
+	IncludeUntracked *bool `json:"include_untracked,omitempty" jsonschema:"Include untracked files (default: true)"`
+	// Refresh rescans the whole working tree instead of using cached results.
+	Refresh bool `json:"refresh,omitempty" jsonschema:"Rescan the whole working tree (default: false, results are kept up to date incrementally)"`
+}
+
+// ChangedFile is one changed path.
+type ChangedFile struct {
+	// Path is relative to the repository root.
+	Path string `json:"path"`
+	// Staged is the change recorded in the index relative to HEAD.
+	Staged string `json:"staged,omitempty"`
+	// Unstaged is the working tree change relative to the index.
+	Unstaged string `json:"unstaged,omitempty"`
+	// Diff is a compact unified diff of the change.
+	Diff string `json:"diff,omitempty"`
+}
+
+// ChangedFilesOutput defines the output of listing changed files.
+type ChangedFilesOutput struct {
+	// Root is the repository root.
+	Root string `json:"root"`
+	// Files are the changed paths sorted by path.
+	Files []ChangedFile `json:"files"`
+	// Count is the number of changed paths.
+	Count int `json:"count"`
+	// Success indicates whether the operation was successful.
+	Success bool `json:"success"`
+	// Error contains error message if the operation failed.
+	Error string `json:"error,omitempty"`
+}
+
+// NewChangedFilesTool creates a tool that lists changed, staged and untracked
+// files by reading the git index directly.
+func NewChangedFilesTool() (tool.Tool, error) {
+	handler := func(ctx tool.Context, input ChangedFilesInput) ChangedFilesOutput {
+		path := input.Path
+		if path == "" {
+			path = "."
+		}
+		tracker, err := gitindex.TrackerFor(path)
+		if err != nil {
+			return ChangedFilesOutput{Files: make([]ChangedFile, 0), Success: false, Error: err.Error()}
+		}
+		changes, err := tracker.Status(input.Refresh)
+		if err != nil {
+			return ChangedFilesOutput{Files: make([]ChangedFile, 0), Success: false, Error: fmt.Sprintf("Failed to read git status: %v", err)}
+		}
+
+		includeUntracked := input.IncludeUntracked == nil || *input.IncludeUntracked
+		maxDiffLines := defaultMaxDiffLines
+		if input.MaxDiffLines != nil && *input.MaxDiffLines > 0 {
+			maxDiffLines = *input.MaxDiffLines
+		}
+
+		files := make([]ChangedFile, 0, len(changes))
+		for _, c := range changes {
+			if c.Unstaged == gitindex.StatusUntracked && !includeUntracked {
+				continue
+			}
+			file := ChangedFile{Path: c.Path, Staged: c.Staged, Unstaged: c.Unstaged}
+			if input.IncludeDiff && c.Unstaged != gitindex.StatusUntracked {
+				file.Diff = changeDiff(tracker.Repository(), c, maxDiffLines)
+			}
+			files = append(files, file)
+		}
+
+		return ChangedFilesOutput{
+			Root:    tracker.Repository().Root,
+			Files:   files,
+			Count:   len(files),
+			Success: true,
+		}
+	}
+
+	t, err := functiontool.New(functiontool.Config{
+		Name:        "git_changed_files",
+		Description: "Lists files changed in the git working tree: unstaged modifications and deletions, staged changes relative to HEAD, and untracked files, optionally with a compact diff per file. Reads the git index directly, so it is much faster than running git status or git diff.",
+	}, handler)
+
+	if err == nil {
+		common.Register(common.ToolMetadata{
+			Tool:      t,
+			Category:  common.CategorySearchDiscovery,
+			Priority:  2,
+			UsageHint: "What changed since HEAD (staged, unstaged, untracked) with optional diffs; use instead of git status/diff",
+		})
+	}
+
+	return t, err
+}
+
+// changeDiff returns a compact diff of the working tree against the index
+// for unstaged changes, or of the index against HEAD for staged ones.
+func changeDiff(repo *gitindex.Repository, c gitindex.Change, maxLines int) string {
+	var before, after []byte
+	var err error
+	switch {
+	case c.Unstaged != "":
+		if c.InIndex {
+			if before, err = repo.ReadBlob(c.IndexHash); err != nil {
+				return ""
+			}
+		}
+		if c.Unstaged != gitindex.StatusDeleted {
+			if after, err = readWorktreeFile(filepath.Join(repo.Root, filepath.FromSlash(c.Path))); err != nil {
+				return ""
+			}
+		}
+	default:
+		if c.InHead {
+			if before, err = repo.ReadBlob(c.HeadHash); err != nil {
+				return ""
+			}
+		}
+		if c.InIndex {
+			if after, err = repo.ReadBlob(c.IndexHash); err != nil {
+				return ""
+			}
+		}
+	}
+
+	if bytes.IndexByte(before, 0) >= 0 || bytes.IndexByte(after, 0) >= 0 {
+		return "Binary file differs"
+	}
+	return compactDiff(search.GenerateDiff(string(before), string(after), diffContextLines), diffContextLines, maxLines)
+}
+
+func readWorktreeFile(path string) ([]byte, error) {
+	info, err := os.Stat(path)
+	if err != nil {
+		return nil, err
+	}
+	if info.Size() > maxDiffFileBytes {
+		return nil, fmt.Errorf("file too large to diff")
+	}
+	return os.ReadFile(path)
+}
+
+// compactDiff keeps changed lines and up to context unchanged lines around
+// them, marks runs skipped between changes with "...", and caps the result
+// at maxLines.
+func compactDiff(diff string, context, maxLines int) string {
+	lines := strings.Split(strings.TrimSuffix(diff, "\n"), "\n")
+	// Drop the ---/+++ header; the path is already in the result
+	if len(lines) >= 2 && strings.HasPrefix(lines[0], "--- ") && strings.HasPrefix(lines[1], "+++ ") {
+		lines = lines[2:]
+	}
+
+	keep := make([]bool, len(lines))
+	for i, line := range lines {
+		if strings.HasPrefix(line, "+") || strings.HasPrefix(line, "-") {
+			for j := max(0, i-context); j <= min(len(lines)-1, i+context); j++ {
+				keep[j] = true
+			}
+		}
+	}
+
+	var out []string
+	skipped := false
+	for i, line := range lines {
+		if !keep[i] {
+			skipped = true
+			continue
+		}
+		if skipped && len(out) > 0 {
+			out = append(out, "...")
+		}
+		skipped = false
+		out = append(out, line)
+	}
+	if len(out) > maxLines {
+		more := len(out) - maxLines
+		out = append(out[:maxLines], fmt.Sprintf("... (%d more lines)", more))
+	}
+	return strings.Join(out, "\n")
+}
@@ -0,0 +1,36 @@
+package vcs
+
+import (
+	"strings"
+	"testing"
+)
+
+func TestCompactDiffKeepsContextAroundChanges(t *testing.T) {
+	var before, after []string
+	for i := 0; i < 20; i++ {
+		line := "line " + string(rune('a'+i))
+		before = append(before, line)
+		if i == 10 {
+			line = "changed"
+		}
+		after = append(after, line)
+	}
+	diff := "--- original\n+++ modified\n"
+	for i := range before {
+		if before[i] == after[i] {
+			diff += " " + before[i] + "\n"
+		} else {
+			diff += "-" + before[i] + "\n+" + after[i] + "\n"
+		}
+	}
+
+	got := compactDiff(diff, 2, 40)
+	want := strings.Join([]string{" line i", " line j", "-line k", "+changed", " line l", " line m"}, "\n")
+	if got != want {
+		t.Errorf("unexpected compact diff:\n%s", got)
+	}
+
+	if got := compactDiff(diff, 2, 3); !strings.HasSuffix(got, "... (3 more lines)") {
+		t.Errorf("expected the diff to be capped, got:\n%s", got)
+	}
+}
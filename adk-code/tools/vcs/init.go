@@ -0,0 +1,14 @@
+// Package vcs provides version control tools for the coding agent.
+package vcs
+
+import (
+	"adk-code/internal/gitindex"
+	common "adk-code/tools/base"
+)
+
+// init registers all version control tools automatically at package initialization
+// and keeps the git status trackers informed of tool writes.
+func init() {
+	common.OnFileWrite(gitindex.NotifyWrite)
+	_, _ = NewChangedFilesTool()
+}
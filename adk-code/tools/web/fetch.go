@@ -4,6 +4,7 @@ package web
 import (
 	"context"
 	"encoding/json"
+	"errors"
 	"fmt"
 	"io"
 	"net/http"
@@ -17,9 +18,12 @@ import (
 	"google.golang.org/adk/tool"
 	"google.golang.org/adk/tool/functiontool"
 
+	"adk-code/internal/tracking"
 	common "adk-code/tools/base"
 )
 
+const fetchWebToolName = "builtin_fetch_web"
+
 // FetchWebInput defines parameters for fetching web content.
 type FetchWebInput struct {
 	// URL to fetch (required)
@@ -32,8 +36,8 @@ type FetchWebInput struct {
 	// "raw" - return raw response
 	Format *string `json:"format,omitempty" jsonschema:"Response format: 'text', 'json', 'html', 'raw' (default: text)"`
 
-	// Timeout in seconds (optional, default: 30s)
-	Timeout *int `json:"timeout,omitempty" jsonschema:"Request timeout in seconds (default: 30)"`
+	// Timeout in seconds (optional, default: adaptive, 30s for new hosts)
+	Timeout *int `json:"timeout,omitempty" jsonschema:"Request timeout in seconds (default: learned from past fetches of the host, 30 for new hosts; max 300)"`
 
 	// FollowRedirects controls automatic redirect following (optional, default: true)
 	FollowRedirects *bool `json:"follow_redirects,omitempty" jsonschema:"Follow HTTP redirects (default: true)"`
@@ -116,9 +120,15 @@ func FetchWebHandler(ctx tool.Context, input FetchWebInput) FetchWebOutput {
 		return output
 	}
 
+	// Latency is tracked per host so slow hosts get longer default timeouts
+	policy := tracking.DefaultTimeoutPolicy()
+	defer func() {
+		policy.Record(fetchWebToolName, parsedURL.Hostname(), time.Since(startTime), output.ErrorCode == "timeout")
+	}()
+
 	// 2. Configure request
 	client := &http.Client{
-		Timeout:       getTimeout(input.Timeout),
+		Timeout:       getTimeout(policy, input.Timeout, parsedURL.Hostname()),
 		CheckRedirect: getRedirectPolicy(input.FollowRedirects),
 	}
 
@@ -145,7 +155,7 @@ func FetchWebHandler(ctx tool.Context, input FetchWebInput) FetchWebOutput {
 	// 4. Execute request with timeout
 	resp, err := client.Do(req)
 	if err != nil {
-		if os.IsTimeout(err) || err == context.DeadlineExceeded {
+		if isTimeout(err) {
 			output.Error = "Request timeout"
 			output.ErrorCode = "timeout"
 		} else {
@@ -182,6 +192,13 @@ func FetchWebHandler(ctx tool.Context, input FetchWebInput) FetchWebOutput {
 	// 8. Read response with limit
 	limitedReader := io.LimitReader(resp.Body, maxSize+1)
 	content, err := io.ReadAll(limitedReader)
+	if err != nil && isTimeout(err) {
+		// The client timeout also covers reading the body
+		output.Error = "Request timeout while reading response"
+		output.ErrorCode = "timeout"
+		output.FetchDurationMS = int(time.Since(startTime).Milliseconds())
+		return output
+	}
 	if err != nil {
 		output.Error = fmt.Sprintf("Failed to read response: %v", err)
 		output.ErrorCode = "read_error"
@@ -223,22 +240,25 @@ func FetchWebHandler(ctx tool.Context, input FetchWebInput) FetchWebOutput {
 	return output
 }
 
-// getTimeout converts optional timeout in seconds to time.Duration.
-func getTimeout(timeoutSeconds *int) time.Duration {
+// isTimeout reports whether err comes from the request timing out.
+func isTimeout(err error) bool {
+	return os.IsTimeout(err) || errors.Is(err, context.DeadlineExceeded)
+}
+
+// getTimeout converts optional timeout in seconds to time.Duration. Without
+// one, the policy picks a timeout from past fetches of the host.
+func getTimeout(policy *tracking.TimeoutPolicy, timeoutSeconds *int, host string) time.Duration {
 	const defaultTimeout = 30 * time.Second
 	const maxTimeout = 5 * time.Minute
 
-	if timeoutSeconds == nil {
-		return defaultTimeout
+	if timeoutSeconds == nil || *timeoutSeconds <= 0 {
+		return policy.Timeout(fetchWebToolName, host, defaultTimeout, maxTimeout)
 	}
 
 	duration := time.Duration(*timeoutSeconds) * time.Second
 	if duration > maxTimeout {
 		duration = maxTimeout
 	}
-	if duration <= 0 {
-		duration = defaultTimeout
-	}
 	return duration
 }
 
@@ -446,7 +466,7 @@ func isJSONContent(contentType string) bool {
 // NewFetchWebTool creates a tool for fetching web content.
 func NewFetchWebTool() (tool.Tool, error) {
 	t, err := functiontool.New(functiontool.Config{
-		Name: "builtin_fetch_web",
+		Name: fetchWebToolName,
 		Description: `Fetches content from a web URL with optional parsing and formatting.
 
 **Parameters:**
@@ -7,6 +7,8 @@ import (
 	"strings"
 	"testing"
 	"time"
+
+	"adk-code/internal/tracking"
 )
 
 func TestFetchWebTool_Basic(t *testing.T) {
@@ -154,6 +156,28 @@ func TestFetchWebTool_Timeout(t *testing.T) {
 	}
 }
 
+func TestFetchWebTool_TimeoutWhileReadingBody(t *testing.T) {
+	// Headers arrive at once, the body stalls past the timeout
+	server := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		w.WriteHeader(http.StatusOK)
+		w.Write([]byte("partial"))
+		w.(http.Flusher).Flush()
+		time.Sleep(2 * time.Second)
+		w.Write([]byte(" response"))
+	}))
+	defer server.Close()
+
+	timeout := 1
+	output := FetchWebHandler(nil, FetchWebInput{URL: server.URL, Timeout: &timeout})
+
+	if output.Success {
+		t.Error("Expected failure due to timeout")
+	}
+	if output.ErrorCode != "timeout" {
+		t.Errorf("Expected error code 'timeout', got: %s", output.ErrorCode)
+	}
+}
+
 func TestFetchWebTool_Redirects(t *testing.T) {
 	// Create a test server with redirect
 	finalServer := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
@@ -290,7 +314,7 @@ func TestGetTimeout_EnforcesLimits(t *testing.T) {
 
 	for _, tt := range tests {
 		t.Run(tt.name, func(t *testing.T) {
-			result := getTimeout(tt.input)
+			result := getTimeout(tracking.NewTimeoutPolicy(), tt.input, "example.com")
 			if result != tt.expected {
 				t.Errorf("Expected %v, got %v", tt.expected, result)
 			}
@@ -298,6 +322,20 @@ func TestGetTimeout_EnforcesLimits(t *testing.T) {
 	}
 }
 
+func TestGetTimeout_AdaptsToHostLatency(t *testing.T) {
+	policy := tracking.NewTimeoutPolicy()
+	for i := 0; i < 10; i++ {
+		policy.Record(fetchWebToolName, "slow.example.com", 50*time.Second, false)
+	}
+
+	if got := getTimeout(policy, nil, "slow.example.com"); got != 100*time.Second {
+		t.Errorf("Expected 100s for a slow host, got %v", got)
+	}
+	if got := getTimeout(policy, intPtr(20), "slow.example.com"); got != 20*time.Second {
+		t.Errorf("Expected an explicit timeout to win, got %v", got)
+	}
+}
+
 func TestGetMaxSize_EnforcesLimits(t *testing.T) {
 	tests := []struct {
 		name     string
@@ -0,0 +1,125 @@
+package websearch
+
+import (
+	"context"
+	"fmt"
+	"strings"
+
+	"google.golang.org/adk/agent"
+	"google.golang.org/adk/runner"
+	"google.golang.org/adk/session"
+	"google.golang.org/adk/tool"
+	"google.golang.org/adk/tool/functiontool"
+	"google.golang.org/genai"
+)
+
+// maxBatchQueries caps how many queries are answered in one subagent call
+const maxBatchQueries = 5
+
+// CachedSearchInput defines the input parameters for a web search.
+type CachedSearchInput struct {
+	// Query is a single search query.
+	Query string `json:"query,omitempty" jsonschema:"Search query"`
+	// Queries answers several independent queries in one call (batch mode).
+	Queries []string `json:"queries,omitempty" jsonschema:"Several independent search queries answered together (max 5)"`
+}
+
+// CachedSearchOutput defines the output of a web search.
+type CachedSearchOutput struct {
+	Results []SearchResult `json:"results"`
+	Success bool           `json:"success"`
+	Error   string         `json:"error,omitempty"`
+}
+
+// NewCachedSearchTool wraps a search subagent (an agent whose only tool is
+// the native google_search tool) in a function tool with a normalized-query
+// cache and batch mode, so repeated or related searches in a session do not
+// each pay a full subagent round trip.
+func NewCachedSearchTool(searchAgent agent.Agent) (tool.Tool, error) {
+	run, err := newSubagentRunner(searchAgent)
+	if err != nil {
+		return nil, err
+	}
+	layer := newSearchLayer(run, DefaultSearchCacheTTL)
+
+	handler := func(ctx tool.Context, input CachedSearchInput) CachedSearchOutput {
+		queries := make([]string, 0, len(input.Queries)+1)
+		if strings.TrimSpace(input.Query) != "" {
+			queries = append(queries, input.Query)
+		}
+		for _, q := range input.Queries {
+			if strings.TrimSpace(q) != "" {
+				queries = append(queries, q)
+			}
+		}
+		if len(queries) == 0 {
+			return CachedSearchOutput{Results: []SearchResult{}, Error: "query or queries is required"}
+		}
+		if len(queries) > maxBatchQueries {
+			return CachedSearchOutput{Results: []SearchResult{}, Error: fmt.Sprintf("at most %d queries per call", maxBatchQueries)}
+		}
+
+		results, err := layer.Search(ctx, queries)
+		if err != nil {
+			return CachedSearchOutput{Results: []SearchResult{}, Error: fmt.Sprintf("search failed: %v", err)}
+		}
+		return CachedSearchOutput{Results: results, Success: true}
+	}
+
+	return functiontool.New(functiontool.Config{
+		Name:        searchAgent.Name(),
+		Description: "Searches the web with Google and returns grounded answers with source citations. Pass several related questions in 'queries' to answer them in one search. Identical queries within a session are answered from cache.",
+	}, handler)
+}
+
+// newSubagentRunner runs the search agent in an isolated in-memory session
+// and collects its final text and grounding metadata.
+func newSubagentRunner(searchAgent agent.Agent) (searchRunner, error) {
+	sessionService := session.InMemoryService()
+	r, err := runner.New(runner.Config{
+		AppName:        searchAgent.Name(),
+		Agent:          searchAgent,
+		SessionService: sessionService,
+	})
+	if err != nil {
+		return nil, fmt.Errorf("failed to create search runner: %w", err)
+	}
+
+	return func(ctx context.Context, prompt string) (string, *genai.GroundingMetadata, error) {
+		created, err := sessionService.Create(ctx, &session.CreateRequest{AppName: searchAgent.Name(), UserID: "search"})
+		if err != nil {
+			return "", nil, fmt.Errorf("failed to create search session: %w", err)
+		}
+		sess := created.Session
+		defer func() {
+			_ = sessionService.Delete(context.Background(), &session.DeleteRequest{AppName: sess.AppName(), UserID: sess.UserID(), SessionID: sess.ID()})
+		}()
+
+		var answer strings.Builder
+		var grounding *genai.GroundingMetadata
+		msg := genai.NewContentFromText(prompt, genai.RoleUser)
+		for event, err := range r.Run(ctx, sess.UserID(), sess.ID(), msg, agent.RunConfig{}) {
+			if err != nil {
+				return "", nil, err
+			}
+			if event == nil || event.Partial {
+				continue
+			}
+			if event.GroundingMetadata != nil {
+				grounding = event.GroundingMetadata
+			}
+			if event.Content == nil || event.Author != searchAgent.Name() {
+				continue
+			}
+			for _, part := range event.Content.Parts {
+				if part != nil && part.Text != "" && !part.Thought {
+					answer.WriteString(part.Text)
+				}
+			}
+		}
+		if answer.Len() == 0 {
+			return "", nil, fmt.Errorf("search returned no answer")
+		}
+		return answer.String(), grounding, nil
+	}, nil
+}
@@ -0,0 +1,290 @@
+package websearch
+
+import (
+	"context"
+	"fmt"
+	"regexp"
+	"strconv"
+	"strings"
+	"sync"
+	"time"
+	"unicode"
+
+	"google.golang.org/genai"
+)
+
+// DefaultSearchCacheTTL is how long a grounded answer is reused for the same query
+const DefaultSearchCacheTTL = 30 * time.Minute
+
+// maxSearchCacheEntries bounds the cache; the oldest entries are dropped first
+const maxSearchCacheEntries = 256
+
+// Citation is a web source backing a grounded answer.
+type Citation struct {
+	Title string `json:"title,omitempty"`
+	URI   string `json:"uri"`
+}
+
+// SearchResult is the answer to one query.
+type SearchResult struct {
+	Query     string     `json:"query"`
+	Answer    string     `json:"answer"`
+	Citations []Citation `json:"citations,omitempty"`
+	Cached    bool       `json:"cached,omitempty"`
+}
+
+// SearchCacheStats reports cache effectiveness for the session.
+type SearchCacheStats struct {
+	Hits          int
+	Misses        int
+	SubagentCalls int
+	Entries       int
+}
+
+// HitRate returns the fraction of lookups served from cache (0-100).
+func (s SearchCacheStats) HitRate() float64 {
+	if total := s.Hits + s.Misses; total > 0 {
+		return float64(s.Hits) / float64(total) * 100
+	}
+	return 0
+}
+
+// searchRunner performs one grounded search round trip for a prompt.
+type searchRunner func(ctx context.Context, prompt string) (string, *genai.GroundingMetadata, error)
+
+type searchCacheEntry struct {
+	result   SearchResult
+	storedAt time.Time
+}
+
+// searchLayer answers queries from a normalized-query cache and sends the
+// remaining ones to the search subagent, several at a time in one call.
+type searchLayer struct {
+	run searchRunner
+	ttl time.Duration
+	now func() time.Time
+
+	mu      sync.Mutex
+	entries map[string]searchCacheEntry
+	order   []string // insertion order for eviction
+	stats   SearchCacheStats
+}
+
+func newSearchLayer(run searchRunner, ttl time.Duration) *searchLayer {
+	if ttl == 0 {
+		ttl = DefaultSearchCacheTTL
+	}
+	return &searchLayer{
+		run:     run,
+		ttl:     ttl,
+		now:     time.Now,
+		entries: make(map[string]searchCacheEntry),
+	}
+}
+
+// Global stats shared by all search layers of the process, for /tokens
+var (
+	searchStatsMu sync.Mutex
+	searchStats   SearchCacheStats
+)
+
+// GetSearchCacheStats returns the search cache statistics for this session.
+func GetSearchCacheStats() SearchCacheStats {
+	searchStatsMu.Lock()
+	defer searchStatsMu.Unlock()
+	return searchStats
+}
+
+// normalizeQuery folds case, whitespace and trailing punctuation so trivially
+// different phrasings of the same query share a cache entry.
+func normalizeQuery(query string) string {
+	fields := strings.FieldsFunc(strings.ToLower(query), func(r rune) bool {
+		return unicode.IsSpace(r)
+	})
+	normalized := strings.Join(fields, " ")
+	return strings.TrimRightFunc(normalized, func(r rune) bool {
+		return r == '?' || r == '.' || r == '!'
+	})
+}
+
+// Search answers all queries, preserving their order.
+func (l *searchLayer) Search(ctx context.Context, queries []string) ([]SearchResult, error) {
+	results := make([]SearchResult, len(queries))
+	var pending []int
+	seen := make(map[string]int) // normalized query -> first pending index
+	dupOf := make(map[int]int)   // repeated query index -> first pending index
+
+	l.mu.Lock()
+	for i, query := range queries {
+		key := normalizeQuery(query)
+		if entry, ok := l.entries[key]; ok && l.now().Sub(entry.storedAt) < l.ttl {
+			results[i] = entry.result
+			results[i].Query = query
+			results[i].Cached = true
+			l.recordLocked(func(s *SearchCacheStats) { s.Hits++ })
+			continue
+		}
+		if first, dup := seen[key]; dup {
+			dupOf[i] = first
+		} else {
+			seen[key] = i
+			pending = append(pending, i)
+		}
+		l.recordLocked(func(s *SearchCacheStats) { s.Misses++ })
+	}
+	l.mu.Unlock()
+
+	if len(pending) > 0 {
+		pendingQueries := make([]string, len(pending))
+		for j, i := range pending {
+			pendingQueries[j] = queries[i]
+		}
+		answers, cacheable, err := l.fetch(ctx, pendingQueries)
+		if err != nil {
+			return nil, err
+		}
+
+		l.mu.Lock()
+		for j, i := range pending {
+			results[i] = answers[j]
+			if cacheable {
+				l.storeLocked(normalizeQuery(queries[i]), answers[j])
+			}
+		}
+		l.mu.Unlock()
+	}
+
+	// Repeated queries within one call share the first answer
+	for i, first := range dupOf {
+		results[i] = results[first]
+		results[i].Query = queries[i]
+	}
+	return results, nil
+}
+
+// fetch runs one subagent call for all queries. The returned flag is false
+// when a batched answer could not be split reliably per query.
+func (l *searchLayer) fetch(ctx context.Context, queries []string) ([]SearchResult, bool, error) {
+	prompt := queries[0]
+	if len(queries) > 1 {
+		prompt = buildBatchPrompt(queries)
+	}
+
+	l.mu.Lock()
+	l.recordLocked(func(s *SearchCacheStats) { s.SubagentCalls++ })
+	l.mu.Unlock()
+
+	answer, grounding, err := l.run(ctx, prompt)
+	if err != nil {
+		return nil, false, err
+	}
+
+	if len(queries) == 1 {
+		return []SearchResult{{Query: queries[0], Answer: strings.TrimSpace(answer), Citations: citationsFor(grounding, 0, len(answer))}}, true, nil
+	}
+
+	sections := splitBatchAnswer(answer, len(queries))
+	results := make([]SearchResult, len(queries))
+	if sections == nil {
+		// The model ignored the format: give every query the whole answer
+		for i, query := range queries {
+			results[i] = SearchResult{Query: query, Answer: strings.TrimSpace(answer), Citations: citationsFor(grounding, 0, len(answer))}
+		}
+		return results, false, nil
+	}
+	for i, query := range queries {
+		s := sections[i]
+		results[i] = SearchResult{Query: query, Answer: strings.TrimSpace(answer[s[0]:s[1]]), Citations: citationsFor(grounding, s[0], s[1])}
+	}
+	return results, true, nil
+}
+
+// recordLocked updates both the layer and the process-wide statistics.
+func (l *searchLayer) recordLocked(update func(*SearchCacheStats)) {
+	update(&l.stats)
+	searchStatsMu.Lock()
+	update(&searchStats)
+	searchStats.Entries = len(l.entries)
+	searchStatsMu.Unlock()
+}
+
+func (l *searchLayer) storeLocked(key string, result SearchResult) {
+	if _, exists := l.entries[key]; !exists {
+		l.order = append(l.order, key)
+	}
+	l.entries[key] = searchCacheEntry{result: result, storedAt: l.now()}
+	for len(l.order) > maxSearchCacheEntries {
+		delete(l.entries, l.order[0])
+		l.order = l.order[1:]
+	}
+	l.recordLocked(func(s *SearchCacheStats) {})
+}
+
+// buildBatchPrompt asks for one clearly delimited answer per query.
+func buildBatchPrompt(queries []string) string {
+	var b strings.Builder
+	b.WriteString("Search the web and answer each of the following queries independently. ")
+	b.WriteString("Start each answer with a line of the form \"### Query N\" (N is the query number) and do not add text before the first heading.\n\n")
+	for i, query := range queries {
+		fmt.Fprintf(&b, "%d. %s\n", i+1, query)
+	}
+	return b.String()
+}
+
+var batchHeading = regexp.MustCompile(`(?m)^#{1,6}\s*Query\s+(\d+)\b[^\n]*\n?`)
+
+// splitBatchAnswer returns the [start, end) byte range of each query's answer,
+// or nil if the answer does not contain exactly one heading per query.
+func splitBatchAnswer(answer string, count int) [][2]int {
+	matches := batchHeading.FindAllStringSubmatchIndex(answer, -1)
+	if len(matches) != count {
+		return nil
+	}
+	sections := make([][2]int, count)
+	for i, m := range matches {
+		n, err := strconv.Atoi(answer[m[2]:m[3]])
+		if err != nil || n != i+1 {
+			return nil
+		}
+		end := len(answer)
+		if i+1 < len(matches) {
+			end = matches[i+1][0]
+		}
+		sections[i] = [2]int{m[1], end}
+	}
+	return sections
+}
+
+// citationsFor returns the web sources supporting text within [start, end).
+// Without support spans every source is attributed to the whole answer.
+func citationsFor(grounding *genai.GroundingMetadata, start, end int) []Citation {
+	if grounding == nil || len(grounding.GroundingChunks) == 0 {
+		return nil
+	}
+
+	useAll := len(grounding.GroundingSupports) == 0
+	selected := make(map[int]bool)
+	if !useAll {
+		for _, support := range grounding.GroundingSupports {
+			if support == nil || support.Segment == nil {
+				continue
+			}
+			if pos := int(support.Segment.StartIndex); pos >= start && pos < end {
+				for _, idx := range support.GroundingChunkIndices {
+					selected[int(idx)] = true
+				}
+			}
+		}
+	}
+
+	var citations []Citation
+	seen := make(map[string]bool)
+	for i, chunk := range grounding.GroundingChunks {
+		if chunk == nil || chunk.Web == nil || (!useAll && !selected[i]) || seen[chunk.Web.URI] {
+			continue
+		}
+		seen[chunk.Web.URI] = true
+		citations = append(citations, Citation{Title: chunk.Web.Title, URI: chunk.Web.URI})
+	}
+	return citations
+}
@@ -0,0 +1,127 @@
+package websearch
+
+import (
+	"context"
+	"strings"
+	"testing"
+	"time"
+
+	"google.golang.org/genai"
+)
+
+// fakeSearch records prompts and answers with a canned response.
+type fakeSearch struct {
+	prompts   []string
+	answer    string
+	grounding *genai.GroundingMetadata
+}
+
+func (f *fakeSearch) run(ctx context.Context, prompt string) (string, *genai.GroundingMetadata, error) {
+	f.prompts = append(f.prompts, prompt)
+	return f.answer, f.grounding, nil
+}
+
+func TestSearchLayerCachesNormalizedQueries(t *testing.T) {
+	fake := &fakeSearch{answer: "Go 1.24 adds generic type aliases."}
+	layer := newSearchLayer(fake.run, time.Minute)
+	ctx := context.Background()
+
+	first, err := layer.Search(ctx, []string{"What is new in Go 1.24?"})
+	if err != nil {
+		t.Fatalf("Search failed: %v", err)
+	}
+	second, err := layer.Search(ctx, []string{"  what is NEW in go 1.24 "})
+	if err != nil {
+		t.Fatalf("Search failed: %v", err)
+	}
+
+	if len(fake.prompts) != 1 {
+		t.Errorf("expected one subagent call, got %d", len(fake.prompts))
+	}
+	if first[0].Cached || !second[0].Cached {
+		t.Errorf("expected miss then hit, got cached=%v/%v", first[0].Cached, second[0].Cached)
+	}
+	if second[0].Answer != first[0].Answer {
+		t.Errorf("expected cached answer %q, got %q", first[0].Answer, second[0].Answer)
+	}
+	if layer.stats.Hits != 1 || layer.stats.Misses != 1 || layer.stats.HitRate() != 50 {
+		t.Errorf("unexpected stats: %+v", layer.stats)
+	}
+}
+
+func TestSearchLayerExpiresEntries(t *testing.T) {
+	fake := &fakeSearch{answer: "answer"}
+	layer := newSearchLayer(fake.run, time.Minute)
+	now := time.Now()
+	layer.now = func() time.Time { return now }
+
+	_, _ = layer.Search(context.Background(), []string{"query"})
+	now = now.Add(2 * time.Minute)
+	_, _ = layer.Search(context.Background(), []string{"query"})
+
+	if len(fake.prompts) != 2 {
+		t.Errorf("expected expired entry to be refetched, got %d calls", len(fake.prompts))
+	}
+}
+
+func TestSearchLayerBatchesAndSplitsAnswers(t *testing.T) {
+	answer := "### Query 1\nFirst answer.\n### Query 2\nSecond answer.\n"
+	second := strings.Index(answer, "Second")
+	fake := &fakeSearch{
+		answer: answer,
+		grounding: &genai.GroundingMetadata{
+			GroundingChunks: []*genai.GroundingChunk{
+				{Web: &genai.GroundingChunkWeb{URI: "https://a.example", Title: "A"}},
+				{Web: &genai.GroundingChunkWeb{URI: "https://b.example", Title: "B"}},
+			},
+			GroundingSupports: []*genai.GroundingSupport{
+				{Segment: &genai.Segment{StartIndex: 12, EndIndex: 25}, GroundingChunkIndices: []int32{0}},
+				{Segment: &genai.Segment{StartIndex: int32(second), EndIndex: int32(second + 14)}, GroundingChunkIndices: []int32{1}},
+			},
+		},
+	}
+	layer := newSearchLayer(fake.run, time.Minute)
+
+	results, err := layer.Search(context.Background(), []string{"first", "second", "first"})
+	if err != nil {
+		t.Fatalf("Search failed: %v", err)
+	}
+	if len(fake.prompts) != 1 || !strings.Contains(fake.prompts[0], "2. second") {
+		t.Fatalf("expected one batched call, got %q", fake.prompts)
+	}
+	if results[0].Answer != "First answer." || results[1].Answer != "Second answer." {
+		t.Errorf("unexpected split answers: %+v", results)
+	}
+	if len(results[0].Citations) != 1 || results[0].Citations[0].URI != "https://a.example" {
+		t.Errorf("unexpected citations for first query: %+v", results[0].Citations)
+	}
+	if len(results[1].Citations) != 1 || results[1].Citations[0].URI != "https://b.example" {
+		t.Errorf("unexpected citations for second query: %+v", results[1].Citations)
+	}
+	if results[2].Answer != results[0].Answer {
+		t.Errorf("expected duplicate query to share the answer, got %+v", results[2])
+	}
+
+	// Both answers were cached individually
+	_, _ = layer.Search(context.Background(), []string{"second"})
+	if len(fake.prompts) != 1 {
+		t.Errorf("expected batched answers to be cached, got %d calls", len(fake.prompts))
+	}
+}
+
+func TestSearchLayerDoesNotCacheUnsplittableBatch(t *testing.T) {
+	fake := &fakeSearch{answer: "One combined answer without headings."}
+	layer := newSearchLayer(fake.run, time.Minute)
+
+	results, err := layer.Search(context.Background(), []string{"a", "b"})
+	if err != nil {
+		t.Fatalf("Search failed: %v", err)
+	}
+	if results[0].Answer != fake.answer || results[1].Answer != fake.answer {
+		t.Errorf("expected whole answer for each query, got %+v", results)
+	}
+	_, _ = layer.Search(context.Background(), []string{"a"})
+	if len(fake.prompts) != 2 {
+		t.Errorf("expected unsplittable batch not to be cached, got %d calls", len(fake.prompts))
+	}
+}